@@ -78,7 +78,7 @@ CFontManager::~CFontManager()
             CharInfo.second = nullptr;
         }    
     }
-    for (auto FontID : m_FontsByName)
+    for (auto FontID : m_FontsByDesignator)
     {
         glDeleteTextures(1, &FontID.second);
     }
@@ -110,6 +110,7 @@ bool CFontManager::addFont(const std::string& _strFontName,
 {
     METHOD_ENTRY("CFontManager::addFont")
     
+    const StringIDType nFont = CStringTable::intern(_strFontName);
     char* pMemFont = nullptr;
    
     //--------------------------------------------------------------------------
@@ -126,7 +127,7 @@ bool CFontManager::addFont(const std::string& _strFontName,
         inStream.read(pMemFont, nSize);
         inStream.close();
 
-        m_FontsMemByName[_strFontName] = pMemFont;
+        m_FontsMemByName[nFont] = pMemFont;
         
         DOM_FIO(INFO_MSG("Font Manager", "Font " << _strFile << " successfully loaded to memory."))
     }
@@ -135,9 +136,9 @@ bool CFontManager::addFont(const std::string& _strFontName,
         DOM_FIO(ERROR_MSG("Font Manager", "Could not load font " << _strFile << "."))
         return false;
     }
-    m_strFont = _strFontName;
+    m_nFont = nFont;
     
-    this->rasterize(_strFontName, _nSize);
+    this->rasterize(nFont, _nSize);
     
     return true;
 }
@@ -258,19 +259,38 @@ float CFontManager::getTextLength(const std::string& _strText,
                                  const int _nSize)
 {
     METHOD_ENTRY("CFontManager::getTextLength")
+    return this->getTextLength(_strText, CStringTable::intern(_strFont), _nSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns the length (px) of a given text for given font and size
+///
+/// \param _strText Text to be measured in length
+/// \param _nFont   Interned name of font of text to be measured
+/// \param _nSize   Size of text to be measured
+///
+/// \return Measured length of given Text \ref _strText.
+///
+////////////////////////////////////////////////////////////////////////////////
+float CFontManager::getTextLength(const std::string& _strText, 
+                                 const StringIDType _nFont,
+                                 const int _nSize)
+{
+    METHOD_ENTRY("CFontManager::getTextLength")
     
-    const auto ci = m_FontsMemByName.find(_strFont);
+    const auto ci = m_FontsMemByName.find(_nFont);
     if (ci != m_FontsMemByName.end())
     {
-        std::string strFontDesignator = std::to_string(_nSize)+_strFont;
+        const FontDesignatorType nFontDesignator = getDesignator(_nFont, _nSize);
         
         auto nID = 0u;
 
-        auto it = m_FontsByName.find(strFontDesignator);
-        if (it == m_FontsByName.end())
+        auto it = m_FontsByDesignator.find(nFontDesignator);
+        if (it == m_FontsByDesignator.end())
         {
-            this->rasterize(_strFont, _nSize);
-            it = m_FontsByName.find(strFontDesignator);
+            this->rasterize(_nFont, _nSize);
+            it = m_FontsByDesignator.find(nFontDesignator);
         }
         
         nID = it->second;
@@ -302,7 +322,7 @@ float CFontManager::getTextLength(const std::string& _strText,
     }
     else
     {
-        WARNING_MSG("Font Manager", "Font <" << m_strFont << "> unknown.")
+        WARNING_MSG("Font Manager", "Font <" << CStringTable::getString(_nFont) << "> unknown.")
         return 0.0f;
     }
 }
@@ -319,9 +339,24 @@ float CFontManager::getTextLength(const std::string& _strText,
 bool CFontManager::setFont(const std::string& _strFontName)
 {
     METHOD_ENTRY("CFontManager::setFont")
-    if (_strFontName != m_strFont)
+    return this->setFont(CStringTable::intern(_strFontName));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Set the given font for usage
+///
+/// \param _nFont Interned name of font to use
+///
+/// \return Success?
+///
+////////////////////////////////////////////////////////////////////////////////
+bool CFontManager::setFont(const StringIDType _nFont)
+{
+    METHOD_ENTRY("CFontManager::setFont")
+    if (_nFont != m_nFont)
     {
-        m_strFont   = _strFontName;
+        m_nFont     = _nFont;
         m_bChanged  = true;
     }
     return true;
@@ -353,7 +388,7 @@ void CFontManager::triggerMaintenance()
 {
     METHOD_ENTRY("CFontManager::triggerMaintenance")
     
-    if (m_FontsByName.size() > FONT_MGR_MAX_FONTS_BEFORE_REMOVAL)
+    if (m_FontsByDesignator.size() > FONT_MGR_MAX_FONTS_BEFORE_REMOVAL)
     {
         std::vector<GLuint> IDs;
         for (auto FontTimer : m_FontsIdleTime)
@@ -381,24 +416,24 @@ void CFontManager::changeFont()
 {
     METHOD_ENTRY("CFontManager::changeFont")
     
-    const auto ci = m_FontsMemByName.find(m_strFont);
+    const auto ci = m_FontsMemByName.find(m_nFont);
     if (ci != m_FontsMemByName.end())
     {
-        std::string strFontDesignator = std::to_string(m_nSize)+m_strFont;
+        const FontDesignatorType nFontDesignator = getDesignator(m_nFont, m_nSize);
         
-        const auto ci = m_FontsByName.find(strFontDesignator);
-        if (ci != m_FontsByName.end())
+        const auto ci = m_FontsByDesignator.find(nFontDesignator);
+        if (ci != m_FontsByDesignator.end())
         {
             m_unTexID = ci->second;
         }
         else
         {
-            this->rasterize(m_strFont, m_nSize);
-            m_unTexID = m_FontsByName[strFontDesignator];
+            this->rasterize(m_nFont, m_nSize);
+            m_unTexID = m_FontsByDesignator[nFontDesignator];
         }
 
         // End current render batch since it is bound to the font texture
-        m_Graphics.restartRenderBatch(m_strRenderModeName);
+        m_Graphics.restartRenderBatch(m_nRenderMode);
         
         m_pFontCharInfo = m_FontsCharInfo[m_unTexID];
         m_nAtlasSize    = m_AtlasSizes[m_unTexID];
@@ -410,7 +445,7 @@ void CFontManager::changeFont()
     }
     else
     {
-        WARNING_MSG("Font Manager", "Font <" << m_strFont << "> unknown.")
+        WARNING_MSG("Font Manager", "Font <" << CStringTable::getString(m_nFont) << "> unknown.")
     }
     m_bChanged = false;
 }
@@ -419,34 +454,34 @@ void CFontManager::changeFont()
 ///
 /// \brief Rasterizes font
 ///
-/// \param _strFontName Name of font to rasterize
+/// \param _nFont Interned name of font to rasterize
 /// \param _nSize Size for rasterized font
 ///
 ////////////////////////////////////////////////////////////////////////////////
-void CFontManager::rasterize(const std::string& _strFontName, const int _nSize)
+void CFontManager::rasterize(const StringIDType _nFont, const int _nSize)
 {
     METHOD_ENTRY("CFontManager::rasterize")
     
-    DEBUG_MSG("Font manager", "Rasterising font " << _strFontName << ", Size: " << _nSize)
+    DEBUG_MSG("Font manager", "Rasterising font " << CStringTable::getString(_nFont) << ", Size: " << _nSize)
     
-    std::string strFontDesignator = std::to_string(_nSize)+_strFontName;
+    const FontDesignatorType nFontDesignator = getDesignator(_nFont, _nSize);
     GLuint unIDTex = 0u;
-    if (m_FontsByName.find(strFontDesignator) == m_FontsByName.end())
+    if (m_FontsByDesignator.find(nFontDesignator) == m_FontsByDesignator.end())
     {
         glGenTextures(1, &unIDTex);
-        m_FontsByName[strFontDesignator] = unIDTex;
+        m_FontsByDesignator[nFontDesignator] = unIDTex;
     }
     else
     {
-        WARNING_MSG("Font Manager", "Font with name " << _strFontName << " already existing.")
-        unIDTex = m_FontsByName[strFontDesignator];
+        WARNING_MSG("Font Manager", "Font with name " << CStringTable::getString(_nFont) << " already existing.")
+        unIDTex = m_FontsByDesignator[nFontDesignator];
     }
     
     DOM_VAR(DEBUG_BLK(
         std::cout << "  Font memory: " << std::endl;
-        for (const auto Font : m_FontsByName)
+        for (const auto Font : m_FontsByDesignator)
         {
-            std::cout << "  - " << Font.first << std::endl;
+            std::cout << "  - " << getDesignatorName(Font.first) << std::endl;
         }
     ))
     
@@ -489,7 +524,7 @@ void CFontManager::rasterize(const std::string& _strFontName, const int _nSize)
         }
         
         stbtt_PackSetOversampling(&Context, 1, 1);
-        if (!stbtt_PackFontRange(&Context, reinterpret_cast<unsigned char*>(m_FontsMemByName[_strFontName]), 0,
+        if (!stbtt_PackFontRange(&Context, reinterpret_cast<unsigned char*>(m_FontsMemByName[_nFont]), 0,
                                 FONT_MGR_SCALE * float(_nSize),
                                 ASCII_FIRST, ASCII_NR, m_pFontCharInfo))
         {
@@ -518,7 +553,7 @@ void CFontManager::rasterize(const std::string& _strFontName, const int _nSize)
 //             m_FontsMemAtlas[unIDTex] = nullptr;
 //         }
 //         m_FontsMemAtlas.erase(unIDTex);
-//         m_FontsByName.erase(strFontDesignator);
+//         m_FontsByDesignator.erase(nFontDesignator);
 //         
 //         m_pFontCharInfo = pFontCharInfo;
     }
@@ -607,11 +642,11 @@ bool CFontManager::removeFont(const GLuint _unTexID)
     }
     else bSuccess = false;
     
-    for (auto it = m_FontsByName.begin(); it != m_FontsByName.end(); ++it)
+    for (auto it = m_FontsByDesignator.begin(); it != m_FontsByDesignator.end(); ++it)
     {
         if (it->second == _unTexID)
         {
-            m_FontsByName.erase(it);
+            m_FontsByDesignator.erase(it);
             break;
         }
         else bSuccess = false;
@@ -34,6 +34,7 @@
 #define GL_GLEXT_PROTOTYPES
 
 //--- Standard header --------------------------------------------------------//
+#include <cstdint>
 
 //--- Program header ---------------------------------------------------------//
 #include "graphics.h"
@@ -57,6 +58,9 @@ constexpr double FONT_MGR_MAX_IDLE_TIME_DEFAULT = 180.0;
 constexpr int FONT_MGR_NO_WORD_WRAP = -1;
 const std::string FONT_MGR_FONT_DEFAULT = "anka_c87_r";
 
+/// Font designator, combining interned font name and font size
+typedef std::uint64_t FontDesignatorType;
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Class for loading, rasterizing and rendering fonts
@@ -69,8 +73,8 @@ class CFontManager : public CGraphicsBase
 
         //--- Constructor/Destructor -----------------------------------------//
         CFontManager() :    m_pFontCharInfo(nullptr),
-                            m_strFont(""),
-                            m_strRenderModeName("font"),
+                            m_nFont(STRING_ID_INVALID),
+                            m_nRenderMode(GRAPHICS_RENDER_MODE_FONT),
                             m_nAtlasSize(FONT_MGR_ATLAS_SIZE_DEFAULT),
                             m_nSize(FONT_MGR_SIZE_DEFAULT),
                             m_unTexID(0u),
@@ -80,7 +84,7 @@ class CFontManager : public CGraphicsBase
         ~CFontManager();
 
         //--- Constant Methods -----------------------------------------------//
-        const std::unordered_map<std::string, GLuint>* getFontsAvailable() const;
+        const std::unordered_map<FontDesignatorType, GLuint>* getFontsAvailable() const;
         const std::unordered_map<GLuint, CTimer*>* getFontsIdleTime() const
         {
             return &m_FontsIdleTime;
@@ -90,32 +94,38 @@ class CFontManager : public CGraphicsBase
         bool    addFont(const std::string&, const std::string&, const int = FONT_MGR_SIZE_DEFAULT);
         void    drawText(const std::string&, const bool = false, const int = FONT_MGR_NO_WORD_WRAP);
         void    drawText(const std::string&, const float&, const float&, const bool = false, const int = FONT_MGR_NO_WORD_WRAP);
-        GLuint  getIDTex(const std::string&);
+        GLuint  getIDTex(const StringIDType, const int);
         float   getTextLength(const std::string&, const std::string&, const int);
+        float   getTextLength(const std::string&, const StringIDType, const int);
         bool    setFont(const std::string&);
-        void    setRenderModeName(const std::string& _strName) {m_strRenderModeName = _strName;}
+        bool    setFont(const StringIDType);
+        void    setRenderModeName(const std::string& _strName) {m_nRenderMode = CStringTable::intern(_strName);}
         void    setSize(const int);
         void    triggerMaintenance();
                 
+        //--- Static methods -------------------------------------------------//
+        static FontDesignatorType   getDesignator(const StringIDType, const int);
+        static std::string          getDesignatorName(const FontDesignatorType);
+
         //--- friends --------------------------------------------------------//
 
     private:
         
         //--- Methods [private] ----------------------------------------------//
         void    changeFont();
-        void    rasterize(const std::string&, const int);
+        void    rasterize(const StringIDType, const int);
         bool    removeFont(const GLuint);
         
         //--- Variables [private] --------------------------------------------//
-        std::unordered_map<std::string, GLuint>         m_FontsByName;      ///< Fonts GL IDs accessed by name
+        std::unordered_map<FontDesignatorType, GLuint>  m_FontsByDesignator;///< Fonts GL IDs accessed by name and size
         std::unordered_map<GLuint, CTimer*>             m_FontsIdleTime;    ///< Time that a font hasn't been used
-        std::unordered_map<std::string, char*>          m_FontsMemByName;   ///< Fonts stored in memory after loading
+        std::unordered_map<StringIDType, char*>         m_FontsMemByName;   ///< Fonts stored in memory after loading, accessed by interned name
         std::unordered_map<GLuint, std::uint8_t*>       m_FontsMemAtlas;    ///< Memory of font atlas texture
         std::unordered_map<GLuint, int>                 m_AtlasSizes;       ///< Size of font atlases
         std::unordered_map<GLuint, stbtt_packedchar*>   m_FontsCharInfo;    ///< Font information like kerning
         stbtt_packedchar*                               m_pFontCharInfo;    ///< Char info of current font
-        std::string                                     m_strFont;          ///< Current font
-        std::string                                     m_strRenderModeName;///< Name of registered render mode for fonts
+        StringIDType                                    m_nFont;            ///< Current font, interned name
+        StringIDType                                    m_nRenderMode;      ///< Interned name of registered render mode for fonts
         int                                             m_nAtlasSize;       ///< Current Atlas size
         int                                             m_nSize;            ///< Current font size
         GLuint                                          m_unTexID;          ///< Current texture
@@ -128,40 +138,74 @@ class CFontManager : public CGraphicsBase
 
 ////////////////////////////////////////////////////////////////////////////////
 ///
-/// \brief Return map of all currently available fonts, accessed by name
+/// \brief Return map of all currently available fonts, accessed by designator
 ///
-/// \return Map of all currently available fonts, accessed by name
+/// \return Map of all currently available fonts, accessed by designator
 ///
 ////////////////////////////////////////////////////////////////////////////////
-inline const std::unordered_map<std::string, GLuint>* CFontManager::getFontsAvailable() const
+inline const std::unordered_map<FontDesignatorType, GLuint>* CFontManager::getFontsAvailable() const
 {
     METHOD_ENTRY("CFontManager::getFontsAvailable")
-    return &m_FontsByName;
+    return &m_FontsByDesignator;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Return id of texture
 ///
-/// \param _strFont Font to get texture id from
+/// \param _nFont Interned name of font to get texture id from
+/// \param _nSize Size of font to get texture id from
 ///
 /// \return ID of texture of given font
 ///
 ////////////////////////////////////////////////////////////////////////////////
-inline GLuint CFontManager::getIDTex(const std::string& _strFont)
+inline GLuint CFontManager::getIDTex(const StringIDType _nFont, const int _nSize)
 {
     METHOD_ENTRY("CFontManager::getIDTex")
     
+    const FontDesignatorType nDesignator = getDesignator(_nFont, _nSize);
     DOM_DEV
     (
-        const auto ci = m_FontsByName.find(_strFont);
-        if (ci == m_FontsByName.end())
+        const auto ci = m_FontsByDesignator.find(nDesignator);
+        if (ci == m_FontsByDesignator.end())
         {
-            ERROR_MSG("Font Manager", "Unknown font with name " << _strFont << ".")
+            ERROR_MSG("Font Manager", "Unknown font with name " << getDesignatorName(nDesignator) << ".")
             return 0;
         }
     )
-    return m_FontsByName[_strFont];
+    return m_FontsByDesignator[nDesignator];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Return designator of font with given name and size
+///
+/// \param _nFont Interned name of font
+/// \param _nSize Size of font
+///
+/// \return Designator of font, identifying a rasterised font
+///
+////////////////////////////////////////////////////////////////////////////////
+inline FontDesignatorType CFontManager::getDesignator(const StringIDType _nFont, const int _nSize)
+{
+    METHOD_ENTRY("CFontManager::getDesignator")
+    return (FontDesignatorType(_nFont) << 32) | std::uint32_t(_nSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Return readable name of font designator, i.e. size and name
+///
+/// \param _nDesignator Designator of font
+///
+/// \return Readable name of font designator
+///
+////////////////////////////////////////////////////////////////////////////////
+inline std::string CFontManager::getDesignatorName(const FontDesignatorType _nDesignator)
+{
+    METHOD_ENTRY("CFontManager::getDesignatorName")
+    return std::to_string(std::int32_t(_nDesignator & 0xFFFFFFFFu)) +
+           CStringTable::getString(StringIDType(_nDesignator >> 32));
 }
 
 #endif // FONT_MANAGER_H
@@ -397,15 +397,40 @@ bool CGraphics::beginRenderBatch(const std::string& _strRenderModeName)
 {
     METHOD_ENTRY("CGraphics::beginRenderBatch")
     
-    auto ci = m_RenderModesByName.find(_strRenderModeName);
-    if (ci != m_RenderModesByName.end())
+    const StringIDType nID = CStringTable::find(_strRenderModeName);
+    if (nID != STRING_ID_INVALID)
+    {
+        return this->beginRenderBatch(nID);
+    }
+    else
+    {
+        WARNING_MSG("Graphics", "Render mode \"" << _strRenderModeName << "\" not registered")
+        return false;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Start registered render batch
+///
+/// \param _nRenderModeID Interned name of render mode to use
+///
+/// \return Success?
+///
+///////////////////////////////////////////////////////////////////////////////
+bool CGraphics::beginRenderBatch(const StringIDType _nRenderModeID)
+{
+    METHOD_ENTRY("CGraphics::beginRenderBatch")
+    
+    auto ci = m_RenderModesByID.find(_nRenderModeID);
+    if (ci != m_RenderModesByID.end())
     {
         this->beginRenderBatch(ci->second);
         return true;
     }
     else
     {
-        WARNING_MSG("Graphics", "Render mode \"" << _strRenderModeName << "\" not registered")
+        WARNING_MSG("Graphics", "Render mode \"" << CStringTable::getString(_nRenderModeID) << "\" not registered")
         return false;
     }
 }
@@ -572,15 +597,40 @@ bool CGraphics::restartRenderBatch(const std::string& _strRenderModeName)
 {
     METHOD_ENTRY("CGraphics::restartRenderBatch")
     
-    auto ci = m_RenderModesByName.find(_strRenderModeName);
-    if (ci != m_RenderModesByName.end())
+    const StringIDType nID = CStringTable::find(_strRenderModeName);
+    if (nID != STRING_ID_INVALID)
+    {
+        return this->restartRenderBatch(nID);
+    }
+    else
+    {
+        WARNING_MSG("Graphics", "Render mode \"" << _strRenderModeName << "\" not registered")
+        return false;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Restart registered render batch
+///
+/// \param _nRenderModeID Interned name of render mode to use
+///
+/// \return Success?
+///
+///////////////////////////////////////////////////////////////////////////////
+bool CGraphics::restartRenderBatch(const StringIDType _nRenderModeID)
+{
+    METHOD_ENTRY("CGraphics::restartRenderBatch")
+    
+    auto ci = m_RenderModesByID.find(_nRenderModeID);
+    if (ci != m_RenderModesByID.end())
     {
         this->restartRenderBatch(ci->second);
         return true;
     }
     else
     {
-        WARNING_MSG("Graphics", "Render mode \"" << _strRenderModeName << "\" not registered")
+        WARNING_MSG("Graphics", "Render mode \"" << CStringTable::getString(_nRenderModeID) << "\" not registered")
         return false;
     }
 }
@@ -668,9 +718,9 @@ bool CGraphics::init()
     this->resetBufferObjects();
     this->setupWorldSpace();
     
-    if (!m_RenderModesByName.empty())
+    if (!m_RenderModesByID.empty())
     {
-        m_pRenderMode = m_RenderModesByName.cbegin()->second;
+        m_pRenderMode = m_RenderModesByID.cbegin()->second;
     }
     else
     {
@@ -1203,12 +1253,15 @@ void CGraphics::dot(const Vector2d& _vecV)
 ///
 /// \brief Draw dots
 ///
-/// \param _Dots List of dots to be drawn
+/// \param _pX x components of dots to be drawn
+/// \param _pY y components of dots to be drawn
+/// \param _nSize Number of dots
 /// \param _vecOffset Offset for drawing, used e.g. when existing list should
 ///                   be shifted.
 ///
 ///////////////////////////////////////////////////////////////////////////////
-void CGraphics::dots(CCircularBuffer<Vector2d>& _Dots,
+void CGraphics::dots(const double* const _pX, const double* const _pY,
+                     const std::size_t _nSize,
                      const Vector2d& _vecOffset)
 {
     METHOD_ENTRY("CGraphics::dots")
@@ -1217,23 +1270,23 @@ void CGraphics::dots(CCircularBuffer<Vector2d>& _Dots,
     int nBatchSize = GRAPHICS_SIZE_OF_INDEX_BUFFER / 8;
     
     // Draw smaller batches if larger than buffer size    
-    if (m_uncI + 4*_Dots.size() > GRAPHICS_SIZE_OF_INDEX_BUFFER / 2)
+    if (m_uncI + 4*_nSize > GRAPHICS_SIZE_OF_INDEX_BUFFER / 2)
     {
         this->restartRenderBatchInternal();
         
-        nBatches = _Dots.size() / nBatchSize;
+        nBatches = _nSize / nBatchSize;
         
         for (auto j=0; j<nBatches; ++j)
         {
             for (int i=j*nBatchSize; i<(j+1)*nBatchSize; ++i)
             {
-                m_vecVertices[m_unIndexVerts++] = _Dots[i][0]+_vecOffset[0];
-                m_vecVertices[m_unIndexVerts++] = _Dots[i][1]+_vecOffset[1];
+                m_vecVertices[m_unIndexVerts++] = _pX[i]+_vecOffset[0];
+                m_vecVertices[m_unIndexVerts++] = _pY[i]+_vecOffset[1];
                 m_vecVertices[m_unIndexVerts++] = float(m_fDepth);
-                m_vecColours[m_unIndexCol++] = m_aColour[0]; // * double(i) / _Dots.size(); Works
-                m_vecColours[m_unIndexCol++] = m_aColour[1]; // * double(i) / _Dots.size(); Works
-                m_vecColours[m_unIndexCol++] = m_aColour[2]; // * double(i) / _Dots.size(); Works
-                m_vecColours[m_unIndexCol++] = m_aColour[3] * double(i) / _Dots.size(); // Somehow, this doesn't work
+                m_vecColours[m_unIndexCol++] = m_aColour[0]; // * double(i) / _nSize; Works
+                m_vecColours[m_unIndexCol++] = m_aColour[1]; // * double(i) / _nSize; Works
+                m_vecColours[m_unIndexCol++] = m_aColour[2]; // * double(i) / _nSize; Works
+                m_vecColours[m_unIndexCol++] = m_aColour[3] * double(i) / _nSize; // Somehow, this doesn't work
                 m_vecIndicesPoints[m_unIndexPoints++] = m_unIndex++;
             }
             this->restartRenderBatchInternal();
@@ -1242,19 +1295,19 @@ void CGraphics::dots(CCircularBuffer<Vector2d>& _Dots,
     }
 
     // Draw residuum
-    for (int i=nBatches*nBatchSize; i< int(_Dots.size()); ++i)
+    for (int i=nBatches*nBatchSize; i< int(_nSize); ++i)
     {
-        m_vecVertices[m_unIndexVerts++] = _Dots[i][0]+_vecOffset[0];
-        m_vecVertices[m_unIndexVerts++] = _Dots[i][1]+_vecOffset[1];
+        m_vecVertices[m_unIndexVerts++] = _pX[i]+_vecOffset[0];
+        m_vecVertices[m_unIndexVerts++] = _pY[i]+_vecOffset[1];
         m_vecVertices[m_unIndexVerts++] = float(m_fDepth);
-        m_vecColours[m_unIndexCol++] = m_aColour[0]; // * double(i) / _Dots.size(); Works
-        m_vecColours[m_unIndexCol++] = m_aColour[1]; // * double(i) / _Dots.size(); Works
-        m_vecColours[m_unIndexCol++] = m_aColour[2]; // * double(i) / _Dots.size(); Works
-        m_vecColours[m_unIndexCol++] = m_aColour[3] * double(i) / _Dots.size(); // Somehow, this doesn't work
+        m_vecColours[m_unIndexCol++] = m_aColour[0]; // * double(i) / _nSize; Works
+        m_vecColours[m_unIndexCol++] = m_aColour[1]; // * double(i) / _nSize; Works
+        m_vecColours[m_unIndexCol++] = m_aColour[2]; // * double(i) / _nSize; Works
+        m_vecColours[m_unIndexCol++] = m_aColour[3] * double(i) / _nSize; // Somehow, this doesn't work
         m_vecIndicesPoints[m_unIndexPoints++] = m_unIndex++;
     }
 
-    m_uncI += 4*(_Dots.size()-nBatches*nBatchSize);
+    m_uncI += 4*(_nSize-nBatches*nBatchSize);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -42,6 +42,7 @@
 #include "shader_program.h"
 #include "shape_subtypes.h"
 #include "render_mode.h"
+#include "string_table.h"
 
 //--- Misc header ------------------------------------------------------------//
 #include <eigen3/Eigen/Core>
@@ -94,14 +95,21 @@ constexpr bool   GRAPHICS_CIRCLE_USE_CACHE = true;          ///< Flag for using
 constexpr bool GRAPHICS_RENDER_BATCH_CALL_FORCED = true;    ///< Indicates a forced render batch call, ignoring stack
 constexpr bool GRAPHICS_RENDER_BATCH_CALL_NORMAL = false;   ///< Indicates a normal render batch call
 
+const StringIDType GRAPHICS_RENDER_MODE_COMPOSITION = CStringTable::intern("composition"); ///< Render mode for composition
+const StringIDType GRAPHICS_RENDER_MODE_FONT = CStringTable::intern("font");               ///< Render mode for fonts
+const StringIDType GRAPHICS_RENDER_MODE_LIGHTS = CStringTable::intern("lights");           ///< Render mode for lights
+const StringIDType GRAPHICS_RENDER_MODE_MAIN_SCREEN = CStringTable::intern("main_screen"); ///< Render mode for main screen
+const StringIDType GRAPHICS_RENDER_MODE_STARS = CStringTable::intern("stars");             ///< Render mode for stars
+const StringIDType GRAPHICS_RENDER_MODE_WORLD = CStringTable::intern("world");             ///< Render mode for world
+
 
 /// Type definition for RGB colours
 typedef std::array<double, 3> ColorTypeRGB;
 /// Type definition for RGBA colours
 typedef std::array<double, 4> ColorTypeRGBA;
 
-/// Type definition of a render modes, accessed by name
-typedef std::unordered_map<std::string, CRenderMode*> RenderModesByNameType;
+/// Type definition of a render modes, accessed by interned name
+typedef std::unordered_map<StringIDType, CRenderMode*> RenderModesByIDType;
 
 // Structure containing viewport information
 struct ViewPort
@@ -173,10 +181,12 @@ class CGraphics
         //--- Methods --------------------------------------------------------//
         void beginRenderBatch(CRenderMode* const, const bool = false);
         bool beginRenderBatch(const std::string&);
+        bool beginRenderBatch(const StringIDType);
         void endRenderBatch(const bool = GRAPHICS_RENDER_BATCH_CALL_NORMAL);
         bool restartRenderBatch(const std::string&);
+        bool restartRenderBatch(const StringIDType);
         void restartRenderBatch(CRenderMode* const);
-        void registerRenderMode(const std::string& _strName, CRenderMode* const);
+        StringIDType registerRenderMode(const std::string& _strName, CRenderMode* const);
         
         bool init();
         void resizeViewport(unsigned short, unsigned short);
@@ -226,7 +236,8 @@ class CGraphics
         void addVertex(const Vector2d&);
         void addVertex(const double&, const double&);
         void dot(const Vector2d&);
-        void dots(CCircularBuffer<Vector2d>&, const Vector2d& _vecOffset = Vector2d(0.0,0.0));
+        void dots(const double* const, const double* const, const std::size_t,
+                  const Vector2d& _vecOffset = Vector2d(0.0,0.0));
         void filledCircle(const Vector2d&, const double&, const int = 12, const bool = false);
         void filledRect(const Vector2d&, const Vector2d&);
         void filledTriangle(const Vector2d&, const Vector2d&, const Vector2d&);
@@ -301,7 +312,7 @@ class CGraphics
         std::vector<GLfloat>    m_vecUV0s;              ///< Temporary buffer for texture coordinates (texture 0)
         std::vector<GLfloat>    m_vecUV1s;              ///< Temporary buffer for texture coordinates (texture 1)
         
-        RenderModesByNameType   m_RenderModesByName;    ///< Map of render modes, accessed by name
+        RenderModesByIDType     m_RenderModesByID;      ///< Map of render modes, accessed by interned name
         CRenderMode*            m_pRenderMode;          ///< Currently selected render mode
         RenderModeType          m_RenderModeType;       ///< Currently used render mode
         std::stack<CRenderMode*> m_RenderModeStack;     ///< Temporarily saves render batch information
@@ -551,11 +562,15 @@ inline WindowHandleType* CGraphics::getWindow() const
 /// \param _strName Name of render mode to be registered
 /// \param _pRenderMode Render mode to register
 ///
+/// \return Interned name of render mode, to be used by \ref beginRenderBatch
+///
 ///////////////////////////////////////////////////////////////////////////////
-inline void CGraphics::registerRenderMode(const std::string& _strName, CRenderMode* const _pRenderMode)
+inline StringIDType CGraphics::registerRenderMode(const std::string& _strName, CRenderMode* const _pRenderMode)
 {
     METHOD_ENTRY("CGraphics::registerRenderMode")
-    m_RenderModesByName.insert({_strName, _pRenderMode});
+    const StringIDType nID = CStringTable::intern(_strName);
+    m_RenderModesByID.insert({nID, _pRenderMode});
+    return nID;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
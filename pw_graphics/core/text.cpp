@@ -48,7 +48,7 @@ CText::CText(CFontManager* const _pFontManager) : CGraphicsBase(),
                   m_nWordWrap(FONT_MGR_NO_WORD_WRAP),
                   m_bCentered(false),
                   m_bNewState(true),
-                  m_strFont(FONT_MGR_FONT_DEFAULT),
+                  m_nFont(CStringTable::intern(FONT_MGR_FONT_DEFAULT)),
                   m_strText(""),
                   m_pFontManager(_pFontManager) 
 {
@@ -68,7 +68,7 @@ void CText::addTextPart(const std::string& _strText)
     METHOD_ENTRY("CText::addTextPart")
     
     DOM_DEV(
-        if (m_strFont == "")
+        if (m_nFont == STRING_ID_INVALID)
         {
             WARNING_MSG("Text", "No font set, yet. Call <setFont> first. Text would have been: " << _strText)
             goto DomDevTextNoFont;
@@ -77,7 +77,7 @@ void CText::addTextPart(const std::string& _strText)
     
     m_PartsColors.push_back(m_Color);
     m_PartsSizes.push_back(m_nSize);
-    m_PartsFonts.push_back(m_strFont);
+    m_PartsFonts.push_back(m_nFont);
     m_PartsTexts.push_back(_strText);
     
     m_strText += _strText;
@@ -114,7 +114,7 @@ void CText::display()
     
     DOM_DEV
     (
-        if (m_strFont == "")
+        if (m_nFont == STRING_ID_INVALID)
         {
             WARNING_MSG("Text", "Font not set. Text would have been: " << m_strText)
             goto LabelDomDevNoFontManager;
@@ -161,9 +161,9 @@ float CText::getLength()
         for (auto Text : m_PartsTexts)
         {
             if (chLast != 10)
-                m_fLength += m_pFontManager->getTextLength(Text, m_strFont, m_nSize);
+                m_fLength += m_pFontManager->getTextLength(Text, m_nFont, m_nSize);
             else
-                m_fLength = m_pFontManager->getTextLength(Text, m_strFont, m_nSize);
+                m_fLength = m_pFontManager->getTextLength(Text, m_nFont, m_nSize);
             
             if (m_fLength > fLengthMax) fLengthMax = m_fLength;
             
@@ -206,14 +206,14 @@ void CText::setColor(const TextPartType _TextPart, const ColorTypeRGBA& _Color)
 void CText::setFont(const std::string& _strFont)
 {
     METHOD_ENTRY("CText::setFont")
-    m_strFont = _strFont;
+    m_nFont = CStringTable::intern(_strFont);
     m_bNewState = true;
     
     // Set font in font manager. This is usually done before rendering, but 
     // here, it ensures that the font manager rasterises a new font if not
     // already existing. Hence, after this call all font/font size related
     // calls are valid, such as getTextLength.
-    m_pFontManager->setFont(_strFont);
+    m_pFontManager->setFont(m_nFont);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -228,9 +228,10 @@ void CText::setFont(const TextPartType _TextPart, const std::string& _strFont)
 {
     METHOD_ENTRY("CText::setFont")
     
+    const StringIDType nFont = CStringTable::intern(_strFont);
     if (m_PartsFonts.size() > _TextPart)
     {
-        m_PartsFonts[_TextPart] = _strFont;
+        m_PartsFonts[_TextPart] = nFont;
     }
     else
     {
@@ -238,7 +239,7 @@ void CText::setFont(const TextPartType _TextPart, const std::string& _strFont)
     }
 
     m_bNewState = true;
-    m_pFontManager->setFont(_strFont);  // See setFont for explanation why to set font here
+    m_pFontManager->setFont(nFont);  // See setFont for explanation why to set font here
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -323,7 +324,7 @@ void CText::setText(const std::string& _strText)
     this->addTextPart(_strText);
     
     DOM_DEV(
-        if (m_strFont == "")
+        if (m_nFont == STRING_ID_INVALID)
         {
             WARNING_MSG("Text", "No font set, yet. Call <setFont> first. Text would have been: " << _strText)
             goto DomDevTextNoFont;
@@ -346,7 +347,7 @@ void CText::setText(const TextPartType _TextPart, const std::string& _strText)
     METHOD_ENTRY("CText::setText")
     
     DOM_DEV(
-        if (m_strFont == "")
+        if (m_nFont == STRING_ID_INVALID)
         {
             WARNING_MSG("Text", "No font set, yet. Call <setFont> first. Text would have been: " << _strText)
             goto DomDevTextNoFont;
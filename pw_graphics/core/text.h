@@ -100,7 +100,7 @@ class CText : virtual public CGraphicsBase
         //--- Variables [private] --------------------------------------------//
         std::vector<ColorTypeRGBA>  m_PartsColors;  ///< Colors of text parts
         std::vector<int>            m_PartsSizes;   ///< Sizes of text parts
-        std::vector<std::string>    m_PartsFonts;   ///< Font type of text parts
+        std::vector<StringIDType>   m_PartsFonts;   ///< Font type of text parts, interned names
         std::vector<std::string>    m_PartsTexts;   ///< Text part
         
         
@@ -112,7 +112,7 @@ class CText : virtual public CGraphicsBase
         int             m_nWordWrap;    ///< Word wrap (px)
         bool            m_bCentered;    ///< Center Text to position
         bool            m_bNewState;    ///< Indicates, if there's a parameter change
-        std::string     m_strFont;      ///< Name of font to use
+        StringIDType    m_nFont;        ///< Interned name of font to use
         std::string     m_strText;      ///< Text to display
         
         CFontManager*   m_pFontManager; ///< Font manager to use for drawing
@@ -51,7 +51,7 @@ CCamera::CCamera() : IGridUser(),
     
     m_vecCell.setZero();
     
-    m_UID.setName("Cam_"+m_UID.getName());
+    m_UID.setNamePrefix("Cam_");
     
     this->reset();
 }
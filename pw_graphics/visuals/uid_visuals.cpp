@@ -49,12 +49,12 @@ void CUIDVisuals::draw(const int _nPosX, const int _nPosY,
     {
         UIDText.setText(_strUsr + ": " + std::to_string(_nUID));
         double fSizeX = UIDText.getLength()+5.0;
-        m_Graphics.beginRenderBatch("world");
+        m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_WORLD);
             m_Graphics.setColor(m_aBGColor);
             m_Graphics.filledRect(Vector2d(_nPosX, _nPosY),
                                   Vector2d(_nPosX + fSizeX, _nPosY+UIDText.getFontSize()*UID_VISUALS_FONT_SCALE));
         m_Graphics.endRenderBatch();
-        m_Graphics.beginRenderBatch("font");
+        m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_FONT);
             UIDText.setPosition(_nPosX+fSizeX*0.5, _nPosY, TEXT_POSITION_CENTERED_X);
             UIDText.display();
         m_Graphics.endRenderBatch();
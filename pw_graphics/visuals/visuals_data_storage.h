@@ -39,7 +39,7 @@
 #include "camera.h"
 #include "com_console.h"
 #include "com_interface.h"
-#include "spinlock.h"
+#include "adaptive_lock.h"
 #include "uid_visuals_user.h"
 #include "widget.h"
 #include "window.h"
@@ -120,7 +120,7 @@ class CVisualsDataStorage : public IComInterfaceUser,
         friend std::ostream& operator<<(std::ostream&, CVisualsDataStorage&);
         
         //--- Variables ------------------------------------------------------//
-        CSpinlock AccessCameras;
+        CAdaptiveLock AccessCameras{"CVisualsDataStorage::AccessCameras"};
         
     private:
       
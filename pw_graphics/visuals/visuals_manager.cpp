@@ -420,17 +420,27 @@ void CVisualsManager::drawParticles(const CHandle<CCamera>& _hCamera) const
             {
                 case ParticleTypeType::DOT:
                 {
-                    m_Graphics.dots((*Particle.second->getPositions()),-_hCamera->getCenter()+
-                        IGridUser::cellToDouble(Particle.second->getCell() - _hCamera->getCell()));
+                    // Live particles might wrap around at the end of the arrays
+                    const Vector2d vecOffset = -_hCamera->getCenter() +
+                                               IGridUser::cellToDouble(Particle.second->getCell() - _hCamera->getCell());
+                    const std::size_t nFirst = Particle.second->getFirstSlot();
+                    const std::size_t nSize  = Particle.second->getNumberOfParticles();
+                    const std::size_t nTail  = std::min(nSize, Particle.second->getCapacity() - nFirst);
+                    m_Graphics.dots(Particle.second->getPositionsX().data() + nFirst,
+                                    Particle.second->getPositionsY().data() + nFirst,
+                                    nTail, vecOffset);
+                    m_Graphics.dots(Particle.second->getPositionsX().data(),
+                                    Particle.second->getPositionsY().data(),
+                                    nSize - nTail, vecOffset);
                     break;
                 }
                 case ParticleTypeType::SMOKE:
                 case ParticleTypeType::THRUST:
                 {
-                    auto   nSize   = Particle.second->getPositions()->size();
+                    auto   nSize   = Particle.second->getNumberOfParticles();
                     double fSizeR  = 1.0;
                     double fGrowth = (Particle.second->getSizeDeath() - Particle.second->getSizeBirth()) *
-                                      nSize/Particle.second->getPositions()->capacity();
+                                      nSize/Particle.second->getCapacity();
                     ColorTypeRGBA paColBirth = *Particle.second->getColorBirth();
                     ColorTypeRGBA paColDeath = *Particle.second->getColorDeath();
                                       
@@ -440,10 +450,9 @@ void CVisualsManager::drawParticles(const CHandle<CCamera>& _hCamera) const
                         m_Graphics.cacheSinCos(12);
                         for (auto i=0u; i<nSize; ++i)
                         {
-                            if (Particle.second->getStates()->at(i) == PARTICLE_STATE_ACTIVE &&
-                                _hCamera->getBoundingBox().isInside(Particle.second->getPositions()->at(i)))
+                            if (_hCamera->getBoundingBox().isInside(Particle.second->getPosition(i)))
                             {
-                                double fAge = double(Particle.second->getAge()->at(i)) / Particle.second->getMaxAge();
+                                double fAge = Particle.second->getAge(i) / Particle.second->getMaxAge();
                                 
                                 double fR = paColBirth[0] * (1.0 - fAge) + paColDeath[0] * fAge;
                                 double fG = paColBirth[1] * (1.0 - fAge) + paColDeath[1] * fAge;
@@ -453,7 +462,7 @@ void CVisualsManager::drawParticles(const CHandle<CCamera>& _hCamera) const
                                 
                                 fSizeR = Particle.second->getSizeBirth() + fGrowth * fAge;
                                 
-                                    m_Graphics.filledCircle(Particle.second->getPositions()->at(i) - _hCamera->getCenter()+
+                                    m_Graphics.filledCircle(Particle.second->getPosition(i) - _hCamera->getCenter()+
                                                 IGridUser::cellToDouble(Particle.second->getCell() - _hCamera->getCell()),
                                                 fSizeR, 12, GRAPHICS_CIRCLE_USE_CACHE);
                             }
@@ -576,7 +585,7 @@ void CVisualsManager::drawCOM() const
 
     if (m_nVisualisations & VISUALS_OBJECT_COM)
     {
-        m_Graphics.beginRenderBatch("world");
+        m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_WORLD);
             for (auto Obj : *m_pDataStorage->getObjectsByValueFront())
             {
                 
@@ -627,7 +636,7 @@ void CVisualsManager::drawBoundingBoxes() const
     if (m_nVisualisations & VISUALS_OBJECT_BBOXES)
     {
         
-        m_Graphics.beginRenderBatch("world");
+        m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_WORLD);
             m_Graphics.setColor(0.0, 1.0, 0.0, 0.8);
             m_Graphics.rect(m_hCamera->getBoundingBox().getLowerLeft()-
                             m_hCamera->getCenter(),
@@ -644,7 +653,7 @@ void CVisualsManager::drawBoundingBoxes() const
             m_Graphics.setColor(1.0, 1.0, 1.0, 1.0);
             m_Graphics.setDepth(GRAPHICS_DEPTH_DEFAULT);
             
-            for (const auto pObj : *m_pDataStorage->getObjectsByValueFront())
+            for (const auto& pObj : *m_pDataStorage->getObjectsByValueFront())
             {
                 if (m_hCamera->getBoundingBox().isInside(pObj.second->getCOM()))
                 {
@@ -687,7 +696,7 @@ void CVisualsManager::drawBoundingBoxes() const
                     }
                 }
             }
-            for (const auto Particle : *m_pDataStorage->getParticlesByValueFront())
+            for (const auto& Particle : *m_pDataStorage->getParticlesByValueFront())
             {
                 m_Graphics.setColor(0.0, 0.0, 1.0, 0.4);
                 m_Graphics.rect(Particle.second->getBoundingBox().getLowerLeft() - m_hCamera->getCenter(),
@@ -1182,17 +1191,17 @@ bool CVisualsManager::processFrame()
     // Hacked, just for testing purposes
     ////////////////////////////////////////////////////////////////////////////
     m_RenderTargetLights.bind(RENDER_TARGET_CLEAR);
-        m_Graphics.beginRenderBatch("lights");
+        m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_LIGHTS);
         for (auto Particle : *m_pDataStorage->getParticlesByValueFront())
         {
             if (Particle.second->getBoundingBox().overlaps(m_hCamera->getBoundingBox()))
             {
                 if (Particle.second->getParticleType() == ParticleTypeType::THRUST)
                 {
-                    auto   nSize   = Particle.second->getPositions()->size();
+                    auto   nSize   = Particle.second->getNumberOfParticles();
                     double fSizeR  = 1.0;
                     double fGrowth = (Particle.second->getSizeDeath() - Particle.second->getSizeBirth()) * 30.0 *
-                                        nSize/Particle.second->getPositions()->capacity();
+                                        nSize/Particle.second->getCapacity();
                     ColorTypeRGBA paColBirth = *Particle.second->getColorBirth();
                     ColorTypeRGBA paColDeath = *Particle.second->getColorDeath();
                                         
@@ -1202,10 +1211,9 @@ bool CVisualsManager::processFrame()
                         m_Graphics.cacheSinCos(100);
                         for (auto i=0u; i<nSize; ++i)
                         {
-                            if (Particle.second->getStates()->at(i) == PARTICLE_STATE_ACTIVE &&
-                                m_hCamera->getBoundingBox().isInside(Particle.second->getPositions()->at(i)))
+                            if (m_hCamera->getBoundingBox().isInside(Particle.second->getPosition(i)))
                             {
-                                double fAge = double(Particle.second->getAge()->at(i)) / Particle.second->getMaxAge();
+                                double fAge = Particle.second->getAge(i) / Particle.second->getMaxAge();
                                 
                                 double fR = paColBirth[0] * (1.0 - fAge) + paColDeath[0] * fAge;
                                 double fG = paColBirth[1] * (1.0 - fAge) + paColDeath[1] * fAge;
@@ -1216,7 +1224,7 @@ bool CVisualsManager::processFrame()
                                 
                                 fSizeR = Particle.second->getSizeBirth() * 30.0 + fGrowth * fAge;
                                 
-                                    m_Graphics.filledCircle(Particle.second->getPositions()->at(i) - m_hCamera->getCenter()+
+                                    m_Graphics.filledCircle(Particle.second->getPosition(i) - m_hCamera->getCenter()+
                                                 IGridUser::cellToDouble(Particle.second->getCell() - m_hCamera->getCell()),
                                                 fSizeR, 100, GRAPHICS_CIRCLE_USE_CACHE);
                             }
@@ -1239,7 +1247,7 @@ bool CVisualsManager::processFrame()
 
     // Compose scene and light information from accordant textures
     m_RenderTargetScreen.bind();    
-        m_Graphics.beginRenderBatch("composition");
+        m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_COMPOSITION);
             m_Graphics.texturedRect(Vector2d(0.0, m_Graphics.getHeightScr()), Vector2d(m_Graphics.getWidthScr(), 0.0),
                                     &m_RenderTargetScene.getTexUV(), &m_RenderTargetLights.getTexUV());
         m_Graphics.endRenderBatch();
@@ -1247,14 +1255,14 @@ bool CVisualsManager::processFrame()
     
     // Render texture to screen
     m_RenderModeMainScreen.setTexture0("ScreenTexture", m_RenderTargetScreen.getIDTex());
-    m_Graphics.beginRenderBatch("main_screen");
+    m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_MAIN_SCREEN);
         m_Graphics.texturedRect(Vector2d(0.0, m_Graphics.getHeightScr()), Vector2d(m_Graphics.getWidthScr(), 0.0), &m_RenderTargetScreen.getTexUV());
     m_Graphics.endRenderBatch();
     
     this->drawKinematicsStates(DrawModeType::TEXT);
     if (bGotCam) this->drawGrid(DrawModeType::TEXT);
     
-    m_Graphics.beginRenderBatch("font");
+    m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_FONT);
         m_TextVersion.display();
     m_Graphics.endRenderBatch();
     
@@ -1362,26 +1370,26 @@ void CVisualsManager::drawDebugInfo()
         auto fBorderY = m_Graphics.getHeightScr() * 0.01;
         
         m_RenderModeMainScreen.setTexture0("LightsTexture", m_RenderTargetLights.getIDTex());
-        m_Graphics.beginRenderBatch("main_screen");
+        m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_MAIN_SCREEN);
             m_Graphics.texturedRect(Vector2d(fBorderX, m_Graphics.getHeightScr()>>1), Vector2d(m_Graphics.getWidthScr()>>1, fBorderY),
                                     &m_RenderTargetLights.getTexUV());
         m_Graphics.endRenderBatch();
         
         m_RenderModeMainScreen.setTexture0("SceneTexture", m_RenderTargetScene.getIDTex());
-        m_Graphics.beginRenderBatch("main_screen");
+        m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_MAIN_SCREEN);
             m_Graphics.texturedRect(Vector2d(m_Graphics.getWidthScr()>>1, m_Graphics.getHeightScr()>>1),
                                     Vector2d(m_Graphics.getWidthScr()-fBorderX, fBorderY),
                                     &m_RenderTargetScene.getTexUV());
         m_Graphics.endRenderBatch();
         m_RenderModeMainScreen.setTexture0("ScreenTexture", m_RenderTargetScreen.getIDTex());
-        m_Graphics.beginRenderBatch("main_screen");
+        m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_MAIN_SCREEN);
             m_Graphics.texturedRect(Vector2d(fBorderX, m_Graphics.getHeightScr()-fBorderY),
                                     Vector2d(m_Graphics.getWidthScr()>>1, m_Graphics.getHeightScr()>>1),
                                     &m_RenderTargetScreen.getTexUV());
         m_Graphics.endRenderBatch();
         
         m_Graphics.setColor({{1.0, 0.0, 1.0, 0.8}});
-        m_Graphics.beginRenderBatch("world");
+        m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_WORLD);
             m_Graphics.rect(Vector2d(fBorderX, m_Graphics.getHeightScr()>>1), Vector2d(m_Graphics.getWidthScr()>>1, fBorderY));
             m_Graphics.rect(Vector2d(m_Graphics.getWidthScr()>>1, m_Graphics.getHeightScr()>>1),
                                     Vector2d(m_Graphics.getWidthScr()-fBorderX, fBorderY));
@@ -1391,19 +1399,19 @@ void CVisualsManager::drawDebugInfo()
 
         m_TextDebugRender.setPosition(fBorderX*2.0, fBorderY*2.0);
         m_TextDebugRender.setText("Lights");
-        m_Graphics.beginRenderBatch("font");
+        m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_FONT);
             m_TextDebugRender.display();
         m_Graphics.endRenderBatch();
         
         m_TextDebugRender.setPosition((m_Graphics.getWidthScr()>>1)+fBorderX*2.0, fBorderY*2.0);
         m_TextDebugRender.setText("Scene");
-        m_Graphics.beginRenderBatch("font");
+        m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_FONT);
             m_TextDebugRender.display();
         m_Graphics.endRenderBatch();
         
         m_TextDebugRender.setPosition(fBorderX*2.0, (m_Graphics.getHeightScr()>>1)+fBorderY*2.0);
         m_TextDebugRender.setText("Composition");
-        m_Graphics.beginRenderBatch("font");
+        m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_FONT);
             m_TextDebugRender.display();
         m_Graphics.endRenderBatch();
     }
@@ -1419,9 +1427,9 @@ void CVisualsManager::drawDebugInfo()
         oss << "\n";
         
         oss << "FONT RENDERER\n\n  Available fonts:\n";
-        for (auto strFont : *m_FontManager.getFontsAvailable())
+        for (const auto& Font : *m_FontManager.getFontsAvailable())
         {
-            oss << "   - " << strFont.first << "\n";
+            oss << "   - " << CFontManager::getDesignatorName(Font.first) << "\n";
         }
         
         oss << "\n";
@@ -1430,7 +1438,9 @@ void CVisualsManager::drawDebugInfo()
         static double fBufferSizeLua = m_pComInterface->call<double>("get_frequency_lua") / 4;
         static CCircularBuffer<double> TimeBufferLua(fBufferSizeLua);
         static CCircularBuffer<double> TimeBufferPhysics(fBufferSizePhysics);
+        static CCircularBuffer<double> TimeBufferPhysicsBroadPhase(fBufferSizePhysics);
         static CCircularBuffer<double> TimeBufferPhysicsBufferCopy(fBufferSizePhysics);
+        static CCircularBuffer<double> TimeBufferPhysicsCollisions(fBufferSizePhysics);
         static CCircularBuffer<double> TimeBufferPhysicsObjects(fBufferSizePhysics);
         static CCircularBuffer<double> TimeBufferPhysicsParticles(fBufferSizePhysics);
         static CCircularBuffer<double> TimeBufferVisuals(m_fFrequency / 4);
@@ -1443,6 +1453,14 @@ void CVisualsManager::drawDebugInfo()
                                         &TimeBufferPhysics,
                                         m_pComInterface->call<double>("get_time_processed_physics"),
                                         fBufferSizePhysics);
+        double fTimeProcessedPhysicsBroadPhase = this->smoothFrameTime(
+                                        &TimeBufferPhysicsBroadPhase,
+                                        m_pComInterface->call<double>("get_time_processed_physics_broad_phase"),
+                                        fBufferSizePhysics);
+        double fTimeProcessedPhysicsCollisions = this->smoothFrameTime(
+                                        &TimeBufferPhysicsCollisions,
+                                        m_pComInterface->call<double>("get_time_processed_physics_collisions"),
+                                        fBufferSizePhysics);
         double fTimeProcessedPhysicsBufferCopy = this->smoothFrameTime(
                                         &TimeBufferPhysicsBufferCopy,
                                         m_pComInterface->call<double>("get_time_processed_physics_buffer_copy"),
@@ -1470,6 +1488,9 @@ void CVisualsManager::drawDebugInfo()
                                       m_pComInterface->call<double>("get_time_per_frame_physics")*1000.0 << " ms\n";
         oss << "  - Objects:     " << fTimeProcessedPhysicsObjects*1000.0 << " ms\n";
         oss << "  - Particles:   " << fTimeProcessedPhysicsParticles*1000.0 << " ms\n";
+        oss << "  - Broad Phase: " << fTimeProcessedPhysicsBroadPhase*1000.0 << " ms, " <<
+                                      m_pComInterface->call<int>("get_broad_phase_pairs") << " pairs\n";
+        oss << "  - Collisions:  " << fTimeProcessedPhysicsCollisions*1000.0 << " ms\n";
         oss << "  - Buffer Copy: " << fTimeProcessedPhysicsBufferCopy*1000.0 << " ms\n";
         oss << "  Lua:           " << fTimeProcessedLua*1000.0 << " of " <<
                                       m_pComInterface->call<double>("get_time_per_frame_lua")*1000.0 << " ms\n";
@@ -1477,7 +1498,7 @@ void CVisualsManager::drawDebugInfo()
         m_TextDebugInfo.setText(oss.str());
         m_Graphics.setColor({{0.1, 0.0, 0.1, 0.8}});
         
-        m_Graphics.beginRenderBatch("world");
+        m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_WORLD);
             double fSizeX = m_TextDebugInfo.getLength()+5.0;
             int nLines = 20;
             m_Graphics.filledRect(Vector2d(10, 10),
@@ -1485,7 +1506,7 @@ void CVisualsManager::drawDebugInfo()
                                   (nLines+m_FontManager.getFontsAvailable()->size())*m_TextDebugInfo.getFontSize()));
         m_Graphics.endRenderBatch();
         
-        m_Graphics.beginRenderBatch("font");
+        m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_FONT);
             m_TextDebugInfo.display();
         m_Graphics.endRenderBatch();
         
@@ -1513,7 +1534,7 @@ void CVisualsManager::drawGrid(const DrawModeType _DrawMode)
     {
         if (_DrawMode == DrawModeType::VISUALS)
         {
-            m_Graphics.beginRenderBatch("world");
+            m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_WORLD);
             
                 // Default sub grid size every 1m
                 double fGrid = 1.0;
@@ -1627,7 +1648,7 @@ void CVisualsManager::drawGrid(const DrawModeType _DrawMode)
         }
         else
         {
-            m_Graphics.beginRenderBatch("font");
+            m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_FONT);
             
             double fGrid = 1.0;
             
@@ -1678,7 +1699,7 @@ void CVisualsManager::drawKinematicsState(const CKinematicsState* const _pKinema
         
         if (_DrawMode == DrawModeType::VISUALS)
         {
-            m_Graphics.beginRenderBatch("world");
+            m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_WORLD);
             
                 m_Graphics.setColor(1.0, 1.0, 1.0, fTransparency);
                 m_Graphics.showVec(
@@ -1706,7 +1727,7 @@ void CVisualsManager::drawKinematicsState(const CKinematicsState* const _pKinema
         else
         {
             // Now draw the text
-            m_Graphics.beginRenderBatch("font");
+            m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_FONT);
             
                 std::stringstream oss;
                 
@@ -1750,7 +1771,7 @@ void CVisualsManager::drawKinematicsStates(const DrawModeType _DrawMode)
     
     if (m_nVisualisations & VISUALS_KINEMATICS_STATES)
     {
-        for (const auto pObj : *m_pDataStorage->getObjectsByValueFront())
+        for (const auto& pObj : *m_pDataStorage->getObjectsByValueFront())
         {
             this->drawKinematicsState(
                 &pObj.second->getKinematicsState(),
@@ -1774,7 +1795,7 @@ void CVisualsManager::drawStars()
 {
     METHOD_ENTRY("CVisualsManager::drawStars")
     
-    m_Graphics.beginRenderBatch("stars");
+    m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_STARS);
     if (m_pDataStorage->getUniverse() != nullptr)
     {
         m_pDataStorage->getUniverse()->Access.acquireLock();
@@ -1826,7 +1847,7 @@ void CVisualsManager::drawTimers()
     
     if (m_nVisualisations & VISUALS_TIMERS)
     {
-        m_Graphics.beginRenderBatch("font");
+        m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_FONT);
         
             // Now draw the text
             std::stringstream oss;
@@ -1888,7 +1909,7 @@ void CVisualsManager::drawWorld()
     METHOD_ENTRY("CVisualsManager::drawWorld")
 
     
-    m_Graphics.beginRenderBatch("world");
+    m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_WORLD);
     
     this->drawObjectsPlanetsAtmospheres(m_hCamera);
     this->drawObjects(m_hCamera);
@@ -1901,9 +1922,9 @@ void CVisualsManager::drawWorld()
     if (m_nVisualisations & VISUALS_NAMES)
     {
         m_Graphics.setupScreenSpace();
-        m_Graphics.beginRenderBatch("font");
+        m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_FONT);
 
-        for (const auto pObj : *m_pDataStorage->getObjectsByValueFront())
+        for (const auto& pObj : *m_pDataStorage->getObjectsByValueFront())
         {
             if (m_hCamera->getZoom() * pObj.second->getGeometry()->getBoundingBox().getWidth() > 1.0)
             {
@@ -1924,7 +1945,7 @@ void CVisualsManager::drawWorld()
                 m_TextObjects.display();
             }
         }
-        for (const auto Particle : *m_pDataStorage->getParticlesByValueFront())
+        for (const auto& Particle : *m_pDataStorage->getParticlesByValueFront())
         {
             if (m_hCamera->getZoom() * Particle.second->getBoundingBox().getWidth() > 1.0)
             {
@@ -2077,7 +2098,7 @@ void CVisualsManager::updateUI()
     
     if (m_bCursor)
     {
-        m_Graphics.beginRenderBatch("world");
+        m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_WORLD);
         // 
             m_Graphics.setColor(1.0, 1.0, 1.0, 0.8);
             m_Graphics.beginLine(PolygonType::LINE_SINGLE);
@@ -215,7 +215,7 @@ class CVisualsManager : virtual public CGraphicsBase,
         CText                           m_TextStarSystems;  ///< Text object for Star Systems
         CText                           m_TextVersion;      ///< Text object for planeworld version
         
-        CSpinlock                       m_CreatorLock;      ///< Indicates if objects might be created
+        CAdaptiveLock                   m_CreatorLock{"CVisualsManager::m_CreatorLock"};   ///< Indicates if objects might be created
         
 };
 
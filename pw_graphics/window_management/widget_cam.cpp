@@ -49,10 +49,10 @@ CWidgetCam::CWidgetCam(CFontManager* const _pFontManager) :
 
     m_Type = WidgetTypeType::CAMERA;
     
-    m_UID.setName("Widget_Cam_"+m_UID.getName());
+    m_UID.setNamePrefix("Widget_Cam_");
     
     m_RenderMode.setRenderModeType(RenderModeType::VERT3COL4TEX2);
-    m_Graphics.registerRenderMode(m_UID.getName(), &m_RenderMode);
+    m_nRenderModeID = m_Graphics.registerRenderMode(m_UID.getName(), &m_RenderMode);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -77,7 +77,7 @@ void CWidgetCam::draw()
 
     m_Graphics.setColor(1.0, 1.0, 1.0, 1.0);
     
-    m_Graphics.beginRenderBatch(m_UID.getName());
+    m_Graphics.beginRenderBatch(m_nRenderModeID);
         m_Graphics.texturedRect(Vector2d(m_nFramePosX, m_nFramePosY+m_nFrameHeight),
                                 Vector2d(m_nFramePosX+m_nFrameWidth, m_nFramePosY),
                                 &m_TargetCam.getTexUV());
@@ -88,6 +88,7 @@ class CWidgetCam : public IWidget,
         CHandle<CCamera> m_hCamera;         ///< Camera attached to this widget
         
         CRenderMode     m_RenderMode;       ///< Render mode to use for rendering
+        StringIDType    m_nRenderModeID;    ///< Interned name of render mode
         CRenderTarget   m_TargetCam;        ///< Rendertarget for virtual camera
         
         float           m_fTransparency;    ///< Transparency of virtual camera display    
@@ -49,7 +49,7 @@ CWidgetConsole::CWidgetConsole(CFontManager* const _pFontManager) :
 
     m_Type = WidgetTypeType::CONSOLE;
     
-    m_UID.setName("Widget_Console_"+m_UID.getName());
+    m_UID.setNamePrefix("Widget_Console_");
     ConsoleText.setText(m_UID.getName());
 }
 
@@ -62,7 +62,7 @@ void CWidgetConsole::draw()
 {
     METHOD_ENTRY("CWidgetConsole::draw")
 
-    m_Graphics.beginRenderBatch("world");
+    m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_WORLD);
         this->drawFrame();
     m_Graphics.endRenderBatch();
     
@@ -87,7 +87,7 @@ void CWidgetConsole::draw()
     ConsoleText.setText(oss.str());
     ConsoleText.setPosition(m_nFramePosX, m_nFramePosY);
     
-    m_Graphics.beginRenderBatch("font");
+    m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_FONT);
         ConsoleText.display();
     m_Graphics.endRenderBatch();
     
@@ -48,7 +48,7 @@ CWidgetText::CWidgetText(CFontManager* const _pFontManager) :
 
     m_Type = WidgetTypeType::TEXT;
     
-    m_UID.setName("Widget_Text_"+m_UID.getName());
+    m_UID.setNamePrefix("Widget_Text_");
     Text.setText(m_UID.getName());
 }
 
@@ -61,13 +61,13 @@ void CWidgetText::draw()
 {
     METHOD_ENTRY("CWidgetText::draw")
 
-    m_Graphics.beginRenderBatch("world");
+    m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_WORLD);
         this->drawFrame();
     m_Graphics.endRenderBatch();
    
     m_Graphics.setColor(1.0, 1.0, 1.0, 1.0);
     
-    m_Graphics.beginRenderBatch("font");
+    m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_FONT);
         Text.setPosition(m_nFramePosX, m_nFramePosY);
         Text.setWordWrap(m_nFrameWidth);
         Text.display();
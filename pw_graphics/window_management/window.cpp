@@ -52,7 +52,7 @@ CWindow::CWindow(CFontManager* const _pFontManager) :
     METHOD_ENTRY("CWindow::CWindow");
     CTOR_CALL("CWindow::CWindow");
     
-    m_UID.setName("Win_"+m_UID.getName());
+    m_UID.setNamePrefix("Win_");
     Title.setText(m_UID.getName());
     Title.setSize(20);
 //     m_Title.setFillColor(sf::Color(m_FontColor[0]*255.0,
@@ -155,7 +155,7 @@ void CWindow::draw()
     
     if (m_bVisible)
     {
-        m_Graphics.beginRenderBatch("world");
+        m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_WORLD);
             // Draw background area
             this->drawFrame();
             
@@ -184,7 +184,7 @@ void CWindow::draw()
             m_Graphics.setColor(1.0, 1.0, 1.0, 1.0);
         m_Graphics.endRenderBatch();
         
-        m_Graphics.beginRenderBatch("font");
+        m_Graphics.beginRenderBatch(GRAPHICS_RENDER_MODE_FONT);
             Title.setPosition(m_nFramePosX + m_nFrameWidth/2, m_nFramePosY, true);
             Title.display();
         m_Graphics.endRenderBatch();
@@ -51,6 +51,28 @@ CInputManager::CInputManager() : m_pWindow(nullptr),
     m_vecMouseCenter = {0,0};
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Initialises input manager by resolving frequently called functions
+///
+/// All modules have to be registered at the com interface before, since
+/// functions called by input are provided by other modules.
+///
+////////////////////////////////////////////////////////////////////////////////
+void CInputManager::init()
+{
+    METHOD_ENTRY("CInputManager::init")
+    
+    m_hMouseSetCursor = m_pComInterface->resolve<void, int, int>("mouse_set_cursor");
+    m_hGetMainCamera = m_pComInterface->resolve<int>("get_main_camera");
+    m_hCamGetZoom = m_pComInterface->resolve<double, int>("cam_get_zoom");
+    m_hCamRotateBy = m_pComInterface->resolve<void, int, double>("cam_rotate_by");
+    m_hCamTranslateBy = m_pComInterface->resolve<void, int, double, double>("cam_translate_by");
+    m_hCamZoomBy = m_pComInterface->resolve<void, int, double>("cam_zoom_by");
+    m_hCamZoomTo = m_pComInterface->resolve<void, int, double>("cam_zoom_to");
+    m_hKeyPressed = m_pComInterface->resolve<void, int>("e_key_pressed");
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Processes one input frame
@@ -68,13 +90,13 @@ bool CInputManager::processFrame()
     if (m_UIMode == UIModeType::WORLD)
         sf::Mouse::setPosition(m_vecMouseCenter,*m_pWindow);
     
-    m_pComInterface->call<void, int, int>("mouse_set_cursor", vecMouse.x, vecMouse.y);
+    m_hMouseSetCursor.call(vecMouse.x, vecMouse.y);
 
     //--- Handle events ---//
     sf::Event Event;
     while (m_pWindow->pollEvent(Event))
     {
-        int nCamMainUID = m_pComInterface->call<int>("get_main_camera");
+        int nCamMainUID = m_hGetMainCamera.call();
         
         switch (Event.type)
         {
@@ -170,7 +192,7 @@ bool CInputManager::processFrame()
                 }
                 else
                 {
-                    m_pComInterface->call<void, int>("e_key_pressed", Event.key.code);
+                    m_hKeyPressed.call(Event.key.code);
                     
                     switch (Event.key.code)
                     {
@@ -246,20 +268,20 @@ bool CInputManager::processFrame()
                 {
                     if (sf::Mouse::isButtonPressed(sf::Mouse::Left))
                     {
-                        double fZoom = m_pComInterface->call<double, int>("cam_get_zoom", nCamMainUID);
-                        m_pComInterface->call<void, int, double, double>("cam_translate_by", nCamMainUID,
-                                        0.2/2.0*double(m_vecMouse.x)/fZoom,
-                                        0.2/2.0*double(m_vecMouse.y)/fZoom);
+                        double fZoom = m_hCamGetZoom.call(nCamMainUID);
+                        m_hCamTranslateBy.call(nCamMainUID,
+                                               0.2/2.0*double(m_vecMouse.x)/fZoom,
+                                               0.2/2.0*double(m_vecMouse.y)/fZoom);
                     }
                     if (sf::Mouse::isButtonPressed(sf::Mouse::Right))
                     {
-                        m_pComInterface->call<void, int, double>("cam_rotate_by", nCamMainUID, -double(m_vecMouse.x)*0.001);
-                        m_pComInterface->call<void, int, double>("cam_zoom_by", nCamMainUID, 1.0+double(m_vecMouse.y)*0.001);
-                        double fZoom = m_pComInterface->call<double, int>("cam_get_zoom", nCamMainUID);
+                        m_hCamRotateBy.call(nCamMainUID, -double(m_vecMouse.x)*0.001);
+                        m_hCamZoomBy.call(nCamMainUID, 1.0+double(m_vecMouse.y)*0.001);
+                        double fZoom = m_hCamGetZoom.call(nCamMainUID);
                         if (fZoom < 1.0e-18)
-                            m_pComInterface->call<void, int, double>("cam_zoom_to", nCamMainUID, 1.0e-18);
+                            m_hCamZoomTo.call(nCamMainUID, 1.0e-18);
                         else if (fZoom > 1.0e3)
-                            m_pComInterface->call<void, int, double>("cam_zoom_to", nCamMainUID, 1.0e3);
+                            m_hCamZoomTo.call(nCamMainUID, 1.0e3);
                     }
                 }
                 break;
@@ -268,12 +290,12 @@ bool CInputManager::processFrame()
             {
                 if (nCamMainUID != 0)
                 {
-                    m_pComInterface->call<void, int, double>("cam_zoom_by", nCamMainUID, 1.0+double(Event.mouseWheel.delta)*0.1);
-                    double fZoom = m_pComInterface->call<double, int>("cam_get_zoom", nCamMainUID);
+                    m_hCamZoomBy.call(nCamMainUID, 1.0+double(Event.mouseWheel.delta)*0.1);
+                    double fZoom = m_hCamGetZoom.call(nCamMainUID);
                     if (fZoom < 1.0e-18)
-                        m_pComInterface->call<void, int, double>("cam_zoom_to", nCamMainUID, 1.0e-18);
+                        m_hCamZoomTo.call(nCamMainUID, 1.0e-18);
                     else if (fZoom > 1.0e3)
-                        m_pComInterface->call<void, int, double>("cam_zoom_to", nCamMainUID, 1.0e3);
+                        m_hCamZoomTo.call(nCamMainUID, 1.0e3);
                 }
                 break;
             }
@@ -67,6 +67,7 @@ class CInputManager : public IComInterfaceProvider,
         //--- Constant Methods -----------------------------------------------//
                 
         //--- Methods --------------------------------------------------------//
+        void init();
         bool processFrame();
         void setWindow(sf::Window* const _pWindow);
         
@@ -83,6 +84,15 @@ class CInputManager : public IComInterfaceProvider,
         sf::Vector2i    m_vecMouse;             ///< Current mouse position
         sf::Vector2i    m_vecMouseCenter;       ///< Mouse position at window center
         UIModeType      m_UIMode;               ///< Currently active UI mode
+        
+        CCommandHandle<void, int, int>             m_hMouseSetCursor; ///< Sets mouse cursor each frame
+        CCommandHandle<int>                        m_hGetMainCamera;  ///< Provides main camera for each event
+        CCommandHandle<double, int>                m_hCamGetZoom;     ///< Provides zoom of camera
+        CCommandHandle<void, int, double>          m_hCamRotateBy;    ///< Rotates camera
+        CCommandHandle<void, int, double, double>  m_hCamTranslateBy; ///< Translates camera
+        CCommandHandle<void, int, double>          m_hCamZoomBy;      ///< Zooms camera by factor
+        CCommandHandle<void, int, double>          m_hCamZoomTo;      ///< Zooms camera to given value
+        CCommandHandle<void, int>                  m_hKeyPressed;     ///< Event, indicating that a key was pressed
 };
 
 //--- Implementation is done here for inline optimisation --------------------//
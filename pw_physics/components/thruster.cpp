@@ -30,12 +30,16 @@
 
 #include "thruster.h"
 
+#include "force_accumulator.h"
+#include "world_data_storage.h"
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Constructor
 ///
 ////////////////////////////////////////////////////////////////////////////////
 CThruster::CThruster() : m_bActive(true),
+                         m_bSampled(false),
                          m_fThrust(1.0),
                          m_fThrustMax(1.0)
 
@@ -43,15 +47,17 @@ CThruster::CThruster() : m_bActive(true),
     METHOD_ENTRY("CThruster::CThruster")
     CTOR_CALL("CThruster::CThruster")
     
-    m_UID.setName("Thruster_"+m_UID.getName());
+    m_vecForce.setZero();
+    m_vecPOC.setZero();
+    m_UID.setNamePrefix("Thruster_");
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Activate thruster
 ///
-/// This method sets the thrust member variable that is applied within the
-/// execute() method which is called by the physics manager periodically.
+/// This method sets the thrust member variable that is sampled within the
+/// sample() method which is called by the physics manager periodically.
 ///
 /// \param _fThrust Thrust (reactive force) to apply
 ///
@@ -64,11 +70,12 @@ const double& CThruster::activate(const double& _fThrust)
     
     m_fThrust = _fThrust;
     
-    for (const auto Emitter : m_hEmitters)
+    for (const auto& hEmitter : m_hEmitters)
     {
-        if (Emitter.isValid())
+        IEmitter* const pEmitter = this->resolveEmitter(hEmitter);
+        if (pEmitter != nullptr)
         {
-            Emitter->setIntensity(_fThrust/m_fThrustMax);
+            pEmitter->setIntensity(_fThrust/m_fThrustMax);
         }
     }
     
@@ -84,11 +91,12 @@ const double& CThruster::activate(const double& _fThrust)
     else if (!m_bActive)
     {
         m_bActive = true;
-        for (const auto Emitter : m_hEmitters)
+        for (const auto& hEmitter : m_hEmitters)
         {
-            if (Emitter.isValid())
+            IEmitter* const pEmitter = this->resolveEmitter(hEmitter);
+            if (pEmitter != nullptr)
             {
-                Emitter->activate();
+                pEmitter->activate();
             }
         }
     }
@@ -100,22 +108,42 @@ const double& CThruster::activate(const double& _fThrust)
 ///
 /// \brief Apply thrust
 ///
-/// This method applies a force depending on the orientation and position of
-/// the object the thruster is hooked on. This is clipped by maximum thrust
-/// value.
+/// This method applies the force of the last sample to the object the
+/// thruster is hooked on.
+///
+/// \param _pForces Accumulator the thrust is added to
 ///
 ///////////////////////////////////////////////////////////////////////////////
-void CThruster::execute()
+void CThruster::execute(CForceAccumulator* const _pForces)
 {
     METHOD_ENTRY("CThruster::execute")
 
-    if (m_bActive)
+    if (m_bSampled && m_hObject.isValid())
     {
-        if (m_hObject.isValid())
-        {
-            Rotation2Dd Rot(m_KinematicsState.getLocalAngle());
-            m_hObject->addForceLC(Rot*Vector2d(m_fThrust, 0.0), m_KinematicsState.getLocalOrigin());
-        }
+        _pForces->addForceLC(m_hObject.ptr(), m_vecForce, m_vecPOC);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Samples thrust
+///
+/// This method calculates the force depending on the orientation and position
+/// of the thruster on its object, clipped by maximum thrust value. It is
+/// called at the rate of thrusters, the force is applied by execute() until
+/// the next sample.
+///
+///////////////////////////////////////////////////////////////////////////////
+void CThruster::sample()
+{
+    METHOD_ENTRY("CThruster::sample")
+
+    m_bSampled = m_bActive && m_hObject.isValid();
+    if (m_bSampled)
+    {
+        Rotation2Dd Rot(m_KinematicsState.getLocalAngle());
+        m_vecForce = Rot*Vector2d(m_fThrust, 0.0);
+        m_vecPOC = m_KinematicsState.getLocalOrigin();
     }
 }
 
@@ -129,7 +157,15 @@ void CThruster::execute()
 void CThruster::addEmitter(IEmitter* const _pEmitter)
 {
     METHOD_ENTRY("CThruster::addEmitter")
-    m_hEmitters.push_back(CHandle<IEmitter>(_pEmitter));
+    if (m_pDataStorage != nullptr)
+    {
+        m_hEmitters.push_back(CHandle<IEmitter>(_pEmitter,
+                              m_pDataStorage->getEmittersByValue()->getHandle(_pEmitter->getUID())));
+    }
+    else
+    {
+        m_hEmitters.push_back(CHandle<IEmitter>(_pEmitter));
+    }
     if (m_hObject.isValid())
     {
         _pEmitter->attachTo(m_hObject.ptr());
@@ -148,8 +184,35 @@ void CThruster::setObject(CObject* const _pObj)
     METHOD_ENTRY("CThruster::setObject")
     m_hObject.set(_pObj);
     m_KinematicsState.setRef(&(_pObj->getKinematicsState()));
-    for (auto Emitter : m_hEmitters)
+    for (const auto& hEmitter : m_hEmitters)
     {
-        Emitter->attachTo(_pObj);
+        IEmitter* const pEmitter = this->resolveEmitter(hEmitter);
+        if (pEmitter != nullptr)
+        {
+            pEmitter->attachTo(_pObj);
+        }
     }
 }
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns emitter of given handle
+///
+/// Emitters might be removed from the world, e.g. after emitting once. If
+/// the emitter was looked up in the world data storage when added, the
+/// handle is validated by the storage, thus, removed emitters are skipped
+/// instead of being accessed.
+///
+/// \param _hEmitter Handle of emitter
+///
+/// \return Emitter, nullptr if removed or invalid
+///
+///////////////////////////////////////////////////////////////////////////////
+IEmitter* CThruster::resolveEmitter(const CHandle<IEmitter>& _hEmitter) const
+{
+    METHOD_ENTRY("CThruster::resolveEmitter")
+
+    if (_hEmitter.getHandle() != SLOT_MAP_HANDLE_INVALID)
+        return _hEmitter.resolve(*m_pDataStorage->getEmittersByValue());
+    return _hEmitter.isValid() ? _hEmitter.ptr() : nullptr;
+}
@@ -39,6 +39,9 @@
 
 //--- Standard header --------------------------------------------------------//
 
+// Forward declarations
+class CForceAccumulator;
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Class representing a thruster component
@@ -56,14 +59,17 @@ class CThruster : public IKinematicsStateUser,
         
         //--- Constant methods -----------------------------------------------//
         double    getAngle() const;
+        CObject*  getObject() const;
         Vector2d  getOrigin() const;
         double    getThrust() const;
+        bool      isFiring() const;
         
         
         //--- Methods --------------------------------------------------------//
         const double& activate(const double&);
         void          deactivate();
-        void          execute();
+        void          execute(CForceAccumulator* const);
+        void          sample();
 
         void addEmitter(IEmitter* const);
         void setObject(CObject* const);
@@ -74,25 +80,58 @@ class CThruster : public IKinematicsStateUser,
         void setThrustMax(const double&);
          
     protected:
+        
+        //--- Constant methods [protected] -----------------------------------//
+        IEmitter* resolveEmitter(const CHandle<IEmitter>&) const;
                 
         //--- Variables ------------------------------------------------------//
         std::vector<CHandle<IEmitter>> m_hEmitters; ///< Emitters for thrust particles
         CHandle<CObject> m_hObject;          ///< Physical object representing thruster
         
         bool        m_bActive;              ///< Flags if thruster is activated
+        bool        m_bSampled;             ///< Flags if force was sampled from active thruster
       
+        Vector2d    m_vecForce;             ///< Sampled force, local coordinates
+        Vector2d    m_vecPOC;               ///< Sampled point of contact, local coordinates
+        
         double      m_fThrust;              ///< Thrust applied to hooked object
         double      m_fThrustMax;           ///< Maximum thrust of this thruster
 };
 
 //--- Implementation is done here for inline optimisation --------------------//
 
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns object the thruster is hooked on
+///
+/// \return Object, nullptr if there is none
+///
+///////////////////////////////////////////////////////////////////////////////
+inline CObject* CThruster::getObject() const
+{
+    METHOD_ENTRY("CThruster::getObject")
+    return m_hObject.isValid() ? m_hObject.ptr() : nullptr;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns if thruster applies force within execute()
+///
+/// \return Thruster firing?
+///
+///////////////////////////////////////////////////////////////////////////////
+inline bool CThruster::isFiring() const
+{
+    METHOD_ENTRY("CThruster::isFiring")
+    return m_bSampled && m_hObject.isValid();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Deactivate thruster
 ///
 /// This method stops the thruster and thus, no force is applied within the
-/// execute() method.
+/// execute() method after the next sample.
 ///
 ///////////////////////////////////////////////////////////////////////////////
 inline void CThruster::deactivate()
@@ -101,11 +140,12 @@ inline void CThruster::deactivate()
     m_fThrust = 0.0;
     
     m_bActive = false;
-    for (const auto Emitter : m_hEmitters)
+    for (const auto& hEmitter : m_hEmitters)
     {
-        if (Emitter.isValid())
+        IEmitter* const pEmitter = this->resolveEmitter(hEmitter);
+        if (pEmitter != nullptr)
         {
-            Emitter->deactivate();
+            pEmitter->deactivate();
         }
     }
 }
@@ -0,0 +1,264 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       broad_phase.cpp
+/// \brief      Implementation of class "CBroadPhase"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "broad_phase.h"
+
+//--- Standard header --------------------------------------------------------//
+#include <algorithm>
+#include <cmath>
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Constructor
+///
+///////////////////////////////////////////////////////////////////////////////
+CBroadPhase::CBroadPhase() : m_nFrame(0u),
+                             m_nSwaps(0)
+{
+    METHOD_ENTRY("CBroadPhase::CBroadPhase")
+    CTOR_CALL("CBroadPhase::CBroadPhase")
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Removes all proxies
+///
+///////////////////////////////////////////////////////////////////////////////
+void CBroadPhase::clear()
+{
+    METHOD_ENTRY("CBroadPhase::clear")
+
+    m_Endpoints.clear();
+    m_Proxies.clear();
+    m_ProxyIndices.clear();
+    m_Pairs.clear();
+    m_nSwaps = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Updates broad phase with current state of given objects
+///
+/// Objects unknown so far get a new proxy, proxies of objects that aren't
+/// part of the given objects anymore are removed. Afterwards, endpoints
+/// are updated, sorted and swept for candidate pairs.
+///
+/// \param _pObjects Objects to be tested for collisions
+///
+///////////////////////////////////////////////////////////////////////////////
+void CBroadPhase::update(const CSlotMap<UIDType, CObject*>* const _pObjects)
+{
+    METHOD_ENTRY("CBroadPhase::update")
+
+    ++m_nFrame;
+
+    int nSeen = 0;
+    int nAdded = 0;
+    for (const auto& Obj : *_pObjects)
+    {
+        auto it = m_ProxyIndices.find(Obj.first);
+        if (it == m_ProxyIndices.end())
+        {
+            const int nProxy = m_Proxies.size();
+            m_ProxyIndices[Obj.first] = nProxy;
+            m_Proxies.push_back({Obj.second, m_nFrame});
+            m_Endpoints.push_back({0.0, 0, nProxy, true});
+            m_Endpoints.push_back({0.0, 0, nProxy, false});
+            ++nAdded;
+        }
+        else
+        {
+            m_Proxies[it->second].pObj = Obj.second;
+            m_Proxies[it->second].nFrame = m_nFrame;
+        }
+        ++nSeen;
+    }
+    if (nSeen < int(m_Proxies.size())) this->removeStaleProxies();
+
+    this->updateEndpoints();
+
+    // Insertion sort degrades for many new, unsorted endpoints, e.g. when
+    // loading a scene, sort from scratch in this case.
+    if (nAdded > int(m_Proxies.size()) / 4)
+    {
+        std::sort(m_Endpoints.begin(), m_Endpoints.end(),
+                  [&](const EndpointType& _EpA, const EndpointType& _EpB) {return this->isLess(_EpA, _EpB);});
+        m_nSwaps = m_Endpoints.size();
+    }
+    else
+    {
+        this->sort();
+    }
+
+    this->sweep();
+
+    DOM_STATS(DEBUG_MSG("Broad Phase", "Proxies: " << m_Proxies.size() <<
+                                       ", swaps: " << m_nSwaps <<
+                                       ", pairs: " << m_Pairs.size()))
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Removes proxies of objects that weren't seen in current frame
+///
+///////////////////////////////////////////////////////////////////////////////
+void CBroadPhase::removeStaleProxies()
+{
+    METHOD_ENTRY("CBroadPhase::removeStaleProxies")
+
+    std::vector<int> NewIndices(m_Proxies.size(), -1);
+    int nProxy = 0;
+    for (auto i=0u; i<m_Proxies.size(); ++i)
+    {
+        if (m_Proxies[i].nFrame == m_nFrame)
+        {
+            NewIndices[i] = nProxy;
+            m_ProxyIndices[m_Proxies[i].pObj->getUID()] = nProxy;
+            m_Proxies[nProxy++] = m_Proxies[i];
+        }
+    }
+    m_Proxies.resize(nProxy);
+
+    // Rebuild map, since UIDs of removed objects are unknown
+    for (auto it = m_ProxyIndices.begin(); it != m_ProxyIndices.end();)
+    {
+        if (it->second >= nProxy || m_Proxies[it->second].pObj->getUID() != it->first)
+            it = m_ProxyIndices.erase(it);
+        else
+            ++it;
+    }
+
+    // Remove endpoints, keeping the order of remaining ones
+    int nEndpoint = 0;
+    for (auto i=0u; i<m_Endpoints.size(); ++i)
+    {
+        if (NewIndices[m_Endpoints[i].nProxy] != -1)
+        {
+            m_Endpoints[nEndpoint] = m_Endpoints[i];
+            m_Endpoints[nEndpoint++].nProxy = NewIndices[m_Endpoints[i].nProxy];
+        }
+    }
+    m_Endpoints.resize(nEndpoint);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sorts endpoints by insertion sort
+///
+/// Endpoints are sorted from the previous frame, thus, only few swaps are
+/// expected.
+///
+///////////////////////////////////////////////////////////////////////////////
+void CBroadPhase::sort()
+{
+    METHOD_ENTRY("CBroadPhase::sort")
+
+    m_nSwaps = 0;
+    for (auto i=1u; i<m_Endpoints.size(); ++i)
+    {
+        const EndpointType Ep = m_Endpoints[i];
+        auto j = i;
+        while (j > 0 && this->isLess(Ep, m_Endpoints[j-1]))
+        {
+            m_Endpoints[j] = m_Endpoints[j-1];
+            --j;
+            ++m_nSwaps;
+        }
+        m_Endpoints[j] = Ep;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sweeps sorted endpoints and collects candidate pairs
+///
+/// Pairs with overlapping intervals on the x-axis are only reported if
+/// they share a depth layer and their bounding boxes overlap.
+///
+///////////////////////////////////////////////////////////////////////////////
+void CBroadPhase::sweep()
+{
+    METHOD_ENTRY("CBroadPhase::sweep")
+
+    m_Pairs.clear();
+    m_Active.clear();
+
+    for (const auto& Ep : m_Endpoints)
+    {
+        if (Ep.bMin)
+        {
+            CObject* const pObjA = m_Proxies[Ep.nProxy].pObj;
+            for (const auto nActive : m_Active)
+            {
+                CObject* const pObjB = m_Proxies[nActive].pObj;
+                if ((pObjA->getDepths() & pObjB->getDepths()) > 0 &&
+                    pObjA->getGeometry()->getBoundingBox().overlaps(
+                    pObjB->getGeometry()->getBoundingBox(), BROAD_PHASE_CELL_LIMIT))
+                {
+                    m_Pairs.push_back({pObjB, pObjA});
+                }
+            }
+            m_Active.push_back(Ep.nProxy);
+        }
+        else
+        {
+            auto it = std::find(m_Active.begin(), m_Active.end(), Ep.nProxy);
+            if (it != m_Active.end())
+            {
+                *it = m_Active.back();
+                m_Active.pop_back();
+            }
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Updates endpoints from multi frame bounding boxes of objects
+///
+/// Positions are normalised to the cell they are located in, since
+/// bounding boxes may exceed the cell of their object.
+///
+///////////////////////////////////////////////////////////////////////////////
+void CBroadPhase::updateEndpoints()
+{
+    METHOD_ENTRY("CBroadPhase::updateEndpoints")
+
+    for (auto& Ep : m_Endpoints)
+    {
+        CBoundingBox& AABB = m_Proxies[Ep.nProxy].pObj->getGeometry()->getBoundingBox();
+
+        double fPos = Ep.bMin ? AABB.getLowerLeft()[0] : AABB.getUpperRight()[0];
+        double fShift = std::floor((fPos + DEFAULT_CELL_SIZE) / DEFAULT_CELL_SIZE_2);
+
+        Ep.fPos  = fPos - fShift * DEFAULT_CELL_SIZE_2;
+        Ep.nCell = AABB.getCell()[0] + int(fShift);
+    }
+}
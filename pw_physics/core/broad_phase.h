@@ -0,0 +1,197 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       broad_phase.h
+/// \brief      Prototype of class "CBroadPhase"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef BROAD_PHASE_H
+#define BROAD_PHASE_H
+
+//--- Standard header --------------------------------------------------------//
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+//--- Program header ---------------------------------------------------------//
+#include "object.h"
+#include "slot_map.h"
+
+//--- Constants --------------------------------------------------------------//
+const int BROAD_PHASE_CELL_LIMIT = 1; ///< Maximum cell distance of overlapping bounding boxes
+
+/// Specifies candidate pairs of objects for narrow phase
+typedef std::vector<std::pair<CObject*, CObject*>> BroadPhasePairsType;
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sweep and prune broad phase over multi frame bounding boxes
+///
+/// Each object is represented by a proxy with two endpoints on the x-axis,
+/// given by its multi frame bounding box. Endpoints are kept in a persistent
+/// list that is sorted by insertion sort every frame. Since objects move
+/// little between two frames, the list is nearly sorted and sorting is
+/// close to linear. A sweep over the sorted list reports all pairs whose
+/// intervals overlap, these are checked for overlapping depth layers and
+/// bounding boxes before being passed on to the narrow phase.
+///
+/// Endpoints are stored as grid cell and position within cell. Both are
+/// normalised, thus comparing cell first and position second gives an exact
+/// order across cells without losing precision in large distances.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CBroadPhase
+{
+
+    public:
+
+        //--- Constructor/Destructor -----------------------------------------//
+        CBroadPhase();
+
+        //--- Constant Methods -----------------------------------------------//
+        int                         getNumberOfPairs() const;
+        int                         getNumberOfProxies() const;
+        int                         getNumberOfSwaps() const;
+        const BroadPhasePairsType&  getPairs() const;
+
+        //--- Methods --------------------------------------------------------//
+        void clear();
+        void update(const CSlotMap<UIDType, CObject*>* const);
+
+    private:
+
+        /// Endpoint of a proxy's interval on the x-axis
+        struct EndpointType
+        {
+            double  fPos;   ///< Position within cell
+            int     nCell;  ///< Grid cell
+            int     nProxy; ///< Index of proxy
+            bool    bMin;   ///< Indicates lower endpoint
+        };
+
+        /// Proxy of an object
+        struct ProxyType
+        {
+            CObject*        pObj;   ///< Object represented by proxy
+            std::uint64_t   nFrame; ///< Last frame the object was seen
+        };
+
+        //--- Constant Methods [private] -------------------------------------//
+        bool isLess(const EndpointType&, const EndpointType&) const;
+
+        //--- Methods [private] ----------------------------------------------//
+        void removeStaleProxies();
+        void sort();
+        void sweep();
+        void updateEndpoints();
+
+        //--- Variables [private] --------------------------------------------//
+        std::vector<EndpointType>           m_Endpoints;    ///< Endpoints, sorted along x-axis
+        std::vector<ProxyType>              m_Proxies;      ///< Proxies of objects
+        std::unordered_map<UIDType, int>    m_ProxyIndices; ///< Index of proxy by UID of object
+        std::vector<int>                    m_Active;       ///< Proxies with open interval while sweeping
+        BroadPhasePairsType                 m_Pairs;        ///< Candidate pairs of last update
+
+        std::uint64_t   m_nFrame;   ///< Number of updates
+        int             m_nSwaps;   ///< Number of endpoint swaps in last update
+};
+
+//--- Implementation is done here for inline optimisation --------------------//
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of candidate pairs of last update
+///
+/// \return Number of candidate pairs
+///
+////////////////////////////////////////////////////////////////////////////////
+inline int CBroadPhase::getNumberOfPairs() const
+{
+    METHOD_ENTRY("CBroadPhase::getNumberOfPairs")
+    return m_Pairs.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of proxies, i.e. objects in broad phase
+///
+/// \return Number of proxies
+///
+////////////////////////////////////////////////////////////////////////////////
+inline int CBroadPhase::getNumberOfProxies() const
+{
+    METHOD_ENTRY("CBroadPhase::getNumberOfProxies")
+    return m_Proxies.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of endpoint swaps while sorting in last update
+///
+/// This is a measure for temporal coherence, if the number is close to
+/// the number of proxies, the incremental sort works well.
+///
+/// \return Number of swaps
+///
+////////////////////////////////////////////////////////////////////////////////
+inline int CBroadPhase::getNumberOfSwaps() const
+{
+    METHOD_ENTRY("CBroadPhase::getNumberOfSwaps")
+    return m_nSwaps;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns candidate pairs of last update
+///
+/// \return Candidate pairs
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const BroadPhasePairsType& CBroadPhase::getPairs() const
+{
+    METHOD_ENTRY("CBroadPhase::getPairs")
+    return m_Pairs;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Compares two endpoints along x-axis
+///
+/// \param _EpA Endpoint A
+/// \param _EpB Endpoint B
+///
+/// \return Is endpoint A left of endpoint B?
+///
+////////////////////////////////////////////////////////////////////////////////
+inline bool CBroadPhase::isLess(const EndpointType& _EpA, const EndpointType& _EpB) const
+{
+    METHOD_ENTRY("CBroadPhase::isLess")
+    return (_EpA.nCell < _EpB.nCell) ||
+           (_EpA.nCell == _EpB.nCell && _EpA.fPos < _EpB.fPos);
+}
+
+#endif // BROAD_PHASE_H
@@ -30,129 +30,109 @@
 
 #include "collision_manager.h"
 
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Updates broad phase with given objects and particles
+///
+/// This provides the candidate pairs of objects and the spatial hash of
+/// particles for \ref detectCollisions.
+///
+/// \param _pObjects Objects to be tested for collisions
+/// \param _pParticles Particles to be tested for collisions with objects,
+///                    nullptr if particles didn't move
+///
+///////////////////////////////////////////////////////////////////////////////
+void CCollisionManager::broadPhase(const CSlotMap<UIDType, CObject*>* const _pObjects,
+                                   const CSlotMap<UIDType, CParticle*>* const _pParticles)
+{
+    METHOD_ENTRY("CCollisionManager::broadPhase")
+
+    m_pObjects = _pObjects;
+    m_BroadPhase.update(_pObjects);
+    if (_pParticles != nullptr)
+        m_ParticleHash.build(_pParticles);
+    else
+        m_ParticleHash.clear();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Tests objects for collisions, depending on broad phase
 ///
+/// Only candidate pairs of last broad phase update are passed to the
+/// narrow phase. Particles are tested against objects if they are hashed
+/// within the object's bounding box.
+///
+/// \param _bObjects Test pairs of objects, false if objects didn't move
+///
 ///////////////////////////////////////////////////////////////////////////////
-void CCollisionManager::detectCollisions()
+void CCollisionManager::detectCollisions(const bool _bObjects)
 {
     METHOD_ENTRY("CCollisionManager::detectCollisions")
 
-    //--------------------------------------------------------------------------
-    // Test dynamic objects
-    //--------------------------------------------------------------------------
-//     for (ObjectsByNameType::const_iterator ci = m_DynamicObjects.begin();
-//         ci != m_DynamicObjects.end(); ++ci)
-//     {
-//         cj = ci;
-//         ++cj;
-//         while (cj != m_DynamicObjects.end())
-//         {
-//             // Test for overlapping depthlayers
-//             if ((ci->second->getDepths() & cj->second->getDepths()) > 0)
-//             {
-// 
-//                 // Test for overlapping bounding boxes
-//                 if (ci->second->getGeometry()->getBoundingBox().overlaps(cj->second->getGeometry()->getBoundingBox(),1))
-//                 {
-//                     this->test(ci->second, cj->second);
-//                     
-// //                     CContact Contact;
-// //                     Contact = (*ci)->collidesWith((*cj));
-// //                     m_ContactList.push_back(Contact);
-// //                     m_ContactList.insert(m_ContactList.end(), Contacts.begin(),
-// //                                         Contacts.end());
-//                 }
-//             }
-//             ++cj;
-//         }
-// //         for (std::list< CParticle* >::const_iterator cj = m_Particle.begin();
-// //             cj != m_Particle.end(); ++cj)
-// //         {
-// //             switch((*ci)->getObjectType())
-// //             {
-// //                 case ObjectType::OBJECT_BODY:
-// //                     this->test(static_cast<CObject*>((*ci)), (*cj));
-// //             }
-// //         }
-// //         m_Graphics.setColor(0.0, 0.8, 0.0);
-// //         m_Graphics.showVec((*ci)->getVelocity(), (*ci)->getCOM());
-// //         m_Graphics.setColor(1.0, 1.0, 1.0);
-//     }
-    
-//     //--------------------------------------------------------------------------
-//     // Test static objects against particle
-//     //--------------------------------------------------------------------------
-//     for (ObjectsByNameType::const_iterator ci = m_StaticObjects.begin();
-//         ci != m_StaticObjects.end(); ++ci)
-//     {
-//         for (std::list< CParticle* >::const_iterator cj = m_Particle.begin();
-//             cj != m_Particle.end(); ++cj)
-//         {
-//             switch(ci->second->getObjectType())
-//             {
-//                 case ObjectType::OBJECT_BODY:
-//                     this->test(static_cast<CObject*>(ci->second), (*cj));
-//                     break;
-//             }
-//         }
-//     }
-//     
-//     //--------------------------------------------------------------------------
-//     // Test dynamic objects against particle
-//     //--------------------------------------------------------------------------
-//     for (ObjectsByNameType::const_iterator ci = m_DynamicObjects.begin();
-//         ci != m_DynamicObjects.end(); ++ci)
-//     {
-//         for (std::list< CParticle* >::const_iterator cj = m_Particle.begin();
-//             cj != m_Particle.end(); ++cj)
-//         {
-//             switch(ci->second->getObjectType())
-//             {
-//                 case ObjectType::OBJECT_BODY:
-//                     this->test(static_cast<CObject*>(ci->second), (*cj));
-//                     break;
-//             }
-//         }
-//     }
+    if (_bObjects)
+    {
+        for (const auto& Pair : m_BroadPhase.getPairs())
+        {
+            this->test(Pair.first, Pair.second);
+        }
+    }
+
+    if (m_pObjects == nullptr || m_ParticleHash.getNumberOfEntries() == 0) return;
+
+    for (const auto& Obj : *m_pObjects)
+    {
+        m_ParticleHash.query(Obj.second->getGeometry()->getBoundingBox(), m_ParticleCandidates);
+        for (auto i=0u; i<m_ParticleCandidates.size(); ++i)
+        {
+            if (!m_ParticleCandidates[i].empty())
+            {
+                this->test(Obj.second, m_ParticleHash.getParticleSystem(i), m_ParticleCandidates[i]);
+            }
+        }
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Tests object against particle
 ///
+/// Shapes and particles are compared in local coordinates, thus, only
+/// particles within the object's cell are tested.
+///
 /// \param _p1 Object
 /// \param _p2 Particle
+/// \param _Indices Indices of candidate particles
 ///
 ///////////////////////////////////////////////////////////////////////////////
-void CCollisionManager::test(CObject* _p1, CParticle* _p2)
+void CCollisionManager::test(CObject* _p1, CParticle* _p2, const std::vector<int>& _Indices)
 {
     METHOD_ENTRY("CCollisionManager::test")
-    
-//     ShapesType::const_iterator ci  = _p1->getGeometry()->getShapes()->begin();
-//     
-//     while (ci != _p1->getGeometry()->getShapes()->end())
-//     {
-//         switch((*ci)->getShapeType())
-//         {
-//             case ShapeType::SHAPE_TERRAIN:
-//                 this->test(static_cast<CTerrain*>((*ci,_p2));
-//                 break;
-//             case ShapeType::SHAPE_CIRCLE:
-//                 this->test(static_cast<CCircle*>((*ci)), static_cast<CCircle*>((*ci)->getShapeBuf()), _p1, _p2);
-//                 break;
-//             case ShapeType::SHAPE_PLANET:
-//                 this->test(static_cast<CPlanet*>((*ci)), static_cast<CPlanet*>((*ci)->getShapeBuf()), _p1, _p2);
-//                 break;
-//             case ShapeType::SHAPE_POLYGON:
-//                 this->test(static_cast<CPolygon*>((*ci)->getShapeCur()), static_cast<CPolygon*>((*ci)->getShapeBuf()), _p1, _p2);
-//                 break;
-//             case ShapeType::SHAPE_NONE:
-//                 break;
-//         }
-//         ++ci;
-//     }
+
+    if ((_p1->getDepths() & _p2->getDepths()) == 0 || _p1->getCell() != _p2->getCell()) return;
+
+    for (const auto& Shp : _p1->getGeometry()->getShapes())
+    {
+        switch (Shp->getShapeType())
+        {
+            case ShapeType::TERRAIN:
+                this->test(static_cast<CTerrain*>(Shp.ptr()), _p2, _Indices);
+                break;
+            case ShapeType::CIRCLE:
+                // Shapes of previous time step aren't buffered anymore, use
+                // current shape for both
+                this->test(static_cast<CCircle*>(Shp.ptr()), static_cast<CCircle*>(Shp.ptr()), _p1, _p2, _Indices);
+                break;
+            case ShapeType::PLANET:
+                this->test(static_cast<CPlanet*>(Shp.ptr()), static_cast<CPlanet*>(Shp.ptr()), _p1, _p2, _Indices);
+                break;
+            case ShapeType::POLYGON:
+                this->test(static_cast<CPolygon*>(Shp.ptr()), static_cast<CPolygon*>(Shp.ptr()), _p1, _p2, _Indices);
+                break;
+            case ShapeType::NONE:
+                break;
+        }
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -163,32 +143,33 @@ void CCollisionManager::test(CObject* _p1, CParticle* _p2)
 /// \param _pC0 Circle shape, time t0
 /// \param _p1 Object 1
 /// \param _p2 Particle
+/// \param _Indices Indices of candidate particles
 ///
 ///////////////////////////////////////////////////////////////////////////////
-void CCollisionManager::test(CCircle* _pC1, CCircle* _pC0, CObject* _p1, CParticle* _p2)
+void CCollisionManager::test(CCircle* _pC1, CCircle* _pC0, CObject* _p1, CParticle* _p2,
+                             const std::vector<int>& _Indices)
 {
     METHOD_ENTRY("CCollisionManager::test")
     
-    CCircularBuffer<Vector2d>* pPos (_p2->getPositions());
-    CCircularBuffer<Vector2d>* pVel(_p2->getVelocities());
-    CCircularBuffer<Vector2d>* pPosP (_p2->getPreviousPositions());
-    
     Vector2d vecPOC;
     Vector2d vecC0 = _pC0->getCenter();
     Vector2d vecC1 = _pC1->getCenter();
     double   fR0   = _pC0->getRadius();
 
-    for (auto i=0u; i<pPos->size(); ++i)
+    for (const auto i : _Indices)
     {
+        const Vector2d vecPos  = _p2->getPosition(i);
+        const Vector2d vecPosP = _p2->getPreviousPosition(i);
         CBoundingBox BBox;
-        BBox.setLowerLeft(pPos->at(i));
-        BBox.setUpperRight(pPos->at(i));
-        BBox.update(pPos->at(i));
+        BBox.setCell(_p2->getCell());
+        BBox.setLowerLeft(vecPos);
+        BBox.setUpperRight(vecPos);
+        BBox.update(vecPos);
         if (_p1->getGeometry()->getBoundingBox().overlaps(BBox))
         {
             double   fT   = 2.0;
-            Vector2d vecA = pPosP->at(i) - vecC0;
-            Vector2d vecB = pPos->at(i) - pPosP->at(i) - vecC1 + vecC0;
+            Vector2d vecA = vecPosP - vecC0;
+            Vector2d vecB = vecPos - vecPosP - vecC1 + vecC0;
             
             double fA = vecB.dot(vecB);
             double fB = 2.0 * vecA.dot(vecB);
@@ -213,8 +194,8 @@ void CCollisionManager::test(CCircle* _pC1, CCircle* _pC0, CObject* _p1, CPartic
                 }
                 if (fT<=1.0)
                 {
-                    vecPOC = pPosP->at(i) + fT * (pPos->at(i) - pPosP->at(i));
-                    double fParticleAngle = std::atan2(pPos->at(i)[1]-pPosP->at(i)[1], pPos->at(i)[0]-pPosP->at(i)[0]);
+                    vecPOC = vecPosP + fT * (vecPos - vecPosP);
+                    double fParticleAngle = std::atan2(vecPos[1]-vecPosP[1], vecPos[0]-vecPosP[0]);
                     
                     Vector2d vecC = vecC0 + fT * ((vecC1 - vecC0));
                     
@@ -233,18 +214,17 @@ void CCollisionManager::test(CCircle* _pC1, CCircle* _pC0, CObject* _p1, CPartic
                     double fDamping = sqrt(fTang*fTang+fOrth*fOrth)*0.7071;
 
                     
-                    double fNorm = pVel->at(i).norm();
-                    pVel->at(i)[0] = ((fOrth*vecNewVelOrth+fTang*vecNewVelTang).normalized() * fDamping * fNorm)[0];
-                    pVel->at(i)[1] = ((fOrth*vecNewVelOrth+fTang*vecNewVelTang).normalized() * fDamping * fNorm)[1];
+                    double fNorm = _p2->getVelocity(i).norm();
+                    Vector2d vecVel = (fOrth*vecNewVelOrth+fTang*vecNewVelTang).normalized() * fDamping * fNorm;
                     
                     // Add the velocity of the object because particle' are virtually weightless.
                     // Otherwise, they would be passed in the next step
-                    pVel->at(i) += _p1->getVelocity();
+                    _p2->setVelocity(i, vecVel + _p1->getVelocity());
                     
-                    // pPos->at(i)= vecPOC+(vecNewVelOrth)/(vecNewVelOrth).norm()*0.001;
+                    // _p2->setPosition(i, vecPOC+(vecNewVelOrth)/(vecNewVelOrth).norm()*0.001);
                     // Cannot use POC here, because particle' are virtually weightless. Thus, the
                     // object moves on and does not care about POC position.
-                    pPos->at(i)= vecC1+(vecNewVelOrth)/(vecNewVelOrth).norm()*(fR0+0.001);
+                    _p2->setPosition(i, vecC1+(vecNewVelOrth)/(vecNewVelOrth).norm()*(fR0+0.001));
                 }
             }
         }
@@ -259,9 +239,11 @@ void CCollisionManager::test(CCircle* _pC1, CCircle* _pC0, CObject* _p1, CPartic
 /// \param _pP0 Planet shape, time t0
 /// \param _p1 Object 1
 /// \param _p2 Particle
+/// \param _Indices Indices of candidate particles
 ///
 ///////////////////////////////////////////////////////////////////////////////
-void CCollisionManager::test(CPlanet* _pP1, CPlanet* _pP0, CObject* _p1, CParticle* _p2)
+void CCollisionManager::test(CPlanet* _pP1, CPlanet* _pP0, CObject* _p1, CParticle* _p2,
+                             const std::vector<int>& _Indices)
 {
     METHOD_ENTRY("CCollisionManager::test")
     
@@ -280,16 +262,14 @@ void CCollisionManager::test(CPlanet* _pP1, CPlanet* _pP0, CObject* _p1, CPartic
 /// \param _pP0 Polygon shape, time t0
 /// \param _p1 Object 1
 /// \param _p2 Particle
+/// \param _Indices Indices of candidate particles
 ///
 ///////////////////////////////////////////////////////////////////////////////
-void CCollisionManager::test(CPolygon* _pP1, CPolygon* _pP0, CObject* _p1, CParticle* _p2)
+void CCollisionManager::test(CPolygon* _pP1, CPolygon* _pP0, CObject* _p1, CParticle* _p2,
+                             const std::vector<int>& _Indices)
 {
     METHOD_ENTRY("CCollisionManager::test")
     
-    CCircularBuffer<Vector2d>* pPos (_p2->getPositions());
-    CCircularBuffer<Vector2d>* pVel(_p2->getVelocities());
-    CCircularBuffer<Vector2d>* pPosP (_p2->getPreviousPositions());
-    
     double fDampOrth = 0.5;
     double fDampTang = 1.0;
     
@@ -302,12 +282,15 @@ void CCollisionManager::test(CPolygon* _pP1, CPolygon* _pP0, CObject* _p1, CPart
     VertexListType::const_iterator ciPS1;
     VertexListType::const_iterator ciPS0;
     
-    for (auto i=0u; i<pPos->size(); ++i)
+    for (const auto i : _Indices)
     {
+        const Vector2d vecPos  = _p2->getPosition(i);
+        const Vector2d vecPosP = _p2->getPreviousPosition(i);
         CBoundingBox BBox;
-        BBox.setLowerLeft(pPos->at(i));
-        BBox.setUpperRight(pPos->at(i));
-        BBox.update(pPosP->at(i));
+        BBox.setCell(_p2->getCell());
+        BBox.setLowerLeft(vecPos);
+        BBox.setUpperRight(vecPos);
+        BBox.update(vecPosP);
         if (_p1->getGeometry()->getBoundingBox().overlaps(BBox))
         {
             ciP01 = _pP1->getVertices().begin();
@@ -327,7 +310,7 @@ void CCollisionManager::test(CPolygon* _pP1, CPolygon* _pP0, CObject* _p1, CPart
             while (ciP11 != _pP1->getVertices().end())
             {
                 CCollisionManager::PointLineContact Contact;
-                Contact = this->testPointLine(pPos->at(i), pPosP->at(i), (*ciP01), (*ciP11), (*ciP00), (*ciP10));
+                Contact = this->testPointLine(vecPos, vecPosP, (*ciP01), (*ciP11), (*ciP00), (*ciP10));
                 if ((Contact.fT >= 0.0) && (Contact.fT < fT))
                 {
                     fT     = Contact.fT;
@@ -344,7 +327,7 @@ void CCollisionManager::test(CPolygon* _pP1, CPolygon* _pP0, CObject* _p1, CPart
                 ciP10 = _pP1->getVertices().begin();
 
                 CCollisionManager::PointLineContact Contact;
-                Contact = this->testPointLine(pPos->at(i), pPosP->at(i), (*ciP01), (*ciP11), (*ciP00), (*ciP10));
+                Contact = this->testPointLine(vecPos, vecPosP, (*ciP01), (*ciP11), (*ciP00), (*ciP10));
                 if ((Contact.fT >= 0.0) && (Contact.fT < fT))
                 {
                     fT     = Contact.fT;
@@ -357,22 +340,22 @@ void CCollisionManager::test(CPolygon* _pP1, CPolygon* _pP0, CObject* _p1, CPart
             if (fT<=1.0)
             {
                 // Calculate point of contact
-                vecPOC = pPosP->at(i) + fT * (pPos->at(i) - pPosP->at(i));
+                vecPOC = vecPosP + fT * (vecPos - vecPosP);
                 
                 // Projection onto segment and separation of orthogonal an tangential component
-                Vector2d vecNewVelTang = (pVel->at(i).dot(((*ciPS0)-(*ciPS1)).normalized())) * ((*ciPS0)-(*ciPS1)).normalized();
-                Vector2d vecNewVelOrth = vecNewVelTang - pVel->at(i);
+                const Vector2d vecVel = _p2->getVelocity(i);
+                Vector2d vecNewVelTang = (vecVel.dot(((*ciPS0)-(*ciPS1)).normalized())) * ((*ciPS0)-(*ciPS1)).normalized();
+                Vector2d vecNewVelOrth = vecNewVelTang - vecVel;
                 
-                pVel->at(i) = (vecNewVelOrth * fDampOrth + vecNewVelTang * fDampTang) * 0.7071;
-
                 // Add the velocity of the object because particle' are virtually weightless.
                 // Otherwise, they would be passed in the next step
-                pVel->at(i) += _p1->getVelocity();
+                _p2->setVelocity(i, (vecNewVelOrth * fDampOrth + vecNewVelTang * fDampTang) * 0.7071 +
+                                    _p1->getVelocity());
                 
-                // pPos->at(i)= vecPOC+(vecNewVelOrth)/(vecNewVelOrth).norm()*0.001;
+                // _p2->setPosition(i, vecPOC+(vecNewVelOrth)/(vecNewVelOrth).norm()*0.001);
                 // Cannot use POC here, because particle' are virtually weightless. Thus, the
                 // object moves on and does not care about POC position.
-                pPos->at(i)  = (*ciPS0) + fAlpha * ((*ciPS1)-(*ciPS0)) + vecNewVelOrth.normalized()*0.001;
+                _p2->setPosition(i, (*ciPS0) + fAlpha * ((*ciPS1)-(*ciPS0)) + vecNewVelOrth.normalized()*0.001);
             } 
         }
     }
@@ -391,22 +374,22 @@ void CCollisionManager::test(CPolygon* _pP1, CPolygon* _pP0, CObject* _p1, CPart
 ///
 /// \param _p1 Terrain shape
 /// \param _p2 Particle
+/// \param _Indices Indices of candidate particles
 ///
 ///////////////////////////////////////////////////////////////////////////////
-void CCollisionManager::test(CTerrain* _p1, CParticle* _p2)
+void CCollisionManager::test(CTerrain* _p1, CParticle* _p2,
+                             const std::vector<int>& _Indices)
 {
     METHOD_ENTRY("CCollisionManager::test")
     
-    CCircularBuffer<Vector2d>* pPos (_p2->getPositions());
-    CCircularBuffer<Vector2d>* pVel(_p2->getVelocities());
-    CCircularBuffer<Vector2d>* pPosP (_p2->getPreviousPositions());
-    
     double fInc = _p1->getGroundResolution();
 
-    for (auto i=0u; i<pPos->size(); ++i)
+    for (const auto i : _Indices)
     {
+        const Vector2d vecPos  = _p2->getPosition(i);
+        const Vector2d vecPosP = _p2->getPreviousPosition(i);
         // Simple broad phase collision detection, does _not_ prevent tunneling.
-//         if (_p1->getBoundingBox().isInside(pPos->at(i)))
+//         if (_p1->getBoundingBox().isInside(vecPos))
         {
             Vector2d vecPOC;
             Vector2d vecTmp;
@@ -417,15 +400,15 @@ void CCollisionManager::test(CTerrain* _p1, CParticle* _p2)
             
             double fParticleLeft;
             double fParticleRight;
-            if (pPos->at(i)[0] < (pPosP->at(i)[0]))
+            if (vecPos[0] < (vecPosP[0]))
             {
-                fParticleLeft  = pPos->at(i)[0];
-                fParticleRight = pPosP->at(i)[0];
+                fParticleLeft  = vecPos[0];
+                fParticleRight = vecPosP[0];
             }
             else
             {
-                fParticleLeft  = pPosP->at(i)[0];
-                fParticleRight = pPos->at(i)[0];
+                fParticleLeft  = vecPosP[0];
+                fParticleRight = vecPos[0];
             }
             
             if (fParticleLeft > fTerrainLeft)
@@ -448,10 +431,10 @@ void CCollisionManager::test(CTerrain* _p1, CParticle* _p2)
             {
                 double fAx = fX1 - fX0;
                 double fAy = fY1 - fY0;
-                double fCx = pPosP->at(i)[0]-fX0;
-                double fCy = pPosP->at(i)[1]-fY0;
-                double fDx = (pPos->at(i) - pPosP->at(i))[0];
-                double fDy = (pPos->at(i) - pPosP->at(i))[1];
+                double fCx = vecPosP[0]-fX0;
+                double fCy = vecPosP[1]-fY0;
+                double fDx = (vecPos - vecPosP)[0];
+                double fDy = (vecPos - vecPosP)[1];
 
                 double fTmpA = fAx*fCy-fAy*fCx;
                 double fTmpB = fAx*fDy-fAy*fDx;
@@ -464,7 +447,7 @@ void CCollisionManager::test(CTerrain* _p1, CParticle* _p2)
                     {
                         if (fTmpT < fT)
                         {
-                            vecTmp = pPosP->at(i) + fTmpT*(pPos->at(i)-pPosP->at(i));
+                            vecTmp = vecPosP + fTmpT*(vecPos-vecPosP);
                             if ((vecTmp-Vector2d(fX0,fY0)).norm() < Vector2d(fX1-fX0,fY1-fY0).norm())
                             {
                                 fT = fTmpT;
@@ -486,7 +469,7 @@ void CCollisionManager::test(CTerrain* _p1, CParticle* _p2)
             if (fT<=1.0)
             {
                 double fSegAngle = std::atan2(fY1Seg-fY0Seg, fX1Seg-fX0Seg);
-                double fPosAngle = std::atan2(pPos->at(i)[1]-pPosP->at(i)[1], pPos->at(i)[0]-pPosP->at(i)[0]);
+                double fPosAngle = std::atan2(vecPos[1]-vecPosP[1], vecPos[0]-vecPosP[0]);
                 
                 Vector2d vecNewVelOrth;
                 Vector2d vecNewVelTang;
@@ -500,10 +483,9 @@ void CCollisionManager::test(CTerrain* _p1, CParticle* _p2)
                 double fOrth =    std::sin(fSegAngle-fPosAngle)*0.5;
                 double fDamping = sqrt(fTang*fTang+fOrth*fOrth)*0.7071;
                 
-                double fNorm = pVel->at(i).norm();
-                pVel->at(i)[0] = ((fOrth*vecNewVelOrth+fTang*vecNewVelTang).normalized() * fDamping * fNorm)[0];
-                pVel->at(i)[1] = ((fOrth*vecNewVelOrth+fTang*vecNewVelTang).normalized() * fDamping * fNorm)[1];
-                pPos->at(i)=vecPOC+(pPosP->at(i)-vecPOC)/(pPosP->at(i)-vecPOC).norm()*0.001;
+                double fNorm = _p2->getVelocity(i).norm();
+                _p2->setVelocity(i, (fOrth*vecNewVelOrth+fTang*vecNewVelTang).normalized() * fDamping * fNorm);
+                _p2->setPosition(i, vecPOC+(vecPosP-vecPOC)/(vecPosP-vecPOC).norm()*0.001);
              
             }
         }
@@ -536,16 +518,14 @@ void CCollisionManager::test(CObject* _p1, CObject* _p2)
                     switch((*cj)->getShapeType())
                     {
                         case ShapeType::CIRCLE:
-                            CCircle* pCircA1;
-                            CCircle* pCircB1;
-                            CCircle* pCircA0;
-                            CCircle* pCircB0;
-//                             pCircA1 = static_cast<CCircle*>((*ci)->getShapeCur());
-//                             pCircB1 = static_cast<CCircle*>((*cj)->getShapeCur());
-//                             pCircA0 = static_cast<CCircle*>((*ci)->getShapeBuf());
-//                             pCircB0 = static_cast<CCircle*>((*cj)->getShapeBuf());
-                            this->test(pCircA1, pCircA0, pCircB1, pCircB0, _p1, _p2);
+                        {
+                            // Shapes of previous time step aren't buffered
+                            // anymore, use current shapes for both
+                            CCircle* pCircA1 = static_cast<CCircle*>(ci->ptr());
+                            CCircle* pCircB1 = static_cast<CCircle*>(cj->ptr());
+                            this->test(pCircA1, pCircA1, pCircB1, pCircB1, _p1, _p2);
                             break;
+                        }
                         case ShapeType::PLANET:
 //                             this->getSurfaceOfInterest();
                             break;
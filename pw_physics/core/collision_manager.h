@@ -34,7 +34,9 @@
 //--- Standard header --------------------------------------------------------//
 
 //--- Program header ---------------------------------------------------------//
+#include "broad_phase.h"
 #include "circle.h"
+#include "particle_hash.h"
 #include "particle.h"
 #include "object.h"
 #include "planet.h"
@@ -57,10 +59,14 @@ class CCollisionManager : public IWorldDataStorageUser
 //         ~CCollisionManager();
         
         //--- Constant Methods -----------------------------------------------//
+        const CBroadPhase&      getBroadPhase() const;
+        const CParticleHash&    getParticleHash() const;
                 
         //--- Methods --------------------------------------------------------//
-        void detectCollisions();
-        void setParticle(const ParticleType&);
+        void broadPhase(const CSlotMap<UIDType, CObject*>* const,
+                        const CSlotMap<UIDType, CParticle*>* const);
+        void detectCollisions(const bool = true);
+        void setParticleBucketSize(const double&);
         
     private:
         
@@ -73,11 +79,11 @@ class CCollisionManager : public IWorldDataStorageUser
         void getSurfaceOfInterest();
         
         void    test(CObject*, CObject*);
-        void    test(CObject*, CParticle*);
-        void    test(CCircle*, CCircle*, CObject*, CParticle*);
-        void    test(CPlanet*, CPlanet*, CObject*, CParticle*);
-        void    test(CPolygon*, CPolygon*, CObject*, CParticle*);
-        void    test(CTerrain*, CParticle*);
+        void    test(CObject*, CParticle*, const std::vector<int>&);
+        void    test(CCircle*, CCircle*, CObject*, CParticle*, const std::vector<int>&);
+        void    test(CPlanet*, CPlanet*, CObject*, CParticle*, const std::vector<int>&);
+        void    test(CPolygon*, CPolygon*, CObject*, CParticle*, const std::vector<int>&);
+        void    test(CTerrain*, CParticle*, const std::vector<int>&);
         void    test(CCircle*, CCircle*, CCircle*, CCircle*, CObject*, CObject*);
         void    test(CCircle*, CCircle*, CPolygon*, CPolygon*, CObject*, CObject*);
         void    test(CPolygon*, CPolygon*, CPolygon*, CPolygon*, CObject*, CObject*);
@@ -89,9 +95,52 @@ class CCollisionManager : public IWorldDataStorageUser
         PointLineContact    testPointLine(const Vector2d&, const Vector2d&, const Vector2d&,
                                           const Vector2d&, const Vector2d&, const Vector2d&);
         
-        ParticleType              m_Particle;           ///< List of particle
+        CBroadPhase               m_BroadPhase;         ///< Broad phase providing candidate pairs
+        CParticleHash             m_ParticleHash;       ///< Spatial hash of particles
+        ParticleCandidatesType    m_ParticleCandidates; ///< Candidate particles of current query
+
+        const CSlotMap<UIDType, CObject*>* m_pObjects = nullptr; ///< Objects of last broad phase update
 };
 
 //--- Implementation is done here for inline optimisation --------------------//
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns broad phase, e.g. for statistics
+///
+/// \return Broad phase
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const CBroadPhase& CCollisionManager::getBroadPhase() const
+{
+    METHOD_ENTRY("CCollisionManager::getBroadPhase")
+    return m_BroadPhase;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns spatial hash of particles, e.g. for statistics
+///
+/// \return Spatial hash of particles
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const CParticleHash& CCollisionManager::getParticleHash() const
+{
+    METHOD_ENTRY("CCollisionManager::getParticleHash")
+    return m_ParticleHash;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets edge length of sub-cells of spatial hash of particles
+///
+/// \param _fBucketSize Edge length of sub-cells
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CCollisionManager::setParticleBucketSize(const double& _fBucketSize)
+{
+    METHOD_ENTRY("CCollisionManager::setParticleBucketSize")
+    m_ParticleHash.setBucketSize(_fBucketSize);
+}
+
 #endif
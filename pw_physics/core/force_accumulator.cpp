@@ -0,0 +1,209 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       force_accumulator.cpp
+/// \brief      Implementation of class "CForceAccumulator"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-15
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "force_accumulator.h"
+
+//--- Standard header --------------------------------------------------------//
+#include <algorithm>
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Constructor
+///
+///////////////////////////////////////////////////////////////////////////////
+CForceAccumulator::CForceAccumulator() : m_nNumberOfWorkers(FORCE_ACCUMULATOR_DEFAULT_WORKERS)
+{
+    METHOD_ENTRY("CForceAccumulator::CForceAccumulator")
+    CTOR_CALL("CForceAccumulator::CForceAccumulator")
+
+    m_Forces.resize(m_nNumberOfWorkers);
+    m_Torques.resize(m_nNumberOfWorkers);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adds a force to given object
+///
+/// This method is used by joints and thrusters which refer to objects
+/// directly.
+///
+/// \param _pObj Object
+/// \param _vecF Force
+/// \param _vecPOC Point of contact
+/// \param _nWorker Worker, whose buffer is used
+///
+///////////////////////////////////////////////////////////////////////////////
+void CForceAccumulator::addForce(CObject* const _pObj,
+                                 const Vector2d& _vecF,
+                                 const Vector2d& _vecPOC,
+                                 const int _nWorker)
+{
+    METHOD_ENTRY("CForceAccumulator::addForce")
+
+    int nIndex = this->getIndex(_pObj);
+    if (nIndex != -1)
+    {
+        this->addForce(nIndex, _vecF, _vecPOC, _nWorker);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adds a force, given in local coordinates, to given object
+///
+/// \param _pObj Object
+/// \param _vecF Force
+/// \param _vecPOC Point of contact
+/// \param _nWorker Worker, whose buffer is used
+///
+///////////////////////////////////////////////////////////////////////////////
+void CForceAccumulator::addForceLC(CObject* const _pObj,
+                                   const Vector2d& _vecF,
+                                   const Vector2d& _vecPOC,
+                                   const int _nWorker)
+{
+    METHOD_ENTRY("CForceAccumulator::addForceLC")
+
+    int nIndex = this->getIndex(_pObj);
+    if (nIndex != -1)
+    {
+        _pObj->addForceLC(_vecF, _vecPOC, m_Forces[_nWorker][nIndex],
+                                          m_Torques[_nWorker][nIndex]);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Initialises buffers and dense indices for given objects
+///
+/// The first worker's buffer starts with the current force and torque of
+/// the objects (which might have been set by queued commands), all others
+/// start with zero.
+///
+/// \param _pObjects Objects to accumulate forces for
+///
+///////////////////////////////////////////////////////////////////////////////
+void CForceAccumulator::init(const CSlotMap<UIDType, CObject*>* const _pObjects)
+{
+    METHOD_ENTRY("CForceAccumulator::init")
+
+    m_Objects.clear();
+    for (const auto& Obj : *_pObjects)
+    {
+        Obj.second->setForceIndex(m_Objects.size());
+        m_Objects.push_back(Obj.second);
+    }
+
+    for (auto i=0; i<m_nNumberOfWorkers; ++i)
+    {
+        m_Forces[i].resize(m_Objects.size());
+        m_Torques[i].resize(m_Objects.size());
+    }
+    for (auto i=0u; i<m_Objects.size(); ++i)
+    {
+        m_Forces[0][i] = m_Objects[i]->getForce();
+        m_Torques[0][i] = m_Objects[i]->getTorque();
+    }
+    for (auto i=1; i<m_nNumberOfWorkers; ++i)
+    {
+        std::fill(m_Forces[i].begin(), m_Forces[i].end(), Vector2d(0.0, 0.0));
+        std::fill(m_Torques[i].begin(), m_Torques[i].end(), 0.0);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sums up buffers of all workers and applies results to objects
+///
+///////////////////////////////////////////////////////////////////////////////
+void CForceAccumulator::reduce()
+{
+    METHOD_ENTRY("CForceAccumulator::reduce")
+
+    const int nSize = m_Objects.size();
+
+    #pragma omp parallel for num_threads(m_nNumberOfWorkers) if(m_nNumberOfWorkers > 1)
+    for (auto i=0; i<nSize; ++i)
+    {
+        Vector2d vecF(m_Forces[0][i]);
+        double   fTorque(m_Torques[0][i]);
+        for (auto j=1; j<m_nNumberOfWorkers; ++j)
+        {
+            vecF += m_Forces[j][i];
+            fTorque += m_Torques[j][i];
+        }
+        m_Objects[i]->setForce(vecF, fTorque);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets number of workers
+///
+/// \param _nNumberOfWorkers Number of workers
+///
+///////////////////////////////////////////////////////////////////////////////
+void CForceAccumulator::setNumberOfWorkers(const int _nNumberOfWorkers)
+{
+    METHOD_ENTRY("CForceAccumulator::setNumberOfWorkers")
+
+    if (_nNumberOfWorkers < 1)
+    {
+        WARNING_MSG("Force Accumulator", "Number of workers must be at least 1.")
+        return;
+    }
+    m_nNumberOfWorkers = _nNumberOfWorkers;
+    m_Forces.resize(m_nNumberOfWorkers);
+    m_Torques.resize(m_nNumberOfWorkers);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns dense index of given object
+///
+/// \param _pObj Object
+///
+/// \return Dense index, -1 if object is not known in current frame
+///
+///////////////////////////////////////////////////////////////////////////////
+int CForceAccumulator::getIndex(CObject* const _pObj) const
+{
+    METHOD_ENTRY("CForceAccumulator::getIndex")
+
+    int nIndex = _pObj->getForceIndex();
+    if (nIndex < 0 || nIndex >= int(m_Objects.size()) || m_Objects[nIndex] != _pObj)
+    {
+        // Objects created after initialisation are unknown until next frame.
+        // They can't be registered here, since workers add forces concurrently.
+        WARNING_MSG("Force Accumulator", "Object " << _pObj->getName() << " unknown in current frame, force not applied.")
+        return -1;
+    }
+    return nIndex;
+}
@@ -0,0 +1,177 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       force_accumulator.h
+/// \brief      Prototype of class "CForceAccumulator"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-15
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef FORCE_ACCUMULATOR_H
+#define FORCE_ACCUMULATOR_H
+
+//--- Standard header --------------------------------------------------------//
+#include <vector>
+
+//--- Program header ---------------------------------------------------------//
+#include "object.h"
+#include "slot_map.h"
+
+//--- Misc header ------------------------------------------------------------//
+
+//--- Constants --------------------------------------------------------------//
+const int FORCE_ACCUMULATOR_DEFAULT_WORKERS = 1; ///< Default number of workers, 1 equals serial processing
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Accumulates forces of multiple workers before applying them to
+///        objects
+///
+/// Each object gets a dense index when initialising a frame. Every worker
+/// owns a private force and torque buffer, indexed by the dense index, so
+/// force calculations can run in parallel without locking. When reducing,
+/// buffers are summed up in order of workers and the result is written to
+/// the objects. The buffer of the first worker is initialised with the
+/// object's current force, hence using one worker results in exactly the
+/// same floating point operations as calling \ref CObject::addForce
+/// directly.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CForceAccumulator
+{
+
+    public:
+
+        //--- Constructor/Destructor -----------------------------------------//
+        CForceAccumulator();
+
+        //--- Constant Methods -----------------------------------------------//
+        const int&      getNumberOfWorkers() const;
+        CObject*        getObject(const int) const;
+        int             size() const;
+
+        //--- Methods --------------------------------------------------------//
+        void addAcceleration(const int, const Vector2d&, const int = 0);
+        void addForce(const int, const Vector2d&, const Vector2d&, const int = 0);
+        void addForce(CObject* const, const Vector2d&, const Vector2d&, const int = 0);
+        void addForceLC(CObject* const, const Vector2d&, const Vector2d&, const int = 0);
+
+        void init(const CSlotMap<UIDType, CObject*>* const);
+        void reduce();
+        void setNumberOfWorkers(const int);
+
+    private:
+
+        //--- Methods [private] ----------------------------------------------//
+        int  getIndex(CObject* const) const;
+
+        //--- Variables [private] --------------------------------------------//
+        std::vector<CObject*>               m_Objects;          ///< Objects by dense index
+        std::vector<std::vector<Vector2d>>  m_Forces;           ///< Force buffers per worker
+        std::vector<std::vector<double>>    m_Torques;          ///< Torque buffers per worker
+        int                                 m_nNumberOfWorkers; ///< Number of workers
+};
+
+//--- Implementation is done here for inline optimisation --------------------//
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of workers
+///
+/// \return Number of workers
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const int& CForceAccumulator::getNumberOfWorkers() const
+{
+    METHOD_ENTRY("CForceAccumulator::getNumberOfWorkers")
+    return m_nNumberOfWorkers;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns object with given dense index
+///
+/// \param _nIndex Dense index of object
+///
+/// \return Object
+///
+////////////////////////////////////////////////////////////////////////////////
+inline CObject* CForceAccumulator::getObject(const int _nIndex) const
+{
+    METHOD_ENTRY("CForceAccumulator::getObject")
+    return m_Objects[_nIndex];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of objects
+///
+/// \return Number of objects
+///
+////////////////////////////////////////////////////////////////////////////////
+inline int CForceAccumulator::size() const
+{
+    METHOD_ENTRY("CForceAccumulator::size")
+    return m_Objects.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adds an acceleration to object with given dense index
+///
+/// \param _nIndex Dense index of object
+/// \param _vecA Acceleration
+/// \param _nWorker Worker, whose buffer is used
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CForceAccumulator::addAcceleration(const int _nIndex,
+                                               const Vector2d& _vecA,
+                                               const int _nWorker)
+{
+    METHOD_ENTRY("CForceAccumulator::addAcceleration")
+    m_Objects[_nIndex]->addAcceleration(_vecA, m_Forces[_nWorker][_nIndex],
+                                               m_Torques[_nWorker][_nIndex]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adds a force to object with given dense index
+///
+/// \param _nIndex Dense index of object
+/// \param _vecF Force
+/// \param _vecPOC Point of contact
+/// \param _nWorker Worker, whose buffer is used
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CForceAccumulator::addForce(const int _nIndex,
+                                        const Vector2d& _vecF,
+                                        const Vector2d& _vecPOC,
+                                        const int _nWorker)
+{
+    METHOD_ENTRY("CForceAccumulator::addForce")
+    m_Objects[_nIndex]->addForce(_vecF, _vecPOC, m_Forces[_nWorker][_nIndex],
+                                                 m_Torques[_nWorker][_nIndex]);
+}
+
+#endif // FORCE_ACCUMULATOR_H
@@ -0,0 +1,323 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       gravity_tree.cpp
+/// \brief      Implementation of class "CGravityTree"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-14
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gravity_tree.h"
+
+//--- Standard header --------------------------------------------------------//
+#include <algorithm>
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Constructor
+///
+///////////////////////////////////////////////////////////////////////////////
+CGravityTree::CGravityTree() : m_fTheta(GRAVITY_TREE_DEFAULT_OPENING_ANGLE),
+                               m_fThetaSqr(GRAVITY_TREE_DEFAULT_OPENING_ANGLE*
+                                           GRAVITY_TREE_DEFAULT_OPENING_ANGLE)
+{
+    METHOD_ENTRY("CGravityTree::CGravityTree")
+    CTOR_CALL("CGravityTree::CGravityTree")
+
+    m_vecCellRef.setZero();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns gravitational field at given location
+///
+/// The field is the sum of m/r^2 in direction of all (approximated) bodies.
+/// Multiplied by the gravitational constant it results in an acceleration,
+/// multiplied by the gravitational constant and mass in a force. Bodies
+/// closer than \ref GRAVITY_TREE_MIN_DISTANCE_SQR are ignored as in the
+/// pairwise algorithm.
+///
+/// \param _vecCOM Location of interest, local to its cell
+/// \param _vecCell Grid cell of location of interest
+/// \param _nSelf Index of body that should be excluded, i.e. the body the
+///               field is calculated for. -1 if it is not part of the tree.
+///
+/// \return Gravitational field
+///
+///////////////////////////////////////////////////////////////////////////////
+Vector2d CGravityTree::getField(const Vector2d& _vecCOM,
+                                const Vector2i& _vecCell,
+                                const int _nSelf) const
+{
+    METHOD_ENTRY("CGravityTree::getField")
+
+    Vector2d vecField(0.0, 0.0);
+
+    if (m_Nodes.empty()) return vecField;
+
+    const Vector2d vecPos(_vecCOM + IGridUser::cellToDouble(_vecCell - m_vecCellRef));
+
+    // Every node on the stack pushes at most four children, so depth
+    // limits the size of the stack
+    int nStack[3*GRAVITY_TREE_MAX_DEPTH+4];
+    int nTop = 0;
+    nStack[nTop++] = 0;
+
+    while (nTop > 0)
+    {
+        const Node& CurrentNode = m_Nodes[nStack[--nTop]];
+
+        if (CurrentNode.nCount > 0)
+        {
+            // Leaf: Exact interaction using cell differences
+            for (auto i = CurrentNode.nFirst; i < CurrentNode.nFirst+CurrentNode.nCount; ++i)
+            {
+                const int j = m_Permutation[i];
+                if (j == _nSelf) continue;
+
+                Vector2d vecD(m_COMs[j] - _vecCOM + IGridUser::cellToDouble(m_Cells[j] - _vecCell));
+                double fDSqr = vecD.squaredNorm();
+                if (fDSqr > GRAVITY_TREE_MIN_DISTANCE_SQR)
+                {
+                    vecField += vecD.normalized() * m_Masses[j] / fDSqr;
+                }
+            }
+        }
+        else
+        {
+            Vector2d vecD(CurrentNode.vecCOM - vecPos);
+            double fDSqr = vecD.squaredNorm();
+            double fSize = 2.0*CurrentNode.fHalfSize;
+
+            // Never approximate nodes containing the location of interest,
+            // it might be part of the node itself
+            bool bInside = ((vecPos - CurrentNode.vecCenter).cwiseAbs().maxCoeff() <= CurrentNode.fHalfSize);
+
+            if (!bInside && fSize*fSize < m_fThetaSqr * fDSqr)
+            {
+                if (fDSqr > GRAVITY_TREE_MIN_DISTANCE_SQR)
+                {
+                    vecField += vecD.normalized() * CurrentNode.fMass / fDSqr;
+                }
+            }
+            else
+            {
+                for (auto i=0; i<4; ++i)
+                {
+                    if (CurrentNode.nChildren[i] != -1)
+                        nStack[nTop++] = CurrentNode.nChildren[i];
+                }
+            }
+        }
+    }
+    return vecField;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adds a body to the tree
+///
+/// Bodies are only inserted into the tree structure when calling
+/// \ref build.
+///
+/// \param _vecCOM Center of mass of body, local to its cell
+/// \param _vecCell Grid cell of body
+/// \param _fMass Mass of body
+///
+/// \return Index of body within tree
+///
+///////////////////////////////////////////////////////////////////////////////
+int CGravityTree::addBody(const Vector2d& _vecCOM,
+                          const Vector2i& _vecCell,
+                          const double& _fMass)
+{
+    METHOD_ENTRY("CGravityTree::addBody")
+
+    if (m_Masses.empty()) m_vecCellRef = _vecCell;
+
+    m_COMs.push_back(_vecCOM);
+    m_Cells.push_back(_vecCell);
+    m_Masses.push_back(_fMass);
+    m_Positions.push_back(_vecCOM + IGridUser::cellToDouble(_vecCell - m_vecCellRef));
+
+    return int(m_Masses.size())-1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Builds the tree from all bodies added
+///
+///////////////////////////////////////////////////////////////////////////////
+void CGravityTree::build()
+{
+    METHOD_ENTRY("CGravityTree::build")
+
+    m_Nodes.clear();
+    if (m_Masses.empty()) return;
+
+    m_Permutation.resize(m_Masses.size());
+    for (auto i=0u; i<m_Permutation.size(); ++i) m_Permutation[i] = i;
+
+    Vector2d vecMin(m_Positions[0]);
+    Vector2d vecMax(m_Positions[0]);
+    for (const auto& vecP : m_Positions)
+    {
+        vecMin = vecMin.cwiseMin(vecP);
+        vecMax = vecMax.cwiseMax(vecP);
+    }
+    double fHalfSize = std::max(0.5*(vecMax-vecMin).maxCoeff(), 1.0);
+
+    m_Nodes.reserve(2*m_Masses.size()/GRAVITY_TREE_LEAF_SIZE+1);
+    this->buildNode(0, m_Permutation.size(), 0.5*(vecMin+vecMax), fHalfSize, 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Removes all bodies and nodes
+///
+/// Memory is kept to avoid reallocation in next frame.
+///
+///////////////////////////////////////////////////////////////////////////////
+void CGravityTree::clear()
+{
+    METHOD_ENTRY("CGravityTree::clear")
+
+    m_Nodes.clear();
+    m_Permutation.clear();
+    m_COMs.clear();
+    m_Cells.clear();
+    m_Masses.clear();
+    m_Positions.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets opening angle of Barnes-Hut criterion
+///
+/// Nodes are approximated by their center of mass, if their size divided by
+/// the distance is smaller than the opening angle. Thus, 0 results in exact
+/// calculation, larger values are faster but less accurate.
+///
+/// \param _fTheta Opening angle
+///
+///////////////////////////////////////////////////////////////////////////////
+void CGravityTree::setOpeningAngle(const double& _fTheta)
+{
+    METHOD_ENTRY("CGravityTree::setOpeningAngle")
+
+    if (_fTheta < 0.0)
+    {
+        WARNING_MSG("Gravity Tree", "Negative opening angle, setting to 0 (exact calculation).")
+        m_fTheta = 0.0;
+    }
+    else
+    {
+        m_fTheta = _fTheta;
+    }
+    m_fThetaSqr = m_fTheta*m_fTheta;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Recursively builds node and its children
+///
+/// Bodies given by range of permutation are partitioned into quadrants.
+///
+/// \param _nFirst First body (index into permutation)
+/// \param _nCount Number of bodies
+/// \param _vecCenter Geometric center of node
+/// \param _fHalfSize Half edge length of node
+/// \param _nDepth Depth of node
+///
+/// \return Index of node created
+///
+///////////////////////////////////////////////////////////////////////////////
+int CGravityTree::buildNode(const int _nFirst, const int _nCount,
+                            const Vector2d& _vecCenter, const double& _fHalfSize,
+                            const int _nDepth)
+{
+    METHOD_ENTRY("CGravityTree::buildNode")
+
+    const int nIndex = m_Nodes.size();
+    m_Nodes.emplace_back();
+
+    Node NewNode;
+    NewNode.vecCenter = _vecCenter;
+    NewNode.vecCOM.setZero();
+    NewNode.fHalfSize = _fHalfSize;
+    NewNode.fMass = 0.0;
+    NewNode.nFirst = _nFirst;
+    NewNode.nCount = 0;
+    for (auto i=0; i<4; ++i) NewNode.nChildren[i] = -1;
+
+    for (auto i = _nFirst; i < _nFirst+_nCount; ++i)
+    {
+        const int j = m_Permutation[i];
+        NewNode.fMass += m_Masses[j];
+        NewNode.vecCOM += m_Masses[j] * m_Positions[j];
+    }
+    if (NewNode.fMass > 0.0)
+        NewNode.vecCOM /= NewNode.fMass;
+    else
+        NewNode.vecCOM = _vecCenter;
+
+    if (_nCount <= GRAVITY_TREE_LEAF_SIZE || _nDepth >= GRAVITY_TREE_MAX_DEPTH)
+    {
+        NewNode.nCount = _nCount;
+        m_Nodes[nIndex] = NewNode;
+        return nIndex;
+    }
+
+    // Partition into quadrants: first by x, then each half by y
+    auto itBegin = m_Permutation.begin() + _nFirst;
+    auto itEnd   = itBegin + _nCount;
+    auto itX = std::partition(itBegin, itEnd, [&](const int _n)
+                              {return m_Positions[_n][0] < _vecCenter[0];});
+    auto itY0 = std::partition(itBegin, itX, [&](const int _n)
+                               {return m_Positions[_n][1] < _vecCenter[1];});
+    auto itY1 = std::partition(itX, itEnd, [&](const int _n)
+                               {return m_Positions[_n][1] < _vecCenter[1];});
+
+    const int nBounds[5] = {_nFirst,
+                            _nFirst + int(itY0 - itBegin),
+                            _nFirst + int(itX  - itBegin),
+                            _nFirst + int(itY1 - itBegin),
+                            _nFirst + _nCount};
+    const double fH = 0.5*_fHalfSize;
+    const Vector2d vecOffsets[4] = {Vector2d(-fH, -fH), Vector2d(-fH, fH),
+                                    Vector2d( fH, -fH), Vector2d( fH, fH)};
+
+    m_Nodes[nIndex] = NewNode;
+    for (auto i=0; i<4; ++i)
+    {
+        if (nBounds[i+1] > nBounds[i])
+        {
+            // Store child index after recursion, node storage might be reallocated
+            int nChild = this->buildNode(nBounds[i], nBounds[i+1]-nBounds[i],
+                                         _vecCenter+vecOffsets[i], fH, _nDepth+1);
+            m_Nodes[nIndex].nChildren[i] = nChild;
+        }
+    }
+    return nIndex;
+}
@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       gravity_tree.h
+/// \brief      Prototype of class "CGravityTree"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-14
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef GRAVITY_TREE_H
+#define GRAVITY_TREE_H
+
+//--- Standard header --------------------------------------------------------//
+#include <vector>
+
+//--- Program header ---------------------------------------------------------//
+#include "grid_user.h"
+
+//--- Misc header ------------------------------------------------------------//
+
+//--- Constants --------------------------------------------------------------//
+const double GRAVITY_TREE_DEFAULT_OPENING_ANGLE = 0.5;     ///< Default opening angle (theta) of Barnes-Hut criterion
+const double GRAVITY_TREE_MIN_DISTANCE_SQR      = 400.0;   ///< Squared distance below which gravitation is ignored
+const int    GRAVITY_TREE_LEAF_SIZE             = 8;       ///< Maximum number of bodies in a leaf
+const int    GRAVITY_TREE_MAX_DEPTH             = 64;      ///< Maximum depth, stops subdivision of coincident bodies
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Quadtree for Barnes-Hut approximation of gravitation
+///
+/// Bodies are given by their center of mass, grid cell and mass. Internally,
+/// positions are stored relative to a reference cell (the cell of the first
+/// body). Groups of bodies that are far away are approximated by their total
+/// mass located at their center of mass, if the node size divided by the
+/// distance is smaller than the opening angle. Interactions within leafs are
+/// calculated exactly, using cell differences just like the pairwise
+/// algorithm does, hence near field precision does not suffer from large
+/// distances to the reference cell.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CGravityTree
+{
+
+    public:
+
+        //--- Constructor/Destructor -----------------------------------------//
+        CGravityTree();
+
+        //--- Constant Methods -----------------------------------------------//
+        Vector2d        getField(const Vector2d&, const Vector2i&, const int = -1) const;
+        const double&   getOpeningAngle() const;
+        std::size_t     size() const;
+
+        //--- Methods --------------------------------------------------------//
+        int  addBody(const Vector2d&, const Vector2i&, const double&);
+        void build();
+        void clear();
+        void setOpeningAngle(const double&);
+
+    private:
+
+        /// Node of the quadtree, either holding four children or bodies
+        struct Node
+        {
+            Vector2d    vecCenter;      ///< Geometric center of node, relative to reference cell
+            Vector2d    vecCOM;         ///< Center of mass, relative to reference cell
+            double      fHalfSize;      ///< Half of the edge length of node
+            double      fMass;          ///< Accumulated mass of all bodies within node
+            int         nChildren[4];   ///< Indices of child nodes, -1 if empty
+            int         nFirst;         ///< First body (index into permutation) of leaf
+            int         nCount;         ///< Number of bodies of leaf, 0 for inner nodes
+        };
+
+        //--- Methods [private] ----------------------------------------------//
+        int  buildNode(const int, const int, const Vector2d&, const double&, const int);
+
+        //--- Variables [private] --------------------------------------------//
+        std::vector<Node>       m_Nodes;        ///< Flat storage of tree nodes, root at index 0
+        std::vector<int>        m_Permutation;  ///< Body indices, sorted by leafs
+
+        std::vector<Vector2d>   m_COMs;         ///< Center of mass of bodies, local to their cell
+        std::vector<Vector2i>   m_Cells;        ///< Grid cells of bodies
+        std::vector<double>     m_Masses;       ///< Masses of bodies
+        std::vector<Vector2d>   m_Positions;    ///< Positions of bodies, relative to reference cell
+
+        Vector2i                m_vecCellRef;   ///< Reference cell of tree
+        double                  m_fTheta;       ///< Opening angle of Barnes-Hut criterion
+        double                  m_fThetaSqr;    ///< Squared opening angle
+};
+
+//--- Implementation is done here for inline optimisation --------------------//
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns opening angle of Barnes-Hut criterion
+///
+/// \return Opening angle
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const double& CGravityTree::getOpeningAngle() const
+{
+    METHOD_ENTRY("CGravityTree::getOpeningAngle")
+    return m_fTheta;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of bodies in tree
+///
+/// \return Number of bodies
+///
+////////////////////////////////////////////////////////////////////////////////
+inline std::size_t CGravityTree::size() const
+{
+    METHOD_ENTRY("CGravityTree::size")
+    return m_Masses.size();
+}
+
+#endif // GRAVITY_TREE_H
@@ -0,0 +1,269 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       island_manager.cpp
+/// \brief      Implementation of class "CIslandManager"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "island_manager.h"
+
+//--- Standard header --------------------------------------------------------//
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Constructor
+///
+///////////////////////////////////////////////////////////////////////////////
+CIslandManager::CIslandManager() : m_fAccelerationThreshold(ISLAND_MANAGER_DEFAULT_ACCELERATION_THRESHOLD),
+                                   m_fAngleVelocityThreshold(ISLAND_MANAGER_DEFAULT_ANGLE_VELOCITY_THRESHOLD),
+                                   m_fVelocityThreshold(ISLAND_MANAGER_DEFAULT_VELOCITY_THRESHOLD),
+                                   m_nFrames(ISLAND_MANAGER_DEFAULT_FRAMES),
+                                   m_nNumberOfIslands(0),
+                                   m_nNumberOfSleeping(0),
+                                   m_bEnabled(true)
+{
+    METHOD_ENTRY("CIslandManager::CIslandManager")
+    CTOR_CALL("CIslandManager::CIslandManager")
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets change of acceleration waking objects
+///
+/// \param _fAcceleration Change of acceleration, linear and angular
+///
+///////////////////////////////////////////////////////////////////////////////
+void CIslandManager::setAccelerationThreshold(const double& _fAcceleration)
+{
+    METHOD_ENTRY("CIslandManager::setAccelerationThreshold")
+
+    if (_fAcceleration < 0.0)
+    {
+        WARNING_MSG("Island Manager", "Threshold must not be negative.")
+        return;
+    }
+    m_fAccelerationThreshold = _fAcceleration;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets angle velocity below which objects are at rest
+///
+/// \param _fAngleVelocity Angle velocity threshold
+///
+///////////////////////////////////////////////////////////////////////////////
+void CIslandManager::setAngleVelocityThreshold(const double& _fAngleVelocity)
+{
+    METHOD_ENTRY("CIslandManager::setAngleVelocityThreshold")
+
+    if (_fAngleVelocity < 0.0)
+    {
+        WARNING_MSG("Island Manager", "Threshold must not be negative.")
+        return;
+    }
+    m_fAngleVelocityThreshold = _fAngleVelocity;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets number of frames at rest before falling asleep
+///
+/// \param _nFrames Number of frames
+///
+///////////////////////////////////////////////////////////////////////////////
+void CIslandManager::setFrames(const int _nFrames)
+{
+    METHOD_ENTRY("CIslandManager::setFrames")
+
+    if (_nFrames < 1)
+    {
+        WARNING_MSG("Island Manager", "Number of frames at rest must be at least 1.")
+        return;
+    }
+    m_nFrames = _nFrames;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets velocity below which objects are at rest
+///
+/// \param _fVelocity Velocity threshold
+///
+///////////////////////////////////////////////////////////////////////////////
+void CIslandManager::setVelocityThreshold(const double& _fVelocity)
+{
+    METHOD_ENTRY("CIslandManager::setVelocityThreshold")
+
+    if (_fVelocity < 0.0)
+    {
+        WARNING_MSG("Island Manager", "Threshold must not be negative.")
+        return;
+    }
+    m_fVelocityThreshold = _fVelocity;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Updates rest of all objects, puts islands to sleep or wakes them
+///
+/// Has to be called after forces of the time step are reduced and before
+/// dynamics. Objects are identified by the dense index of the force
+/// accumulator. Objects without dynamics don't connect islands.
+///
+/// \param _Forces Force accumulator, initialised for current time step
+/// \param _Joints Joints connecting objects to islands
+///
+///////////////////////////////////////////////////////////////////////////////
+void CIslandManager::update(const CForceAccumulator& _Forces, const std::list<IJoint*>& _Joints)
+{
+    METHOD_ENTRY("CIslandManager::update")
+
+    const int nSize = _Forces.size();
+    m_nNumberOfSleeping = 0;
+
+    if (!m_bEnabled)
+    {
+        for (auto i=0; i<nSize; ++i)
+        {
+            if (_Forces.getObject(i)->isSleeping()) _Forces.getObject(i)->wake();
+        }
+        m_nNumberOfIslands = nSize;
+        return;
+    }
+
+    // Connect objects to islands
+    m_Parents.resize(nSize);
+    std::iota(m_Parents.begin(), m_Parents.end(), 0);
+    for (const auto pJoint : _Joints)
+    {
+        const CObject* const pA = pJoint->getObjectA();
+        const CObject* const pB = pJoint->getObjectB();
+        if (pA->getForceIndex() != -1 && pB->getForceIndex() != -1 &&
+            pA->getDynamicsState() && pB->getDynamicsState())
+        {
+            this->unite(pA->getForceIndex(), pB->getForceIndex());
+        }
+    }
+
+    // Islands rest as long as their least resting object
+    m_RestFrames.assign(nSize, std::numeric_limits<int>::max());
+    m_nNumberOfIslands = 0;
+    for (auto i=0; i<nSize; ++i)
+    {
+        CObject* const pObj = _Forces.getObject(i);
+        pObj->updateRest(m_fVelocityThreshold, m_fAngleVelocityThreshold, m_fAccelerationThreshold);
+
+        const int nRoot = this->find(i);
+        if (nRoot == i) ++m_nNumberOfIslands;
+        if (!pObj->isSleeping())
+            m_RestFrames[nRoot] = std::min(m_RestFrames[nRoot], pObj->getRestFrames());
+    }
+
+    for (auto i=0; i<nSize; ++i)
+    {
+        CObject* const pObj = _Forces.getObject(i);
+        if (!pObj->getDynamicsState()) continue;
+
+        if (m_RestFrames[this->find(i)] >= m_nFrames)
+        {
+            pObj->sleep();
+            ++m_nNumberOfSleeping;
+        }
+        else if (pObj->isSleeping())
+        {
+            pObj->wake();
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Wakes sleeping objects close to moving objects
+///
+/// Moving objects, i.e. objects not at rest, wake sleeping candidates of the
+/// broad phase. Islands follow with the next update.
+///
+/// \param _Pairs Candidate pairs of broad phase
+///
+///////////////////////////////////////////////////////////////////////////////
+void CIslandManager::wakeContacts(const BroadPhasePairsType& _Pairs)
+{
+    METHOD_ENTRY("CIslandManager::wakeContacts")
+
+    for (const auto& Pair : _Pairs)
+    {
+        CObject* const pA = Pair.first;
+        CObject* const pB = Pair.second;
+        if (pA->isSleeping() && !pB->isSleeping() && pB->getDynamicsState() && pB->getRestFrames() == 0)
+            pA->wake();
+        else if (pB->isSleeping() && !pA->isSleeping() && pA->getDynamicsState() && pA->getRestFrames() == 0)
+            pB->wake();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns root of island of given object, compressing the path
+///
+/// \param _nIndex Dense index of object
+///
+/// \return Dense index of root
+///
+///////////////////////////////////////////////////////////////////////////////
+int CIslandManager::find(int _nIndex)
+{
+    METHOD_ENTRY("CIslandManager::find")
+
+    while (m_Parents[_nIndex] != _nIndex)
+    {
+        m_Parents[_nIndex] = m_Parents[m_Parents[_nIndex]];
+        _nIndex = m_Parents[_nIndex];
+    }
+    return _nIndex;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Unites islands of given objects
+///
+/// \param _nA Dense index of first object
+/// \param _nB Dense index of second object
+///
+///////////////////////////////////////////////////////////////////////////////
+void CIslandManager::unite(const int _nA, const int _nB)
+{
+    METHOD_ENTRY("CIslandManager::unite")
+
+    const int nRootA = this->find(_nA);
+    const int nRootB = this->find(_nB);
+    if (nRootA < nRootB)
+        m_Parents[nRootB] = nRootA;
+    else if (nRootB < nRootA)
+        m_Parents[nRootA] = nRootB;
+}
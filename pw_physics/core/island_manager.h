@@ -0,0 +1,227 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       island_manager.h
+/// \brief      Prototype of class "CIslandManager"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ISLAND_MANAGER_H
+#define ISLAND_MANAGER_H
+
+//--- Standard header --------------------------------------------------------//
+#include <list>
+#include <vector>
+
+//--- Program header ---------------------------------------------------------//
+#include "broad_phase.h"
+#include "force_accumulator.h"
+#include "joint.h"
+
+//--- Constants --------------------------------------------------------------//
+const double ISLAND_MANAGER_DEFAULT_ACCELERATION_THRESHOLD   = 1.0e-3; ///< Default acceleration and its change below which objects rest, linear and angular
+const double ISLAND_MANAGER_DEFAULT_ANGLE_VELOCITY_THRESHOLD = 1.0e-2; ///< Default angle velocity below which objects are at rest
+const int    ISLAND_MANAGER_DEFAULT_FRAMES                   = 60;     ///< Default number of frames at rest before falling asleep
+const double ISLAND_MANAGER_DEFAULT_VELOCITY_THRESHOLD       = 1.0e-2; ///< Default velocity below which objects are at rest
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Puts resting objects to sleep and wakes them, grouped in islands
+///
+/// Objects are at rest if velocity and angle velocity stay below their
+/// thresholds while forces don't change and hardly accelerate them. Joints connect objects to islands,
+/// which fall asleep if all of their objects rested for a given number of
+/// frames, and wake up together if one of their objects is woken. Sleeping
+/// objects are parked in the kinematics store and skipped by dynamics.
+///
+/// Objects are woken if forces acting on them change, e.g. by thrusters or
+/// gravitation, if their state is set, or if a moving object comes close
+/// as indicated by the broad phase.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CIslandManager
+{
+
+    public:
+
+        //--- Constructor/Destructor -----------------------------------------//
+        CIslandManager();
+
+        //--- Constant Methods -----------------------------------------------//
+        const double&   getAccelerationThreshold() const;
+        const double&   getAngleVelocityThreshold() const;
+        const int&      getFrames() const;
+        const int&      getNumberOfIslands() const;
+        const int&      getNumberOfSleeping() const;
+        const double&   getVelocityThreshold() const;
+        bool            isEnabled() const;
+
+        //--- Methods --------------------------------------------------------//
+        void disable();
+        void enable();
+        void setAccelerationThreshold(const double&);
+        void setAngleVelocityThreshold(const double&);
+        void setFrames(const int);
+        void setVelocityThreshold(const double&);
+        void update(const CForceAccumulator&, const std::list<IJoint*>&);
+        void wakeContacts(const BroadPhasePairsType&);
+
+    private:
+
+        //--- Methods [private] ----------------------------------------------//
+        int  find(int);
+        void unite(const int, const int);
+
+        //--- Variables [private] --------------------------------------------//
+        std::vector<int>    m_Parents;                  ///< Parents of objects by dense index, forming islands
+        std::vector<int>    m_RestFrames;               ///< Minimum frames at rest of awake objects per island root
+
+        double  m_fAccelerationThreshold;   ///< Acceleration and its change below which objects rest, linear and angular
+        double  m_fAngleVelocityThreshold;  ///< Angle velocity below which objects are at rest
+        double  m_fVelocityThreshold;       ///< Velocity below which objects are at rest
+        int     m_nFrames;                  ///< Number of frames at rest before falling asleep
+        int     m_nNumberOfIslands;         ///< Number of islands of last update
+        int     m_nNumberOfSleeping;        ///< Number of sleeping objects after last update
+        bool    m_bEnabled;                 ///< Indicates if objects may fall asleep
+};
+
+//--- Implementation is done here for inline optimisation --------------------//
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns change of acceleration waking objects
+///
+/// \return Change of acceleration, linear and angular
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const double& CIslandManager::getAccelerationThreshold() const
+{
+    METHOD_ENTRY("CIslandManager::getAccelerationThreshold")
+    return m_fAccelerationThreshold;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns angle velocity below which objects are at rest
+///
+/// \return Angle velocity threshold
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const double& CIslandManager::getAngleVelocityThreshold() const
+{
+    METHOD_ENTRY("CIslandManager::getAngleVelocityThreshold")
+    return m_fAngleVelocityThreshold;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of frames at rest before falling asleep
+///
+/// \return Number of frames
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const int& CIslandManager::getFrames() const
+{
+    METHOD_ENTRY("CIslandManager::getFrames")
+    return m_nFrames;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of islands of last update
+///
+/// Objects not connected by joints form an island on their own.
+///
+/// \return Number of islands
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const int& CIslandManager::getNumberOfIslands() const
+{
+    METHOD_ENTRY("CIslandManager::getNumberOfIslands")
+    return m_nNumberOfIslands;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of sleeping objects after last update
+///
+/// \return Number of sleeping objects
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const int& CIslandManager::getNumberOfSleeping() const
+{
+    METHOD_ENTRY("CIslandManager::getNumberOfSleeping")
+    return m_nNumberOfSleeping;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns velocity below which objects are at rest
+///
+/// \return Velocity threshold
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const double& CIslandManager::getVelocityThreshold() const
+{
+    METHOD_ENTRY("CIslandManager::getVelocityThreshold")
+    return m_fVelocityThreshold;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns if objects may fall asleep
+///
+/// \return Sleeping enabled?
+///
+////////////////////////////////////////////////////////////////////////////////
+inline bool CIslandManager::isEnabled() const
+{
+    METHOD_ENTRY("CIslandManager::isEnabled")
+    return m_bEnabled;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Disables sleeping, sleeping objects are woken with next update
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CIslandManager::disable()
+{
+    METHOD_ENTRY("CIslandManager::disable")
+    m_bEnabled = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Enables sleeping of resting objects
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CIslandManager::enable()
+{
+    METHOD_ENTRY("CIslandManager::enable")
+    m_bEnabled = true;
+}
+
+#endif // ISLAND_MANAGER_H
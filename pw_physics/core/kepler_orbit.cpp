@@ -0,0 +1,181 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       kepler_orbit.cpp
+/// \brief      Implementation of class "CKeplerOrbit"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "kepler_orbit.h"
+
+//--- Standard header --------------------------------------------------------//
+#include <algorithm>
+#include <cmath>
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Constructor
+///
+///////////////////////////////////////////////////////////////////////////////
+CKeplerOrbit::CKeplerOrbit() : m_vecPosition0(Vector2d::Zero()),
+                               m_vecVelocity0(Vector2d::Zero()),
+                               m_vecPosition(Vector2d::Zero()),
+                               m_vecVelocity(Vector2d::Zero()),
+                               m_fGM(0.0),
+                               m_fAlpha(0.0),
+                               m_fChi(0.0),
+                               m_fPeriod(0.0),
+                               m_fTime(0.0)
+{
+    METHOD_ENTRY("CKeplerOrbit::CKeplerOrbit")
+    CTOR_CALL("CKeplerOrbit::CKeplerOrbit")
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Initialises orbit, current time becomes epoch
+///
+/// \param _vecPosition Position relative to central body
+/// \param _vecVelocity Velocity relative to central body
+/// \param _fGM Gravitational constant times mass of central body
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKeplerOrbit::init(const Vector2d& _vecPosition, const Vector2d& _vecVelocity, const double& _fGM)
+{
+    METHOD_ENTRY("CKeplerOrbit::init")
+
+    m_vecPosition0 = _vecPosition;
+    m_vecVelocity0 = _vecVelocity;
+    m_vecPosition = _vecPosition;
+    m_vecVelocity = _vecVelocity;
+    m_fGM = _fGM;
+    m_fChi = 0.0;
+    m_fTime = 0.0;
+
+    m_fAlpha = 2.0/_vecPosition.norm() - _vecVelocity.squaredNorm()/_fGM;
+    if (m_fAlpha > 0.0)
+        m_fPeriod = 2.0*M_PI / std::sqrt(_fGM*m_fAlpha*m_fAlpha*m_fAlpha);
+    else
+        m_fPeriod = 0.0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Advances orbit by given time and evaluates state
+///
+/// Kepler's equation is solved for the universal anomaly using Newton's
+/// method, starting from the anomaly of the last evaluation. Thus, few
+/// iterations are needed if the orbit is advanced frame by frame. State is
+/// given by Lagrange coefficients.
+///
+/// \param _fTime Time to advance
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKeplerOrbit::propagate(const double& _fTime)
+{
+    METHOD_ENTRY("CKeplerOrbit::propagate")
+
+    const double fSqrtGM = std::sqrt(m_fGM);
+
+    // Initial guess of universal anomaly, advanced from current state. It
+    // changes by 2*pi*sqrt(a) per revolution of elliptic orbits.
+    double fChi = m_fChi + fSqrtGM * _fTime / m_vecPosition.norm();
+    m_fTime += _fTime;
+    if (m_fPeriod > 0.0)
+    {
+        const double fRevolutions = std::floor(m_fTime / m_fPeriod);
+        m_fTime -= fRevolutions * m_fPeriod;
+        fChi -= fRevolutions * 2.0*M_PI / std::sqrt(m_fAlpha);
+    }
+
+    const double fT = m_fTime;
+    const double fR0 = m_vecPosition0.norm();
+    const double fRV0 = m_vecPosition0.dot(m_vecVelocity0) / fSqrtGM;
+
+    double fC = 0.5;
+    double fS = 1.0/6.0;
+    for (auto i=0; i<KEPLER_ORBIT_MAX_ITERATIONS; ++i)
+    {
+        const double fChi2 = fChi*fChi;
+        const double fZ = m_fAlpha*fChi2;
+        stumpff(fZ, fC, fS);
+
+        const double fF  = fRV0*fChi2*fC + (1.0-m_fAlpha*fR0)*fChi2*fChi*fS + fR0*fChi - fSqrtGM*fT;
+        const double fDF = fRV0*fChi*(1.0-fZ*fS) + (1.0-m_fAlpha*fR0)*fChi2*fC + fR0;
+        const double fDelta = fF / fDF;
+        fChi -= fDelta;
+        if (std::abs(fDelta) <= KEPLER_ORBIT_PRECISION * std::max(1.0, std::abs(fChi))) break;
+    }
+
+    const double fChi2 = fChi*fChi;
+    const double fZ = m_fAlpha*fChi2;
+    stumpff(fZ, fC, fS);
+
+    const double fLF = 1.0 - fChi2/fR0*fC;
+    const double fLG = fT - fChi2*fChi*fS/fSqrtGM;
+    m_vecPosition = fLF*m_vecPosition0 + fLG*m_vecVelocity0;
+
+    const double fR = m_vecPosition.norm();
+    const double fLFDot = fSqrtGM/(fR*fR0) * fChi * (fZ*fS-1.0);
+    const double fLGDot = 1.0 - fChi2/fR*fC;
+    m_vecVelocity = fLFDot*m_vecPosition0 + fLGDot*m_vecVelocity0;
+    m_fChi = fChi;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Calculates Stumpff functions C(z) and S(z)
+///
+/// Series expansions are used close to 0 to avoid cancellation.
+///
+/// \param _fZ Argument
+/// \param _fC Returns C(z)
+/// \param _fS Returns S(z)
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKeplerOrbit::stumpff(const double& _fZ, double& _fC, double& _fS)
+{
+    METHOD_ENTRY("CKeplerOrbit::stumpff")
+
+    if (_fZ > KEPLER_ORBIT_STUMPFF_SERIES)
+    {
+        const double fSqrtZ = std::sqrt(_fZ);
+        const double fSinHalf = std::sin(0.5*fSqrtZ);
+        _fC = 2.0*fSinHalf*fSinHalf / _fZ;
+        _fS = (fSqrtZ - std::sin(fSqrtZ)) / (fSqrtZ*_fZ);
+    }
+    else if (_fZ < -KEPLER_ORBIT_STUMPFF_SERIES)
+    {
+        const double fSqrtZ = std::sqrt(-_fZ);
+        const double fSinhHalf = std::sinh(0.5*fSqrtZ);
+        _fC = 2.0*fSinhHalf*fSinhHalf / (-_fZ);
+        _fS = (std::sinh(fSqrtZ) - fSqrtZ) / (fSqrtZ*(-_fZ));
+    }
+    else
+    {
+        _fC = 1.0/2.0 - _fZ*(1.0/24.0 - _fZ*(1.0/720.0 - _fZ*(1.0/40320.0 - _fZ/3628800.0)));
+        _fS = 1.0/6.0 - _fZ*(1.0/120.0 - _fZ*(1.0/5040.0 - _fZ*(1.0/362880.0 - _fZ/39916800.0)));
+    }
+}
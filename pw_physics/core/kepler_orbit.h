@@ -0,0 +1,162 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       kepler_orbit.h
+/// \brief      Prototype of class "CKeplerOrbit"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef KEPLER_ORBIT_H
+#define KEPLER_ORBIT_H
+
+//--- Program header ---------------------------------------------------------//
+#include "log.h"
+
+//--- Misc header ------------------------------------------------------------//
+#include <eigen3/Eigen/Core>
+
+using namespace Eigen;
+
+//--- Constants --------------------------------------------------------------//
+const int    KEPLER_ORBIT_MAX_ITERATIONS = 50;      ///< Maximum number of Newton iterations solving Kepler's equation
+const double KEPLER_ORBIT_PRECISION      = 1.0e-13; ///< Relative precision of universal anomaly
+const double KEPLER_ORBIT_STUMPFF_SERIES = 1.0e-2;  ///< Stumpff functions are expanded in series below this argument
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Conic orbit around a point mass, evaluated in closed form
+///
+/// The orbit is defined by position and velocity relative to the central
+/// body at epoch. State at any time since epoch is calculated by solving
+/// Kepler's equation in its universal formulation, hence, elliptic,
+/// parabolic and hyperbolic orbits are covered alike. Elliptic orbits wrap
+/// the time since epoch at their period to keep precision over many
+/// revolutions.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CKeplerOrbit
+{
+
+    public:
+
+        //--- Constructor/Destructor -----------------------------------------//
+        CKeplerOrbit();
+
+        //--- Constant Methods -----------------------------------------------//
+        const double&   getGM() const;
+        const double&   getPeriod() const;
+        const Vector2d& getPosition() const;
+        const double&   getTime() const;
+        const Vector2d& getVelocity() const;
+
+        //--- Methods --------------------------------------------------------//
+        void init(const Vector2d&, const Vector2d&, const double&);
+        void propagate(const double&);
+
+    private:
+
+        //--- Methods [private] ----------------------------------------------//
+        static void stumpff(const double&, double&, double&);
+
+        //--- Variables [private] --------------------------------------------//
+        Vector2d    m_vecPosition0;     ///< Relative position at epoch
+        Vector2d    m_vecVelocity0;     ///< Relative velocity at epoch
+        Vector2d    m_vecPosition;      ///< Relative position at current time
+        Vector2d    m_vecVelocity;      ///< Relative velocity at current time
+        double      m_fGM;              ///< Gravitational constant times mass of central body
+        double      m_fAlpha;           ///< Reciprocal of semi-major axis
+        double      m_fChi;             ///< Universal anomaly at current time, initial guess for next one
+        double      m_fPeriod;          ///< Period of elliptic orbits, 0 otherwise
+        double      m_fTime;            ///< Time since epoch
+};
+
+//--- Implementation is done here for inline optimisation --------------------//
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns gravitational constant times mass of central body
+///
+/// \return Gravitational parameter
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const double& CKeplerOrbit::getGM() const
+{
+    METHOD_ENTRY("CKeplerOrbit::getGM")
+    return m_fGM;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns period of orbit
+///
+/// \return Period, 0 if orbit isn't elliptic
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const double& CKeplerOrbit::getPeriod() const
+{
+    METHOD_ENTRY("CKeplerOrbit::getPeriod")
+    return m_fPeriod;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns position relative to central body at current time
+///
+/// \return Relative position
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const Vector2d& CKeplerOrbit::getPosition() const
+{
+    METHOD_ENTRY("CKeplerOrbit::getPosition")
+    return m_vecPosition;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns time since epoch
+///
+/// \return Time since epoch, wrapped at period for elliptic orbits
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const double& CKeplerOrbit::getTime() const
+{
+    METHOD_ENTRY("CKeplerOrbit::getTime")
+    return m_fTime;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns velocity relative to central body at current time
+///
+/// \return Relative velocity
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const Vector2d& CKeplerOrbit::getVelocity() const
+{
+    METHOD_ENTRY("CKeplerOrbit::getVelocity")
+    return m_vecVelocity;
+}
+
+#endif // KEPLER_ORBIT_H
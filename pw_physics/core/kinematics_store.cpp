@@ -0,0 +1,784 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       kinematics_store.cpp
+/// \brief      Implementation of class "CKinematicsStore"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-16
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "kinematics_store.h"
+
+//--- Standard header --------------------------------------------------------//
+#include <cmath>
+#include <utility>
+
+//--- Program header ---------------------------------------------------------//
+#include "grid_user.h"
+#include "object.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Constructor
+///
+///////////////////////////////////////////////////////////////////////////////
+CKinematicsStore::CKinematicsStore() : m_nRejectedSteps(0),
+                                       m_nSubSteps(0),
+                                       m_nSubStepsMax(0),
+                                       m_fRailsThreshold(KINEMATICS_STORE_DEFAULT_RAILS_THRESHOLD),
+                                       m_bRails(false)
+{
+    METHOD_ENTRY("CKinematicsStore::CKinematicsStore")
+    CTOR_CALL("CKinematicsStore::CKinematicsStore")
+
+    m_GroupEnds.fill(0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Destructor
+///
+/// Objects still bound fall back to their own members.
+///
+///////////////////////////////////////////////////////////////////////////////
+CKinematicsStore::~CKinematicsStore()
+{
+    METHOD_ENTRY("CKinematicsStore::~CKinematicsStore")
+    DTOR_CALL("CKinematicsStore::~CKinematicsStore")
+
+    for (auto pObj : m_Objects)
+    {
+        pObj->m_pKinematicsStore = nullptr;
+        pObj->m_nKinematicsSlot = -1;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Binds given object to a new slot
+///
+/// The slot is initialised with the current state of the object and put
+/// into the group of its integrator type.
+///
+/// \param _pObj Object to bind
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKinematicsStore::add(CObject* const _pObj)
+{
+    METHOD_ENTRY("CKinematicsStore::add")
+
+    if (_pObj->m_pKinematicsStore != nullptr)
+    {
+        WARNING_MSG("Kinematics Store", "Object " << _pObj->getName() << " already bound to a kinematics store.")
+        return;
+    }
+
+    m_Objects.push_back(_pObj);
+    m_Positions.push_back(_pObj->m_pIntPos->getValue());
+    m_Velocities.push_back(_pObj->m_pIntVel->getValue());
+    m_Angles.push_back(_pObj->m_pIntAng->getValue());
+    m_AngleVelocities.push_back(_pObj->m_pIntAngVel->getValue());
+    m_Forces.push_back(_pObj->m_vecForce);
+    m_Torques.push_back(_pObj->m_fTorque);
+    m_Masses.push_back(_pObj->m_Geometry.getMass());
+    m_Inertias.push_back(_pObj->m_Geometry.getInertia());
+    m_TimeFacs.push_back(_pObj->m_fTimeFac);
+    m_Accelerations.emplace_back();
+    m_AngleAccelerations.emplace_back();
+    m_StepSizes.push_back(0.0);
+    m_Rails.push_back({nullptr, CKeplerOrbit(), false, false});
+    for (auto i=0; i<BATCH_INTEGRATOR_HISTORY_DEPTH; ++i)
+    {
+        m_PositionHistory[i].push_back(Vector2d::Zero());
+        m_VelocityHistory[i].push_back(Vector2d::Zero());
+        m_AngleHistory[i].push_back(0.0);
+        m_AngleVelocityHistory[i].push_back(0.0);
+    }
+
+    const int nSlot = m_Objects.size()-1;
+    _pObj->m_pKinematicsStore = this;
+    _pObj->m_nKinematicsSlot = nSlot;
+
+    if (_pObj->m_bDynamics && !_pObj->m_bSleeping) this->setGroup(nSlot, _pObj->m_IntegratorType);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adds an attractor for adaptive integration of current time step
+///
+/// State of the attractor is taken from given object at the time of adding,
+/// thus, attractors are frozen within the time step. Forces acting on the
+/// attractor have to be accumulated before, they are needed to measure the
+/// perturbation of slots on rails.
+///
+/// \param _pObj Gravitating object
+/// \param _fGM Gravitational constant times mass of object
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKinematicsStore::addAttractor(CObject* const _pObj, const double& _fGM)
+{
+    METHOD_ENTRY("CKinematicsStore::addAttractor")
+
+    Vector2d vecAccel = _pObj->getForce();
+    if (_pObj->getMass() > 0.0) vecAccel /= _pObj->getMass();
+
+    m_Attractors.push_back({_pObj, _pObj->getCOM(), _pObj->getCell(), _pObj->getVelocity(), vecAccel, _fGM});
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Removes all attractors
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKinematicsStore::clearAttractors()
+{
+    METHOD_ENTRY("CKinematicsStore::clearAttractors")
+
+    m_Attractors.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Disables rails, slots on rails drop back to their integrators
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKinematicsStore::disableRails()
+{
+    METHOD_ENTRY("CKinematicsStore::disableRails")
+
+    m_bRails = false;
+    this->updateRails();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Enables rails, slots may go on rails with next update
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKinematicsStore::enableRails()
+{
+    METHOD_ENTRY("CKinematicsStore::enableRails")
+
+    m_bRails = true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets angle of given slot, resetting its history
+///
+/// \param _nSlot Slot
+/// \param _fAngle Angle
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKinematicsStore::initAngle(const int _nSlot, const double& _fAngle)
+{
+    METHOD_ENTRY("CKinematicsStore::initAngle")
+
+    m_Angles[_nSlot] = _fAngle;
+    for (auto& History : m_AngleHistory) History[_nSlot] = 0.0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets angle velocity of given slot, resetting its history
+///
+/// \param _nSlot Slot
+/// \param _fAngleVelocity Angle velocity
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKinematicsStore::initAngleVelocity(const int _nSlot, const double& _fAngleVelocity)
+{
+    METHOD_ENTRY("CKinematicsStore::initAngleVelocity")
+
+    m_AngleVelocities[_nSlot] = _fAngleVelocity;
+    for (auto& History : m_AngleVelocityHistory) History[_nSlot] = 0.0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets position of given slot, resetting its history and sub-step size
+///
+/// Slots on rails drop back to their integrator, thus, the slot might change.
+///
+/// \param _nSlot Slot
+/// \param _vecPosition Position (center of mass, local to cell)
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKinematicsStore::initPosition(const int _nSlot, const Vector2d& _vecPosition)
+{
+    METHOD_ENTRY("CKinematicsStore::initPosition")
+
+    m_Positions[_nSlot] = _vecPosition;
+    m_StepSizes[_nSlot] = 0.0;
+    for (auto& History : m_PositionHistory) History[_nSlot].setZero();
+
+    // State was set from outside, conic doesn't hold anymore
+    if (this->getGroup(_nSlot) == KINEMATICS_STORE_GROUP_RAILS)
+        this->setGroup(_nSlot, m_Objects[_nSlot]->m_IntegratorType);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets velocity of given slot, resetting its history and sub-step size
+///
+/// Slots on rails drop back to their integrator, thus, the slot might change.
+///
+/// \param _nSlot Slot
+/// \param _vecVelocity Velocity
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKinematicsStore::initVelocity(const int _nSlot, const Vector2d& _vecVelocity)
+{
+    METHOD_ENTRY("CKinematicsStore::initVelocity")
+
+    m_Velocities[_nSlot] = _vecVelocity;
+    m_StepSizes[_nSlot] = 0.0;
+    for (auto& History : m_VelocityHistory) History[_nSlot].setZero();
+
+    // State was set from outside, conic doesn't hold anymore
+    if (this->getGroup(_nSlot) == KINEMATICS_STORE_GROUP_RAILS)
+        this->setGroup(_nSlot, m_Objects[_nSlot]->m_IntegratorType);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Integrates all slots of integrated groups
+///
+/// Accelerations are calculated for all groups at once, afterwards each
+/// group is integrated by its own kernels. The adaptive group counts its
+/// sub-steps. Slots on rails are propagated last, since they follow their
+/// attractors.
+///
+/// \param _fTimeStep Time between two frames
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKinematicsStore::integrate(const double& _fTimeStep)
+{
+    METHOD_ENTRY("CKinematicsStore::integrate")
+
+    const int nSize = m_GroupEnds.back();
+
+    for (auto i=0; i<nSize; ++i)
+    {
+        m_Accelerations[i] = m_Forces[i];
+        if (m_Masses[i] > 0.0) m_Accelerations[i] /= m_Masses[i];
+
+        m_AngleAccelerations[i] = m_Torques[i];
+        if (m_Inertias[i] > 0.0) m_AngleAccelerations[i] /= m_Inertias[i];
+    }
+
+    this->integrateGroup<INTEGRATOR_EULER>(_fTimeStep, 0, m_GroupEnds[INTEGRATOR_EULER]);
+    this->integrateGroup<INTEGRATOR_ADAMS_BASHFORTH>(_fTimeStep, m_GroupEnds[INTEGRATOR_ADAMS_BASHFORTH-1],
+                                                                 m_GroupEnds[INTEGRATOR_ADAMS_BASHFORTH]);
+    this->integrateGroup<INTEGRATOR_ADAMS_MOULTON>(_fTimeStep, m_GroupEnds[INTEGRATOR_ADAMS_MOULTON-1],
+                                                               m_GroupEnds[INTEGRATOR_ADAMS_MOULTON]);
+    this->integrateAdaptive(_fTimeStep, m_GroupEnds[INTEGRATOR_DORMAND_PRINCE-1],
+                                        m_GroupEnds[INTEGRATOR_DORMAND_PRINCE]);
+    this->integrateRails(_fTimeStep, m_GroupEnds[KINEMATICS_STORE_GROUP_RAILS-1],
+                                     m_GroupEnds[KINEMATICS_STORE_GROUP_RAILS]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Marks given object as perturbed within current time step
+///
+/// Perturbed objects don't go on rails or drop back to their integrator with
+/// the next update of rails, e.g. if a thruster fires.
+///
+/// \param _pObj Object
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKinematicsStore::perturb(CObject* const _pObj)
+{
+    METHOD_ENTRY("CKinematicsStore::perturb")
+
+    if (_pObj->m_pKinematicsStore == this)
+        m_Rails[_pObj->m_nKinematicsSlot].bPerturbed = true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Unbinds object of given slot and removes the slot
+///
+/// The slot is moved to the end first, hence the slot of other objects
+/// might change.
+///
+/// \param _nSlot Slot to remove
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKinematicsStore::remove(const int _nSlot)
+{
+    METHOD_ENTRY("CKinematicsStore::remove")
+
+    CObject* const pObj = m_Objects[_nSlot];
+    this->setGroup(_nSlot, KINEMATICS_STORE_GROUP_STATIC);
+    this->swapSlots(pObj->m_nKinematicsSlot, m_Objects.size()-1);
+
+    m_Objects.back()->m_pKinematicsStore = nullptr;
+    m_Objects.back()->m_nKinematicsSlot = -1;
+
+    m_Objects.pop_back();
+    m_Positions.pop_back();
+    m_Velocities.pop_back();
+    m_Angles.pop_back();
+    m_AngleVelocities.pop_back();
+    m_Forces.pop_back();
+    m_Torques.pop_back();
+    m_Masses.pop_back();
+    m_Inertias.pop_back();
+    m_TimeFacs.pop_back();
+    m_Accelerations.pop_back();
+    m_AngleAccelerations.pop_back();
+    m_StepSizes.pop_back();
+    m_Rails.pop_back();
+    for (auto i=0; i<BATCH_INTEGRATOR_HISTORY_DEPTH; ++i)
+    {
+        m_PositionHistory[i].pop_back();
+        m_VelocityHistory[i].pop_back();
+        m_AngleHistory[i].pop_back();
+        m_AngleVelocityHistory[i].pop_back();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Moves given slot to given group
+///
+/// The slot is moved across group boundaries by swapping it with the
+/// boundary slots, thus it costs one swap per group passed.
+///
+/// \param _nSlot Slot
+/// \param _nGroup Group, i.e. integrator type or
+///                \ref KINEMATICS_STORE_GROUP_STATIC
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKinematicsStore::setGroup(const int _nSlot, const int _nGroup)
+{
+    METHOD_ENTRY("CKinematicsStore::setGroup")
+
+    int nSlot = _nSlot;
+    int nGroup = this->getGroup(_nSlot);
+
+    // Move backwards: Become first slot of next group
+    while (nGroup < _nGroup)
+    {
+        this->swapSlots(nSlot, m_GroupEnds[nGroup]-1);
+        nSlot = --m_GroupEnds[nGroup];
+        ++nGroup;
+    }
+    // Move forwards: Become last slot of previous group
+    while (nGroup > _nGroup)
+    {
+        const int nFirst = m_GroupEnds[nGroup-1];
+        this->swapSlots(nSlot, nFirst);
+        nSlot = nFirst;
+        ++m_GroupEnds[nGroup-1];
+        --nGroup;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets maximum number of sub-steps of adaptive slots per time step
+///
+/// \param _nMaxSubSteps Maximum number of sub-steps
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKinematicsStore::setMaxSubSteps(const int _nMaxSubSteps)
+{
+    METHOD_ENTRY("CKinematicsStore::setMaxSubSteps")
+
+    m_AdaptiveIntegrator.setMaxSubSteps(_nMaxSubSteps);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets perturbation threshold of slots on rails
+///
+/// \param _fThreshold Perturbation relative to field of dominant attractor
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKinematicsStore::setRailsThreshold(const double& _fThreshold)
+{
+    METHOD_ENTRY("CKinematicsStore::setRailsThreshold")
+
+    if (_fThreshold < 0.0)
+    {
+        WARNING_MSG("Kinematics Store", "Rails threshold must not be negative.")
+        return;
+    }
+    m_fRailsThreshold = _fThreshold;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets tolerances of local error of adaptive slots
+///
+/// \param _fToleranceRel Relative tolerance
+/// \param _fToleranceAbs Absolute tolerance
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKinematicsStore::setTolerance(const double& _fToleranceRel, const double& _fToleranceAbs)
+{
+    METHOD_ENTRY("CKinematicsStore::setTolerance")
+
+    m_AdaptiveIntegrator.setTolerance(_fToleranceRel, _fToleranceAbs);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Puts slots on rails or lets them drop back to their integrators
+///
+/// Has to be called after forces and attractors of the time step are known
+/// and before integration. Slots are only moved between groups after all of
+/// them have been checked, since moving changes slots.
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKinematicsStore::updateRails()
+{
+    METHOD_ENTRY("CKinematicsStore::updateRails")
+
+    m_RailsChanges.clear();
+
+    const int nFirstRails = m_GroupEnds[KINEMATICS_STORE_GROUP_RAILS-1];
+    const int nLastRails = m_GroupEnds[KINEMATICS_STORE_GROUP_RAILS];
+    const int nFirst = m_bRails ? 0 : nFirstRails;
+
+    // Slots on rails are always checked, they drop back if rails are disabled
+    for (auto i=nFirst; i<nLastRails; ++i)
+    {
+        const bool bOnRails = (i >= nFirstRails);
+        bool bRails = m_bRails && !m_Rails[i].bPerturbed && m_Masses[i] > 0.0;
+
+        Vector2d vecField;
+        const int nAttractor = bRails ? this->findDominantAttractor(i, vecField) : -1;
+        if (nAttractor < 0)
+        {
+            bRails = false;
+        }
+        else
+        {
+            const AttractorType& Attractor = m_Attractors[nAttractor];
+
+            // Perturbation relative to the frame of the attractor
+            const Vector2d vecPerturbation = m_Forces[i]/m_Masses[i] - vecField - Attractor.vecAccel;
+            bRails = vecPerturbation.norm() < m_fRailsThreshold * vecField.norm();
+
+            // Leaving sphere of influence of attractor ends conic
+            if (bOnRails && Attractor.pObj != m_Rails[i].pAttractor) bRails = false;
+
+            if (bRails && !bOnRails)
+            {
+                const Vector2d vecPosition = Attractor.vecPosition +
+                                             IGridUser::cellToDouble(Attractor.vecCell-m_Objects[i]->getCell());
+                m_Rails[i].pAttractor = Attractor.pObj;
+                m_Rails[i].Orbit.init(m_Positions[i]-vecPosition, m_Velocities[i]-Attractor.vecVelocity, Attractor.fGM);
+            }
+        }
+        if (bRails != bOnRails) m_RailsChanges.push_back(m_Objects[i]);
+    }
+
+    for (const auto pObj : m_RailsChanges)
+    {
+        const int nSlot = pObj->m_nKinematicsSlot;
+        if (this->getGroup(nSlot) == KINEMATICS_STORE_GROUP_RAILS)
+        {
+            this->setGroup(nSlot, pObj->m_IntegratorType);
+
+            // Integrator starts without history
+            const int nNewSlot = pObj->m_nKinematicsSlot;
+            m_StepSizes[nNewSlot] = 0.0;
+            for (auto i=0; i<BATCH_INTEGRATOR_HISTORY_DEPTH; ++i)
+            {
+                m_PositionHistory[i][nNewSlot].setZero();
+                m_VelocityHistory[i][nNewSlot].setZero();
+                m_AngleHistory[i][nNewSlot] = 0.0;
+                m_AngleVelocityHistory[i][nNewSlot] = 0.0;
+            }
+        }
+        else
+        {
+            this->setGroup(nSlot, KINEMATICS_STORE_GROUP_RAILS);
+        }
+    }
+    DOM_STATS(
+        if (!m_RailsChanges.empty())
+            DEBUG_MSG("Kinematics Store", m_RailsChanges.size() << " objects changed rails, " <<
+                                          this->getNumberOfRails() << " objects on rails")
+    )
+
+    for (auto& Rails : m_Rails) Rails.bPerturbed = false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Finds attractor with strongest field at given slot
+///
+/// \param _nSlot Slot
+/// \param _vecField Returns field of dominant attractor
+///
+/// \return Index of dominant attractor, -1 if there is none
+///
+///////////////////////////////////////////////////////////////////////////////
+int CKinematicsStore::findDominantAttractor(const int _nSlot, Vector2d& _vecField) const
+{
+    METHOD_ENTRY("CKinematicsStore::findDominantAttractor")
+
+    const Vector2i vecCell = m_Objects[_nSlot]->getCell();
+    int nDominant = -1;
+    double fFieldMax = 0.0;
+
+    for (auto i=0u; i<m_Attractors.size(); ++i)
+    {
+        const AttractorType& Attractor = m_Attractors[i];
+        if (Attractor.pObj == m_Objects[_nSlot]) continue;
+
+        const Vector2d vecD = Attractor.vecPosition + IGridUser::cellToDouble(Attractor.vecCell-vecCell) -
+                              m_Positions[_nSlot];
+        const double fDSqr = vecD.squaredNorm();
+        if (fDSqr > KINEMATICS_STORE_GRAVITY_MIN_DISTANCE_SQR && Attractor.fGM / fDSqr > fFieldMax)
+        {
+            fFieldMax = Attractor.fGM / fDSqr;
+            _vecField = vecD * (Attractor.fGM / (fDSqr*std::sqrt(fDSqr)));
+            nDominant = i;
+        }
+    }
+    return nDominant;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Integrates a range of slots adaptively
+///
+/// Every slot is sub-stepped until the end of the time step is reached.
+/// Acceleration within sub-steps is the gravitation of attractors at the
+/// intermediate position plus the remainder of the accumulated acceleration
+/// at the initial position. Torque is constant, thus, angles are integrated
+/// exactly in one step.
+///
+/// \param _fTimeStep Time between two frames
+/// \param _nFirst First slot
+/// \param _nLast Slot behind last slot
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKinematicsStore::integrateAdaptive(const double& _fTimeStep, const int _nFirst, const int _nLast)
+{
+    METHOD_ENTRY("CKinematicsStore::integrateAdaptive")
+
+    m_nRejectedSteps = 0;
+    m_nSubSteps = 0;
+    m_nSubStepsMax = 0;
+
+    const auto Field = [&](const Vector2d& _vecPos) -> Vector2d
+    {
+        Vector2d vecField = Vector2d::Zero();
+        for (const auto& Attractor : m_AttractorsLocal)
+        {
+            const Vector2d vecD = Attractor.vecPosition - _vecPos;
+            const double fDSqr = vecD.squaredNorm();
+            if (fDSqr > KINEMATICS_STORE_GRAVITY_MIN_DISTANCE_SQR)
+                vecField += vecD * (Attractor.fGM / (fDSqr*std::sqrt(fDSqr)));
+        }
+        return vecField;
+    };
+
+    for (auto i=_nFirst; i<_nLast; ++i)
+    {
+        // Attractors relative to cell of slot, an object doesn't attract itself
+        const Vector2i vecCell = m_Objects[i]->getCell();
+        m_AttractorsLocal.clear();
+        for (const auto& Attractor : m_Attractors)
+        {
+            if (Attractor.pObj == m_Objects[i]) continue;
+            m_AttractorsLocal.push_back({Attractor.pObj,
+                                         Attractor.vecPosition + IGridUser::cellToDouble(Attractor.vecCell-vecCell),
+                                         vecCell, Attractor.vecVelocity, Attractor.vecAccel, Attractor.fGM});
+        }
+
+        const double fStep = _fTimeStep*m_TimeFacs[i];
+        const Vector2d vecAccelConst = m_Accelerations[i] - Field(m_Positions[i]);
+
+        int nRejected = 0;
+        const int nSubSteps = m_AdaptiveIntegrator.integrate(m_Positions[i], m_Velocities[i], m_StepSizes[i], fStep,
+                                                             [&](const Vector2d& _vecPos) -> Vector2d
+                                                             {
+                                                                 return vecAccelConst + Field(_vecPos);
+                                                             }, nRejected);
+        m_nRejectedSteps += nRejected;
+        m_nSubSteps += nSubSteps;
+        if (nSubSteps > m_nSubStepsMax) m_nSubStepsMax = nSubSteps;
+
+        this->integrateAngle(i, fStep);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Integrates angle of given slot exactly for constant torque
+///
+/// \param _nSlot Slot
+/// \param _fStep Time step, multiplied by time factor
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKinematicsStore::integrateAngle(const int _nSlot, const double& _fStep)
+{
+    METHOD_ENTRY("CKinematicsStore::integrateAngle")
+
+    m_Angles[_nSlot] += (m_AngleVelocities[_nSlot] + 0.5*m_AngleAccelerations[_nSlot]*_fStep) * _fStep;
+    m_AngleVelocities[_nSlot] += m_AngleAccelerations[_nSlot] * _fStep;
+
+    int nF = floor(m_Angles[_nSlot] / (2.0*M_PI));
+    if (nF >= 1)
+        m_Angles[_nSlot] -= nF*2.0*M_PI;
+    else if (nF <= -2)
+        m_Angles[_nSlot] -= (nF+1)*2.0*M_PI;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Propagates a range of slots on rails
+///
+/// \param _fTimeStep Time between two frames
+/// \param _nFirst First slot
+/// \param _nLast Slot behind last slot
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKinematicsStore::integrateRails(const double& _fTimeStep, const int _nFirst, const int _nLast)
+{
+    METHOD_ENTRY("CKinematicsStore::integrateRails")
+
+    for (auto i=_nFirst; i<_nLast; ++i) m_Rails[i].bDone = false;
+    for (auto i=_nFirst; i<_nLast; ++i) this->propagateRails(i, _fTimeStep);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Propagates given slot on rails
+///
+/// The conic is evaluated relative to the attractor's state at the end of
+/// the time step. Attractors on rails are propagated first, hence, moons
+/// might follow planets on rails.
+///
+/// \param _nSlot Slot
+/// \param _fTimeStep Time between two frames
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKinematicsStore::propagateRails(const int _nSlot, const double& _fTimeStep)
+{
+    METHOD_ENTRY("CKinematicsStore::propagateRails")
+
+    RailsType& Rails = m_Rails[_nSlot];
+    if (Rails.bDone) return;
+    Rails.bDone = true;
+
+    const CObject* const pAttractor = Rails.pAttractor;
+    Vector2d vecPosition;
+    Vector2d vecVelocity;
+    if (pAttractor->m_pKinematicsStore == this)
+    {
+        const int nSlotAttractor = pAttractor->m_nKinematicsSlot;
+        if (this->getGroup(nSlotAttractor) == KINEMATICS_STORE_GROUP_RAILS)
+            this->propagateRails(nSlotAttractor, _fTimeStep);
+        vecPosition = m_Positions[nSlotAttractor];
+        vecVelocity = m_Velocities[nSlotAttractor];
+    }
+    else
+    {
+        vecPosition = pAttractor->getCOM();
+        vecVelocity = pAttractor->getVelocity();
+    }
+
+    const double fStep = _fTimeStep*m_TimeFacs[_nSlot];
+    Rails.Orbit.propagate(fStep);
+    m_Positions[_nSlot] = vecPosition + IGridUser::cellToDouble(pAttractor->getCell()-m_Objects[_nSlot]->getCell()) +
+                          Rails.Orbit.getPosition();
+    m_Velocities[_nSlot] = vecVelocity + Rails.Orbit.getVelocity();
+
+    this->integrateAngle(_nSlot, fStep);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Integrates a range of slots using given integrator type
+///
+/// Velocity is integrated first, position is integrated using the new
+/// velocity, just like \ref CObject::dynamics does.
+///
+/// \param _fTimeStep Time between two frames
+/// \param _nFirst First slot
+/// \param _nLast Slot behind last slot
+///
+///////////////////////////////////////////////////////////////////////////////
+template <IntegratorType TIntegrator>
+void CKinematicsStore::integrateGroup(const double& _fTimeStep, const int _nFirst, const int _nLast)
+{
+    METHOD_ENTRY("CKinematicsStore::integrateGroup")
+
+    CBatchIntegrator<TIntegrator, Vector2d>::integrate(m_Velocities, m_VelocityHistory, m_Accelerations,
+                                                       m_TimeFacs, _fTimeStep, _nFirst, _nLast);
+    CBatchIntegrator<TIntegrator, Vector2d>::integrate(m_Positions, m_PositionHistory, m_Velocities,
+                                                       m_TimeFacs, _fTimeStep, _nFirst, _nLast);
+    CBatchIntegrator<TIntegrator, double>::integrate(m_AngleVelocities, m_AngleVelocityHistory, m_AngleAccelerations,
+                                                     m_TimeFacs, _fTimeStep, _nFirst, _nLast);
+    CBatchIntegrator<TIntegrator, double>::integrateClip(m_Angles, m_AngleHistory, m_AngleVelocities,
+                                                         m_TimeFacs, _fTimeStep, _nFirst, _nLast, 2.0*M_PI);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Swaps two slots, updating their owners
+///
+/// \param _nA First slot
+/// \param _nB Second slot
+///
+///////////////////////////////////////////////////////////////////////////////
+void CKinematicsStore::swapSlots(const int _nA, const int _nB)
+{
+    METHOD_ENTRY("CKinematicsStore::swapSlots")
+
+    if (_nA == _nB) return;
+
+    std::swap(m_Objects[_nA], m_Objects[_nB]);
+    std::swap(m_Positions[_nA], m_Positions[_nB]);
+    std::swap(m_Velocities[_nA], m_Velocities[_nB]);
+    std::swap(m_Angles[_nA], m_Angles[_nB]);
+    std::swap(m_AngleVelocities[_nA], m_AngleVelocities[_nB]);
+    std::swap(m_Forces[_nA], m_Forces[_nB]);
+    std::swap(m_Torques[_nA], m_Torques[_nB]);
+    std::swap(m_Masses[_nA], m_Masses[_nB]);
+    std::swap(m_Inertias[_nA], m_Inertias[_nB]);
+    std::swap(m_TimeFacs[_nA], m_TimeFacs[_nB]);
+    std::swap(m_StepSizes[_nA], m_StepSizes[_nB]);
+    std::swap(m_Rails[_nA], m_Rails[_nB]);
+    for (auto i=0; i<BATCH_INTEGRATOR_HISTORY_DEPTH; ++i)
+    {
+        std::swap(m_PositionHistory[i][_nA], m_PositionHistory[i][_nB]);
+        std::swap(m_VelocityHistory[i][_nA], m_VelocityHistory[i][_nB]);
+        std::swap(m_AngleHistory[i][_nA], m_AngleHistory[i][_nB]);
+        std::swap(m_AngleVelocityHistory[i][_nA], m_AngleVelocityHistory[i][_nB]);
+    }
+
+    m_Objects[_nA]->m_nKinematicsSlot = _nA;
+    m_Objects[_nB]->m_nKinematicsSlot = _nB;
+}
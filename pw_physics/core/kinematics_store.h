@@ -0,0 +1,520 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       kinematics_store.h
+/// \brief      Prototype of class "CKinematicsStore"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-16
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef KINEMATICS_STORE_H
+#define KINEMATICS_STORE_H
+
+//--- Standard header --------------------------------------------------------//
+#include <array>
+#include <vector>
+
+//--- Program header ---------------------------------------------------------//
+#include "batch_integrator.h"
+#include "dormand_prince_integrator.h"
+#include "kepler_orbit.h"
+#include "log.h"
+
+//--- Misc header ------------------------------------------------------------//
+#include <eigen3/Eigen/Core>
+
+using namespace Eigen;
+
+//--- Constants --------------------------------------------------------------//
+const int KINEMATICS_STORE_GROUP_RAILS       = INTEGRATOR_NONE;                    ///< Group of slots on rails, behind groups of integrator types
+const int KINEMATICS_STORE_INTEGRATED_GROUPS = KINEMATICS_STORE_GROUP_RAILS+1;     ///< Number of integrated groups, one per integrator type and rails
+const int KINEMATICS_STORE_GROUP_STATIC      = KINEMATICS_STORE_INTEGRATED_GROUPS; ///< Group of slots that are not integrated
+
+const double KINEMATICS_STORE_GRAVITY_MIN_DISTANCE_SQR  = 400.0;  ///< Squared distance below which attractors don't act, as in pairwise gravitation
+const double KINEMATICS_STORE_DEFAULT_RAILS_THRESHOLD   = 1.0e-5; ///< Default perturbation relative to dominant attractor for slots on rails
+
+//--- Forward declarations ---------------------------------------------------//
+class CObject;
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Dense structure of arrays holding the kinematics of objects
+///
+/// Every object bound to the store owns a slot. Position (center of mass,
+/// local to cell), velocity, angle, angle velocity, force, torque, mass,
+/// inertia and time factor are stored in separate contiguous arrays, the
+/// accessors of \ref CObject are views into these arrays.
+///
+/// Slots are grouped by integrator type, the group index equals the
+/// \ref IntegratorType. Objects with dynamics disabled form the last,
+/// static group. Each integrated group is stepped by \ref CBatchIntegrator
+/// kernels in one linear sweep instead of a walk through a hash map with
+/// virtual integrator calls. The derivative history needed by multistep
+/// integrators is stored alongside. Slots are swapped when objects change
+/// their group or are removed, hence slot indices are not stable.
+///
+/// The group of \ref INTEGRATOR_DORMAND_PRINCE is integrated adaptively.
+/// Each slot is divided into as many sub-steps as its error control demands
+/// to reach the end of the time step. Within sub-steps, gravitation of all
+/// attractors, i.e. gravitating objects frozen at the beginning of the time
+/// step, is evaluated at the intermediate positions. All other forces, like
+/// thrust, joints or constant gravity, are kept constant. Hence, orbits stay
+/// accurate at high time acceleration without increasing the frequency of
+/// the physics thread.
+///
+/// If rails are enabled, slots following a conic around their dominant
+/// attractor are put on rails: Their state is evaluated in closed form by
+/// \ref CKeplerOrbit relative to the attractor instead of being integrated.
+/// The dominant attractor is the one with the strongest field at the slot,
+/// approximating the sphere of influence of patched conics. Perturbation is
+/// the acceleration of the slot relative to the attractor, less the field
+/// of the attractor itself. Slots drop back to their integrator when they
+/// are perturbed, e.g. by thrusters, when perturbation exceeds a threshold,
+/// when their dominant attractor changes, or when their state is set.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CKinematicsStore
+{
+
+    public:
+
+        //--- Constructor/Destructor -----------------------------------------//
+        CKinematicsStore();
+        ~CKinematicsStore();
+
+        //--- Constant Methods -----------------------------------------------//
+        const CDormandPrinceIntegrator<Vector2d>& getAdaptiveIntegrator() const;
+        const double&   getAngle(const int) const;
+        const double&   getAngleVelocity(const int) const;
+        const Vector2d& getForce(const int) const;
+        const double&   getInertia(const int) const;
+        int             getGroup(const int) const;
+        const double&   getMass(const int) const;
+        int             getNumberOfAdaptive() const;
+        int             getNumberOfIntegrated() const;
+        int             getNumberOfRails() const;
+        const int&      getNumberOfRejectedSteps() const;
+        const int&      getNumberOfSubSteps() const;
+        const int&      getNumberOfSubStepsMax() const;
+        CObject*        getObject(const int) const;
+        const Vector2d& getPosition(const int) const;
+        const double&   getRailsThreshold() const;
+        const double&   getTorque(const int) const;
+        const Vector2d& getVelocity(const int) const;
+        bool            isIntegrated(const int) const;
+        bool            isRailsEnabled() const;
+        int             size() const;
+
+        //--- Methods --------------------------------------------------------//
+        void add(CObject* const);
+        void addAttractor(CObject* const, const double&);
+        void clearAttractors();
+        void disableRails();
+        void enableRails();
+        void initAngle(const int, const double&);
+        void initAngleVelocity(const int, const double&);
+        void initPosition(const int, const Vector2d&);
+        void initVelocity(const int, const Vector2d&);
+        void integrate(const double&);
+        void perturb(CObject* const);
+        void remove(const int);
+        void setGroup(const int, const int);
+        void setMaxSubSteps(const int);
+        void setRailsThreshold(const double&);
+        void setTolerance(const double&, const double&);
+        void updateRails();
+
+        //--- friends --------------------------------------------------------//
+        friend class CObject; // Objects write to their slots directly
+
+    private:
+
+        /// Gravitating object acting on adaptively integrated slots
+        struct AttractorType
+        {
+            CObject*    pObj;           ///< Gravitating object, doesn't attract itself
+            Vector2d    vecPosition;    ///< Center of mass, local to cell
+            Vector2i    vecCell;        ///< Cell
+            Vector2d    vecVelocity;    ///< Velocity
+            Vector2d    vecAccel;       ///< Acceleration by accumulated forces
+            double      fGM;            ///< Gravitational constant times mass
+        };
+
+        /// Conic state of a slot on rails
+        struct RailsType
+        {
+            CObject*        pAttractor; ///< Dominant attractor, central body of orbit
+            CKeplerOrbit    Orbit;      ///< Orbit relative to attractor
+            bool            bPerturbed; ///< Perturbed within current time step, e.g. by thrust
+            bool            bDone;      ///< Already propagated within current time step
+        };
+
+        //--- Methods [private] ----------------------------------------------//
+        int  findDominantAttractor(const int, Vector2d&) const;
+        void integrateAdaptive(const double&, const int, const int);
+        void integrateAngle(const int, const double&);
+        void integrateRails(const double&, const int, const int);
+        void propagateRails(const int, const double&);
+        template <IntegratorType TIntegrator>
+        void integrateGroup(const double&, const int, const int);
+        void swapSlots(const int, const int);
+
+        //--- Variables [private] --------------------------------------------//
+        std::vector<CObject*>   m_Objects;          ///< Owners of slots
+        std::vector<Vector2d>   m_Positions;        ///< Center of mass, local to cell
+        std::vector<Vector2d>   m_Velocities;       ///< Velocities
+        std::vector<double>     m_Angles;           ///< Angles
+        std::vector<double>     m_AngleVelocities;  ///< Angle velocities
+        std::vector<Vector2d>   m_Forces;           ///< Resulting forces
+        std::vector<double>     m_Torques;          ///< Resulting torques
+        std::vector<double>     m_Masses;           ///< Masses
+        std::vector<double>     m_Inertias;         ///< Inertias
+        std::vector<double>     m_TimeFacs;         ///< Factors of realtime
+
+        std::vector<Vector2d>   m_Accelerations;        ///< Accelerations, temporary while integrating
+        std::vector<double>     m_AngleAccelerations;   ///< Angle accelerations, temporary while integrating
+        std::vector<double>     m_StepSizes;            ///< Sizes of last sub-steps of adaptive integration
+        std::vector<RailsType>  m_Rails;                ///< Conic states of slots on rails
+
+        BatchHistoryType<Vector2d>  m_PositionHistory;      ///< Derivative history of positions
+        BatchHistoryType<Vector2d>  m_VelocityHistory;      ///< Derivative history of velocities
+        BatchHistoryType<double>    m_AngleHistory;         ///< Derivative history of angles
+        BatchHistoryType<double>    m_AngleVelocityHistory; ///< Derivative history of angle velocities
+
+        std::array<int, KINEMATICS_STORE_INTEGRATED_GROUPS> m_GroupEnds; ///< Slot behind last slot of each integrated group
+
+        CDormandPrinceIntegrator<Vector2d>  m_AdaptiveIntegrator;   ///< Integrator of adaptive group
+        std::vector<AttractorType>          m_Attractors;           ///< Attractors of current time step
+        std::vector<AttractorType>          m_AttractorsLocal;      ///< Attractors relative to cell of current slot
+        int                                 m_nRejectedSteps;       ///< Rejected sub-steps within last time step
+        int                                 m_nSubSteps;            ///< Sub-steps of all adaptive slots within last time step
+        int                                 m_nSubStepsMax;         ///< Maximum sub-steps of one slot within last time step
+        std::vector<CObject*>               m_RailsChanges;         ///< Objects entering or leaving rails, temporary while updating
+        double                              m_fRailsThreshold;      ///< Relative perturbation below which slots go on rails
+        bool                                m_bRails;               ///< Indicates if slots may go on rails
+};
+
+//--- Implementation is done here for inline optimisation --------------------//
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns integrator of adaptive group
+///
+/// \return Adaptive integrator
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const CDormandPrinceIntegrator<Vector2d>& CKinematicsStore::getAdaptiveIntegrator() const
+{
+    METHOD_ENTRY("CKinematicsStore::getAdaptiveIntegrator")
+    return m_AdaptiveIntegrator;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns angle of given slot
+///
+/// \param _nSlot Slot
+///
+/// \return Angle
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const double& CKinematicsStore::getAngle(const int _nSlot) const
+{
+    METHOD_ENTRY("CKinematicsStore::getAngle")
+    return m_Angles[_nSlot];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns angle velocity of given slot
+///
+/// \param _nSlot Slot
+///
+/// \return Angle velocity
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const double& CKinematicsStore::getAngleVelocity(const int _nSlot) const
+{
+    METHOD_ENTRY("CKinematicsStore::getAngleVelocity")
+    return m_AngleVelocities[_nSlot];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns resulting force of given slot
+///
+/// \param _nSlot Slot
+///
+/// \return Force
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const Vector2d& CKinematicsStore::getForce(const int _nSlot) const
+{
+    METHOD_ENTRY("CKinematicsStore::getForce")
+    return m_Forces[_nSlot];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns inertia of given slot
+///
+/// \param _nSlot Slot
+///
+/// \return Inertia
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const double& CKinematicsStore::getInertia(const int _nSlot) const
+{
+    METHOD_ENTRY("CKinematicsStore::getInertia")
+    return m_Inertias[_nSlot];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns group of given slot
+///
+/// \param _nSlot Slot
+///
+/// \return Group, i.e. integrator type or \ref KINEMATICS_STORE_GROUP_STATIC
+///
+////////////////////////////////////////////////////////////////////////////////
+inline int CKinematicsStore::getGroup(const int _nSlot) const
+{
+    METHOD_ENTRY("CKinematicsStore::getGroup")
+
+    int nGroup = 0;
+    while (nGroup < KINEMATICS_STORE_INTEGRATED_GROUPS && _nSlot >= m_GroupEnds[nGroup]) ++nGroup;
+    return nGroup;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns mass of given slot
+///
+/// \param _nSlot Slot
+///
+/// \return Mass
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const double& CKinematicsStore::getMass(const int _nSlot) const
+{
+    METHOD_ENTRY("CKinematicsStore::getMass")
+    return m_Masses[_nSlot];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of slots integrated adaptively
+///
+/// \return Number of slots in group of \ref INTEGRATOR_DORMAND_PRINCE
+///
+////////////////////////////////////////////////////////////////////////////////
+inline int CKinematicsStore::getNumberOfAdaptive() const
+{
+    METHOD_ENTRY("CKinematicsStore::getNumberOfAdaptive")
+    return m_GroupEnds[INTEGRATOR_DORMAND_PRINCE] - m_GroupEnds[INTEGRATOR_DORMAND_PRINCE-1];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of slots integrated by store
+///
+/// These are the first slots of the store.
+///
+/// \return Number of slots integrated by store
+///
+////////////////////////////////////////////////////////////////////////////////
+inline int CKinematicsStore::getNumberOfIntegrated() const
+{
+    METHOD_ENTRY("CKinematicsStore::getNumberOfIntegrated")
+    return m_GroupEnds.back();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of slots on rails
+///
+/// \return Number of slots on rails
+///
+////////////////////////////////////////////////////////////////////////////////
+inline int CKinematicsStore::getNumberOfRails() const
+{
+    METHOD_ENTRY("CKinematicsStore::getNumberOfRails")
+    return m_GroupEnds[KINEMATICS_STORE_GROUP_RAILS] - m_GroupEnds[KINEMATICS_STORE_GROUP_RAILS-1];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of rejected sub-steps within last time step
+///
+/// \return Number of rejected sub-steps of all adaptive slots
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const int& CKinematicsStore::getNumberOfRejectedSteps() const
+{
+    METHOD_ENTRY("CKinematicsStore::getNumberOfRejectedSteps")
+    return m_nRejectedSteps;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of sub-steps within last time step
+///
+/// \return Number of accepted sub-steps of all adaptive slots
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const int& CKinematicsStore::getNumberOfSubSteps() const
+{
+    METHOD_ENTRY("CKinematicsStore::getNumberOfSubSteps")
+    return m_nSubSteps;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns maximum number of sub-steps of one slot within last time step
+///
+/// \return Maximum number of accepted sub-steps of one adaptive slot
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const int& CKinematicsStore::getNumberOfSubStepsMax() const
+{
+    METHOD_ENTRY("CKinematicsStore::getNumberOfSubStepsMax")
+    return m_nSubStepsMax;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns owner of given slot
+///
+/// \param _nSlot Slot
+///
+/// \return Object
+///
+////////////////////////////////////////////////////////////////////////////////
+inline CObject* CKinematicsStore::getObject(const int _nSlot) const
+{
+    METHOD_ENTRY("CKinematicsStore::getObject")
+    return m_Objects[_nSlot];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns position (center of mass, local to cell) of given slot
+///
+/// \param _nSlot Slot
+///
+/// \return Position
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const Vector2d& CKinematicsStore::getPosition(const int _nSlot) const
+{
+    METHOD_ENTRY("CKinematicsStore::getPosition")
+    return m_Positions[_nSlot];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns perturbation threshold of slots on rails
+///
+/// \return Perturbation relative to field of dominant attractor
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const double& CKinematicsStore::getRailsThreshold() const
+{
+    METHOD_ENTRY("CKinematicsStore::getRailsThreshold")
+    return m_fRailsThreshold;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns resulting torque of given slot
+///
+/// \param _nSlot Slot
+///
+/// \return Torque
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const double& CKinematicsStore::getTorque(const int _nSlot) const
+{
+    METHOD_ENTRY("CKinematicsStore::getTorque")
+    return m_Torques[_nSlot];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns velocity of given slot
+///
+/// \param _nSlot Slot
+///
+/// \return Velocity
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const Vector2d& CKinematicsStore::getVelocity(const int _nSlot) const
+{
+    METHOD_ENTRY("CKinematicsStore::getVelocity")
+    return m_Velocities[_nSlot];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns if given slot is integrated by store
+///
+/// \param _nSlot Slot
+///
+/// \return Integrated by store?
+///
+////////////////////////////////////////////////////////////////////////////////
+inline bool CKinematicsStore::isIntegrated(const int _nSlot) const
+{
+    METHOD_ENTRY("CKinematicsStore::isIntegrated")
+    return _nSlot < m_GroupEnds.back();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns if slots may go on rails
+///
+/// \return Rails enabled?
+///
+////////////////////////////////////////////////////////////////////////////////
+inline bool CKinematicsStore::isRailsEnabled() const
+{
+    METHOD_ENTRY("CKinematicsStore::isRailsEnabled")
+    return m_bRails;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of slots
+///
+/// \return Number of slots
+///
+////////////////////////////////////////////////////////////////////////////////
+inline int CKinematicsStore::size() const
+{
+    METHOD_ENTRY("CKinematicsStore::size")
+    return m_Objects.size();
+}
+
+#endif // KINEMATICS_STORE_H
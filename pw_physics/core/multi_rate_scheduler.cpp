@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       multi_rate_scheduler.cpp
+/// \brief      Implementation of class "CMultiRateScheduler"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "multi_rate_scheduler.h"
+
+//--- Standard header --------------------------------------------------------//
+#include <algorithm>
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Constructor
+///
+/// All classes are due within the first frame.
+///
+///////////////////////////////////////////////////////////////////////////////
+CMultiRateScheduler::CMultiRateScheduler() : m_nFrames(0u)
+{
+    METHOD_ENTRY("CMultiRateScheduler::CMultiRateScheduler")
+    CTOR_CALL("CMultiRateScheduler::CMultiRateScheduler")
+
+    for (auto& Class : m_Classes)
+    {
+        Class.fFrequency = MULTI_RATE_SCHEDULER_DEFAULT_FREQUENCY;
+        Class.fResidual = 1.0;
+        Class.fTime = 0.0;
+        Class.fStep = 0.0;
+        Class.nFrames = 0;
+        Class.nFramesStep = 0;
+        Class.fCostFrame = 0.0;
+        Class.fCostTotal = 0.0;
+        Class.nSteps = 0u;
+        Class.bDue = false;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Advances by one frame and determines due classes
+///
+/// Classes with a rate higher than the frame rate are due every frame.
+///
+/// \param _fFrequency Frame rate
+/// \param _fTimeScale Ratio of simulation time to real time
+///
+///////////////////////////////////////////////////////////////////////////////
+void CMultiRateScheduler::advance(const double& _fFrequency, const double& _fTimeScale)
+{
+    METHOD_ENTRY("CMultiRateScheduler::advance")
+
+    ++m_nFrames;
+    for (auto& Class : m_Classes)
+    {
+        Class.fCostFrame = 0.0;
+        Class.fTime += 1.0/_fFrequency*_fTimeScale;
+        ++Class.nFrames;
+        Class.fResidual += std::min(Class.fFrequency/_fFrequency, 1.0);
+        if (Class.fResidual >= 1.0)
+        {
+            Class.fResidual -= 1.0;
+            Class.fStep = Class.fTime;
+            Class.fTime = 0.0;
+            Class.nFramesStep = Class.nFrames;
+            Class.nFrames = 0;
+            Class.bDue = true;
+            ++Class.nSteps;
+        }
+        else
+        {
+            Class.bDue = false;
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets rate of given class
+///
+/// \param _Class Rate class
+/// \param _fFrequency Frequency
+///
+///////////////////////////////////////////////////////////////////////////////
+void CMultiRateScheduler::setFrequency(const RateClassType _Class, const double& _fFrequency)
+{
+    METHOD_ENTRY("CMultiRateScheduler::setFrequency")
+
+    if (_Class == RateClassType::NONE)
+    {
+        WARNING_MSG("Multi Rate Scheduler", "Unknown rate class.")
+        return;
+    }
+    if (_fFrequency <= 0.0)
+    {
+        WARNING_MSG("Multi Rate Scheduler", "Frequency must be positive.")
+        return;
+    }
+    m_Classes[static_cast<int>(_Class)].fFrequency = _fFrequency;
+}
@@ -0,0 +1,315 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       multi_rate_scheduler.h
+/// \brief      Prototype of class "CMultiRateScheduler"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MULTI_RATE_SCHEDULER_H
+#define MULTI_RATE_SCHEDULER_H
+
+//--- Standard header --------------------------------------------------------//
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+
+//--- Program header ---------------------------------------------------------//
+#include "log.h"
+#include "timer.h"
+
+//--- Constants --------------------------------------------------------------//
+const double MULTI_RATE_SCHEDULER_DEFAULT_FREQUENCY = 200.0; ///< Default frequency of all classes
+
+//--- Enumerations -----------------------------------------------------------//
+
+/// Specifies the classes of entities processed at their own rate
+enum class RateClassType
+{
+    OBJECTS,
+    PARTICLES,
+    EMITTERS,
+    THRUSTERS,
+    CELLS,
+    NONE
+};
+
+const int RATE_CLASS_NUMBER = 5; ///< Number of rate classes, NONE excluded
+
+//--- Enum parser ------------------------------------------------------------//
+const std::map<RateClassType, std::string> mapRateClassToString = {
+    {RateClassType::OBJECTS, "objects"},
+    {RateClassType::PARTICLES, "particles"},
+    {RateClassType::EMITTERS, "emitters"},
+    {RateClassType::THRUSTERS, "thrusters"},
+    {RateClassType::CELLS, "cells"}
+}; ///< Map from RateClassType to string
+
+const std::map<std::string, RateClassType> STRING_TO_RATE_CLASS_TYPE_MAP = {
+    {"objects", RateClassType::OBJECTS},
+    {"particles", RateClassType::PARTICLES},
+    {"emitters", RateClassType::EMITTERS},
+    {"thrusters", RateClassType::THRUSTERS},
+    {"cells", RateClassType::CELLS}
+}; ///< Map from string to RateClassType
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Maps given string to rate class
+///
+/// \return Rate class
+///
+////////////////////////////////////////////////////////////////////////////////
+inline RateClassType mapStringToRateClassType(const std::string& _strS)
+{
+    METHOD_ENTRY("mapStringToRateClassType")
+
+    const auto ci = STRING_TO_RATE_CLASS_TYPE_MAP.find(_strS);
+    if (ci != STRING_TO_RATE_CLASS_TYPE_MAP.end())
+        return ci->second;
+    else
+        return RateClassType::NONE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Schedules classes of entities at individual rates within frames
+///
+/// The physics thread runs at a fixed frame rate. Each class of entities
+/// declares its own rate, which is limited by the frame rate. Every frame,
+/// the fraction of a step of each class is accumulated. A class is due when
+/// a full step is reached, the remainder is kept as residual, hence, the
+/// average rate is exact even if it isn't an integer divisor of the frame
+/// rate.
+///
+/// Simulation time passed since the last step of a class is accumulated,
+/// too. Due classes are stepped by exactly this time, thus, all classes
+/// cover the same simulation time, independent of their rate or changes of
+/// time scale in between. The number of frames covered by a step is kept as
+/// well, e.g. to average quantities accumulated every frame.
+///
+/// Processing time of each class is measured for the last frame and
+/// accumulated over all frames.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CMultiRateScheduler
+{
+
+    public:
+
+        //--- Constructor/Destructor -----------------------------------------//
+        CMultiRateScheduler();
+
+        //--- Constant Methods -----------------------------------------------//
+        double                  getCostAverage(const RateClassType) const;
+        const double&           getCostFrame(const RateClassType) const;
+        const double&           getFrequency(const RateClassType) const;
+        const std::uint64_t&    getNumberOfFrames() const;
+        int                     getNumberOfFramesStep(const RateClassType) const;
+        const std::uint64_t&    getNumberOfSteps(const RateClassType) const;
+        const double&           getStep(const RateClassType) const;
+        bool                    isDue(const RateClassType) const;
+
+        //--- Methods --------------------------------------------------------//
+        void advance(const double&, const double&);
+        void setFrequency(const RateClassType, const double&);
+        void start(const RateClassType);
+        void stop(const RateClassType);
+
+    private:
+
+        /// State of one rate class
+        struct RateClassStateType
+        {
+            CTimer          Timer;       ///< Timer for processing of current frame
+            double          fFrequency;  ///< Rate of class
+            double          fResidual;   ///< Accumulated fraction of next step
+            double          fTime;       ///< Simulation time since last step
+            double          fStep;       ///< Simulation time to be stepped if due
+            int             nFrames;     ///< Frames since last step
+            int             nFramesStep; ///< Frames covered by step if due
+            double          fCostFrame;  ///< Processing time within last frame
+            double          fCostTotal;  ///< Processing time over all frames
+            std::uint64_t   nSteps;      ///< Number of steps
+            bool            bDue;        ///< Indicates if class is due in current frame
+        };
+
+        //--- Variables [private] --------------------------------------------//
+        std::array<RateClassStateType, RATE_CLASS_NUMBER> m_Classes; ///< State of all classes
+        std::uint64_t   m_nFrames;  ///< Number of frames
+};
+
+//--- Implementation is done here for inline optimisation --------------------//
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns average processing time per frame of given class
+///
+/// \param _Class Rate class
+///
+/// \return Average processing time per frame
+///
+////////////////////////////////////////////////////////////////////////////////
+inline double CMultiRateScheduler::getCostAverage(const RateClassType _Class) const
+{
+    METHOD_ENTRY("CMultiRateScheduler::getCostAverage")
+    if (m_nFrames == 0u) return 0.0;
+    return m_Classes[static_cast<int>(_Class)].fCostTotal / m_nFrames;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns processing time of given class within last frame
+///
+/// \param _Class Rate class
+///
+/// \return Processing time within last frame
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const double& CMultiRateScheduler::getCostFrame(const RateClassType _Class) const
+{
+    METHOD_ENTRY("CMultiRateScheduler::getCostFrame")
+    return m_Classes[static_cast<int>(_Class)].fCostFrame;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns rate of given class
+///
+/// \param _Class Rate class
+///
+/// \return Frequency
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const double& CMultiRateScheduler::getFrequency(const RateClassType _Class) const
+{
+    METHOD_ENTRY("CMultiRateScheduler::getFrequency")
+    return m_Classes[static_cast<int>(_Class)].fFrequency;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of frames
+///
+/// \return Number of frames
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const std::uint64_t& CMultiRateScheduler::getNumberOfFrames() const
+{
+    METHOD_ENTRY("CMultiRateScheduler::getNumberOfFrames")
+    return m_nFrames;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of frames covered by step of given class
+///
+/// \param _Class Rate class
+///
+/// \return Number of frames since previous step
+///
+////////////////////////////////////////////////////////////////////////////////
+inline int CMultiRateScheduler::getNumberOfFramesStep(const RateClassType _Class) const
+{
+    METHOD_ENTRY("CMultiRateScheduler::getNumberOfFramesStep")
+    return m_Classes[static_cast<int>(_Class)].nFramesStep;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of steps of given class
+///
+/// \param _Class Rate class
+///
+/// \return Number of steps
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const std::uint64_t& CMultiRateScheduler::getNumberOfSteps(const RateClassType _Class) const
+{
+    METHOD_ENTRY("CMultiRateScheduler::getNumberOfSteps")
+    return m_Classes[static_cast<int>(_Class)].nSteps;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns simulation time to be stepped by given class
+///
+/// \param _Class Rate class
+///
+/// \return Time step
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const double& CMultiRateScheduler::getStep(const RateClassType _Class) const
+{
+    METHOD_ENTRY("CMultiRateScheduler::getStep")
+    return m_Classes[static_cast<int>(_Class)].fStep;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Indicates if given class is due within current frame
+///
+/// \param _Class Rate class
+///
+/// \return Due?
+///
+////////////////////////////////////////////////////////////////////////////////
+inline bool CMultiRateScheduler::isDue(const RateClassType _Class) const
+{
+    METHOD_ENTRY("CMultiRateScheduler::isDue")
+    return m_Classes[static_cast<int>(_Class)].bDue;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Starts measuring processing time of given class
+///
+/// \param _Class Rate class
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CMultiRateScheduler::start(const RateClassType _Class)
+{
+    METHOD_ENTRY("CMultiRateScheduler::start")
+    m_Classes[static_cast<int>(_Class)].Timer.start();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Stops measuring processing time of given class
+///
+/// \param _Class Rate class
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CMultiRateScheduler::stop(const RateClassType _Class)
+{
+    METHOD_ENTRY("CMultiRateScheduler::stop")
+    RateClassStateType& Class = m_Classes[static_cast<int>(_Class)];
+    Class.Timer.stop();
+    Class.fCostFrame += Class.Timer.getTime();
+    Class.fCostTotal += Class.Timer.getTime();
+}
+
+#endif // MULTI_RATE_SCHEDULER_H
@@ -105,9 +105,10 @@ void CObjectEmitter::emit(const double& _fF)
                     double fX = m_UniformDist(m_Generator)*(m_fMaxX-m_fMinX) + m_fMinX;
                     double fY = m_UniformDist(m_Generator)*(m_fMaxY-m_fMinY) + m_fMinY;
                     
-                    CObject* pObject = m_pTemplate->clone();
+                    // Copy instead of cloning, to not place objects next to template
+                    CObject* pObject = new CObject(*m_pTemplate);
+                    MEM_ALLOC("CObject")
                     pObject->setNewID();
-                    pObject->setName("Obj_"+pObject->getName());
                     
                     pObject->setOrigin(Vector2d(fX, fY) + m_KinematicsState.getOrigin());
                     m_pDataStorage->addObject(pObject);
@@ -119,7 +120,9 @@ void CObjectEmitter::emit(const double& _fF)
                     double fAngle = m_NormalDist(m_Generator)*m_fAngleStd + m_KinematicsState.getAngle();;
                     double fVelocity = (m_NormalDist(m_Generator)*m_fVelocityStd + m_fVelocity) * m_fIntensity;
                                     
-                    CObject* pObject = m_pTemplate->clone();
+                    // Copy instead of cloning, to not place objects next to template
+                    CObject* pObject = new CObject(*m_pTemplate);
+                    MEM_ALLOC("CObject")
                     pObject->setNewID();
                     
                     pObject->setOrigin(m_KinematicsState.getOrigin());
@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       particle_dynamics.cpp
+/// \brief      Implementation of class "CParticleDynamics"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "particle_dynamics.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Constructor
+///
+///////////////////////////////////////////////////////////////////////////////
+CParticleDynamics::CParticleDynamics() : m_nChunkSize(PARTICLE_DYNAMICS_DEFAULT_CHUNK_SIZE),
+                                         m_nNumberOfWorkers(PARTICLE_DYNAMICS_DEFAULT_WORKERS)
+{
+    METHOD_ENTRY("CParticleDynamics::CParticleDynamics")
+    CTOR_CALL("CParticleDynamics::CParticleDynamics")
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Calculates dynamics of given particle systems
+///
+/// \param _pParticles Particle systems
+/// \param _fStep Time step
+///
+///////////////////////////////////////////////////////////////////////////////
+void CParticleDynamics::dynamics(const CSlotMap<UIDType, CParticle*>* const _pParticles,
+                                 const double& _fStep)
+{
+    METHOD_ENTRY("CParticleDynamics::dynamics")
+
+    // Plan chunks, sizes of live ranges are fixed from now on
+    m_Chunks.clear();
+    for (const auto& Particle : *_pParticles)
+    {
+        const int nSize = Particle.second->getNumberOfParticles();
+        for (auto i=0; i<nSize; i+=m_nChunkSize)
+        {
+            m_Chunks.push_back({Particle.second, i, std::min(i+m_nChunkSize, nSize),
+                                CParticle::getEmptyBounds()});
+        }
+    }
+
+    const int nChunks = m_Chunks.size();
+
+    #pragma omp parallel for schedule(dynamic, 1) num_threads(m_nNumberOfWorkers) if(m_nNumberOfWorkers > 1)
+    for (auto i=0; i<nChunks; ++i)
+    {
+        ChunkType& Chunk = m_Chunks[i];
+        Chunk.pParticle->dynamics(_fStep, Chunk.nFirst, Chunk.nLast, Chunk.Bounds);
+    }
+
+    // Merge bounds of all chunks of a system, then finish its step. Chunks
+    // of one system are adjacent.
+    auto i=0;
+    while (i < nChunks)
+    {
+        CParticle* const pParticle = m_Chunks[i].pParticle;
+        CParticle::BoundsType Bounds = m_Chunks[i].Bounds;
+        while (++i < nChunks && m_Chunks[i].pParticle == pParticle)
+            CParticle::mergeBounds(Bounds, m_Chunks[i].Bounds);
+        pParticle->finishDynamics(Bounds);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets number of particles per chunk
+///
+/// \param _nChunkSize Number of particles per chunk
+///
+///////////////////////////////////////////////////////////////////////////////
+void CParticleDynamics::setChunkSize(const int _nChunkSize)
+{
+    METHOD_ENTRY("CParticleDynamics::setChunkSize")
+
+    if (_nChunkSize < 1)
+    {
+        WARNING_MSG("Particle Dynamics", "Chunk size must be at least 1.")
+        return;
+    }
+    m_nChunkSize = _nChunkSize;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets number of workers
+///
+/// \param _nNumberOfWorkers Number of workers
+///
+///////////////////////////////////////////////////////////////////////////////
+void CParticleDynamics::setNumberOfWorkers(const int _nNumberOfWorkers)
+{
+    METHOD_ENTRY("CParticleDynamics::setNumberOfWorkers")
+
+    if (_nNumberOfWorkers < 1)
+    {
+        WARNING_MSG("Particle Dynamics", "Number of workers must be at least 1.")
+        return;
+    }
+    m_nNumberOfWorkers = _nNumberOfWorkers;
+}
@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       particle_dynamics.h
+/// \brief      Prototype of class "CParticleDynamics"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PARTICLE_DYNAMICS_H
+#define PARTICLE_DYNAMICS_H
+
+//--- Standard header --------------------------------------------------------//
+#include <vector>
+
+//--- Program header ---------------------------------------------------------//
+#include "particle.h"
+#include "slot_map.h"
+
+//--- Constants --------------------------------------------------------------//
+const int PARTICLE_DYNAMICS_DEFAULT_CHUNK_SIZE = 16384; ///< Default number of particles per chunk
+const int PARTICLE_DYNAMICS_DEFAULT_WORKERS = 1;        ///< Default number of workers, 1 equals serial processing
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Calculates dynamics of all particle systems by multiple workers
+///
+/// The live particles of each system are split into chunks of a fixed
+/// number of particles, small systems form a single chunk. Chunks of all
+/// systems are distributed dynamically among the workers, hence, many small
+/// systems as well as a few large ones keep all workers busy. Every chunk
+/// accumulates its own bounds, which are merged per system afterwards before
+/// expired particles are removed.
+///
+/// Chunks are planned at the beginning of a step, no particles must be
+/// generated while workers are running. Each particle is calculated exactly
+/// as by \ref CParticle::dynamics, thus, results do not depend on the number
+/// of workers.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CParticleDynamics
+{
+
+    public:
+
+        //--- Constructor/Destructor -----------------------------------------//
+        CParticleDynamics();
+
+        //--- Constant Methods -----------------------------------------------//
+        const int&      getChunkSize() const;
+        int             getNumberOfChunks() const;
+        const int&      getNumberOfWorkers() const;
+
+        //--- Methods --------------------------------------------------------//
+        void dynamics(const CSlotMap<UIDType, CParticle*>* const, const double&);
+        void setChunkSize(const int);
+        void setNumberOfWorkers(const int);
+
+    private:
+
+        /// Part of the live particles of one particle system
+        struct ChunkType
+        {
+            CParticle*              pParticle;  ///< Particle system
+            int                     nFirst;     ///< Index of first live particle
+            int                     nLast;      ///< Index behind last live particle
+            CParticle::BoundsType   Bounds;     ///< Bounds of particles of this chunk
+        };
+
+        //--- Variables [private] --------------------------------------------//
+        std::vector<ChunkType>  m_Chunks;           ///< Chunks of current step, grouped by system
+        int                     m_nChunkSize;       ///< Number of particles per chunk
+        int                     m_nNumberOfWorkers; ///< Number of workers
+};
+
+//--- Implementation is done here for inline optimisation --------------------//
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of particles per chunk
+///
+/// \return Chunk size
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const int& CParticleDynamics::getChunkSize() const
+{
+    METHOD_ENTRY("CParticleDynamics::getChunkSize")
+    return m_nChunkSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of chunks calculated in last step
+///
+/// \return Number of chunks
+///
+////////////////////////////////////////////////////////////////////////////////
+inline int CParticleDynamics::getNumberOfChunks() const
+{
+    METHOD_ENTRY("CParticleDynamics::getNumberOfChunks")
+    return m_Chunks.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of workers
+///
+/// \return Number of workers
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const int& CParticleDynamics::getNumberOfWorkers() const
+{
+    METHOD_ENTRY("CParticleDynamics::getNumberOfWorkers")
+    return m_nNumberOfWorkers;
+}
+
+#endif // PARTICLE_DYNAMICS_H
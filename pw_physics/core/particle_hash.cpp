@@ -0,0 +1,211 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       particle_hash.cpp
+/// \brief      Implementation of class "CParticleHash"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "particle_hash.h"
+
+//--- Standard header --------------------------------------------------------//
+#include <algorithm>
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Constructor
+///
+///////////////////////////////////////////////////////////////////////////////
+CParticleHash::CParticleHash() : m_fMargin(0.0),
+                                 m_nTableMask(0u)
+{
+    METHOD_ENTRY("CParticleHash::CParticleHash")
+    CTOR_CALL("CParticleHash::CParticleHash")
+
+    this->setBucketSize(PARTICLE_HASH_DEFAULT_BUCKET_SIZE);
+    m_BucketStarts.assign(2, 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Hashes all active particles of given particle systems
+///
+/// Entries are counting sorted by bucket into one contiguous array. The
+/// number of buckets is the next power of two of the number of particles.
+///
+/// \param _pParticles Particle systems to be hashed
+///
+///////////////////////////////////////////////////////////////////////////////
+void CParticleHash::build(const CSlotMap<UIDType, CParticle*>* const _pParticles)
+{
+    METHOD_ENTRY("CParticleHash::build")
+
+    m_ParticleSystems.clear();
+    m_EntriesUnsorted.clear();
+    m_fMargin = 0.0;
+
+    for (const auto& Particle : *_pParticles)
+    {
+        CParticle* const pParticle = Particle.second;
+        const Vector2i vecCell = pParticle->getCell();
+        const int nSystem = m_ParticleSystems.size();
+
+        m_ParticleSystems.push_back(pParticle);
+        for (auto i=0; i<int(pParticle->getNumberOfParticles()); ++i)
+        {
+            const Vector2d vecP = pParticle->getPosition(i);
+            m_EntriesUnsorted.push_back({this->toSubCell(vecP[0], vecCell[0]),
+                                         this->toSubCell(vecP[1], vecCell[1]),
+                                         nSystem, i});
+            m_fMargin = std::max(m_fMargin, (vecP - pParticle->getPreviousPosition(i)).cwiseAbs().maxCoeff());
+        }
+    }
+
+    const std::size_t nEntries = m_EntriesUnsorted.size();
+    std::size_t nBuckets = 1u;
+    while (nBuckets < nEntries) nBuckets <<= 1;
+    m_nTableMask = nBuckets - 1u;
+
+    // Count entries per bucket, shifted by one for prefix sum
+    m_BucketStarts.assign(nBuckets + 1u, 0);
+    m_EntryBuckets.resize(nEntries);
+    for (auto i=0u; i<nEntries; ++i)
+    {
+        m_EntryBuckets[i] = this->hash(m_EntriesUnsorted[i].nX, m_EntriesUnsorted[i].nY);
+        ++m_BucketStarts[m_EntryBuckets[i] + 1u];
+    }
+    for (auto i=1u; i<=nBuckets; ++i)
+        m_BucketStarts[i] += m_BucketStarts[i-1];
+
+    // Scatter entries, bucket starts are advanced while filling and
+    // restored afterwards
+    m_Entries.resize(nEntries);
+    for (auto i=0u; i<nEntries; ++i)
+        m_Entries[m_BucketStarts[m_EntryBuckets[i]]++] = m_EntriesUnsorted[i];
+    for (auto i=nBuckets; i>0u; --i)
+        m_BucketStarts[i] = m_BucketStarts[i-1];
+    m_BucketStarts[0] = 0;
+
+    DOM_STATS(DEBUG_MSG("Particle Hash", "Particles: " << nEntries << ", buckets: " << nBuckets <<
+                                         ", margin: " << m_fMargin))
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Removes all particles from hash
+///
+///////////////////////////////////////////////////////////////////////////////
+void CParticleHash::clear()
+{
+    METHOD_ENTRY("CParticleHash::clear")
+
+    m_ParticleSystems.clear();
+    m_Entries.clear();
+    m_BucketStarts.assign(2, 0);
+    m_fMargin = 0.0;
+    m_nTableMask = 0u;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Finds particles within given bounding box
+///
+/// The bounding box is enlarged by the largest particle displacement and one
+/// sub-cell to cover moving particles and rounding at cell borders.
+/// Resulting candidates are exact with respect to sub-cells, i.e. there are
+/// no duplicates and no particles of other sub-cells sharing a bucket.
+///
+/// \param _BBox Bounding box
+/// \param _Candidates Candidates, one index list per particle system
+///
+///////////////////////////////////////////////////////////////////////////////
+void CParticleHash::query(const CBoundingBox& _BBox, ParticleCandidatesType& _Candidates)
+{
+    METHOD_ENTRY("CParticleHash::query")
+
+    _Candidates.resize(m_ParticleSystems.size());
+    for (auto& Candidates : _Candidates) Candidates.clear();
+
+    if (m_Entries.empty()) return;
+
+    const Vector2i vecCell = _BBox.getCell();
+    const std::int64_t nX0 = this->toSubCell(_BBox.getLowerLeft()[0] - m_fMargin, vecCell[0]) - 1;
+    const std::int64_t nY0 = this->toSubCell(_BBox.getLowerLeft()[1] - m_fMargin, vecCell[1]) - 1;
+    const std::int64_t nX1 = this->toSubCell(_BBox.getUpperRight()[0] + m_fMargin, vecCell[0]) + 1;
+    const std::int64_t nY1 = this->toSubCell(_BBox.getUpperRight()[1] + m_fMargin, vecCell[1]) + 1;
+
+    auto isInside = [&](const EntryType& _Entry) -> bool
+    {
+        return _Entry.nX >= nX0 && _Entry.nX <= nX1 &&
+               _Entry.nY >= nY0 && _Entry.nY <= nY1;
+    };
+
+    // Large boxes, e.g. terrain, cover more sub-cells than there are buckets,
+    // checking all entries is cheaper then.
+    if (double(nX1-nX0+1) * double(nY1-nY0+1) >= double(m_nTableMask + 1u))
+    {
+        for (const auto& Entry : m_Entries)
+            if (isInside(Entry)) _Candidates[Entry.nSystem].push_back(Entry.nParticle);
+        return;
+    }
+
+    // Different sub-cells might share a bucket, visit each bucket once
+    m_QueryBuckets.clear();
+    for (auto nX = nX0; nX <= nX1; ++nX)
+        for (auto nY = nY0; nY <= nY1; ++nY)
+            m_QueryBuckets.push_back(this->hash(nX, nY));
+    std::sort(m_QueryBuckets.begin(), m_QueryBuckets.end());
+    m_QueryBuckets.erase(std::unique(m_QueryBuckets.begin(), m_QueryBuckets.end()), m_QueryBuckets.end());
+
+    for (const auto nBucket : m_QueryBuckets)
+    {
+        for (auto i = m_BucketStarts[nBucket]; i < m_BucketStarts[nBucket+1]; ++i)
+        {
+            if (isInside(m_Entries[i])) _Candidates[m_Entries[i].nSystem].push_back(m_Entries[i].nParticle);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets edge length of sub-cells
+///
+/// Takes effect with next build.
+///
+/// \param _fBucketSize Edge length of sub-cells
+///
+///////////////////////////////////////////////////////////////////////////////
+void CParticleHash::setBucketSize(const double& _fBucketSize)
+{
+    METHOD_ENTRY("CParticleHash::setBucketSize")
+
+    if (_fBucketSize <= 0.0)
+    {
+        WARNING_MSG("Particle Hash", "Bucket size must be positive.")
+        return;
+    }
+    m_fBucketSize = _fBucketSize;
+    m_nSubCellsPerCell = std::int64_t(std::ceil(DEFAULT_CELL_SIZE_2 / m_fBucketSize));
+}
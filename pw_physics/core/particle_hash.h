@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       particle_hash.h
+/// \brief      Prototype of class "CParticleHash"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PARTICLE_HASH_H
+#define PARTICLE_HASH_H
+
+//--- Standard header --------------------------------------------------------//
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+//--- Program header ---------------------------------------------------------//
+#include "particle.h"
+#include "slot_map.h"
+
+//--- Constants --------------------------------------------------------------//
+const double PARTICLE_HASH_DEFAULT_BUCKET_SIZE = 10.0; ///< Default edge length of sub-cells in metres
+
+/// Specifies indices of candidate particles, one list per particle system
+typedef std::vector<std::vector<int>> ParticleCandidatesType;
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Uniform spatial hash of active particle positions
+///
+/// Each grid cell is divided into square sub-cells. Active particles of all
+/// particle systems are hashed by global sub-cell index, i.e. cell and
+/// sub-cell, which is rebuilt every frame by a counting sort into one
+/// contiguous array. Bounding boxes of shapes query only the buckets of the
+/// sub-cells they cover instead of testing all particles.
+///
+/// Particles are hashed by their current position. Queries are enlarged by
+/// the largest particle displacement of the frame, hence, particles that
+/// passed a bounding box within one step are found as well.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CParticleHash
+{
+
+    public:
+
+        //--- Constructor/Destructor -----------------------------------------//
+        CParticleHash();
+
+        //--- Constant Methods -----------------------------------------------//
+        const double&   getBucketSize() const;
+        int             getNumberOfEntries() const;
+        int             getNumberOfParticleSystems() const;
+        CParticle*      getParticleSystem(const int) const;
+
+        //--- Methods --------------------------------------------------------//
+        void build(const CSlotMap<UIDType, CParticle*>* const);
+        void clear();
+        void query(const CBoundingBox&, ParticleCandidatesType&);
+        void setBucketSize(const double&);
+
+    private:
+
+        /// Hashed particle
+        struct EntryType
+        {
+            std::int64_t    nX;         ///< Global sub-cell index, x
+            std::int64_t    nY;         ///< Global sub-cell index, y
+            int             nSystem;    ///< Index of particle system
+            int             nParticle;  ///< Index of particle within system
+        };
+
+        //--- Constant Methods [private] -------------------------------------//
+        std::size_t     hash(const std::int64_t, const std::int64_t) const;
+        std::int64_t    toSubCell(const double&, const int) const;
+
+        //--- Variables [private] --------------------------------------------//
+        std::vector<CParticle*>     m_ParticleSystems;  ///< Particle systems hashed in current frame
+        std::vector<EntryType>      m_Entries;          ///< Entries, sorted by bucket
+        std::vector<EntryType>      m_EntriesUnsorted;  ///< Entries, temporary while building
+        std::vector<int>            m_BucketStarts;     ///< First entry of each bucket, one additional end
+        std::vector<std::size_t>    m_EntryBuckets;     ///< Bucket of each unsorted entry
+        std::vector<std::size_t>    m_QueryBuckets;     ///< Buckets covered by query, temporary while querying
+
+        double          m_fBucketSize;      ///< Edge length of sub-cells
+        double          m_fMargin;          ///< Largest particle displacement of current frame
+        std::int64_t    m_nSubCellsPerCell; ///< Number of sub-cells along one cell edge
+        std::size_t     m_nTableMask;       ///< Mask for number of buckets (power of two)
+};
+
+//--- Implementation is done here for inline optimisation --------------------//
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns edge length of sub-cells
+///
+/// \return Bucket size
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const double& CParticleHash::getBucketSize() const
+{
+    METHOD_ENTRY("CParticleHash::getBucketSize")
+    return m_fBucketSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of hashed particles
+///
+/// \return Number of hashed particles
+///
+////////////////////////////////////////////////////////////////////////////////
+inline int CParticleHash::getNumberOfEntries() const
+{
+    METHOD_ENTRY("CParticleHash::getNumberOfEntries")
+    return m_Entries.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of particle systems hashed in current frame
+///
+/// \return Number of particle systems
+///
+////////////////////////////////////////////////////////////////////////////////
+inline int CParticleHash::getNumberOfParticleSystems() const
+{
+    METHOD_ENTRY("CParticleHash::getNumberOfParticleSystems")
+    return m_ParticleSystems.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns particle system of given index
+///
+/// Indices correspond to those of \ref ParticleCandidatesType.
+///
+/// \param _nSystem Index of particle system
+///
+/// \return Particle system
+///
+////////////////////////////////////////////////////////////////////////////////
+inline CParticle* CParticleHash::getParticleSystem(const int _nSystem) const
+{
+    METHOD_ENTRY("CParticleHash::getParticleSystem")
+    return m_ParticleSystems[_nSystem];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns bucket of given global sub-cell
+///
+/// \param _nX Global sub-cell index, x
+/// \param _nY Global sub-cell index, y
+///
+/// \return Bucket
+///
+////////////////////////////////////////////////////////////////////////////////
+inline std::size_t CParticleHash::hash(const std::int64_t _nX, const std::int64_t _nY) const
+{
+    METHOD_ENTRY("CParticleHash::hash")
+    return (std::size_t(_nX) * 73856093u ^ std::size_t(_nY) * 19349663u) & m_nTableMask;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns global sub-cell index of given position along one axis
+///
+/// \param _fPos Position within cell
+/// \param _nCell Cell
+///
+/// \return Global sub-cell index
+///
+////////////////////////////////////////////////////////////////////////////////
+inline std::int64_t CParticleHash::toSubCell(const double& _fPos, const int _nCell) const
+{
+    METHOD_ENTRY("CParticleHash::toSubCell")
+    return std::int64_t(_nCell) * m_nSubCellsPerCell +
+           std::int64_t(std::floor((_fPos + DEFAULT_CELL_SIZE) / m_fBucketSize));
+}
+
+#endif // PARTICLE_HASH_H
@@ -35,13 +35,16 @@
 #include "objects_emitter.h"
 #include "shape.h"
 
+//--- Standard header --------------------------------------------------------//
+#include <omp.h>
+
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Constructor
 ///
 ///////////////////////////////////////////////////////////////////////////////
 CPhysicsManager::CPhysicsManager() : m_fG(6.67408e-11),
-                                     m_fFrequencyParticle(PHYSICS_PARTICLE_DEFAULT_FREQUENCY),
+                                     m_GravityMode(GravityModeType::PAIRWISE),
                                      m_nCellUpdateLast(0u),
                                      m_fCellUpdateResidual(0.0),
                                      m_bCellUpdateFirst(true),
@@ -57,6 +60,12 @@ CPhysicsManager::CPhysicsManager() : m_fG(6.67408e-11),
     #endif
     m_vecConstantGravitation.setZero();
     
+    m_Scheduler.setFrequency(RateClassType::OBJECTS, PHYSICS_DEFAULT_FREQUENCY);
+    m_Scheduler.setFrequency(RateClassType::PARTICLES, PHYSICS_PARTICLE_DEFAULT_FREQUENCY);
+    m_Scheduler.setFrequency(RateClassType::EMITTERS, PHYSICS_DEFAULT_FREQUENCY);
+    m_Scheduler.setFrequency(RateClassType::THRUSTERS, PHYSICS_DEFAULT_FREQUENCY);
+    m_Scheduler.setFrequency(RateClassType::CELLS, PHYSICS_DEFAULT_FREQUENCY);
+    
     // Start global timer (index 0)
     m_SimTimer[0].start();
 }
@@ -201,6 +210,43 @@ UIDType CPhysicsManager::createObjectPlanet()
     return pObjectPlanet->getUID();
 }
 
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Create a number of objects and insert them to world data storage
+///
+/// Locks are taken once for all objects, which are enqueued in one go.
+///
+/// \param _nNumber Number of objects to be created
+///
+/// \return UID values of objects
+///
+///////////////////////////////////////////////////////////////////////////////
+std::vector<UIDType> CPhysicsManager::createObjects(const int _nNumber)
+{
+    METHOD_ENTRY("CPhysicsManager::createObjects")
+    
+    std::vector<UIDType> UIDs;
+    if (_nNumber <= 0) return UIDs;
+    
+    m_CreatorLock.acquireLock();
+    m_pDataStorage->AccessObjects.setLock();
+    
+    UIDs.resize(_nNumber);
+    std::vector<CObject*> Objects(_nNumber);
+    this->createBatch(_nNumber, [&](const int _nI)
+    {
+        Objects[_nI] = new CObject();
+        MEM_ALLOC("CObject")
+        
+        Objects[_nI]->init();
+        UIDs[_nI] = Objects[_nI]->getUID();
+    });
+    m_ObjectsToBeAddedToWorld.enqueue_bulk(Objects.begin(), Objects.size());
+    m_CreatorLock.releaseLock();
+    
+    return UIDs;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Creates a particle group and inserts it to world data storage
@@ -315,6 +361,128 @@ UIDType CPhysicsManager::createShape(const std::string& _strShapeType)
     return this->createShape(mapStringToShapeType(_strShapeType));
 }
 
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Create a number of shapes of given type
+///
+/// Locks are taken once for all shapes, which are enqueued in one go.
+///
+/// \param _ShapeType Type of shapes to be created
+/// \param _nNumber Number of shapes to be created
+///
+/// \return UID values of shapes
+///
+///////////////////////////////////////////////////////////////////////////////
+std::vector<UIDType> CPhysicsManager::createShapes(const ShapeType _ShapeType, const int _nNumber)
+{
+    METHOD_ENTRY("CPhysicsManager::createShapes")
+    
+    std::vector<UIDType> UIDs;
+    if (_nNumber <= 0) return UIDs;
+    
+    if (_ShapeType != ShapeType::CIRCLE &&
+        _ShapeType != ShapeType::PLANET &&
+        _ShapeType != ShapeType::POLYGON)
+    {
+        WARNING_MSG("Physics Manager", "Unknown shape type. Cannot create shapes")
+        return UIDs;
+    }
+    
+    m_CreatorLock.acquireLock();
+    m_pDataStorage->AccessShapes.setLock();
+    
+    UIDs.resize(_nNumber);
+    std::vector<IShape*> Shapes(_nNumber);
+    this->createBatch(_nNumber, [&](const int _nI)
+    {
+        switch (_ShapeType)
+        {
+            case ShapeType::CIRCLE:
+                Shapes[_nI] = new CCircle();
+                break;
+            case ShapeType::PLANET:
+                Shapes[_nI] = new CPlanet();
+                break;
+            default:
+                Shapes[_nI] = new CPolygon();
+                break;
+        }
+        MEM_ALLOC("IShape")
+        UIDs[_nI] = Shapes[_nI]->getUID();
+    });
+    m_ShapesToBeAddedToWorld.enqueue_bulk(Shapes.begin(), Shapes.size());
+    m_CreatorLock.releaseLock();
+    
+    return UIDs;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Create a number of shapes of given type
+///
+/// \param _strShapeType Type of shapes to be created as string
+/// \param _nNumber Number of shapes to be created
+///
+/// \return UID values of shapes
+///
+///////////////////////////////////////////////////////////////////////////////
+std::vector<UIDType> CPhysicsManager::createShapes(const std::string& _strShapeType, const int _nNumber)
+{
+    METHOD_ENTRY("CPhysicsManager::createShapes")
+    return this->createShapes(mapStringToShapeType(_strShapeType), _nNumber);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Create a number of polygons with given vertices
+///
+/// All polygons have the same number of vertices. The vertices of all
+/// polygons are given consecutively, thus, the number of polygons results
+/// from the number of vertices given.
+///
+/// \param _nVertices Number of vertices per polygon
+/// \param _vecVertices Vertices of all polygons (x0, y0, x1, y1, ... xN, yN)
+///
+/// \return UID values of polygons
+///
+///////////////////////////////////////////////////////////////////////////////
+std::vector<UIDType> CPhysicsManager::createShapesPolygon(const int _nVertices, const std::vector<double>& _vecVertices)
+{
+    METHOD_ENTRY("CPhysicsManager::createShapesPolygon")
+    
+    std::vector<UIDType> UIDs;
+    if (_nVertices <= 0 || _vecVertices.size() % (2*_nVertices) != 0)
+    {
+        WARNING_MSG("Physics Manager", "Invalid number of vertices. Must be a multiple of " << 2*_nVertices << " (x,y).")
+        return UIDs;
+    }
+    const int nNumber = _vecVertices.size() / (2*_nVertices);
+    if (nNumber == 0) return UIDs;
+    
+    m_CreatorLock.acquireLock();
+    m_pDataStorage->AccessShapes.setLock();
+    
+    UIDs.resize(nNumber);
+    std::vector<IShape*> Shapes(nNumber);
+    this->createBatch(nNumber, [&](const int _nI)
+    {
+        CPolygon* pPolygon = new CPolygon();
+        MEM_ALLOC("IShape")
+        
+        const auto nOffset = 2*_nVertices*_nI;
+        for (auto i=0; i<2*_nVertices; i+=2)
+        {
+            pPolygon->addVertex(_vecVertices[nOffset+i], _vecVertices[nOffset+i+1]);
+        }
+        Shapes[_nI] = pPolygon;
+        UIDs[_nI] = pPolygon->getUID();
+    });
+    m_ShapesToBeAddedToWorld.enqueue_bulk(Shapes.begin(), Shapes.size());
+    m_CreatorLock.releaseLock();
+    
+    return UIDs;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Create a thruster and insert to world data storage
@@ -332,6 +500,7 @@ UIDType CPhysicsManager::createThruster()
     CThruster* pThruster = new CThruster();
     MEM_ALLOC("CThruster")
     
+    pThruster->setWorldDataStorage(m_pDataStorage);
 //     pThruster->init();
     m_ThrustersToBeAddedToWorld.enqueue(pThruster);
     m_CreatorLock.releaseLock();
@@ -425,6 +594,16 @@ void CPhysicsManager::resetTime()
 ///
 /// \brief Processes one single frame
 ///
+/// Objects, particles, emitters, thrusters and cell updates are processed at
+/// their own rates. Each class is stepped by the simulation time passed since
+/// its last step, when due within this frame.
+///
+/// Forces are cleared after objects were stepped, hence, forces applied by
+/// queued commands in between are kept for the next step. They are averaged
+/// over the frames covered by this step, thus, the resulting impulse equals
+/// the one of stepping objects every frame. While paused, forces are cleared
+/// every frame.
+///
 /// \return Success
 ///
 ////////////////////////////////////////////////////////////////////////////////
@@ -432,11 +611,6 @@ bool CPhysicsManager::processFrame()
 {
     METHOD_ENTRY("CPhysicsManager::processFrame")
 
-    static std::uint64_t nFrame = 0u;
-    
-    for (const auto Obj : *m_pDataStorage->getObjectsByValueBack())
-        Obj.second->clearForces();
-
     this->processQueues();
     
     if ((!m_bPaused) || (m_bPaused && m_bProcessOneFrame))
@@ -445,13 +619,102 @@ bool CPhysicsManager::processFrame()
         {
             m_SimTimer[i].inc(1.0/m_fFrequency*m_pDataStorage->getTimeScale());
         }
-        this->addGlobalForces();
-        this->dynamics(nFrame);
-        this->collisionDetection();
-        this->updateCells();
+        m_Scheduler.advance(m_fFrequency, m_pDataStorage->getTimeScale());
+        
+        const bool bObjects = m_Scheduler.isDue(RateClassType::OBJECTS);
+        const bool bParticles = m_Scheduler.isDue(RateClassType::PARTICLES);
+        
+        if (m_Scheduler.isDue(RateClassType::THRUSTERS))
+        {
+            m_Scheduler.start(RateClassType::THRUSTERS);
+            for (const auto& pThruster : *m_pDataStorage->getThrustersByValue())
+                pThruster.second->sample();
+            m_Scheduler.stop(RateClassType::THRUSTERS);
+        }
+        if (bObjects)
+        {
+            m_Scheduler.start(RateClassType::OBJECTS);
+            const int nFrames = m_Scheduler.getNumberOfFramesStep(RateClassType::OBJECTS);
+            if (nFrames > 1)
+            {
+                for (const auto& Obj : *m_pDataStorage->getObjectsByValueBack())
+                    Obj.second->setForce(Obj.second->getForce()/nFrames, Obj.second->getTorque()/nFrames);
+            }
+            this->addGlobalForces();
+            m_Scheduler.stop(RateClassType::OBJECTS);
+        }
+        if (m_Scheduler.isDue(RateClassType::EMITTERS))
+        {
+            m_Scheduler.start(RateClassType::EMITTERS);
+            this->emit(m_Scheduler.getStep(RateClassType::EMITTERS));
+            m_Scheduler.stop(RateClassType::EMITTERS);
+        }
+        if (bObjects)
+        {
+            m_Scheduler.start(RateClassType::OBJECTS);
+            this->dynamicsObjects(m_Scheduler.getStep(RateClassType::OBJECTS));
+            m_Scheduler.stop(RateClassType::OBJECTS);
+        }
+        if (bParticles)
+        {
+            m_Scheduler.start(RateClassType::PARTICLES);
+            this->dynamicsParticles(m_Scheduler.getStep(RateClassType::PARTICLES));
+            m_Scheduler.stop(RateClassType::PARTICLES);
+        }
+        
+        // Collisions are accounted to objects, or particles if only those moved
+        const RateClassType CollisionClass = bObjects ? RateClassType::OBJECTS : RateClassType::PARTICLES;
+        m_Scheduler.start(CollisionClass);
+        this->collisionDetection(bObjects, bParticles);
+        if (bObjects)
+        {
+            m_IslandManager.wakeContacts(m_CollisionManager.getBroadPhase().getPairs());
+            for (const auto& Obj : *m_pDataStorage->getObjectsByValueBack())
+                Obj.second->clearForces();
+        }
+        m_Scheduler.stop(CollisionClass);
+        
+        if (m_Scheduler.isDue(RateClassType::CELLS))
+        {
+            m_Scheduler.start(RateClassType::CELLS);
+            this->updateCells(std::min(m_Scheduler.getFrequency(RateClassType::CELLS), m_fFrequency));
+            m_Scheduler.stop(RateClassType::CELLS);
+        }
+        
+        DOM_STATS(
+            std::ostringstream oss;
+            for (const auto& Class : mapRateClassToString)
+                oss << Class.second << ": " << m_Scheduler.getCostFrame(Class.first)*1.0e3 << "ms ";
+            DEBUG_MSG("Physics Manager", "Cost per class: " << oss.str())
+            if (bObjects && m_pDataStorage->getKinematicsStore()->getNumberOfAdaptive() > 0)
+            {
+                DEBUG_MSG("Physics Manager", "Adaptive sub-steps: " <<
+                          m_pDataStorage->getKinematicsStore()->getNumberOfSubSteps() << " (max. " <<
+                          m_pDataStorage->getKinematicsStore()->getNumberOfSubStepsMax() << ", " <<
+                          m_pDataStorage->getKinematicsStore()->getNumberOfRejectedSteps() << " rejected)")
+            }
+            if (bObjects && m_pDataStorage->getKinematicsStore()->getNumberOfRails() > 0)
+            {
+                DEBUG_MSG("Physics Manager", "Objects on rails: " <<
+                          m_pDataStorage->getKinematicsStore()->getNumberOfRails())
+            }
+            if (bObjects && m_IslandManager.getNumberOfSleeping() > 0)
+            {
+                DEBUG_MSG("Physics Manager", "Sleeping objects: " << m_IslandManager.getNumberOfSleeping() <<
+                          " (" << m_IslandManager.getNumberOfIslands() << " islands)")
+            }
+            DEBUG_MSG("Physics Manager", "Buffer copies of last swap: " <<
+                      m_pDataStorage->getNumberOfCopied() << " copied, " <<
+                      m_pDataStorage->getNumberOfSkipped() << " skipped")
+        )
         
         m_bProcessOneFrame = false;
     }
+    else
+    {
+        for (const auto& Obj : *m_pDataStorage->getObjectsByValueBack())
+            Obj.second->clearForces();
+    }
     DEBUG_BLK(Log.setLoglevel(LOG_LEVEL_NOTICE);)
     m_TimeProcessedBufferCopy.start();
     m_pDataStorage->swapBack();
@@ -466,140 +729,309 @@ bool CPhysicsManager::processFrame()
 /// \brief Add global forces to all objects
 ///
 /// This method adds global forces to all objects, for example gravitation.
+/// Forces of joints, gravitation and thrusters are accumulated in private
+/// buffers of the force workers and reduced into the objects afterwards.
 ///
 ///////////////////////////////////////////////////////////////////////////////
 void CPhysicsManager::addGlobalForces()
 {
     METHOD_ENTRY("CPhysicsManager::addGlobalForces")
     
-    ObjectsByValueType::const_iterator cj;
-    double fCCSqr;
-    Vector2d vecCC;
-    Vector2d vecG;
+    m_ForceAccumulator.init(m_pDataStorage->getObjectsByValueBack());
 
     for (std::list< IJoint* >::const_iterator ci = m_pDataStorage->getJoints().begin();
         ci != m_pDataStorage->getJoints().end(); ++ci)
     {
-        (*ci)->react();
+        (*ci)->react(&m_ForceAccumulator);
+    }
+    
+    if (m_GravityMode == GravityModeType::BARNES_HUT)
+        this->addGravitationBarnesHut();
+    else
+        this->addGravitationPairwise();
+    
+    CKinematicsStore* const pKinematicsStore = m_pDataStorage->getKinematicsStore();
+    for (const auto& pThruster : *m_pDataStorage->getThrustersByValue())
+    {
+        pThruster.second->execute(&m_ForceAccumulator);
+        
+        // Thrust is no perturbation to be measured, objects leave rails
+        if (pThruster.second->isFiring())
+        {
+            pThruster.second->getObject()->wake();
+            pKinematicsStore->perturb(pThruster.second->getObject());
+        }
+    }
+    
+    m_ForceAccumulator.reduce();
+    
+    // Resting objects fall asleep before they are integrated, objects with
+    // changed forces wake up
+    m_IslandManager.update(m_ForceAccumulator, m_pDataStorage->getJoints());
+    
+    // Adaptive integration evaluates gravitation within its sub-steps, rails
+    // follow the dominant attractor. Both need the reduced forces.
+    pKinematicsStore->clearAttractors();
+    if (pKinematicsStore->getNumberOfAdaptive() > 0 || pKinematicsStore->isRailsEnabled() ||
+        pKinematicsStore->getNumberOfRails() > 0)
+    {
+        for (auto i=0; i<m_ForceAccumulator.size(); ++i)
+        {
+            CObject* pObj = m_ForceAccumulator.getObject(i);
+            if (pObj->getGravitationState())
+                pKinematicsStore->addAttractor(pObj, pObj->getMass() * m_fG);
+        }
+    }
+    pKinematicsStore->updateRails();
+    
+//     for (auto ci = m_pDataStorage->getParticle().cbegin();
+//         ci != m_pDataStorage->getParticle().cend(); ++ci)
+//     {
+// //         (*ci)->setForce(Vector2d(0.0, -1.81));
+//     }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adds gravitation and constant gravity using Barnes-Hut approximation
+///
+/// Gravitating objects are inserted into one tree, all others into a second
+/// tree. As in the pairwise algorithm, a pair of objects interacts if at least
+/// one of them is gravitating: Each object is attracted by the gravitating
+/// objects, gravitating objects are additionally attracted by non-gravitating
+/// ones.
+///
+///////////////////////////////////////////////////////////////////////////////
+void CPhysicsManager::addGravitationBarnesHut()
+{
+    METHOD_ENTRY("CPhysicsManager::addGravitationBarnesHut")
+    
+    const int nSize = m_ForceAccumulator.size();
+    const int nWorkers = m_ForceAccumulator.getNumberOfWorkers();
+    
+    m_GravityTreeActive.clear();
+    m_GravityTreePassive.clear();
+    m_GravityIndices.clear();
+    
+    for (auto i=0; i<nSize; ++i)
+    {
+        CObject* pObj = m_ForceAccumulator.getObject(i);
+        if (pObj->getGravitationState())
+            m_GravityIndices.push_back(m_GravityTreeActive.addBody(pObj->getCOM(), pObj->getCell(), pObj->getMass()));
+        else
+            m_GravityIndices.push_back(m_GravityTreePassive.addBody(pObj->getCOM(), pObj->getCell(), pObj->getMass()));
+    }
+    m_GravityTreeActive.build();
+    m_GravityTreePassive.build();
+    
+    #pragma omp parallel for num_threads(nWorkers) if(nWorkers > 1)
+    for (auto i=0; i<nSize; ++i)
+    {
+        const int nWorker = omp_get_thread_num();
+        CObject* pObj = m_ForceAccumulator.getObject(i);
+        Vector2d vecField;
+        
+        if (pObj->getGravitationState())
+        {
+            vecField = m_GravityTreeActive.getField(pObj->getCOM(), pObj->getCell(), m_GravityIndices[i]) +
+                       m_GravityTreePassive.getField(pObj->getCOM(), pObj->getCell());
+        }
+        else
+        {
+            vecField = m_GravityTreeActive.getField(pObj->getCOM(), pObj->getCell());
+        }
+        m_ForceAccumulator.addForce(i, vecField * pObj->getMass() * m_fG, pObj->getCOM(), nWorker);
+        m_ForceAccumulator.addAcceleration(i, m_vecConstantGravitation, nWorker);
     }
+}
 
-    for (auto ci  = m_pDataStorage->getObjectsByValueBack()->cbegin();
-              ci != m_pDataStorage->getObjectsByValueBack()->cend(); ++ci)
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adds gravitation and constant gravity using exact pairwise algorithm
+///
+/// Rows of the pair matrix are distributed cyclically among the force
+/// workers to balance the triangular workload. With a single worker, the
+/// order of calculation equals the serial loop.
+///
+///////////////////////////////////////////////////////////////////////////////
+void CPhysicsManager::addGravitationPairwise()
+{
+    METHOD_ENTRY("CPhysicsManager::addGravitationPairwise")
+    
+    const int nSize = m_ForceAccumulator.size();
+    const int nWorkers = m_ForceAccumulator.getNumberOfWorkers();
+    
+    #pragma omp parallel for schedule(static, 1) num_threads(nWorkers) if(nWorkers > 1)
+    for (auto i=0; i<nSize; ++i)
     {
-        cj = ci;
-        ++cj;
+        const int nWorker = omp_get_thread_num();
+        CObject* pObjI = m_ForceAccumulator.getObject(i);
         
-        while (cj != m_pDataStorage->getObjectsByValueBack()->cend())
+        for (auto j=i+1; j<nSize; ++j)
         {
-            if ((*ci).second->getGravitationState() == true ||
-                (*cj).second->getGravitationState() == true)
+            CObject* pObjJ = m_ForceAccumulator.getObject(j);
+            
+            if (pObjI->getGravitationState() == true ||
+                pObjJ->getGravitationState() == true)
             {
-                
-                vecCC = (*ci).second->getCOM() - (*cj).second->getCOM() +
-                        IGridUser::cellToDouble((*ci).second->getCell()-(*cj).second->getCell());
+                Vector2d vecCC = pObjI->getCOM() - pObjJ->getCOM() +
+                                 IGridUser::cellToDouble(pObjI->getCell()-pObjJ->getCell());
 
-                fCCSqr = vecCC.squaredNorm();
+                double fCCSqr = vecCC.squaredNorm();
                 
                 if (fCCSqr > 400.0)
                 {
-                    vecG = vecCC.normalized() * ((*ci).second->getMass() * (*cj).second->getMass()) / fCCSqr
-                           * m_fG;
-                    (*ci).second->addForce(-vecG, (*ci).second->getCOM());
-                    (*cj).second->addForce(vecG, (*cj).second->getCOM());
+                    Vector2d vecG = vecCC.normalized() * (pObjI->getMass() * pObjJ->getMass()) / fCCSqr
+                                    * m_fG;
+                    m_ForceAccumulator.addForce(i, -vecG, pObjI->getCOM(), nWorker);
+                    m_ForceAccumulator.addForce(j,  vecG, pObjJ->getCOM(), nWorker);
                 }
             }
-            ++cj;
         }
 
-        (*ci).second->addAcceleration(m_vecConstantGravitation);
+        m_ForceAccumulator.addAcceleration(i, m_vecConstantGravitation, nWorker);
     }
-    
-//     for (auto ci = m_pDataStorage->getParticle().cbegin();
-//         ci != m_pDataStorage->getParticle().cend(); ++ci)
-//     {
-// //         (*ci)->setForce(Vector2d(0.0, -1.81));
-//     }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Tests all objects for collision
 ///
+/// Pairs of objects are only tested if objects moved, particles are only
+/// tested if particles moved within this frame.
+///
+/// \param _bObjects Objects were stepped
+/// \param _bParticles Particles were stepped
+///
 ///////////////////////////////////////////////////////////////////////////////
-void CPhysicsManager::collisionDetection()
+void CPhysicsManager::collisionDetection(const bool _bObjects, const bool _bParticles)
 {
     METHOD_ENTRY("CPhysicsManager::collisionDetection")
 
-//     m_ContactList.clear();
-//     m_CollisionManager.setParticle(m_pDataStorage->getParticle());
-//     m_CollisionManager.setDynamicObjects(m_pDataStorage->getObjectsByValueBack());
-//     m_CollisionManager.setStaticObjects(m_pDataStorage->getObjectsByValueBack());
-//     m_CollisionManager.detectCollisions();
-    
-//  for (ContactList::const_iterator ci = m_ContactList.begin();
-//      ci != m_ContactList.end(); ++ci)
-//  {
-//      (*ci).getObjectA()->disableDynamics();
-//      (*ci).getObjectB()->disableDynamics();
-//  }
+    if (!_bObjects && !_bParticles) return;
+
+    m_TimeProcessedBroadPhase.start();
+    m_CollisionManager.broadPhase(m_pDataStorage->getObjectsByValueBack(),
+                                  _bParticles ? m_pDataStorage->getParticlesByValueBack() : nullptr);
+    m_TimeProcessedBroadPhase.stop();
+
+    m_TimeProcessedCollisions.start();
+    m_CollisionManager.detectCollisions(_bObjects);
+    m_TimeProcessedCollisions.stop();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Creates a number of entities, reserving their UIDs in one go
+///
+/// The first entity is created with some UIDs reserved, which reveals the
+/// number of UIDs an entity takes. UIDs of all remaining entities are
+/// reserved at once, hence, IDs are acquired in one go instead of for each
+/// entity.
+///
+/// \param _nNumber Number of entities to be created
+/// \param _Create Function creating entity of given index
+///
+///////////////////////////////////////////////////////////////////////////////
+void CPhysicsManager::createBatch(const int _nNumber, const std::function<void(const int)>& _Create)
+{
+    METHOD_ENTRY("CPhysicsManager::createBatch")
+    
+    CUID::reserve(PHYSICS_BATCH_UIDS_FIRST);
+    _Create(0);
+    
+    const std::size_t nUIDsPerEntity = PHYSICS_BATCH_UIDS_FIRST - CUID::getNumberOfReserved();
+    CUID::reserve((_nNumber-1)*nUIDsPerEntity);
+    for (auto i=1; i<_nNumber; ++i)
+    {
+        _Create(i);
+    }
+    CUID::unreserve();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Dynamics processing the masses
 ///
+/// \param _fStep Time step
+///
 ////////////////////////////////////////////////////////////////////////////////
-void CPhysicsManager::dynamics(std::uint64_t _nStep)
+void CPhysicsManager::dynamicsObjects(const double& _fStep)
 {
-    METHOD_ENTRY("CPhysicsManager::dynamics")
+    METHOD_ENTRY("CPhysicsManager::dynamicsObjects")
     
-    for (auto pThruster : *m_pDataStorage->getThrustersByValue())
+    m_TimeProcessedObjects.start();
+    // Integrate all objects in linear sweeps, one per integrator type,
+    // afterwards, objects only update their kinematics state
+    CKinematicsStore* const pKinematicsStore = m_pDataStorage->getKinematicsStore();
+    pKinematicsStore->integrate(_fStep);
+    for (auto i=0; i<pKinematicsStore->size(); ++i)
     {
-        pThruster.second->execute();
+        CObject* const pObj = pKinematicsStore->getObject(i);
+        if (pObj->isSleeping()) continue;
+        pObj->dynamics(_fStep);
+        pObj->transform();
     }
+    m_TimeProcessedObjects.stop();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Dynamics of all particle systems
+///
+/// \param _fStep Time step
+///
+////////////////////////////////////////////////////////////////////////////////
+void CPhysicsManager::dynamicsParticles(const double& _fStep)
+{
+    METHOD_ENTRY("CPhysicsManager::dynamicsParticles")
+    
+    m_TimeProcessedParticles.start();
+    m_ParticleDynamics.dynamics(m_pDataStorage->getParticlesByValueBack(), _fStep);
+    m_TimeProcessedParticles.stop();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Emits particles and objects of all emitters
+///
+/// \param _fStep Time step
+///
+////////////////////////////////////////////////////////////////////////////////
+void CPhysicsManager::emit(const double& _fStep)
+{
+    METHOD_ENTRY("CPhysicsManager::emit")
+    
+    // Emitters generating into the same particle system overwrite each
+    // others particles if the system is full, hence, they emit in order of
+    // their UIDs to be reproducible. All particles are generated before
+    // particle dynamics are planned.
+    m_EmittersOrdered.clear();
+    for (const auto& Emitter : *m_pDataStorage->getEmittersByValue())
+        m_EmittersOrdered.push_back(Emitter.second);
+    std::sort(m_EmittersOrdered.begin(), m_EmittersOrdered.end(),
+              [](const IEmitter* const _pA, const IEmitter* const _pB) {return _pA->getUID() < _pB->getUID();});
     
     std::vector<UIDType> vecToBeDeleted;
-    for (auto pEmitter : *m_pDataStorage->getEmittersByValue())
+    for (auto pEmitter : m_EmittersOrdered)
     {
-        if (pEmitter.second->getMode() == EmitterModeType::ONCE)
+        if (pEmitter->getMode() == EmitterModeType::ONCE)
         {
-            pEmitter.second->emit();
-            vecToBeDeleted.push_back(pEmitter.second->getUID());
+            pEmitter->emit();
+            vecToBeDeleted.push_back(pEmitter->getUID());
             
-            delete pEmitter.second;
-            pEmitter.second = nullptr;
+            delete pEmitter;
             MEM_FREED("IEmitter")
         }
         else
         {
-            pEmitter.second->emit(1.0/m_fFrequency*m_pDataStorage->getTimeScale());
+            pEmitter->emit(_fStep);
         }
     }
     for (auto EmDel : vecToBeDeleted)
     {
         m_pDataStorage->getEmittersByValue()->erase(EmDel);
     }
-    
-    m_TimeProcessedObjects.start();
-    for (const auto Obj : *m_pDataStorage->getObjectsByValueBack())
-    {
-        Obj.second->dynamics(1.0/m_fFrequency*m_pDataStorage->getTimeScale());
-        Obj.second->transform();
-    }
-    m_TimeProcessedObjects.stop();
-//     if (_nStep % static_cast<int>(m_fFrequency/m_fFrequencyParticle) == 0)
-    {
-        
-        m_TimeProcessedParticles.start();
-        
-        for (const auto Particle : *m_pDataStorage->getParticlesByValueBack())
-        {
-            Particle.second->dynamics(1.0/m_fFrequencyParticle*m_pDataStorage->getTimeScale());
-        }
-        
-        m_TimeProcessedParticles.stop();
-    }
-    
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -622,6 +1054,12 @@ void CPhysicsManager::myInitComInterface()
     for (auto EmitterDistributionType : STRING_TO_EMITTER_DISTRIBUTION_TYPE_MAP) ossEmitterDistributionType << " " << EmitterDistributionType.first;
     std::ostringstream ossEmitterModeType("");
     for (auto EmitterModeType : STRING_TO_EMITTER_MODE_TYPE_MAP) ossEmitterModeType << " " << EmitterModeType.first;
+    std::ostringstream ossRateClassType("");
+    for (auto RateClassType : STRING_TO_RATE_CLASS_TYPE_MAP) ossRateClassType << " " << RateClassType.first;
+    std::ostringstream ossGravityModeType("");
+    for (auto GravityModeType : STRING_TO_GRAVITY_MODE_TYPE_MAP) ossGravityModeType << " " << GravityModeType.first;
+    std::ostringstream ossIntegratorType("");
+    for (auto IntegratorType : STRING_TO_INTEGRATOR_TYPE_MAP) ossIntegratorType << " " << IntegratorType.first;
     std::ostringstream ossPolygonType("");
     for (auto PolyType : STRING_TO_POLYGON_TYPE_MAP) ossPolygonType << " " << PolyType.first;
     std::ostringstream ossShapeType("");
@@ -656,6 +1094,17 @@ void CPhysicsManager::myInitComInterface()
                                         {{ParameterType::INT, "UID of object"}},
                                         "system"
                                         );
+    m_pComInterface->registerFunction("create_objs",
+                                        CCommand<std::vector<double>, int>([&](const int _nNumber) -> std::vector<double>
+                                        {
+                                            const auto UIDs = this->createObjects(_nNumber);
+                                            return std::vector<double>(UIDs.begin(), UIDs.end());
+                                        }),
+                                        "Creates a number of default objects at once.",
+                                        {{ParameterType::DYN_ARRAY, "UIDs of objects"},
+                                        {ParameterType::INT, "Number of objects"}},
+                                        "system"
+                                        );
     m_pComInterface->registerFunction("create_particles",
                                         CCommand<int, std::string>([&](const std::string& _strParticleType) -> int {return this->createParticles(_strParticleType);}),
                                         "Creates a group of particles.",
@@ -670,6 +1119,32 @@ void CPhysicsManager::myInitComInterface()
                                         {ParameterType::STRING, "Shape type ("+ossShapeType.str()+" )"}},
                                         "system"
                                         );
+    m_pComInterface->registerFunction("create_shps",
+                                        CCommand<std::vector<double>, std::string, int>(
+                                            [&](const std::string& _strShapeType, const int _nNumber) -> std::vector<double>
+                                        {
+                                            const auto UIDs = this->createShapes(_strShapeType, _nNumber);
+                                            return std::vector<double>(UIDs.begin(), UIDs.end());
+                                        }),
+                                        "Creates a number of shapes at once.",
+                                        {{ParameterType::DYN_ARRAY, "UIDs of shapes"},
+                                        {ParameterType::STRING, "Shape type ("+ossShapeType.str()+" )"},
+                                        {ParameterType::INT, "Number of shapes"}},
+                                        "system"
+                                        );
+    m_pComInterface->registerFunction("create_shps_polygon",
+                                        CCommand<std::vector<double>, int, std::vector<double>>(
+                                            [&](const int _nVertices, const std::vector<double>& _vecVerts) -> std::vector<double>
+                                        {
+                                            const auto UIDs = this->createShapesPolygon(_nVertices, _vecVerts);
+                                            return std::vector<double>(UIDs.begin(), UIDs.end());
+                                        }),
+                                        "Creates a number of polygons at once, number is given by vertices.",
+                                        {{ParameterType::DYN_ARRAY, "UIDs of polygons"},
+                                        {ParameterType::INT, "Number of vertices per polygon"},
+                                        {ParameterType::DYN_ARRAY, "Vertices of all polygons (x0, y0, x1, y1, ... xN, yN)"}},
+                                        "system"
+                                        );
     m_pComInterface->registerFunction("create_thruster",
                                         CCommand<int>([&]() -> int {return this->createThruster();}),
                                         "Creates a default thruster.",
@@ -898,24 +1373,229 @@ void CPhysicsManager::myInitComInterface()
                                         {{ParameterType::DOUBLE, "processing frequency in Hertz"}},
                                         "system"
                                         );
+    m_pComInterface->registerFunction("get_frequency_physics_class",
+                                        CCommand<double, std::string>([&](const std::string& _strClass) -> double
+                                        {
+                                            const RateClassType Class = mapStringToRateClassType(_strClass);
+                                            if (Class == RateClassType::NONE)
+                                            {
+                                                WARNING_MSG("Physics Manager", "Unknown rate class " << _strClass << ".")
+                                                return 0.0;
+                                            }
+                                            return m_Scheduler.getFrequency(Class);
+                                        }),
+                                        "Return processing frequency of given class in Hertz.",
+                                        {{ParameterType::DOUBLE, "Processing frequency in Hertz"},
+                                        {ParameterType::STRING, "Rate class ("+ossRateClassType.str()+" )"}},
+                                        "system"
+                                        );
+    m_pComInterface->registerFunction("get_steps_physics_class",
+                                        CCommand<int, std::string>([&](const std::string& _strClass) -> int
+                                        {
+                                            const RateClassType Class = mapStringToRateClassType(_strClass);
+                                            if (Class == RateClassType::NONE)
+                                            {
+                                                WARNING_MSG("Physics Manager", "Unknown rate class " << _strClass << ".")
+                                                return 0;
+                                            }
+                                            return m_Scheduler.getNumberOfSteps(Class);
+                                        }),
+                                        "Return number of steps of given class since start.",
+                                        {{ParameterType::INT, "Number of steps"},
+                                        {ParameterType::STRING, "Rate class ("+ossRateClassType.str()+" )"}},
+                                        "system"
+                                        );
     m_pComInterface->registerFunction("get_time_per_frame_physics",
                                         CCommand<double>([&]() -> double {return this->getTimePerFrame();}),
                                         "Return time available per frame (i.e. 1.0/Frequency).",
                                         {{ParameterType::DOUBLE, "Time available per frame"}},
                                         "system"
                                         );
+    m_pComInterface->registerFunction("get_broad_phase_pairs",
+                                        CCommand<int>([&]() -> int {return m_CollisionManager.getBroadPhase().getNumberOfPairs();}),
+                                        "Return number of candidate pairs of collision broad phase in last frame.",
+                                        {{ParameterType::INT, "Number of candidate pairs"}},
+                                        "system"
+                                        );
+    m_pComInterface->registerFunction("get_broad_phase_swaps",
+                                        CCommand<int>([&]() -> int {return m_CollisionManager.getBroadPhase().getNumberOfSwaps();}),
+                                        "Return number of endpoint swaps of collision broad phase in last frame.",
+                                        {{ParameterType::INT, "Number of endpoint swaps"}},
+                                        "system"
+                                        );
+    m_pComInterface->registerFunction("get_particle_hash_bucket_size",
+                                        CCommand<double>([&]() -> double {return m_CollisionManager.getParticleHash().getBucketSize();}),
+                                        "Return edge length of sub-cells of spatial hash for particle collisions.",
+                                        {{ParameterType::DOUBLE, "Edge length of sub-cells"}},
+                                        "system"
+                                        );
+    m_pComInterface->registerFunction("get_particle_hash_entries",
+                                        CCommand<int>([&]() -> int {return m_CollisionManager.getParticleHash().getNumberOfEntries();}),
+                                        "Return number of active particles hashed for collisions in last frame.",
+                                        {{ParameterType::INT, "Number of hashed particles"}},
+                                        "system"
+                                        );
+    m_pComInterface->registerFunction("get_particle_chunk_size",
+                                        CCommand<int>([&]() -> int {return m_ParticleDynamics.getChunkSize();}),
+                                        "Return number of particles per chunk for parallel particle dynamics.",
+                                        {{ParameterType::INT, "Number of particles per chunk"}},
+                                        "system"
+                                        );
+    m_pComInterface->registerFunction("get_particle_chunks",
+                                        CCommand<int>([&]() -> int {return m_ParticleDynamics.getNumberOfChunks();}),
+                                        "Return number of chunks of particle dynamics in last frame.",
+                                        {{ParameterType::INT, "Number of chunks"}},
+                                        "system"
+                                        );
+    m_pComInterface->registerFunction("get_objects_on_rails",
+                                        CCommand<int>([&]() -> int
+                                        {
+                                            return m_pDataStorage->getKinematicsStore()->getNumberOfRails();
+                                        }),
+                                        "Return number of objects propagated on conic orbits.",
+                                        {{ParameterType::INT, "Number of objects on rails"}},
+                                        "system"
+                                        );
+    m_pComInterface->registerFunction("get_islands",
+                                        CCommand<int>([&]() -> int {return m_IslandManager.getNumberOfIslands();}),
+                                        "Return number of islands, i.e. objects connected by joints, in last frame.",
+                                        {{ParameterType::INT, "Number of islands"}},
+                                        "system"
+                                        );
+    m_pComInterface->registerFunction("get_objects_sleeping",
+                                        CCommand<int>([&]() -> int {return m_IslandManager.getNumberOfSleeping();}),
+                                        "Return number of sleeping objects.",
+                                        {{ParameterType::INT, "Number of sleeping objects"}},
+                                        "system"
+                                        );
+    m_pComInterface->registerFunction("get_rails_threshold",
+                                        CCommand<double>([&]() -> double
+                                        {
+                                            return m_pDataStorage->getKinematicsStore()->getRailsThreshold();
+                                        }),
+                                        "Return perturbation relative to dominant gravitation below which objects go on rails.",
+                                        {{ParameterType::DOUBLE, "Relative perturbation"}},
+                                        "system"
+                                        );
+    m_pComInterface->registerFunction("get_sleep_acceleration_threshold",
+                                        CCommand<double>([&]() -> double {return m_IslandManager.getAccelerationThreshold();}),
+                                        "Return change of acceleration, linear and angular, waking sleeping objects.",
+                                        {{ParameterType::DOUBLE, "Acceleration threshold"}},
+                                        "system"
+                                        );
+    m_pComInterface->registerFunction("get_sleep_angle_velocity_threshold",
+                                        CCommand<double>([&]() -> double {return m_IslandManager.getAngleVelocityThreshold();}),
+                                        "Return angle velocity below which objects are at rest.",
+                                        {{ParameterType::DOUBLE, "Angle velocity threshold"}},
+                                        "system"
+                                        );
+    m_pComInterface->registerFunction("get_sleep_frames",
+                                        CCommand<int>([&]() -> int {return m_IslandManager.getFrames();}),
+                                        "Return number of frames objects are at rest before falling asleep.",
+                                        {{ParameterType::INT, "Number of frames"}},
+                                        "system"
+                                        );
+    m_pComInterface->registerFunction("get_sleep_velocity_threshold",
+                                        CCommand<double>([&]() -> double {return m_IslandManager.getVelocityThreshold();}),
+                                        "Return velocity below which objects are at rest.",
+                                        {{ParameterType::DOUBLE, "Velocity threshold"}},
+                                        "system"
+                                        );
+    m_pComInterface->registerFunction("get_substeps_adaptive",
+                                        CCommand<int>([&]() -> int
+                                        {
+                                            return m_pDataStorage->getKinematicsStore()->getNumberOfSubSteps();
+                                        }),
+                                        "Return number of sub-steps of all adaptively integrated objects in last step.",
+                                        {{ParameterType::INT, "Number of sub-steps"}},
+                                        "system"
+                                        );
+    m_pComInterface->registerFunction("get_substeps_adaptive_max",
+                                        CCommand<int>([&]() -> int
+                                        {
+                                            return m_pDataStorage->getKinematicsStore()->getNumberOfSubStepsMax();
+                                        }),
+                                        "Return maximum number of sub-steps of one adaptively integrated object in last step.",
+                                        {{ParameterType::INT, "Maximum number of sub-steps"}},
+                                        "system"
+                                        );
+    m_pComInterface->registerFunction("get_substeps_adaptive_rejected",
+                                        CCommand<int>([&]() -> int
+                                        {
+                                            return m_pDataStorage->getKinematicsStore()->getNumberOfRejectedSteps();
+                                        }),
+                                        "Return number of rejected sub-steps of all adaptively integrated objects in last step.",
+                                        {{ParameterType::INT, "Number of rejected sub-steps"}},
+                                        "system"
+                                        );
+    m_pComInterface->registerFunction("get_workers_particles",
+                                        CCommand<int>([&]() -> int {return m_ParticleDynamics.getNumberOfWorkers();}),
+                                        "Return number of workers for particle dynamics.",
+                                        {{ParameterType::INT, "Number of workers"}},
+                                        "system"
+                                        );
+    m_pComInterface->registerFunction("get_workers_physics",
+                                        CCommand<int>([&]() -> int {return m_ForceAccumulator.getNumberOfWorkers();}),
+                                        "Return number of workers for force accumulation.",
+                                        {{ParameterType::INT, "Number of workers"}},
+                                        "system"
+                                        );
     m_pComInterface->registerFunction("get_time_processed_physics",
                                         CCommand<double>([&]() -> double {return this->getTimeProcessed();}),
                                         "Return time used for processing.",
                                         {{ParameterType::DOUBLE, "Time used for processing"}},
                                         "system"
                                         );
+    m_pComInterface->registerFunction("get_time_processed_physics_broad_phase",
+                                        CCommand<double>([&]() -> double {return m_TimeProcessedBroadPhase.getTime();}),
+                                        "Return time used for collision broad phase.",
+                                        {{ParameterType::DOUBLE, "Time used for collision broad phase"}},
+                                        "system"
+                                        );
     m_pComInterface->registerFunction("get_time_processed_physics_buffer_copy",
                                         CCommand<double>([&]() -> double {return m_TimeProcessedBufferCopy.getTime();}),
                                         "Return time used for copying object buffers.",
                                         {{ParameterType::DOUBLE, "Time used for object buffer copy"}},
                                         "system"
                                         );
+    m_pComInterface->registerFunction("get_time_processed_physics_class",
+                                        CCommand<double, std::string>([&](const std::string& _strClass) -> double
+                                        {
+                                            const RateClassType Class = mapStringToRateClassType(_strClass);
+                                            if (Class == RateClassType::NONE)
+                                            {
+                                                WARNING_MSG("Physics Manager", "Unknown rate class " << _strClass << ".")
+                                                return 0.0;
+                                            }
+                                            return m_Scheduler.getCostFrame(Class);
+                                        }),
+                                        "Return time used for processing given class within last frame.",
+                                        {{ParameterType::DOUBLE, "Time used for processing class"},
+                                        {ParameterType::STRING, "Rate class ("+ossRateClassType.str()+" )"}},
+                                        "system"
+                                        );
+    m_pComInterface->registerFunction("get_time_processed_physics_class_average",
+                                        CCommand<double, std::string>([&](const std::string& _strClass) -> double
+                                        {
+                                            const RateClassType Class = mapStringToRateClassType(_strClass);
+                                            if (Class == RateClassType::NONE)
+                                            {
+                                                WARNING_MSG("Physics Manager", "Unknown rate class " << _strClass << ".")
+                                                return 0.0;
+                                            }
+                                            return m_Scheduler.getCostAverage(Class);
+                                        }),
+                                        "Return average time per frame used for processing given class.",
+                                        {{ParameterType::DOUBLE, "Average time per frame used for processing class"},
+                                        {ParameterType::STRING, "Rate class ("+ossRateClassType.str()+" )"}},
+                                        "system"
+                                        );
+    m_pComInterface->registerFunction("get_time_processed_physics_collisions",
+                                        CCommand<double>([&]() -> double {return m_TimeProcessedCollisions.getTime();}),
+                                        "Return time used for collision narrow phase.",
+                                        {{ParameterType::DOUBLE, "Time used for collision narrow phase"}},
+                                        "system"
+                                        );
     m_pComInterface->registerFunction("get_time_processed_physics_objects",
                                         CCommand<double>([&]() -> double {return m_TimeProcessedObjects.getTime();}),
                                         "Return time used for object processing.",
@@ -1032,6 +1712,30 @@ void CPhysicsManager::myInitComInterface()
                                         {ParameterType::STRING, "Particle type (" + ossParticleType.str() + " )"}},
                                         "system", "physics"
                                         );
+    m_pComInterface->registerFunction("disable_rails",
+                                        CCommand<void>([&](){m_pDataStorage->getKinematicsStore()->disableRails();}),
+                                        "Disables rails, objects on conic orbits are integrated again.",
+                                        {{ParameterType::NONE, "No return value"}},
+                                        "system", "physics"
+                                        );
+    m_pComInterface->registerFunction("enable_rails",
+                                        CCommand<void>([&](){m_pDataStorage->getKinematicsStore()->enableRails();}),
+                                        "Enables rails, unperturbed objects are propagated on conic orbits.",
+                                        {{ParameterType::NONE, "No return value"}},
+                                        "system", "physics"
+                                        );
+    m_pComInterface->registerFunction("disable_sleeping",
+                                        CCommand<void>([&](){m_IslandManager.disable();}),
+                                        "Disables sleeping, sleeping objects are woken.",
+                                        {{ParameterType::NONE, "No return value"}},
+                                        "system", "physics"
+                                        );
+    m_pComInterface->registerFunction("enable_sleeping",
+                                        CCommand<void>([&](){m_IslandManager.enable();}),
+                                        "Enables sleeping, resting objects and islands are parked.",
+                                        {{ParameterType::NONE, "No return value"}},
+                                        "system", "physics"
+                                        );
     m_pComInterface->registerFunction("decelerate_time",
                                         CCommand<void>([&](){this->decelerateTime();}),
                                         "Decelerates time.",
@@ -1050,7 +1754,7 @@ void CPhysicsManager::myInitComInterface()
                                         {
                                             int nUID(0);
                                             m_pDataStorage->AccessNames.acquireLock();
-                                            const auto ci = m_pDataStorage->getUIDsByName()->find(_strName);
+                                            const auto ci = m_pDataStorage->getUIDsByName()->find(CStringTable::find(_strName));
                                             if (ci != m_pDataStorage->getUIDsByName()->end())
                                             {
                                                 nUID = ci->second;
@@ -1139,12 +1843,115 @@ void CPhysicsManager::myInitComInterface()
                                         CCommand<void, double>([&](const double& _fFrequency)
                                         {
                                             this->setFrequency(_fFrequency);
-                                            this->setFrequencyParticle(_fFrequency);
+                                            for (const auto& Class : mapRateClassToString)
+                                                m_Scheduler.setFrequency(Class.first, _fFrequency);
                                         }),
-                                        "Sets the frequency of the physics thread.",
+                                        "Sets the frequency of the physics thread and of all classes.",
                                         {{ParameterType::NONE, "No return value"},
                                         {ParameterType::DOUBLE, "Frequency"}},
                                         "system", "physics");
+    m_pComInterface->registerFunction("set_frequency_physics_class",
+                                        CCommand<void, std::string, double>([&](const std::string& _strClass, const double& _fFrequency)
+                                        {
+                                            m_Scheduler.setFrequency(mapStringToRateClassType(_strClass), _fFrequency);
+                                        }),
+                                        "Sets the frequency of given class, limited by frequency of the physics thread.",
+                                        {{ParameterType::NONE, "No return value"},
+                                        {ParameterType::STRING, "Rate class ("+ossRateClassType.str()+" )"},
+                                        {ParameterType::DOUBLE, "Frequency"}},
+                                        "system", "physics");
+    m_pComInterface->registerFunction("set_particle_chunk_size",
+                                        CCommand<void, int>([&](const int _nChunkSize)
+                                        {
+                                            m_ParticleDynamics.setChunkSize(_nChunkSize);
+                                        }),
+                                        "Sets the number of particles per chunk for parallel particle dynamics.",
+                                        {{ParameterType::NONE, "No return value"},
+                                        {ParameterType::INT, "Number of particles per chunk"}},
+                                        "system", "physics");
+    m_pComInterface->registerFunction("set_rails_threshold",
+                                        CCommand<void, double>([&](const double& _fThreshold)
+                                        {
+                                            m_pDataStorage->getKinematicsStore()->setRailsThreshold(_fThreshold);
+                                        }),
+                                        "Sets the perturbation relative to dominant gravitation below which objects go on rails.",
+                                        {{ParameterType::NONE, "No return value"},
+                                        {ParameterType::DOUBLE, "Relative perturbation"}},
+                                        "system", "physics");
+    m_pComInterface->registerFunction("set_sleep_acceleration_threshold",
+                                        CCommand<void, double>([&](const double& _fAcceleration)
+                                        {
+                                            m_IslandManager.setAccelerationThreshold(_fAcceleration);
+                                        }),
+                                        "Sets the change of acceleration, linear and angular, waking sleeping objects.",
+                                        {{ParameterType::NONE, "No return value"},
+                                        {ParameterType::DOUBLE, "Acceleration threshold"}},
+                                        "system", "physics");
+    m_pComInterface->registerFunction("set_sleep_angle_velocity_threshold",
+                                        CCommand<void, double>([&](const double& _fAngleVelocity)
+                                        {
+                                            m_IslandManager.setAngleVelocityThreshold(_fAngleVelocity);
+                                        }),
+                                        "Sets the angle velocity below which objects are at rest.",
+                                        {{ParameterType::NONE, "No return value"},
+                                        {ParameterType::DOUBLE, "Angle velocity threshold"}},
+                                        "system", "physics");
+    m_pComInterface->registerFunction("set_sleep_frames",
+                                        CCommand<void, int>([&](const int _nFrames)
+                                        {
+                                            m_IslandManager.setFrames(_nFrames);
+                                        }),
+                                        "Sets the number of frames objects are at rest before falling asleep.",
+                                        {{ParameterType::NONE, "No return value"},
+                                        {ParameterType::INT, "Number of frames"}},
+                                        "system", "physics");
+    m_pComInterface->registerFunction("set_sleep_velocity_threshold",
+                                        CCommand<void, double>([&](const double& _fVelocity)
+                                        {
+                                            m_IslandManager.setVelocityThreshold(_fVelocity);
+                                        }),
+                                        "Sets the velocity below which objects are at rest.",
+                                        {{ParameterType::NONE, "No return value"},
+                                        {ParameterType::DOUBLE, "Velocity threshold"}},
+                                        "system", "physics");
+    m_pComInterface->registerFunction("set_substeps_adaptive_max",
+                                        CCommand<void, int>([&](const int _nMaxSubSteps)
+                                        {
+                                            m_pDataStorage->getKinematicsStore()->setMaxSubSteps(_nMaxSubSteps);
+                                        }),
+                                        "Sets the maximum number of sub-steps of an adaptively integrated object per step.",
+                                        {{ParameterType::NONE, "No return value"},
+                                        {ParameterType::INT, "Maximum number of sub-steps"}},
+                                        "system", "physics");
+    m_pComInterface->registerFunction("set_tolerance_adaptive",
+                                        CCommand<void, double, double>([&](const double& _fToleranceRel,
+                                                                           const double& _fToleranceAbs)
+                                        {
+                                            m_pDataStorage->getKinematicsStore()->setTolerance(_fToleranceRel, _fToleranceAbs);
+                                        }),
+                                        "Sets the tolerances of the local error of adaptively integrated objects.",
+                                        {{ParameterType::NONE, "No return value"},
+                                        {ParameterType::DOUBLE, "Relative tolerance"},
+                                        {ParameterType::DOUBLE, "Absolute tolerance"}},
+                                        "system", "physics");
+    m_pComInterface->registerFunction("set_workers_particles",
+                                        CCommand<void, int>([&](const int _nWorkers)
+                                        {
+                                            m_ParticleDynamics.setNumberOfWorkers(_nWorkers);
+                                        }),
+                                        "Sets the number of workers for particle dynamics (1 equals serial processing).",
+                                        {{ParameterType::NONE, "No return value"},
+                                        {ParameterType::INT, "Number of workers"}},
+                                        "system", "physics");
+    m_pComInterface->registerFunction("set_workers_physics",
+                                        CCommand<void, int>([&](const int _nWorkers)
+                                        {
+                                            m_ForceAccumulator.setNumberOfWorkers(_nWorkers);
+                                        }),
+                                        "Sets the number of workers for force accumulation (1 equals serial processing).",
+                                        {{ParameterType::NONE, "No return value"},
+                                        {ParameterType::INT, "Number of workers"}},
+                                        "system", "physics");
     m_pComInterface->registerFunction("sync_to_physics",
                                         CCommand<void>([&]()
                                         {
@@ -1710,6 +2517,22 @@ void CPhysicsManager::myInitComInterface()
                                         {ParameterType::INT, "Object UID"}},
                                         "physics", "physics"
                                         );
+    m_pComInterface->registerFunction("obj_set_integrator",
+                                        CCommand<void, int, std::string>(
+                                        [&](const int _nUID, const std::string& _strIntegrator)
+                                        {
+                                            CObject* pObj = m_pDataStorage->getObjectByValueBack(_nUID);
+                                            if (pObj != nullptr)
+                                            {
+                                                pObj->setNewIntegrator(mapStringToIntegratorType(_strIntegrator));
+                                            }
+                                        }),
+                                        "Sets integrator of a given object.",
+                                        {{ParameterType::NONE, "No return value"},
+                                        {ParameterType::INT, "Object UID"},
+                                        {ParameterType::STRING, "Integrator ("+ossIntegratorType.str()+" )"}},
+                                        "physics", "physics"
+                                        );
     m_pComInterface->registerFunction("obj_set_name",
                                         CCommand<void, int, std::string>(
                                         [&](const int _nUID, const std::string& _strName)
@@ -1721,8 +2544,8 @@ void CPhysicsManager::myInitComInterface()
                                                 pObj->setName(_strName);
                                                 
                                                 m_pDataStorage->AccessNames.acquireLock();
-                                                m_pDataStorage->getUIDsByName()->insert({_strName, pObj->getUID()});
-                                                m_pDataStorage->getUIDsByName()->erase(strNameOld);
+                                                m_pDataStorage->getUIDsByName()->insert({CStringTable::intern(_strName), pObj->getUID()});
+                                                m_pDataStorage->getUIDsByName()->erase(CStringTable::find(strNameOld));
                                                 m_pDataStorage->AccessNames.releaseLock();
                                             }
                                         }),
@@ -1767,6 +2590,139 @@ void CPhysicsManager::myInitComInterface()
                                         {ParameterType::DOUBLE, "Velocity Y"}},
                                         "physics", "physics"
                                         );
+    m_pComInterface->registerFunction("objs_apply_force",
+                                        CCommand<void, std::vector<double>, std::vector<double>>(
+                                        [&](const std::vector<double>& _UIDs, const std::vector<double>& _Forces)
+                                        {
+                                            if (_Forces.size() != 4*_UIDs.size())
+                                            {
+                                                throw CComInterfaceException(ComIntExceptionType::PARAM_ERROR);
+                                            }
+                                            // Check all objects first, hence, nothing is changed if one is unknown
+                                            std::vector<CObject*> Objects(_UIDs.size(), nullptr);
+                                            for (auto i=0u; i<_UIDs.size(); ++i)
+                                            {
+                                                Objects[i] = m_pDataStorage->getObjectByValueBack(static_cast<UIDType>(_UIDs[i]));
+                                                if (Objects[i] == nullptr)
+                                                {
+                                                    throw CComInterfaceException(ComIntExceptionType::INVALID_VALUE);
+                                                }
+                                            }
+                                            for (auto i=0u; i<_UIDs.size(); ++i)
+                                            {
+                                                Objects[i]->addForceLC(Vector2d(_Forces[4*i], _Forces[4*i+1]),
+                                                                       Vector2d(_Forces[4*i+2], _Forces[4*i+3]));
+                                            }
+                                        }),
+                                        "Applies forces on given objects at once.",
+                                        {{ParameterType::NONE, "No return value"},
+                                        {ParameterType::DYN_ARRAY, "Object UIDs"},
+                                        {ParameterType::DYN_ARRAY, "Forces and points of attack (Fx0, Fy0, Px0, Py0, ... FxN, FyN, PxN, PyN)"}},
+                                        "physics", "physics"
+                                        );
+    m_pComInterface->registerFunction("objs_get_position",
+                                        CCommand<std::vector<double>, std::vector<double>>(
+                                            [&](const std::vector<double>& _UIDs) -> std::vector<double>
+                                            {
+                                            std::vector<double> Positions(2*_UIDs.size(), 0.0);
+                                            for (auto i=0u; i<_UIDs.size(); ++i)
+                                            {
+                                                CObject* pObj = m_pDataStorage->getObjectByValueBack(static_cast<UIDType>(_UIDs[i]));
+                                                if (pObj == nullptr)
+                                                {
+                                                    throw CComInterfaceException(ComIntExceptionType::INVALID_VALUE);
+                                                }
+                                                Positions[2*i]   = pObj->getOrigin()[0];
+                                                Positions[2*i+1] = pObj->getOrigin()[1];
+                                            }
+                                            return Positions;
+                                            }),
+                                        "Returns positions of given objects at once.",
+                                        {{ParameterType::DYN_ARRAY, "Positions (x0, y0, ... xN, yN)"},
+                                        {ParameterType::DYN_ARRAY, "Object UIDs"}},
+                                        "physics"
+                                        );
+    m_pComInterface->registerFunction("objs_get_velocity",
+                                        CCommand<std::vector<double>, std::vector<double>>(
+                                            [&](const std::vector<double>& _UIDs) -> std::vector<double>
+                                            {
+                                            std::vector<double> Velocities(2*_UIDs.size(), 0.0);
+                                            for (auto i=0u; i<_UIDs.size(); ++i)
+                                            {
+                                                CObject* pObj = m_pDataStorage->getObjectByValueBack(static_cast<UIDType>(_UIDs[i]));
+                                                if (pObj == nullptr)
+                                                {
+                                                    throw CComInterfaceException(ComIntExceptionType::INVALID_VALUE);
+                                                }
+                                                Velocities[2*i]   = pObj->getVelocity()[0];
+                                                Velocities[2*i+1] = pObj->getVelocity()[1];
+                                            }
+                                            return Velocities;
+                                            }),
+                                        "Returns velocities of given objects at once.",
+                                        {{ParameterType::DYN_ARRAY, "Velocities (x0, y0, ... xN, yN)"},
+                                        {ParameterType::DYN_ARRAY, "Object UIDs"}},
+                                        "physics"
+                                        );
+    m_pComInterface->registerFunction("objs_set_position",
+                                        CCommand<void, std::vector<double>, std::vector<double>>(
+                                        [&](const std::vector<double>& _UIDs, const std::vector<double>& _Positions)
+                                        {
+                                            if (_Positions.size() != 2*_UIDs.size())
+                                            {
+                                                throw CComInterfaceException(ComIntExceptionType::PARAM_ERROR);
+                                            }
+                                            // Check all objects first, hence, nothing is changed if one is unknown
+                                            std::vector<CObject*> Objects(_UIDs.size(), nullptr);
+                                            for (auto i=0u; i<_UIDs.size(); ++i)
+                                            {
+                                                Objects[i] = m_pDataStorage->getObjectByValueBack(static_cast<UIDType>(_UIDs[i]));
+                                                if (Objects[i] == nullptr)
+                                                {
+                                                    throw CComInterfaceException(ComIntExceptionType::INVALID_VALUE);
+                                                }
+                                            }
+                                            for (auto i=0u; i<_UIDs.size(); ++i)
+                                            {
+                                                Objects[i]->setOrigin(_Positions[2*i], _Positions[2*i+1]);
+                                                Objects[i]->init();
+                                            }
+                                        }),
+                                        "Sets positions of given objects at once.",
+                                        {{ParameterType::NONE, "No return value"},
+                                        {ParameterType::DYN_ARRAY, "Object UIDs"},
+                                        {ParameterType::DYN_ARRAY, "Positions (x0, y0, ... xN, yN)"}},
+                                        "physics", "physics"
+                                        );
+    m_pComInterface->registerFunction("objs_set_velocity",
+                                        CCommand<void, std::vector<double>, std::vector<double>>(
+                                        [&](const std::vector<double>& _UIDs, const std::vector<double>& _Velocities)
+                                        {
+                                            if (_Velocities.size() != 2*_UIDs.size())
+                                            {
+                                                throw CComInterfaceException(ComIntExceptionType::PARAM_ERROR);
+                                            }
+                                            // Check all objects first, hence, nothing is changed if one is unknown
+                                            std::vector<CObject*> Objects(_UIDs.size(), nullptr);
+                                            for (auto i=0u; i<_UIDs.size(); ++i)
+                                            {
+                                                Objects[i] = m_pDataStorage->getObjectByValueBack(static_cast<UIDType>(_UIDs[i]));
+                                                if (Objects[i] == nullptr)
+                                                {
+                                                    throw CComInterfaceException(ComIntExceptionType::INVALID_VALUE);
+                                                }
+                                            }
+                                            for (auto i=0u; i<_UIDs.size(); ++i)
+                                            {
+                                                Objects[i]->setVelocity(Vector2d(_Velocities[2*i], _Velocities[2*i+1]));
+                                            }
+                                        }),
+                                        "Sets velocities of given objects at once.",
+                                        {{ParameterType::NONE, "No return value"},
+                                        {ParameterType::DYN_ARRAY, "Object UIDs"},
+                                        {ParameterType::DYN_ARRAY, "Velocities (x0, y0, ... xN, yN)"}},
+                                        "physics", "physics"
+                                        );
     m_pComInterface->registerFunction("remove_shape",
                                         CCommand<void, int>(
                                         [&](const int _nUID)
@@ -1778,6 +2734,46 @@ void CPhysicsManager::myInitComInterface()
                                         {ParameterType::INT, "Shapes UID"}},
                                         "physics", "physics"
                                         );
+    m_pComInterface->registerFunction("get_gravity_opening_angle",
+                                        CCommand<double>([&]() -> double
+                                        {
+                                            return m_GravityTreeActive.getOpeningAngle();
+                                        }),
+                                        "Returns opening angle of Barnes-Hut gravitation.",
+                                        {{ParameterType::DOUBLE, "Opening angle"}},
+                                        "physics"
+                                        );
+    m_pComInterface->registerFunction("set_gravity_mode",
+                                        CCommand<void, std::string>([&](const std::string& _strMode)
+                                        {
+                                            this->setGravityMode(mapStringToGravityModeType(_strMode));
+                                        }),
+                                        "Set algorithm for calculation of gravitation.",
+                                        {{ParameterType::NONE, "No return value"},
+                                        {ParameterType::STRING, "Mode ("+ossGravityModeType.str()+" )"}},
+                                        "physics", "physics"
+                                        );
+    m_pComInterface->registerFunction("set_gravity_opening_angle",
+                                        CCommand<void, double>([&](const double& _fTheta)
+                                        {
+                                            m_GravityTreeActive.setOpeningAngle(_fTheta);
+                                            m_GravityTreePassive.setOpeningAngle(_fTheta);
+                                        }),
+                                        "Set opening angle of Barnes-Hut gravitation (0 is exact, larger is faster).",
+                                        {{ParameterType::NONE, "No return value"},
+                                        {ParameterType::DOUBLE, "Opening angle"}},
+                                        "physics", "physics"
+                                        );
+    m_pComInterface->registerFunction("set_particle_hash_bucket_size",
+                                        CCommand<void, double>([&](const double& _fBucketSize)
+                                        {
+                                            m_CollisionManager.setParticleBucketSize(_fBucketSize);
+                                        }),
+                                        "Set edge length of sub-cells of spatial hash for particle collisions.",
+                                        {{ParameterType::NONE, "No return value"},
+                                        {ParameterType::DOUBLE, "Edge length of sub-cells"}},
+                                        "physics", "physics"
+                                        );
     m_pComInterface->registerFunction("set_gravity_vector",
                                         CCommand<void, double, double>(
                                             [&](const double& _fGX, const double& _fGY)
@@ -2118,10 +3114,15 @@ void CPhysicsManager::processQueues()
     }
     m_pDataStorage->AccessEmitters.releaseLock();
     
-    CObject* pObj = nullptr;
-    while (m_ObjectsToBeAddedToWorld.try_dequeue(pObj))
+    // Objects and shapes might be created in batches, dequeue in bulk
+    std::array<CObject*, PHYSICS_DEQUEUE_BULK_SIZE> Objs;
+    std::size_t nObjs = 0u;
+    while ((nObjs = m_ObjectsToBeAddedToWorld.try_dequeue_bulk(Objs.begin(), Objs.size())) > 0u)
     {
-        m_pDataStorage->addObject(pObj);
+        for (auto i=0u; i<nObjs; ++i)
+        {
+            m_pDataStorage->addObject(Objs[i]);
+        }
     }
     CObjectPlanet* pObjPl = nullptr;
     while (m_ObjectsPlanetsToBeAddedToWorld.try_dequeue(pObjPl))
@@ -2138,10 +3139,14 @@ void CPhysicsManager::processQueues()
     }
     m_pDataStorage->AccessParticles.releaseLock();
     
-    IShape* pShp = nullptr;
-    while (m_ShapesToBeAddedToWorld.try_dequeue(pShp))
+    std::array<IShape*, PHYSICS_DEQUEUE_BULK_SIZE> Shps;
+    std::size_t nShps = 0u;
+    while ((nShps = m_ShapesToBeAddedToWorld.try_dequeue_bulk(Shps.begin(), Shps.size())) > 0u)
     {
-        m_pDataStorage->addShape(pShp);
+        for (auto i=0u; i<nShps; ++i)
+        {
+            m_pDataStorage->addShape(Shps[i]);
+        }
     }
     m_pDataStorage->AccessShapes.releaseLock();
     
@@ -2167,8 +3172,10 @@ void CPhysicsManager::processQueues()
 /// Since the actual frequency might be higher than the frequency the method is
 /// called at, the number of objects updated is chosen accordingly.
 ///
+/// \param _fFrequency Frequency this method is called at
+///
 ///////////////////////////////////////////////////////////////////////////////
-void CPhysicsManager::updateCells()
+void CPhysicsManager::updateCells(const double& _fFrequency)
 {
     METHOD_ENTRY("CPhysicsManager::updateCells")
     
@@ -2178,7 +3185,7 @@ void CPhysicsManager::updateCells()
                         m_fTimeAccel *
                         m_pDataStorage->getObjectsByValueBack()->size()/DEFAULT_CELL_SIZE_2;
                         
-    double          fNrOfObj = fFreq/m_fFrequency + m_fCellUpdateResidual;
+    double          fNrOfObj = fFreq/_fFrequency + m_fCellUpdateResidual;
     std::uint32_t   nNrOfObj = static_cast<std::uint32_t>(fNrOfObj);
 
     if (nNrOfObj > m_pDataStorage->getObjectsByValueBack()->size())
@@ -32,12 +32,20 @@
 #define PHYSICS_MANAGER_H
 
 //--- Standard header --------------------------------------------------------//
+#include <array>
+#include <functional>
+#include <vector>
 
 //--- Program header ---------------------------------------------------------//
 #include "collision_manager.h"
 #include "com_interface_provider.h"
 #include "emitter.h"
+#include "force_accumulator.h"
+#include "gravity_tree.h"
+#include "island_manager.h"
+#include "multi_rate_scheduler.h"
 #include "object_planet.h"
+#include "particle_dynamics.h"
 #include "sim_timer.h"
 #include "thread_module.h"
 #include "thruster.h"
@@ -50,6 +58,47 @@ const bool        PHYSICS_ALLOW_STEP_SIZE_INC   = true;     ///< Increasing step
 const bool        PHYSICS_FORBID_STEP_SIZE_INC  = false;    ///< Increasing step size when accelerating is forbidden
 const double      PHYSICS_DEFAULT_FREQUENCY     = 200.0;    ///< Default physics frequency
 const double      PHYSICS_PARTICLE_DEFAULT_FREQUENCY = 30.0;  ///< Default physics frequency for particle
+const std::size_t PHYSICS_BATCH_UIDS_FIRST      = 16u;      ///< UIDs reserved for first entity of a batch to count UIDs per entity
+const std::size_t PHYSICS_DEQUEUE_BULK_SIZE     = 256u;     ///< Maximum number of new entities dequeued at once
+
+//--- Enumerations -----------------------------------------------------------//
+
+/// Specifies the algorithm used for calculation of gravitation
+enum class GravityModeType
+{
+    NONE,
+    PAIRWISE,
+    BARNES_HUT
+};
+
+//--- Enum parser ------------------------------------------------------------//
+const std::map<GravityModeType, std::string> mapGravityModeToString = {
+    {GravityModeType::PAIRWISE, "pairwise"},
+    {GravityModeType::BARNES_HUT, "barnes_hut"}
+}; ///< Map from GravityModeType to string
+
+const std::map<std::string, GravityModeType> STRING_TO_GRAVITY_MODE_TYPE_MAP = {
+    {"pairwise", GravityModeType::PAIRWISE},
+    {"barnes_hut", GravityModeType::BARNES_HUT}
+}; ///< Map from string to GravityModeType
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Maps given string to gravity mode
+///
+/// \return Gravity mode
+///
+////////////////////////////////////////////////////////////////////////////////
+static GravityModeType mapStringToGravityModeType(const std::string& _strS)
+{
+    METHOD_ENTRY("mapStringToGravityModeType")
+    
+    const auto ci = STRING_TO_GRAVITY_MODE_TYPE_MAP.find(_strS);
+    if (ci != STRING_TO_GRAVITY_MODE_TYPE_MAP.end())
+        return ci->second;
+    else
+        return GravityModeType::NONE;
+}
 
 //--- Type definitions -------------------------------------------------------//
 
@@ -92,13 +141,18 @@ class CPhysicsManager : public IComInterfaceProvider,
         UIDType createEmitter(const std::string&);
         UIDType createObject();
         UIDType createObjectPlanet();
+        std::vector<UIDType> createObjects(const int);
         UIDType createParticles(const ParticleTypeType);
         UIDType createParticles(const std::string&);
         UIDType createShape(const ShapeType);
         UIDType createShape(const std::string&);
+        std::vector<UIDType> createShapes(const ShapeType, const int);
+        std::vector<UIDType> createShapes(const std::string&, const int);
+        std::vector<UIDType> createShapesPolygon(const int, const std::vector<double>&);
         UIDType createThruster();
         
         void setConstantGravity(const Vector2d&);
+        void setGravityMode(const GravityModeType&);
         void setFrequencyParticle(const double&);
         
         void pause();
@@ -119,11 +173,16 @@ class CPhysicsManager : public IComInterfaceProvider,
         
         //--- Methods [private] ----------------------------------------------//
         void addGlobalForces();
-        void collisionDetection();
-        void dynamics(std::uint64_t);
+        void addGravitationBarnesHut();
+        void addGravitationPairwise();
+        void collisionDetection(const bool, const bool);
+        void createBatch(const int, const std::function<void(const int)>&);
+        void dynamicsObjects(const double&);
+        void dynamicsParticles(const double&);
+        void emit(const double&);
         void myInitComInterface();
         void processQueues();
-        void updateCells();
+        void updateCells(const double&);
         
         EmittersQueueType   m_EmittersToBeAddedToWorld;         ///< Emitters already created to be added to world
         ObjectsQueueType    m_ObjectsToBeAddedToWorld;          ///< Objects already created to be added to world
@@ -133,11 +192,19 @@ class CPhysicsManager : public IComInterfaceProvider,
         ThrustersQueueType  m_ThrustersToBeAddedToWorld;        ///< Thrusters already created to be added to world
         
         CCollisionManager   m_CollisionManager;                 ///< Instance for collision handling
+        CForceAccumulator   m_ForceAccumulator;                 ///< Per worker accumulation of forces
+        CIslandManager      m_IslandManager;                    ///< Sleeping of resting objects, grouped by joints
+        CMultiRateScheduler m_Scheduler;                        ///< Rates of objects, particles, emitters, thrusters and cells
+        CParticleDynamics   m_ParticleDynamics;                 ///< Per worker dynamics of particle chunks
+        std::vector<IEmitter*> m_EmittersOrdered;               ///< Emitters of current frame, ordered by UID
 
         double              m_fG;                               ///< Gravitational constant
-        double              m_fFrequencyParticle;                 ///< Frequency of particle physics processing
         
         Vector2d                    m_vecConstantGravitation;   ///< Vector for constant gravitation
+        GravityModeType             m_GravityMode;              ///< Algorithm for calculation of gravitation
+        CGravityTree                m_GravityTreeActive;        ///< Barnes-Hut tree of gravitating objects
+        CGravityTree                m_GravityTreePassive;       ///< Barnes-Hut tree of non-gravitating objects
+        std::vector<int>            m_GravityIndices;           ///< Index of objects within their gravity tree
 
         UIDType                     m_nCellUpdateLast;          ///< Last updated object concerning grid cells
         double                      m_fCellUpdateResidual;      ///< Residual for calculation of cell update
@@ -147,11 +214,13 @@ class CPhysicsManager : public IComInterfaceProvider,
         
         std::array<CSimTimer,4>     m_SimTimer;                 ///< Timer / stop watch in simulation time
 
+        CTimer              m_TimeProcessedBroadPhase;          ///< Counts processing time for collision broad phase
         CTimer              m_TimeProcessedBufferCopy;          ///< Counts processing time for buffer copy
+        CTimer              m_TimeProcessedCollisions;          ///< Counts processing time for collision narrow phase
         CTimer              m_TimeProcessedObjects;             ///< Counts processing time for objects
         CTimer              m_TimeProcessedParticles;           ///< Counts processing time for particles
         
-        CSpinlock           m_CreatorLock;                      ///< Indicates if objects might be created
+        CAdaptiveLock       m_CreatorLock{"CPhysicsManager::m_CreatorLock"};                 ///< Indicates if objects might be created
 };
 
 //--- Implementation is done here for inline optimisation --------------------//
@@ -182,6 +251,24 @@ inline void CPhysicsManager::setConstantGravity(const Vector2d& _vecG)
     m_vecConstantGravitation = _vecG;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Set algorithm for calculation of gravitation
+///
+/// \param _GravityMode Gravity mode
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CPhysicsManager::setGravityMode(const GravityModeType& _GravityMode)
+{
+    METHOD_ENTRY("CPhysicsManager::setGravityMode")
+    if (_GravityMode == GravityModeType::NONE)
+    {
+        WARNING_MSG("Physics Manager", "Unknown gravity mode, keeping current mode.")
+        return;
+    }
+    m_GravityMode = _GravityMode;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Set frequency for particle physics processing
@@ -192,7 +279,7 @@ inline void CPhysicsManager::setConstantGravity(const Vector2d& _vecG)
 inline void CPhysicsManager::setFrequencyParticle(const double& _fFrequency)
 {
     METHOD_ENTRY("CPhysicsManager::setFrequencyParticle")
-    m_fFrequencyParticle = _fFrequency;
+    m_Scheduler.setFrequency(RateClassType::PARTICLES, _fFrequency);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
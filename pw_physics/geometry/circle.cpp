@@ -70,7 +70,7 @@ CCircle* CCircle::clone() const
 {
     METHOD_ENTRY("CCircle::clone");
     
-    CCircle* pClone = new CCircle();
+    CCircle* pClone = new (PoolNeighbourType{this}) CCircle();
     MEM_ALLOC("IShape")
         
     pClone->copy(this);
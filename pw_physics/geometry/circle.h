@@ -52,6 +52,9 @@ class CCircle : public IShape
         CCircle();
         virtual ~CCircle();
         
+        //--- Memory management ----------------------------------------------//
+        POOL_ALLOCATION(CCircle, BUFFER_QUADRUPLE)
+
         //--- Constant Methods -----------------------------------------------//
         CCircle*            clone() const;
         
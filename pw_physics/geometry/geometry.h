@@ -64,6 +64,7 @@ class CGeometry
 
         //--- Constant methods -----------------------------------------------//
         CGeometry*                clone() const;
+        const CBoundingBox&       getBoundingBox(AABBType = AABBType::MULTIFRAME) const;
         const Vector2d&           getCOM() const;
         const double&             getInertia() const;
         const double&             getMass() const;
@@ -160,6 +161,24 @@ inline const ShapesType& CGeometry::getShapes() const
     return m_Shapes;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns the bounding box
+///
+/// \param _AABBType Type of bounding box, either single or multi frame
+///
+/// \return Bounding box
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const CBoundingBox& CGeometry::getBoundingBox(AABBType _AABBType) const
+{
+    METHOD_ENTRY("CGeometry::getBoundingBox")
+    if (_AABBType == AABBType::MULTIFRAME)
+        return m_AABB;
+    else
+        return m_AABBS;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Returns the bounding box
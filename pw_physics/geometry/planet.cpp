@@ -85,7 +85,7 @@ CPlanet* CPlanet::clone() const
 {
     METHOD_ENTRY("CPlanet::clone")
     
-    CPlanet* pClone = new CPlanet();
+    CPlanet* pClone = new (PoolNeighbourType{this}) CPlanet();
     MEM_ALLOC("IShape")
         
     pClone->copy(this);
@@ -75,6 +75,9 @@ class CPlanet : public IShape
         CPlanet();
         virtual ~CPlanet();
         
+        //--- Memory management ----------------------------------------------//
+        POOL_ALLOCATION(CPlanet, BUFFER_QUADRUPLE)
+
         //--- Constant Methods -----------------------------------------------//
         CPlanet*                     clone() const;
         
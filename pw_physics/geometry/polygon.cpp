@@ -43,7 +43,7 @@ CPolygon* CPolygon::clone() const
 {
     METHOD_ENTRY("CPolygon::clone")
     
-    CPolygon* pClone = new CPolygon();
+    CPolygon* pClone = new (PoolNeighbourType{this}) CPolygon();
     MEM_ALLOC("IShape")
     
     pClone->copy(this);
@@ -54,6 +54,9 @@ class CPolygon : public IShape
         CPolygon() : m_PolygonType(PolygonType::FILLED){}
         virtual ~CPolygon(){};
         
+        //--- Memory management ----------------------------------------------//
+        POOL_ALLOCATION(CPolygon, BUFFER_QUADRUPLE)
+
         //--- Constant Methods -----------------------------------------------//
         CPolygon*              clone() const;
         
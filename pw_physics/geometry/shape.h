@@ -37,6 +37,8 @@
 
 //--- Program header ---------------------------------------------------------//
 #include "bounding_box.h"
+#include "multi_buffer.h"
+#include "pool.h"
 #include "shape_subtypes.h"
 #include "uid_user.h"
 
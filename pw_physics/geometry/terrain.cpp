@@ -74,7 +74,7 @@ CTerrain* CTerrain::clone() const
 {
     METHOD_ENTRY("CTerrain::clone")
     
-    CTerrain* pClone = new CTerrain();
+    CTerrain* pClone = new (PoolNeighbourType{this}) CTerrain();
     MEM_ALLOC("pClone")
     
     pClone->copy(this);
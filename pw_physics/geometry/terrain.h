@@ -54,6 +54,9 @@ class CTerrain : public IShape
         CTerrain();
         virtual ~CTerrain();
         
+        //--- Memory management ----------------------------------------------//
+        POOL_ALLOCATION(CTerrain, BUFFER_QUADRUPLE)
+
         //--- Constant Methods -----------------------------------------------//
         CTerrain*       clone() const;
         const double&   getAngle() const;
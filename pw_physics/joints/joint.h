@@ -37,6 +37,7 @@
 //--- Standard header --------------------------------------------------------//
 
 // Forward declarations
+class CForceAccumulator;
 class CObject;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -54,7 +55,7 @@ class IJoint
         virtual ~IJoint(){};
 
         //--- Constant methods -----------------------------------------------//
-        virtual void react() const = 0;
+        virtual void react(CForceAccumulator* const) const = 0;
         
         AnchorIDType    getAnchorIDA() const;
         AnchorIDType    getAnchorIDB() const;
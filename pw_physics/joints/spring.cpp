@@ -30,6 +30,8 @@
 
 #include "spring.h"
 
+#include "force_accumulator.h"
+
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Constructor
@@ -66,8 +68,10 @@ CSpring::~CSpring()
 ///
 /// \brief Calculate reaction forces
 ///
+/// \param _pForces Accumulator the reaction forces are added to
+///
 ///////////////////////////////////////////////////////////////////////////////
-void CSpring::react() const
+void CSpring::react(CForceAccumulator* const _pForces) const
 {
     METHOD_ENTRY("CSpring::react")
 
@@ -75,6 +79,6 @@ void CSpring::react() const
                         m_pObjectA->getAnchor(m_AnchorIDA);
     Vector2d vecF = vecTmp.normalized()*(vecTmp.norm()-m_fLength)*m_fC;
 
-    m_pObjectA->addForce( vecF, m_pObjectA->getAnchor(m_AnchorIDA));
-    m_pObjectB->addForce(-vecF, m_pObjectB->getAnchor(m_AnchorIDB));
+    _pForces->addForce(m_pObjectA,  vecF, m_pObjectA->getAnchor(m_AnchorIDA));
+    _pForces->addForce(m_pObjectB, -vecF, m_pObjectB->getAnchor(m_AnchorIDB));
 }
@@ -54,7 +54,7 @@ class CSpring : public IJoint
         const double& getC() const;
         const double& getLength() const;
 
-        void react() const;
+        void react(CForceAccumulator* const) const;
 
         //--- Methods --------------------------------------------------------//
         void setC(const double&);
@@ -40,14 +40,23 @@ uint32_t CObject::m_unNrOfObjects = 0;
 CObject::CObject(): IUIDUser(), IKinematicsStateUser(), IGridUser(),
                 m_bGravitation(true),
                 m_bDynamics(true),
+                m_bSleeping(false),
+                m_nRestFrames(0),
+                m_fTorqueRest(0.0),
                 m_fTimeFac(1.0),
-                m_nDepthlayers(SHAPE_DEPTH_ALL)
+                m_fTorque(0.0),
+                m_nForceIndex(-1),
+                m_nDepthlayers(SHAPE_DEPTH_ALL),
+                m_nGeneration(0),
+                m_IntegratorType(INTEGRATOR_EULER),
+                m_pKinematicsStore(nullptr),
+                m_nKinematicsSlot(-1)
 {
     METHOD_ENTRY("CObject::CObject")
     CTOR_CALL("CObject::CObject")
 
     // Default name for any object:
-    m_UID.setName("Obj_" + m_UID.getName());
+    m_UID.setNamePrefix("Obj_");
     
     m_pIntAng = new CEulerIntegrator<double>;
     MEM_ALLOC("IIntegrator")
@@ -59,6 +68,7 @@ CObject::CObject(): IUIDUser(), IKinematicsStateUser(), IGridUser(),
     MEM_ALLOC("IIntegrator")
 
     m_vecForce.setZero();
+    m_vecForceRest.setZero();
     m_vecCell.setZero();
     
     m_Lifetime.start();
@@ -74,7 +84,10 @@ CObject::CObject(): IUIDUser(), IKinematicsStateUser(), IGridUser(),
 CObject::CObject(const CObject& _Obj) : 
                 IUIDUser(_Obj),
                 IKinematicsStateUser(_Obj),
-                IGridUser(_Obj)
+                IGridUser(_Obj),
+                m_IntegratorType(INTEGRATOR_EULER),
+                m_pKinematicsStore(nullptr),
+                m_nKinematicsSlot(-1)
 {
     METHOD_ENTRY("CObject::CObject")
     CTOR_CALL("CObject::CObject")
@@ -101,6 +114,11 @@ CObject::~CObject()
     METHOD_ENTRY("CObject::~CObject")
     DTOR_CALL("CObject::~CObject")
 
+    if (m_pKinematicsStore != nullptr)
+    {
+        m_pKinematicsStore->remove(m_nKinematicsSlot);
+    }
+
     if (m_pIntAng != nullptr)
     {
         delete m_pIntAng;
@@ -160,6 +178,9 @@ CObject& CObject::operator=(const CObject& _Obj)
 ///
 /// \brief Clone object
 ///
+/// The clone is placed next to this object in memory if possible, e.g. for
+/// buffer copies.
+///
 /// \return Pointer to cloned object
 ///
 ////////////////////////////////////////////////////////////////////////////////
@@ -167,7 +188,7 @@ CObject* CObject::clone() const
 {
     METHOD_ENTRY("CObject::clone")
     
-    CObject* pClone = new CObject(*this);
+    CObject* pClone = new (PoolNeighbourType{this}) CObject(*this);
     MEM_ALLOC("CObject")
 
     return pClone;
@@ -191,11 +212,34 @@ Vector2d CObject::getAnchor(const int& _nID) const
     Vector2d vecResult;
     Rotation2Dd Rotation(m_KinematicsState.getLocalAngle());
 
-    vecResult = Rotation * m_Anchors[_nID] + m_pIntPos->getValue();
+    vecResult = Rotation * m_Anchors[_nID] + this->getPositionCOM();
 
     return vecResult;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Writes the state that changes each frame to given render state
+///
+/// \param _State Render state to be written
+///
+////////////////////////////////////////////////////////////////////////////////
+void CObject::getRenderState(RenderObjectType& _State) const
+{
+    METHOD_ENTRY("CObject::getRenderState")
+
+    _State.nUID               = this->getUID();
+    _State.vecCell            = m_vecCell;
+    _State.vecOrigin          = m_KinematicsState.getLocalOrigin();
+    _State.vecVelocity        = m_KinematicsState.getLocalVelocity();
+    _State.fAngle             = m_KinematicsState.getLocalAngle();
+    _State.fAngleVelocity     = m_KinematicsState.getLocalAngleVelocity();
+    _State.vecAABBLowerLeft   = m_Geometry.getBoundingBox().getLowerLeft();
+    _State.vecAABBUpperRight  = m_Geometry.getBoundingBox().getUpperRight();
+    _State.vecAABBSLowerLeft  = m_Geometry.getBoundingBox(AABBType::SINGLEFRAME).getLowerLeft();
+    _State.vecAABBSUpperRight = m_Geometry.getBoundingBox(AABBType::SINGLEFRAME).getUpperRight();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Adds a force to object
@@ -208,9 +252,32 @@ void CObject::addForce(const Vector2d& _vecF, const Vector2d& _vecPOC)
 {
     METHOD_ENTRY("CObject::addForce")
 
-    m_vecForce  +=  _vecF;
-    m_fTorque   +=  (_vecPOC - m_pIntPos->getValue())[0] * _vecF[1] -
-                    (_vecPOC - m_pIntPos->getValue())[1] * _vecF[0];
+    this->addForce(_vecF, _vecPOC, this->forceBuffer(), this->torqueBuffer());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adds a force to given force and torque buffers
+///
+/// This method doesn't modify the object, resulting force and torque are
+/// accumulated in the given buffers, e.g. for multithreaded force
+/// accumulation.
+///
+/// \param _vecF Force to be applied
+/// \param _vecPOC Point of contact
+/// \param _vecForce Force buffer to accumulate to
+/// \param _fTorque Torque buffer to accumulate to
+///
+///////////////////////////////////////////////////////////////////////////////
+void CObject::addForce(const Vector2d& _vecF, const Vector2d& _vecPOC,
+                       Vector2d& _vecForce, double& _fTorque) const
+{
+    METHOD_ENTRY("CObject::addForce")
+
+    const Vector2d vecR = _vecPOC - this->getPositionCOM();
+
+    _vecForce   +=  _vecF;
+    _fTorque    +=  vecR[0] * _vecF[1] - vecR[1] * _vecF[0];
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -225,13 +292,32 @@ void CObject::addForceLC(const Vector2d& _vecF, const Vector2d& _vecPOC)
 {
     METHOD_ENTRY("CObject::addForceLC")
 
+    this->addForceLC(_vecF, _vecPOC, this->forceBuffer(), this->torqueBuffer());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adds a force (local coordinates given) to given force and torque
+///        buffers
+///
+/// \param _vecF Force to be applied
+/// \param _vecPOC Point of contact
+/// \param _vecForce Force buffer to accumulate to
+/// \param _fTorque Torque buffer to accumulate to
+///
+///////////////////////////////////////////////////////////////////////////////
+void CObject::addForceLC(const Vector2d& _vecF, const Vector2d& _vecPOC,
+                         Vector2d& _vecForce, double& _fTorque) const
+{
+    METHOD_ENTRY("CObject::addForceLC")
+
     Rotation2Dd Rotation(m_KinematicsState.getAngle());
     
     Vector2d vecV = Rotation * _vecF;
-    m_vecForce  +=  vecV;
+    _vecForce   +=  vecV;
     
     Vector2d vecTmp = Rotation * (_vecPOC-m_Geometry.getCOM());
-    m_fTorque   +=  vecTmp[0] * vecV[1] - vecTmp[1] * vecV[0];
+    _fTorque    +=  vecTmp[0] * vecV[1] - vecTmp[1] * vecV[0];
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -243,8 +329,8 @@ void CObject::clearForces()
 {
     METHOD_ENTRY("CObject::clearForces")
 
-    m_fTorque = 0.0;
-    m_vecForce.setZero();
+    this->torqueBuffer() = 0.0;
+    this->forceBuffer().setZero();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -263,27 +349,31 @@ void CObject::updateCell()
     vecUpdate.setZero();
     vecUpdateCell.setZero();
     
-    if      (m_pIntPos->getValue()[0] >  DEFAULT_CELL_SIZE)
+    const Vector2d vecPos = this->getPositionCOM();
+    
+    if      (vecPos[0] >  DEFAULT_CELL_SIZE)
     {
         vecUpdate[0]     -= DEFAULT_CELL_SIZE_2;
         vecUpdateCell[0] += 1;
     }
-    else if (m_pIntPos->getValue()[0] < -DEFAULT_CELL_SIZE)
+    else if (vecPos[0] < -DEFAULT_CELL_SIZE)
     {
         vecUpdate[0] += DEFAULT_CELL_SIZE_2;
         vecUpdateCell[0] -= 1;
     }
-    else if (m_pIntPos->getValue()[1] >  DEFAULT_CELL_SIZE)
+    else if (vecPos[1] >  DEFAULT_CELL_SIZE)
     {
         vecUpdate[1] -= DEFAULT_CELL_SIZE_2;
         vecUpdateCell[1] += 1;
     }
-    else if (m_pIntPos->getValue()[1] < -DEFAULT_CELL_SIZE)
+    else if (vecPos[1] < -DEFAULT_CELL_SIZE)
     {
         vecUpdate[1] += DEFAULT_CELL_SIZE_2;
         vecUpdateCell[1] -= 1;
     }
-    m_pIntPos->init(m_pIntPos->getValue()+vecUpdate);
+    m_pIntPos->init(vecPos+vecUpdate);
+    if (m_pKinematicsStore != nullptr)
+        m_pKinematicsStore->initPosition(m_nKinematicsSlot, vecPos+vecUpdate);
     /// \bug Bounding box must be updated with new relative position
     
     m_vecCell += vecUpdateCell;
@@ -302,6 +392,10 @@ void CObject::updateCell()
 ///
 /// \brief Calculate dynamics of object
 ///
+/// If the object is bound to a kinematics store, integration was already
+/// done by \ref CKinematicsStore::integrate and only the kinematics state is
+/// updated here.
+///
 /// \param _fTimeStep Time between two frames
 ///
 ///////////////////////////////////////////////////////////////////////////////
@@ -312,27 +406,38 @@ void CObject::dynamics(const double& _fTimeStep)
     // Call object specific dynamics if enabled
     if (m_bDynamics)
     {
-        Vector2d vecAccel = m_vecForce;
-    
-        if (m_Geometry.getMass() > 0.0) vecAccel /= m_Geometry.getMass();
-        
-        m_pIntVel->integrate(vecAccel, _fTimeStep*m_fTimeFac);
-        m_pIntPos->integrate(m_pIntVel->getValue(),_fTimeStep*m_fTimeFac);
-        
-        double fAngleAccel = m_fTorque;
-        
-        if (m_Geometry.getInertia() > 0.0) fAngleAccel /= m_Geometry.getInertia();
+        if (m_pKinematicsStore != nullptr)
+        {
+            m_KinematicsState.setAngleVelocity(m_pKinematicsStore->getAngleVelocity(m_nKinematicsSlot));
+            m_KinematicsState.setAngle(m_pKinematicsStore->getAngle(m_nKinematicsSlot));
+        }
+        else
+        {
+            Vector2d vecAccel = this->getForce();
         
-        double fAngleVel = m_pIntAngVel->integrate(fAngleAccel, _fTimeStep*m_fTimeFac);
-        m_KinematicsState.setAngleVelocity(fAngleVel);
-        m_KinematicsState.setAngle(m_pIntAng->integrateClip(fAngleVel, _fTimeStep*m_fTimeFac, 2.0*M_PI));
+            if (this->getMass() > 0.0) vecAccel /= this->getMass();
+            
+            m_pIntVel->integrate(vecAccel, _fTimeStep*m_fTimeFac);
+            m_pIntPos->integrate(m_pIntVel->getValue(),_fTimeStep*m_fTimeFac);
+            
+            double fAngleAccel = this->getTorque();
+            
+            if (this->getInertia() > 0.0) fAngleAccel /= this->getInertia();
+            
+            double fAngleVel = m_pIntAngVel->integrate(fAngleAccel, _fTimeStep*m_fTimeFac);
+            m_KinematicsState.setAngleVelocity(fAngleVel);
+            m_KinematicsState.setAngle(m_pIntAng->integrateClip(fAngleVel, _fTimeStep*m_fTimeFac, 2.0*M_PI));
+        }
         
-        m_Trajectory.update(m_pIntPos->getValue(), m_vecCell);
+        m_Trajectory.update(this->getPositionCOM(), m_vecCell);
     }
     
-    // Update kinematics state from integrator
-    m_KinematicsState.setOrigin(m_pIntPos->getValue()-m_Geometry.getCOM());
-    m_KinematicsState.setVelocity(m_pIntVel->getValue());
+    // Update kinematics state from integrator or kinematics store
+    m_KinematicsState.setOrigin(this->getPositionCOM()-m_Geometry.getCOM());
+    if (m_pKinematicsStore != nullptr)
+        m_KinematicsState.setVelocity(m_pKinematicsStore->getVelocity(m_nKinematicsSlot));
+    else
+        m_KinematicsState.setVelocity(m_pIntVel->getValue());
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -348,6 +453,10 @@ void CObject::init()
 {
     METHOD_ENTRY("CObject::init")
 
+    // State might be changed, hence, sleep is interrupted
+    this->wake();
+    ++m_nGeneration;
+    
     // First, calculate geometry, i.e. center of mass, inertia, etc.
     m_Geometry.update();
     
@@ -356,15 +465,16 @@ void CObject::init()
     m_pIntAngVel->init(m_KinematicsState.getAngleVelocity());
     m_pIntPos->init(m_KinematicsState.getLocalPosition(m_Geometry.getCOM()));
     m_pIntVel->init(m_KinematicsState.getVelocity());
+    this->syncToKinematicsStore();
     
     this->setCell(m_vecCell);
     
     // Call transform twice to correctly set bounding boxes
     // (Otherwise, temporal bbox will always include the origin)
     m_Geometry.transform(m_KinematicsState.getAngle(), m_KinematicsState.getOrigin());
-    m_KinematicsState.transform(m_pIntPos->getValue(), m_Geometry.getCOM());
+    m_KinematicsState.transform(this->getPositionCOM(), m_Geometry.getCOM());
     m_Geometry.transform(m_KinematicsState.getAngle(), m_KinematicsState.getOrigin());
-    m_KinematicsState.transform(m_pIntPos->getValue(), m_Geometry.getCOM());
+    m_KinematicsState.transform(this->getPositionCOM(), m_Geometry.getCOM());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -409,6 +519,41 @@ void CObject::setCell(const int& _nGridX, const int& _nGridY)
     this->setCell(Vector2i(_nGridX, _nGridY));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets the state that changes each frame from given render state
+///
+/// Shapes are transformed like done by physics, but only if the object
+/// moved. Bounding boxes are taken from the render state, since multi frame
+/// boxes depend on the frames in between.
+///
+/// \param _State Render state
+///
+////////////////////////////////////////////////////////////////////////////////
+void CObject::setRenderState(const RenderObjectType& _State)
+{
+    METHOD_ENTRY("CObject::setRenderState")
+
+    const bool bMoved = _State.vecCell   != m_vecCell ||
+                        _State.vecOrigin != m_KinematicsState.getLocalOrigin() ||
+                        _State.fAngle    != m_KinematicsState.getLocalAngle();
+
+    m_KinematicsState.setVelocity(_State.vecVelocity);
+    m_KinematicsState.setAngleVelocity(_State.fAngleVelocity);
+
+    if (bMoved)
+    {
+        m_KinematicsState.setOrigin(_State.vecOrigin);
+        m_KinematicsState.setAngle(_State.fAngle);
+        if (_State.vecCell != m_vecCell) this->setCell(_State.vecCell);
+        m_Geometry.transform(_State.fAngle, _State.vecOrigin);
+    }
+    m_Geometry.getBoundingBox().setLowerLeft(_State.vecAABBLowerLeft);
+    m_Geometry.getBoundingBox().setUpperRight(_State.vecAABBUpperRight);
+    m_Geometry.getBoundingBox(AABBType::SINGLEFRAME).setLowerLeft(_State.vecAABBSLowerLeft);
+    m_Geometry.getBoundingBox(AABBType::SINGLEFRAME).setUpperRight(_State.vecAABBSUpperRight);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Sets a new integrator for this instance
@@ -420,6 +565,19 @@ void CObject::setNewIntegrator(const IntegratorType& _IntType)
 {
     METHOD_ENTRY("CObject::setNewIntegrator")
 
+    if (_IntType == INTEGRATOR_NONE)
+    {
+        WARNING_MSG("Object", "Unknown integrator type, keeping current integrator.")
+        return;
+    }
+
+    // Keep current state for new integrators
+    this->syncFromKinematicsStore();
+    const double   fAngle    = m_pIntAng->getValue();
+    const double   fAngleVel = m_pIntAngVel->getValue();
+    const Vector2d vecPos    = m_pIntPos->getValue();
+    const Vector2d vecVel    = m_pIntVel->getValue();
+
     if (m_pIntAng != nullptr)
     {
         delete m_pIntAng;
@@ -477,8 +635,125 @@ void CObject::setNewIntegrator(const IntegratorType& _IntType)
             MEM_ALLOC("CAdamsMoultonIntegrator")
             MEM_ALLOC("CAdamsMoultonIntegrator")
             break;
+        case INTEGRATOR_DORMAND_PRINCE:
+            // Sub-steps need the attractors of the kinematics store, objects
+            // not bound to a store fall back to Euler
+            m_pIntAng = new CEulerIntegrator<double>;
+            m_pIntAngVel = new CEulerIntegrator<double>;
+            m_pIntPos = new CEulerIntegrator<Vector2d>;
+            m_pIntVel = new CEulerIntegrator<Vector2d>;
+            MEM_ALLOC("IIntegrator")
+            MEM_ALLOC("IIntegrator")
+            MEM_ALLOC("IIntegrator")
+            MEM_ALLOC("IIntegrator")
+            break;
+        case INTEGRATOR_NONE:
+            break;
+    }
+    m_IntegratorType = _IntType;
+    ++m_nGeneration;
+
+    m_pIntAng->init(fAngle);
+    m_pIntAngVel->init(fAngleVel);
+    m_pIntPos->init(vecPos);
+    m_pIntVel->init(vecVel);
+
+    // New integrators start without history
+    this->syncToKinematicsStore();
+    if (m_pKinematicsStore != nullptr && m_bDynamics && !m_bSleeping)
+        m_pKinematicsStore->setGroup(m_nKinematicsSlot, m_IntegratorType);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Puts object to sleep
+///
+/// Sleeping objects are parked at their current position, i.e. velocities
+/// are cleared and they aren't integrated until woken.
+///
+///////////////////////////////////////////////////////////////////////////////
+void CObject::sleep()
+{
+    METHOD_ENTRY("CObject::sleep")
+
+    if (m_bSleeping) return;
+    m_bSleeping = true;
+
+    const Vector2d vecPos = this->getPositionCOM();
+    const double   fAngle = this->getAngle();
+
+    m_KinematicsState.setVelocity(Vector2d::Zero());
+    m_KinematicsState.setAngleVelocity(0.0);
+    m_pIntAng->init(fAngle);
+    m_pIntAngVel->init(0.0);
+    m_pIntPos->init(vecPos);
+    m_pIntVel->init(Vector2d::Zero());
+
+    if (m_pKinematicsStore != nullptr)
+    {
+        // Slot might change when leaving rails, thus, always use current one
+        m_pKinematicsStore->initAngle(m_nKinematicsSlot, fAngle);
+        m_pKinematicsStore->initAngleVelocity(m_nKinematicsSlot, 0.0);
+        m_pKinematicsStore->initPosition(m_nKinematicsSlot, vecPos);
+        m_pKinematicsStore->initVelocity(m_nKinematicsSlot, Vector2d::Zero());
+        m_pKinematicsStore->setGroup(m_nKinematicsSlot, KINEMATICS_STORE_GROUP_STATIC);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Updates number of frames object is at rest
+///
+/// Objects are at rest while they are slower than the given thresholds,
+/// hardly accelerated, and the resulting acceleration didn't change since
+/// they came to rest. Otherwise, a weak but constant acceleration would let
+/// objects fall asleep before they exceed the velocity threshold. Sleeping
+/// objects are woken if acceleration changed, e.g. by thrust or gravitation
+/// of moving objects. Has to be called once per frame after forces are
+/// accumulated.
+///
+/// \param _fVelocity Velocity below which object is at rest
+/// \param _fAngleVelocity Angle velocity below which object is at rest
+/// \param _fAcceleration Acceleration and its change, linear and angular, ending rest
+///
+///////////////////////////////////////////////////////////////////////////////
+void CObject::updateRest(const double& _fVelocity, const double& _fAngleVelocity, const double& _fAcceleration)
+{
+    METHOD_ENTRY("CObject::updateRest")
+
+    const Vector2d& vecForce = this->getForce();
+    const double&   fTorque  = this->getTorque();
+
+    const bool bAccelerated = vecForce.norm()    > _fAcceleration * this->getMass() ||
+                              std::abs(fTorque)  > _fAcceleration * this->getInertia();
+
+    bool bChanged = true;
+    if (m_bSleeping || m_nRestFrames > 0)
+    {
+        bChanged = (vecForce - m_vecForceRest).norm() > _fAcceleration * this->getMass() ||
+                   std::abs(fTorque - m_fTorqueRest)  > _fAcceleration * this->getInertia();
     }
 
+    if (m_bSleeping)
+    {
+        if (bChanged || bAccelerated) this->wake();
+    }
+    else if (bAccelerated ||
+             this->getVelocity().norm() > _fVelocity ||
+             std::abs(this->getAngleVelocity()) > _fAngleVelocity)
+    {
+        m_nRestFrames = 0;
+    }
+    else if (!bChanged)
+    {
+        ++m_nRestFrames;
+    }
+    else
+    {
+        m_nRestFrames = 1;
+        m_vecForceRest = vecForce;
+        m_fTorqueRest = fTorque;
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -495,7 +770,7 @@ void CObject::transform()
     if (m_bDynamics)
     {
         m_Geometry.transform(m_KinematicsState.getAngle(), m_KinematicsState.getOrigin());
-        m_KinematicsState.transform(m_pIntPos->getValue(), m_Geometry.getCOM());
+        m_KinematicsState.transform(this->getPositionCOM(), m_Geometry.getCOM());
     }
 }
 
@@ -527,14 +802,15 @@ std::istream& operator>>(std::istream& _is, CObject* const _pObj)
     _is >> _pObj->m_Lifetime;
     _is >> _pObj->m_fTimeFac;
     _is >> _pObj->m_Geometry;
-    _is >> _pObj->m_vecForce[0];
-    _is >> _pObj->m_vecForce[1];
-    _is >> _pObj->m_fTorque;
+    _is >> _pObj->forceBuffer()[0];
+    _is >> _pObj->forceBuffer()[1];
+    _is >> _pObj->torqueBuffer();
     _is >> _pObj->m_nDepthlayers;
     _is >> _pObj->m_pIntAng;
     _is >> _pObj->m_pIntAngVel;
     _is >> _pObj->m_pIntPos;
     _is >> _pObj->m_pIntVel;
+    _pObj->syncToKinematicsStore();
 //     _is >> _pObj->m_Anchors.size();
 //     for (const auto ci : _pObj->m_Anchors)
 //         _is >> ci;
@@ -557,6 +833,8 @@ std::ostream& operator<<(std::ostream& _os, CObject* const _pObj)
 {
     METHOD_ENTRY("CObject::operator<<")
     
+    _pObj->syncFromKinematicsStore();
+    
     _os << "Object:" << std::endl;
     
     // From IKinematicsStateUser
@@ -570,9 +848,9 @@ std::ostream& operator<<(std::ostream& _os, CObject* const _pObj)
     _os << _pObj->m_Lifetime << std::endl;
     _os << _pObj->m_fTimeFac << std::endl;
     _os << _pObj->m_Geometry << std::endl;
-    _os << _pObj->m_vecForce[0] << " " <<
-           _pObj->m_vecForce[1] << std::endl;
-    _os << _pObj->m_fTorque << std::endl;
+    _os << _pObj->getForce()[0] << " " <<
+           _pObj->getForce()[1] << std::endl;
+    _os << _pObj->getTorque() << std::endl;
     _os << _pObj->m_nDepthlayers << std::endl;
     _os << _pObj->m_pIntAng << std::endl;
     _os << _pObj->m_pIntAngVel << std::endl;
@@ -601,12 +879,18 @@ void CObject::copy(const CObject& _Obj)
 
     m_bGravitation      = _Obj.m_bGravitation;
     m_bDynamics         = _Obj.m_bDynamics;
+    m_bSleeping         = _Obj.m_bSleeping;
+    m_nRestFrames       = _Obj.m_nRestFrames;
+    m_vecForceRest      = _Obj.m_vecForceRest;
+    m_fTorqueRest       = _Obj.m_fTorqueRest;
 //     m_Lifetime          = _Obj.m_Lifetime;
     m_fTimeFac          = _Obj.m_fTimeFac;
     m_Geometry          = _Obj.m_Geometry;
-    m_vecForce          = _Obj.m_vecForce;
-    m_fTorque           = _Obj.m_fTorque;
+    this->forceBuffer() = _Obj.getForce();
+    this->torqueBuffer()= _Obj.getTorque();
+    m_nForceIndex       = _Obj.m_nForceIndex;
     m_nDepthlayers      = _Obj.m_nDepthlayers;
+    m_nGeneration       = _Obj.m_nGeneration;
     
     *m_pIntAng          = *(_Obj.m_pIntAng);
     *m_pIntAngVel       = *(_Obj.m_pIntAngVel);
@@ -614,4 +898,66 @@ void CObject::copy(const CObject& _Obj)
     *m_pIntVel          = *(_Obj.m_pIntVel);
     
     m_Anchors           = _Obj.m_Anchors;
+    
+    // Integrators are not copied, thus take state of source if bound
+    if (m_pKinematicsStore != nullptr)
+    {
+        // Slot might change when leaving rails, thus, always use current one
+        m_pKinematicsStore->initAngle(m_nKinematicsSlot, _Obj.getAngle());
+        m_pKinematicsStore->initAngleVelocity(m_nKinematicsSlot, _Obj.getAngleVelocity());
+        m_pKinematicsStore->initPosition(m_nKinematicsSlot, _Obj.getPositionCOM());
+        m_pKinematicsStore->initVelocity(m_nKinematicsSlot, _Obj.getVelocity());
+        m_pKinematicsStore->m_Masses[m_nKinematicsSlot]   = m_Geometry.getMass();
+        m_pKinematicsStore->m_Inertias[m_nKinematicsSlot] = m_Geometry.getInertia();
+        m_pKinematicsStore->m_TimeFacs[m_nKinematicsSlot] = m_fTimeFac;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Updates integrators from kinematics store
+///
+/// Integrators of objects bound to the store are not updated while
+/// simulating. This method sets them to the current state, e.g. before
+/// serialising them. The derivative history of multistep integrators is
+/// not transferred.
+///
+////////////////////////////////////////////////////////////////////////////////
+void CObject::syncFromKinematicsStore()
+{
+    METHOD_ENTRY("CObject::syncFromKinematicsStore")
+    
+    if (m_pKinematicsStore != nullptr)
+    {
+        m_pIntAng->init(m_pKinematicsStore->getAngle(m_nKinematicsSlot));
+        m_pIntAngVel->init(m_pKinematicsStore->getAngleVelocity(m_nKinematicsSlot));
+        m_pIntPos->init(m_pKinematicsStore->getPosition(m_nKinematicsSlot));
+        m_pIntVel->init(m_pKinematicsStore->getVelocity(m_nKinematicsSlot));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Updates kinematics store from integrators and geometry
+///
+/// Like initialising integrators, this resets the derivative history. Force
+/// and torque are not touched, they are held by the store exclusively while
+/// the object is bound.
+///
+////////////////////////////////////////////////////////////////////////////////
+void CObject::syncToKinematicsStore()
+{
+    METHOD_ENTRY("CObject::syncToKinematicsStore")
+    
+    if (m_pKinematicsStore != nullptr)
+    {
+        // Slot might change when leaving rails, thus, always use current one
+        m_pKinematicsStore->initAngle(m_nKinematicsSlot, m_pIntAng->getValue());
+        m_pKinematicsStore->initAngleVelocity(m_nKinematicsSlot, m_pIntAngVel->getValue());
+        m_pKinematicsStore->initPosition(m_nKinematicsSlot, m_pIntPos->getValue());
+        m_pKinematicsStore->initVelocity(m_nKinematicsSlot, m_pIntVel->getValue());
+        m_pKinematicsStore->m_Masses[m_nKinematicsSlot]   = m_Geometry.getMass();
+        m_pKinematicsStore->m_Inertias[m_nKinematicsSlot] = m_Geometry.getInertia();
+        m_pKinematicsStore->m_TimeFacs[m_nKinematicsSlot] = m_fTimeFac;
+    }
 }
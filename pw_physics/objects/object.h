@@ -37,6 +37,10 @@
 #include "euler_integrator.h"
 #include "geometry.h"
 #include "kinematics_state_user.h"
+#include "kinematics_store.h"
+#include "multi_buffer.h"
+#include "pool.h"
+#include "render_snapshot.h"
 #include "trajectory.h"
 
 //--- Standard header --------------------------------------------------------//
@@ -64,6 +68,9 @@ class CObject : public IUIDUser,
         CObject(const CObject&);
         virtual ~CObject();
         
+        //--- Memory management ----------------------------------------------//
+        POOL_ALLOCATION(CObject, BUFFER_QUADRUPLE)
+
         CObject& operator=(const CObject&);
 
         //--- Constant methods -----------------------------------------------//
@@ -74,19 +81,32 @@ class CObject : public IUIDUser,
               Vector2d      getCOM() const;
               int           getDepths() const;
               bool          getDynamicsState() const;
+              int           getForceIndex() const;
+              std::uint32_t getGeneration() const;
               bool          getGravitationState() const;
         const double&       getInertia() const;
+        const IntegratorType& getIntegratorType() const;
         const double&       getMass() const;
-        const std::string&  getName() const;
-        const Vector2d&     getForce() const {return m_vecForce;}
+        std::string         getName() const;
+        const Vector2d&     getForce() const;
         const Vector2d&     getOrigin() const;
+              int           getRestFrames() const;
+        const double&       getTorque() const;
         const Vector2d&     getVelocity() const;
         const CTrajectory&  getTrajectory() const;
+              bool          isSleeping() const;
+        
+        void                addAcceleration(const Vector2d&, Vector2d&, double&) const;
+        void                addForce(const Vector2d&, const Vector2d&, Vector2d&, double&) const;
+        void                addForceLC(const Vector2d&, const Vector2d&, Vector2d&, double&) const;
+        void                getRenderState(RenderObjectType&) const;
 
         //--- Methods --------------------------------------------------------//
         void                addForce(const Vector2d&,  const Vector2d&);
         void                addForceLC(const Vector2d&,  const Vector2d&);
         void                clearForces();
+        void                setForce(const Vector2d&, const double&);
+        void                setForceIndex(const int);
         
         void                addAcceleration(const Vector2d&);
         AnchorIDType        addAnchor(const Vector2d&);
@@ -101,6 +121,7 @@ class CObject : public IUIDUser,
         void                setOrigin(const double&, const double&);
         void                setDepths(const int&);
         void                setName(const std::string&);
+        void                setRenderState(const RenderObjectType&);
         void                setTimeFac(const double&);
         void                setVelocity(const Vector2d&);
         void                unsetDepths(const int&);
@@ -109,6 +130,10 @@ class CObject : public IUIDUser,
         void                enableDynamics();
         void                disableDynamics();
         
+        void                sleep();
+        void                updateRest(const double&, const double&, const double&);
+        void                wake();
+        
         void                dynamics(const double&);
         void                init();
         void                setNewIntegrator(const IntegratorType&);
@@ -120,15 +145,26 @@ class CObject : public IUIDUser,
         //--- friends --------------------------------------------------------//
         friend std::istream&    operator>>(std::istream&, CObject* const);
         friend std::ostream&    operator<<(std::ostream&, CObject* const);
+        friend class CKinematicsStore;
         
     protected:
         
         //--- Methods [protected] --------------------------------------------//
         void copy(const CObject&);
+        
+        Vector2d            getPositionCOM() const;
+        Vector2d&           forceBuffer();
+        double&             torqueBuffer();
+        void                syncFromKinematicsStore();
+        void                syncToKinematicsStore();
 
         //-- Variables [protected] -------------------------------------------//
         bool                    m_bGravitation;                     ///< Does this object influence others by gravitation?
         bool                    m_bDynamics;                        ///< Dynamics calculations for object
+        bool                    m_bSleeping;                        ///< Object rests and is parked, dynamics are skipped
+        int                     m_nRestFrames;                      ///< Number of frames object is at rest, 0 if moving
+        Vector2d                m_vecForceRest;                     ///< Force when object came to rest
+        double                  m_fTorqueRest;                      ///< Torque when object came to rest
 
         CTimer                  m_Lifetime;                         ///< Lifetime counter
         double                  m_fTimeFac;                         ///< Factor of realtime
@@ -137,13 +173,19 @@ class CObject : public IUIDUser,
 
         Vector2d                m_vecForce;                         ///< Resulting force applied
         double                  m_fTorque;                          ///< Resulting torque on object
+        int                     m_nForceIndex;                      ///< Dense index for force accumulation, -1 if unset
         
         int                     m_nDepthlayers;                     ///< Depths in which shape exists
+        std::uint32_t           m_nGeneration;                      ///< Incremented on changes not covered by render state
         
         IIntegrator<double>*    m_pIntAng;                          ///< Angle integrator
         IIntegrator<double>*    m_pIntAngVel;                       ///< Angle velocity integrator
         IIntegrator<Vector2d>*  m_pIntPos;                          ///< Position integrator
         IIntegrator<Vector2d>*  m_pIntVel;                          ///< Velocity integrator
+        IntegratorType          m_IntegratorType;                   ///< Type of integrators
+
+        CKinematicsStore*       m_pKinematicsStore;                 ///< Store holding kinematics, nullptr if not bound
+        int                     m_nKinematicsSlot;                  ///< Slot within kinematics store, -1 if not bound
 
         std::vector<Vector2d>   m_Anchors;                          ///< Anchors to joints
         
@@ -165,7 +207,28 @@ inline void CObject::addAcceleration(const Vector2d& _vecA)
 {
     METHOD_ENTRY("CObject::addAcceleration")
 
-    this->addForce(_vecA*m_Geometry.getMass(), m_pIntPos->getValue()+m_Geometry.getCOM());
+    this->addAcceleration(_vecA, this->forceBuffer(), this->torqueBuffer());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adds a specific acceleration to given force and torque
+///
+/// This method doesn't modify the object, resulting force and torque are
+/// accumulated in the given buffers, e.g. for multithreaded force
+/// accumulation.
+///
+/// \param _vecA Acceleration vector
+/// \param _vecForce Force buffer to accumulate to
+/// \param _fTorque Torque buffer to accumulate to
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CObject::addAcceleration(const Vector2d& _vecA, Vector2d& _vecForce, double& _fTorque) const
+{
+    METHOD_ENTRY("CObject::addAcceleration")
+
+    this->addForce(_vecA*this->getMass(), this->getPositionCOM()+m_Geometry.getCOM(),
+                   _vecForce, _fTorque);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -178,6 +241,8 @@ inline void CObject::addAcceleration(const Vector2d& _vecA)
 inline const double& CObject::getAngle() const
 {
     METHOD_ENTRY("CObject::getAngle")
+    if (m_pKinematicsStore != nullptr)
+        return m_pKinematicsStore->getAngle(m_nKinematicsSlot);
     return m_KinematicsState.getLocalAngle();
 }
 
@@ -191,6 +256,8 @@ inline const double& CObject::getAngle() const
 inline const double& CObject::getAngleVelocity() const
 {
     METHOD_ENTRY("CObject::getAngleVelocity")
+    if (m_pKinematicsStore != nullptr)
+        return m_pKinematicsStore->getAngleVelocity(m_nKinematicsSlot);
     return m_KinematicsState.getLocalAngleVelocity();
 }
 
@@ -233,6 +300,51 @@ inline bool CObject::getDynamicsState() const
     return (m_bDynamics);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns resulting force on object
+///
+/// \return Force
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const Vector2d& CObject::getForce() const
+{
+    METHOD_ENTRY("CObject::getForce")
+    if (m_pKinematicsStore != nullptr)
+        return m_pKinematicsStore->getForce(m_nKinematicsSlot);
+    return m_vecForce;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns dense index of object used for force accumulation
+///
+/// \return Dense index, -1 if unset
+///
+////////////////////////////////////////////////////////////////////////////////
+inline int CObject::getForceIndex() const
+{
+    METHOD_ENTRY("CObject::getForceIndex")
+    return m_nForceIndex;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns generation of object
+///
+/// The generation changes with every change that isn't part of the render
+/// state, e.g. geometry, name or integrator. Two copies of an object with
+/// equal generation only differ in their render state.
+///
+/// \return Generation
+///
+////////////////////////////////////////////////////////////////////////////////
+inline std::uint32_t CObject::getGeneration() const
+{
+    METHOD_ENTRY("CObject::getGeneration")
+    return m_nGeneration;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Returns the gravitational state
@@ -261,9 +373,24 @@ inline bool CObject::getGravitationState() const
 inline const double& CObject::getInertia() const
 {
     METHOD_ENTRY("CObject::getInertia")
+    if (m_pKinematicsStore != nullptr)
+        return m_pKinematicsStore->getInertia(m_nKinematicsSlot);
     return m_Geometry.getInertia();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns type of integrators
+///
+/// \return Integrator type
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const IntegratorType& CObject::getIntegratorType() const
+{
+    METHOD_ENTRY("CObject::getIntegratorType")
+    return m_IntegratorType;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Returns the mass of the object
@@ -274,6 +401,8 @@ inline const double& CObject::getInertia() const
 inline const double& CObject::getMass() const
 {
     METHOD_ENTRY("CObject::getMass")
+    if (m_pKinematicsStore != nullptr)
+        return m_pKinematicsStore->getMass(m_nKinematicsSlot);
     return (m_Geometry.getMass());
 }
 
@@ -284,7 +413,7 @@ inline const double& CObject::getMass() const
 /// \return Name of the object
 ///
 ////////////////////////////////////////////////////////////////////////////////
-inline const std::string& CObject::getName() const
+inline std::string CObject::getName() const
 {
     METHOD_ENTRY("CObject::getName")
     return (m_UID.getName());
@@ -303,6 +432,34 @@ inline const Vector2d& CObject::getOrigin() const
     return m_KinematicsState.getLocalOrigin();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of frames object is at rest
+///
+/// \return Number of frames at rest, 0 if moving
+///
+////////////////////////////////////////////////////////////////////////////////
+inline int CObject::getRestFrames() const
+{
+    METHOD_ENTRY("CObject::getRestFrames")
+    return m_nRestFrames;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns resulting torque on object
+///
+/// \return Torque
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const double& CObject::getTorque() const
+{
+    METHOD_ENTRY("CObject::getTorque")
+    if (m_pKinematicsStore != nullptr)
+        return m_pKinematicsStore->getTorque(m_nKinematicsSlot);
+    return m_fTorque;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Returns the velocity of the object
@@ -314,6 +471,8 @@ inline const Vector2d& CObject::getVelocity() const
 {
     METHOD_ENTRY("CObject::getVelocity")
 //     return (m_pIntVel->getValue());
+    if (m_pKinematicsStore != nullptr)
+        return m_pKinematicsStore->getVelocity(m_nKinematicsSlot);
     return m_KinematicsState.getLocalVelocity();
 }
 
@@ -330,6 +489,19 @@ inline const CTrajectory& CObject::getTrajectory() const
     return m_Trajectory;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns if object is sleeping
+///
+/// \return Sleeping?
+///
+////////////////////////////////////////////////////////////////////////////////
+inline bool CObject::isSleeping() const
+{
+    METHOD_ENTRY("CObject::isSleeping")
+    return m_bSleeping;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Adds a connector for a joint
@@ -344,6 +516,7 @@ inline AnchorIDType CObject::addAnchor(const Vector2d& _vecV)
     METHOD_ENTRY("CObject::addAnchor")
 
     m_Anchors.push_back(_vecV);
+    ++m_nGeneration;
     
     return m_Anchors.size()-1;
 }
@@ -364,6 +537,7 @@ inline void CObject::disableGravitation()
     METHOD_ENTRY("CObject::disableGravitation")
 
     m_bGravitation = false;
+    ++m_nGeneration;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -382,6 +556,7 @@ inline void CObject::enableGravitation()
     METHOD_ENTRY("CObject::enableGravitation")
 
     m_bGravitation = true;
+    ++m_nGeneration;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -407,8 +582,11 @@ inline CGeometry* CObject::getGeometry()
 inline void CObject::setAngle(const double& _fAng)
 {
     METHOD_ENTRY("CObject::setAngle")
+    this->wake();
     m_pIntAng->init(_fAng);
     m_KinematicsState.setAngle(_fAng);
+    if (m_pKinematicsStore != nullptr)
+        m_pKinematicsStore->initAngle(m_nKinematicsSlot, _fAng);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -421,8 +599,11 @@ inline void CObject::setAngle(const double& _fAng)
 inline void CObject::setAngleVelocity(const double& _fV)
 {
     METHOD_ENTRY("CObject::setAngleVelocity")
+    this->wake();
     m_pIntAngVel->init(_fV);
     m_KinematicsState.setAngleVelocity(_fV);
+    if (m_pKinematicsStore != nullptr)
+        m_pKinematicsStore->initAngleVelocity(m_nKinematicsSlot, _fV);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -436,8 +617,11 @@ inline void CObject::setOrigin(const Vector2d& _vecOrigin)
 {
     METHOD_ENTRY("CObject::setOrigin")
 
+    this->wake();
     m_KinematicsState.setOrigin(_vecOrigin);
     m_pIntPos->init(m_KinematicsState.getOrigin());
+    if (m_pKinematicsStore != nullptr)
+        m_pKinematicsStore->initPosition(m_nKinematicsSlot, m_KinematicsState.getOrigin());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -452,8 +636,35 @@ inline void CObject::setOrigin(const double& _fX, const double& _fY)
 {
     METHOD_ENTRY("CObject::setOrigin")
 
-    m_KinematicsState.setOrigin(Vector2d(_fX, _fY));
-    m_pIntPos->init(m_KinematicsState.getOrigin());
+    this->setOrigin(Vector2d(_fX, _fY));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets resulting force and torque, e.g. after force accumulation
+///
+/// \param _vecF Resulting force
+/// \param _fTorque Resulting torque
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CObject::setForce(const Vector2d& _vecF, const double& _fTorque)
+{
+    METHOD_ENTRY("CObject::setForce")
+    this->forceBuffer() = _vecF;
+    this->torqueBuffer() = _fTorque;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets dense index of object used for force accumulation
+///
+/// \param _nIndex Dense index
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CObject::setForceIndex(const int _nIndex)
+{
+    METHOD_ENTRY("CObject::setForceIndex")
+    m_nForceIndex = _nIndex;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -468,6 +679,7 @@ inline void CObject::setDepths(const int& _nD)
     METHOD_ENTRY("CObject::setDepths")
 
     m_nDepthlayers |= _nD;
+    ++m_nGeneration;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -482,6 +694,7 @@ inline void CObject::unsetDepths(const int& _nD)
     METHOD_ENTRY("CObject::unsetDepths")
 
     m_nDepthlayers &= (!_nD);
+    ++m_nGeneration;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -496,6 +709,7 @@ inline void CObject::setName(const std::string& _strName)
     METHOD_ENTRY("CObject::setName")
 
     m_UID.setName(_strName);
+    ++m_nGeneration;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -514,6 +728,9 @@ inline void CObject::setTimeFac(const double& _fTF)
     METHOD_ENTRY("CObject::setTimeFac")
 
     m_fTimeFac = _fTF;
+    ++m_nGeneration;
+    if (m_pKinematicsStore != nullptr)
+        m_pKinematicsStore->m_TimeFacs[m_nKinematicsSlot] = _fTF;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -527,8 +744,11 @@ inline void CObject::setVelocity(const Vector2d& _vecVel)
 {
     METHOD_ENTRY("CObject::setVelocity")
 
+    this->wake();
     m_KinematicsState.setVelocity(_vecVel);
     m_pIntVel->init(_vecVel);
+    if (m_pKinematicsStore != nullptr)
+        m_pKinematicsStore->initVelocity(m_nKinematicsSlot, _vecVel);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -543,6 +763,11 @@ inline void CObject::enableDynamics()
     METHOD_ENTRY("CObject::enableDynamics")
 
     m_bDynamics = true;
+    m_bSleeping = false;
+    m_nRestFrames = 0;
+    ++m_nGeneration;
+    if (m_pKinematicsStore != nullptr)
+        m_pKinematicsStore->setGroup(m_nKinematicsSlot, m_IntegratorType);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -559,6 +784,76 @@ inline void CObject::disableDynamics()
     METHOD_ENTRY("CObject::disableDynamics")
 
     m_bDynamics = false;
+    m_bSleeping = false;
+    m_nRestFrames = 0;
+    ++m_nGeneration;
+    if (m_pKinematicsStore != nullptr)
+        m_pKinematicsStore->setGroup(m_nKinematicsSlot, KINEMATICS_STORE_GROUP_STATIC);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Wakes object, restarting its rest
+///
+/// Sleeping objects are integrated again, starting without history.
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CObject::wake()
+{
+    METHOD_ENTRY("CObject::wake")
+
+    m_nRestFrames = 0;
+    if (m_bSleeping)
+    {
+        m_bSleeping = false;
+        if (m_pKinematicsStore != nullptr && m_bDynamics)
+            m_pKinematicsStore->setGroup(m_nKinematicsSlot, m_IntegratorType);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns integrated position, i.e. center of mass local to cell
+///
+/// \return Position of center of mass
+///
+////////////////////////////////////////////////////////////////////////////////
+inline Vector2d CObject::getPositionCOM() const
+{
+    METHOD_ENTRY("CObject::getPositionCOM")
+    if (m_pKinematicsStore != nullptr)
+        return m_pKinematicsStore->getPosition(m_nKinematicsSlot);
+    return m_pIntPos->getValue();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns force buffer, either of kinematics store or object itself
+///
+/// \return Force buffer
+///
+////////////////////////////////////////////////////////////////////////////////
+inline Vector2d& CObject::forceBuffer()
+{
+    METHOD_ENTRY("CObject::forceBuffer")
+    if (m_pKinematicsStore != nullptr)
+        return m_pKinematicsStore->m_Forces[m_nKinematicsSlot];
+    return m_vecForce;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns torque buffer, either of kinematics store or object itself
+///
+/// \return Torque buffer
+///
+////////////////////////////////////////////////////////////////////////////////
+inline double& CObject::torqueBuffer()
+{
+    METHOD_ENTRY("CObject::torqueBuffer")
+    if (m_pKinematicsStore != nullptr)
+        return m_pKinematicsStore->m_Torques[m_nKinematicsSlot];
+    return m_fTorque;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
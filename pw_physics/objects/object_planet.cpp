@@ -88,7 +88,7 @@ const CObjectPlanet* CObjectPlanet::clone() const
 {
     METHOD_ENTRY("CObjectPlanet::clone")
     
-    CObjectPlanet* pClone = new CObjectPlanet(*this);
+    CObjectPlanet* pClone = new (PoolNeighbourType{this}) CObjectPlanet(*this);
     MEM_ALLOC("CObject")
     
     return pClone;
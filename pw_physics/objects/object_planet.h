@@ -74,6 +74,9 @@ class CObjectPlanet : public CObject,
         CObjectPlanet(const CObjectPlanet&);        
         CObjectPlanet& operator=(const CObjectPlanet&);
 
+        //--- Memory management ----------------------------------------------//
+        POOL_ALLOCATION(CObjectPlanet, BUFFER_QUADRUPLE)
+
         //--- Constant methods -----------------------------------------------//
         const CObjectPlanet* clone() const;
         
@@ -191,6 +194,7 @@ inline void CObjectPlanet::setPressureAtGround(const double& _fPressure)
 {
     METHOD_ENTRY("CObjectPlanet::setPressureAtGround")
     m_fAtmosphericPressure = _fPressure;
+    ++m_nGeneration;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -209,6 +213,7 @@ inline void CObjectPlanet::setRadius(const double& _fRadius)
     {
         static_cast<CPlanet*>(hShp.ptr())->setRadius(_fRadius);
     }
+    ++m_nGeneration;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -222,6 +227,7 @@ inline void CObjectPlanet::setScaleHeight(const double& _fScaleHeight)
 {
     METHOD_ENTRY("CObjectPlanet::setScaleHeight")
     m_fScaleHeight = _fScaleHeight;
+    ++m_nGeneration;
 }
 
 #endif // OBJECT_PLANET_H
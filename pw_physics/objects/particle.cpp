@@ -30,6 +30,19 @@
 
 #include "particle.h"
 
+//--- Standard header --------------------------------------------------------//
+#include <algorithm>
+#include <array>
+#include <limits>
+
+//--- Misc header ------------------------------------------------------------//
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define PARTICLE_KERNEL_X86
+    #include <immintrin.h>
+#endif
+
+ParticleKernelType CParticle::s_Kernel = CParticle::detectKernel();
+
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Constructor, initialising members
@@ -37,6 +50,10 @@
 ///////////////////////////////////////////////////////////////////////////////
 CParticle::CParticle() : IGridUser(),
                      IUIDUser(),
+                     m_nCapacity(0u),
+                     m_nBegin(0u),
+                     m_nSize(0u),
+                     m_nGeneration(0u),
                      m_ParticleType(ParticleTypeType::DOT),
                      m_fTimeFac(1.0),
                      m_fDamping(0.0),
@@ -44,20 +61,17 @@ CParticle::CParticle() : IGridUser(),
                      m_fSizeDeath(1.0),
                      m_aColorBirth({{1.0, 1.0, 1.0, 1.0}}),
                      m_aColorDeath({{1.0, 1.0, 1.0, 0.0}}),
-                     m_fMaxAge(1.0e300)
+                     m_fMaxAge(1.0e300),
+                     m_nDepthlayers(SHAPE_DEPTH_ALL)
 {
     METHOD_ENTRY("CParticle::CParticle")
     CTOR_CALL("CParticle::CParticle")
     
-    m_PosList.reserve(PARTICLE_DEFAULT_NUMBER);
-    m_VelList.reserve(PARTICLE_DEFAULT_NUMBER);
-    m_PosListPrev.reserve(PARTICLE_DEFAULT_NUMBER);
-    m_AgeList.reserve(PARTICLE_DEFAULT_NUMBER);
-    m_StateList.reserve(PARTICLE_DEFAULT_NUMBER);
+    this->setNumber(PARTICLE_DEFAULT_NUMBER);
     
     m_vecForce.setZero();
     
-    m_UID.setName("Particle_"+m_UID.getName());
+    m_UID.setNamePrefix("Particle_");
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -81,6 +95,9 @@ CParticle::CParticle(const CParticle& _Particle) : IGridUser(_Particle),
 ///
 /// \brief Clones particle
 ///
+/// The clone is placed next to this particle in memory if possible, e.g. for
+/// buffer copies.
+///
 /// \return Pointer to cloned particle
 ///
 ////////////////////////////////////////////////////////////////////////////////
@@ -88,7 +105,7 @@ CParticle* CParticle::clone() const
 {
     METHOD_ENTRY("CParticle::clone")
     
-    CParticle* pClone = new CParticle(*this);
+    CParticle* pClone = new (PoolNeighbourType{this}) CParticle(*this);
     MEM_ALLOC("CParticle")
 
     return pClone;
@@ -118,43 +135,111 @@ CParticle& CParticle::operator=(const CParticle& _Particle)
 /// \brief Calculates dynamics of the particle
 ///
 /// This method calculates the dynamics -- acceleration, velocity, position --
-/// of all particle in the list
+/// of all live particles. The bounding box is calculated in the same pass.
+/// Afterwards, particles exceeding the maximum age are removed from the
+/// beginning of the live range.
+///
+/// \param _fStep Time step
 ///
 ///////////////////////////////////////////////////////////////////////////////
 void CParticle::dynamics(const double& _fStep)
 {
     METHOD_ENTRY("CParticle::dynamics")
     
-    if (m_PosList.size() > 0)
+    if (m_nSize > 0)
     {
-        m_BBox.setLowerLeft(m_PosList[0]);
-        m_BBox.setUpperRight(m_PosList[0]);
-        
-        Vector2d vecStep = m_vecForce * _fStep * m_fTimeFac;
-        for (auto i=0u; i<m_PosList.size(); ++i)
+        BoundsType Bounds = getEmptyBounds();
+        this->dynamics(_fStep, 0, m_nSize, Bounds);
+        this->finishDynamics(Bounds);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Calculates dynamics of a part of the live particles
+///
+/// Different parts of the live range might be calculated concurrently, as
+/// long as no particles are generated meanwhile. Neither the bounding box is
+/// updated, nor are expired particles removed, which is done by
+/// \ref finishDynamics once all parts are calculated.
+///
+/// \param _fStep Time step
+/// \param _nFirst Index of first live particle
+/// \param _nLast Index behind last live particle
+/// \param _Bounds Bounds to be extended by previous and new positions
+///
+///////////////////////////////////////////////////////////////////////////////
+void CParticle::dynamics(const double& _fStep, const int _nFirst, const int _nLast, BoundsType& _Bounds)
+{
+    METHOD_ENTRY("CParticle::dynamics")
+    
+    if (_nFirst >= _nLast) return;
+    
+    Vector2d vecStep = m_vecForce * _fStep * m_fTimeFac;
+    
+    // Part of live range might wrap around at the capacity
+    const std::size_t nFirst = this->toSlot(_nFirst);
+    const std::size_t nEnd = std::min(nFirst + (_nLast - _nFirst), m_nCapacity);
+    const std::array<std::pair<std::size_t, std::size_t>, 2> Ranges =
+    {{
+        {nFirst, nEnd},
+        {0u, (_nLast - _nFirst) - (nEnd - nFirst)}
+    }};
+    for (const auto& Range : Ranges)
+    {
+        switch (s_Kernel)
         {
-            // Only if state is active
-            if (m_StateList[i] == PARTICLE_STATE_ACTIVE)
-            {
-                m_BBox.update(m_PosList[i]);
-                m_PosListPrev[i] = m_PosList[i];
-                m_VelList[i] += vecStep;
-                m_PosList[i] += m_VelList[i] * _fStep;
-                m_BBox.update(m_PosList[i]);
-                m_AgeList[i] += _fStep;
-                if (m_AgeList[i] >= m_fMaxAge) m_StateList[i] = PARTICLE_STATE_INACTIVE;
-            }
+            #ifdef PARTICLE_KERNEL_X86
+            case ParticleKernelType::AVX2:
+                this->dynamicsAVX2(_fStep, vecStep, Range.first, Range.second, _Bounds);
+                break;
+            case ParticleKernelType::SSE2:
+                this->dynamicsSSE2(_fStep, vecStep, Range.first, Range.second, _Bounds);
+                break;
+            #endif
+            default:
+                this->dynamicsScalar(_fStep, vecStep, Range.first, Range.second, _Bounds);
+                break;
         }
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Finishes a step after all live particles were calculated
+///
+/// The bounding box is set to the accumulated bounds and particles exceeding
+/// the maximum age are removed from the beginning of the live range.
+///
+/// \param _Bounds Bounds of all live particles
+///
+///////////////////////////////////////////////////////////////////////////////
+void CParticle::finishDynamics(const BoundsType& _Bounds)
+{
+    METHOD_ENTRY("CParticle::finishDynamics")
+    
+    if (m_nSize > 0)
+    {
+        m_BBox.setLowerLeft(Vector2d(_Bounds.fMinX, _Bounds.fMinY));
+        m_BBox.setUpperRight(Vector2d(_Bounds.fMaxX, _Bounds.fMaxY));
+        ++m_nGeneration;
+    }
+    
+    // All particles age at the same rate, the oldest ones expire first
+    while (m_nSize > 0 && m_Ages[m_nBegin] >= m_fMaxAge)
+    {
+        if (++m_nBegin == m_nCapacity) m_nBegin = 0;
+        --m_nSize;
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Generate a new particle
 ///
-/// This method generates a new particle. Because of using a circular buffer, a
-/// new particle might overwrite the oldest one if the maximum number of particle
-/// is reached.
+/// This method generates a new particle at the end of the live range. If the
+/// maximum number of particles is reached, the new particle overwrites the
+/// oldest one.
 ///
 /// \param _vecP Position of the new particle
 /// \param _vecV Velocity of the new particle
@@ -164,35 +249,277 @@ void CParticle::generate(const Vector2d& _vecP, const Vector2d& _vecV)
 {
     METHOD_ENTRY("CParticle::generate")
     
-    m_PosList.push_back(_vecP);
-    m_PosListPrev.push_back(_vecP);
-    m_VelList.push_back(_vecV);
-    m_AgeList.push_back(0u);
-    m_StateList.push_back(PARTICLE_STATE_ACTIVE);
+    const std::size_t i = this->toSlot(m_nSize % m_nCapacity);
+    m_PosX[i] = m_PosPrevX[i] = _vecP[0];
+    m_PosY[i] = m_PosPrevY[i] = _vecP[1];
+    m_VelX[i] = _vecV[0];
+    m_VelY[i] = _vecV[1];
+    m_Ages[i] = 0.0;
+    
+    if (m_nSize < m_nCapacity)
+        ++m_nSize;
+    else if (++m_nBegin == m_nCapacity)
+        m_nBegin = 0;
+    ++m_nGeneration;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Set number of particle
 ///
+/// Live particles are moved to the beginning of the arrays. If the number
+/// is reduced, the youngest particles are kept.
+///
 /// \param _nN Number of particle
 ///
 ////////////////////////////////////////////////////////////////////////////////
 void CParticle::setNumber(const int& _nN)
 {
     METHOD_ENTRY("CParticle::setNumber")
+    
+    if (_nN <= 0)
+    {
+        WARNING_MSG("Particle", "Number of particles must be positive.")
+        return;
+    }
+    
+    const std::size_t nCapacity = _nN;
+    const std::size_t nSize = std::min(m_nSize, nCapacity);
+    const std::size_t nSkip = m_nSize - nSize;
+    
+    auto linearise = [&](ParticleArrayType& _Array)
+    {
+        ParticleArrayType Array(nCapacity);
+        for (auto i=0u; i<nSize; ++i) Array[i] = _Array[this->toSlot(nSkip + i)];
+        _Array.swap(Array);
+    };
+    linearise(m_PosX);
+    linearise(m_PosY);
+    linearise(m_PosPrevX);
+    linearise(m_PosPrevY);
+    linearise(m_VelX);
+    linearise(m_VelY);
+    linearise(m_Ages);
+    
+    m_nCapacity = nCapacity;
+    m_nBegin = 0;
+    m_nSize = nSize;
+    ++m_nGeneration;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets kernel used for dynamics of all particles
+///
+/// Kernels not supported by the CPU fall back to the best supported one.
+///
+/// \param _Kernel Kernel
+///
+////////////////////////////////////////////////////////////////////////////////
+void CParticle::setKernel(const ParticleKernelType _Kernel)
+{
+    METHOD_ENTRY("CParticle::setKernel")
+    
+    const ParticleKernelType Supported = CParticle::detectKernel();
+    if (static_cast<int>(_Kernel) > static_cast<int>(Supported))
+    {
+        WARNING_MSG("Particle", "Kernel not supported by CPU, falling back.")
+        s_Kernel = Supported;
+    }
+    else
+    {
+        s_Kernel = _Kernel;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns best kernel supported by the CPU
+///
+/// \return Kernel
+///
+////////////////////////////////////////////////////////////////////////////////
+ParticleKernelType CParticle::detectKernel()
+{
+    METHOD_ENTRY("CParticle::detectKernel")
+    
+    #ifdef PARTICLE_KERNEL_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return ParticleKernelType::AVX2;
+        if (__builtin_cpu_supports("sse2")) return ParticleKernelType::SSE2;
+    #endif
+    return ParticleKernelType::SCALAR;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Calculates dynamics of given slots, scalar kernel
+///
+/// Remaining slots of the SIMD kernels are calculated by this kernel, too.
+///
+/// \param _fStep Time step
+/// \param _vecStep Change of velocity within time step
+/// \param _nFirst First slot
+/// \param _nLast Slot behind last slot
+/// \param _Bounds Bounds to be extended by previous and new positions
+///
+///////////////////////////////////////////////////////////////////////////////
+void CParticle::dynamicsScalar(const double& _fStep, const Vector2d& _vecStep,
+                               const int _nFirst, const int _nLast, BoundsType& _Bounds)
+{
+    METHOD_ENTRY("CParticle::dynamicsScalar")
+    
+    for (auto i=_nFirst; i<_nLast; ++i)
+    {
+        const double fX0 = m_PosX[i];
+        const double fY0 = m_PosY[i];
+        m_PosPrevX[i] = fX0;
+        m_PosPrevY[i] = fY0;
+        m_VelX[i] += _vecStep[0];
+        m_VelY[i] += _vecStep[1];
+        const double fX1 = fX0 + m_VelX[i] * _fStep;
+        const double fY1 = fY0 + m_VelY[i] * _fStep;
+        m_PosX[i] = fX1;
+        m_PosY[i] = fY1;
+        m_Ages[i] += _fStep;
+        
+        _Bounds.fMinX = std::min(_Bounds.fMinX, std::min(fX0, fX1));
+        _Bounds.fMinY = std::min(_Bounds.fMinY, std::min(fY0, fY1));
+        _Bounds.fMaxX = std::max(_Bounds.fMaxX, std::max(fX0, fX1));
+        _Bounds.fMaxY = std::max(_Bounds.fMaxY, std::max(fY0, fY1));
+    }
+}
+
+#ifdef PARTICLE_KERNEL_X86
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Calculates dynamics of given slots, SSE2 kernel
+///
+/// Two particles are calculated at once.
+///
+/// \param _fStep Time step
+/// \param _vecStep Change of velocity within time step
+/// \param _nFirst First slot
+/// \param _nLast Slot behind last slot
+/// \param _Bounds Bounds to be extended by previous and new positions
+///
+///////////////////////////////////////////////////////////////////////////////
+__attribute__((target("sse2")))
+void CParticle::dynamicsSSE2(const double& _fStep, const Vector2d& _vecStep,
+                             const int _nFirst, const int _nLast, BoundsType& _Bounds)
+{
+    METHOD_ENTRY("CParticle::dynamicsSSE2")
+    
+    const __m128d vStep   = _mm_set1_pd(_fStep);
+    const __m128d vStepX  = _mm_set1_pd(_vecStep[0]);
+    const __m128d vStepY  = _mm_set1_pd(_vecStep[1]);
+    __m128d vMinX = _mm_set1_pd(_Bounds.fMinX);
+    __m128d vMinY = _mm_set1_pd(_Bounds.fMinY);
+    __m128d vMaxX = _mm_set1_pd(_Bounds.fMaxX);
+    __m128d vMaxY = _mm_set1_pd(_Bounds.fMaxY);
+    
+    auto i = _nFirst;
+    for (; i+2 <= _nLast; i+=2)
+    {
+        const __m128d vX0  = _mm_loadu_pd(&m_PosX[i]);
+        const __m128d vY0  = _mm_loadu_pd(&m_PosY[i]);
+        const __m128d vVX1 = _mm_add_pd(_mm_loadu_pd(&m_VelX[i]), vStepX);
+        const __m128d vVY1 = _mm_add_pd(_mm_loadu_pd(&m_VelY[i]), vStepY);
+        const __m128d vX1  = _mm_add_pd(vX0, _mm_mul_pd(vVX1, vStep));
+        const __m128d vY1  = _mm_add_pd(vY0, _mm_mul_pd(vVY1, vStep));
+        
+        _mm_storeu_pd(&m_PosPrevX[i], vX0);
+        _mm_storeu_pd(&m_PosPrevY[i], vY0);
+        _mm_storeu_pd(&m_VelX[i], vVX1);
+        _mm_storeu_pd(&m_VelY[i], vVY1);
+        _mm_storeu_pd(&m_PosX[i], vX1);
+        _mm_storeu_pd(&m_PosY[i], vY1);
+        _mm_storeu_pd(&m_Ages[i], _mm_add_pd(_mm_loadu_pd(&m_Ages[i]), vStep));
+        
+        vMinX = _mm_min_pd(vMinX, _mm_min_pd(vX0, vX1));
+        vMinY = _mm_min_pd(vMinY, _mm_min_pd(vY0, vY1));
+        vMaxX = _mm_max_pd(vMaxX, _mm_max_pd(vX0, vX1));
+        vMaxY = _mm_max_pd(vMaxY, _mm_max_pd(vY0, vY1));
+    }
+    
+    double afMin[2];
+    double afMax[2];
+    _mm_storeu_pd(afMin, vMinX); _mm_storeu_pd(afMax, vMaxX);
+    _Bounds.fMinX = std::min(afMin[0], afMin[1]);
+    _Bounds.fMaxX = std::max(afMax[0], afMax[1]);
+    _mm_storeu_pd(afMin, vMinY); _mm_storeu_pd(afMax, vMaxY);
+    _Bounds.fMinY = std::min(afMin[0], afMin[1]);
+    _Bounds.fMaxY = std::max(afMax[0], afMax[1]);
+    
+    this->dynamicsScalar(_fStep, _vecStep, i, _nLast, _Bounds);
+}
 
-    m_PosList.reserve(_nN);
-    m_StateList.reserve(_nN);
-    m_PosListPrev.reserve(_nN);
-    m_AgeList.reserve(_nN);
-    for (auto i=0u; i<m_PosList.capacity();++i)
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Calculates dynamics of given slots, AVX2 kernel
+///
+/// Four particles are calculated at once.
+///
+/// \param _fStep Time step
+/// \param _vecStep Change of velocity within time step
+/// \param _nFirst First slot
+/// \param _nLast Slot behind last slot
+/// \param _Bounds Bounds to be extended by previous and new positions
+///
+///////////////////////////////////////////////////////////////////////////////
+__attribute__((target("avx2")))
+void CParticle::dynamicsAVX2(const double& _fStep, const Vector2d& _vecStep,
+                             const int _nFirst, const int _nLast, BoundsType& _Bounds)
+{
+    METHOD_ENTRY("CParticle::dynamicsAVX2")
+    
+    const __m256d vStep   = _mm256_set1_pd(_fStep);
+    const __m256d vStepX  = _mm256_set1_pd(_vecStep[0]);
+    const __m256d vStepY  = _mm256_set1_pd(_vecStep[1]);
+    __m256d vMinX = _mm256_set1_pd(_Bounds.fMinX);
+    __m256d vMinY = _mm256_set1_pd(_Bounds.fMinY);
+    __m256d vMaxX = _mm256_set1_pd(_Bounds.fMaxX);
+    __m256d vMaxY = _mm256_set1_pd(_Bounds.fMaxY);
+    
+    auto i = _nFirst;
+    for (; i+4 <= _nLast; i+=4)
     {
-        m_StateList.push_back(PARTICLE_STATE_ACTIVE);
+        const __m256d vX0  = _mm256_loadu_pd(&m_PosX[i]);
+        const __m256d vY0  = _mm256_loadu_pd(&m_PosY[i]);
+        const __m256d vVX1 = _mm256_add_pd(_mm256_loadu_pd(&m_VelX[i]), vStepX);
+        const __m256d vVY1 = _mm256_add_pd(_mm256_loadu_pd(&m_VelY[i]), vStepY);
+        const __m256d vX1  = _mm256_add_pd(vX0, _mm256_mul_pd(vVX1, vStep));
+        const __m256d vY1  = _mm256_add_pd(vY0, _mm256_mul_pd(vVY1, vStep));
+        
+        _mm256_storeu_pd(&m_PosPrevX[i], vX0);
+        _mm256_storeu_pd(&m_PosPrevY[i], vY0);
+        _mm256_storeu_pd(&m_VelX[i], vVX1);
+        _mm256_storeu_pd(&m_VelY[i], vVY1);
+        _mm256_storeu_pd(&m_PosX[i], vX1);
+        _mm256_storeu_pd(&m_PosY[i], vY1);
+        _mm256_storeu_pd(&m_Ages[i], _mm256_add_pd(_mm256_loadu_pd(&m_Ages[i]), vStep));
+        
+        vMinX = _mm256_min_pd(vMinX, _mm256_min_pd(vX0, vX1));
+        vMinY = _mm256_min_pd(vMinY, _mm256_min_pd(vY0, vY1));
+        vMaxX = _mm256_max_pd(vMaxX, _mm256_max_pd(vX0, vX1));
+        vMaxY = _mm256_max_pd(vMaxY, _mm256_max_pd(vY0, vY1));
     }
-    m_VelList.reserve(_nN);
+    
+    double afMin[4];
+    double afMax[4];
+    _mm256_storeu_pd(afMin, vMinX); _mm256_storeu_pd(afMax, vMaxX);
+    _Bounds.fMinX = std::min({afMin[0], afMin[1], afMin[2], afMin[3]});
+    _Bounds.fMaxX = std::max({afMax[0], afMax[1], afMax[2], afMax[3]});
+    _mm256_storeu_pd(afMin, vMinY); _mm256_storeu_pd(afMax, vMaxY);
+    _Bounds.fMinY = std::min({afMin[0], afMin[1], afMin[2], afMin[3]});
+    _Bounds.fMaxY = std::max({afMax[0], afMax[1], afMax[2], afMax[3]});
+    
+    this->dynamicsScalar(_fStep, _vecStep, i, _nLast, _Bounds);
 }
 
+#endif // PARTICLE_KERNEL_X86
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Input stream for game state information
@@ -221,11 +548,19 @@ std::istream& operator>>(std::istream& _is, CParticle* const _pParticle)
     _is >> _pParticle->m_Lifetime;
     _is >> _pParticle->m_fTimeFac;
     
-    _is >> _pParticle->m_PosList;
-    _is >> _pParticle->m_PosListPrev;
-    _is >> _pParticle->m_VelList;
-    _is >> _pParticle->m_AgeList;
-    _is >> _pParticle->m_StateList;
+    std::size_t nCapacity;
+    _is >> nCapacity;
+    _pParticle->m_nSize = 0u;
+    _pParticle->setNumber(nCapacity);
+    _is >> _pParticle->m_nBegin;
+    _is >> _pParticle->m_nSize;
+    for (auto i=0u; i<_pParticle->m_nCapacity; ++i)
+    {
+        _is >> _pParticle->m_PosX[i] >> _pParticle->m_PosY[i];
+        _is >> _pParticle->m_PosPrevX[i] >> _pParticle->m_PosPrevY[i];
+        _is >> _pParticle->m_VelX[i] >> _pParticle->m_VelY[i];
+        _is >> _pParticle->m_Ages[i];
+    }
     
 //     _is >> _pParticle->m_BBox;
     
@@ -264,13 +599,16 @@ std::ostream& operator<<(std::ostream& _os, CParticle* const _pParticle)
     _os << _pParticle->m_Lifetime << std::endl;
     _os << _pParticle->m_fTimeFac << std::endl;
     
-    _os << _pParticle->m_PosList << std::endl;
-    _os << _pParticle->m_PosListPrev << std::endl;
-    _os << _pParticle->m_VelList << std::endl;
-    _os << _pParticle->m_AgeList << std::endl;
-    _os << _pParticle->m_StateList << std::endl;
-    
-    _os << _pParticle->m_StateList << std::endl;
+    _os << _pParticle->m_nCapacity << std::endl;
+    _os << _pParticle->m_nBegin << std::endl;
+    _os << _pParticle->m_nSize << std::endl;
+    for (auto i=0u; i<_pParticle->m_nCapacity; ++i)
+    {
+        _os << _pParticle->m_PosX[i] << " " << _pParticle->m_PosY[i] << " " <<
+               _pParticle->m_PosPrevX[i] << " " << _pParticle->m_PosPrevY[i] << " " <<
+               _pParticle->m_VelX[i] << " " << _pParticle->m_VelY[i] << " " <<
+               _pParticle->m_Ages[i] << std::endl;
+    }
     
     _os << _pParticle->m_fDamping << std::endl;
     _os << _pParticle->m_fMaxAge << std::endl;
@@ -292,11 +630,39 @@ void CParticle::copy(const CParticle& _Particle)
     METHOD_ENTRY("CParticle::copy")
     
     //--- Variables of CParticle -----------------------------------------------//
-    m_PosList = _Particle.m_PosList;
-    m_PosListPrev = _Particle.m_PosListPrev;
-    m_VelList = _Particle.m_VelList;
-    m_AgeList = _Particle.m_AgeList;
-    m_StateList = _Particle.m_StateList;
+    if (m_Ages.size() == _Particle.m_Ages.size())
+    {
+        // Free slots are overwritten before use, only live range is copied
+        const std::size_t nEnd = std::min(_Particle.m_nBegin + _Particle.m_nSize, _Particle.m_nCapacity);
+        const std::size_t nWrap = _Particle.m_nSize - (nEnd - _Particle.m_nBegin);
+        auto copyLive = [&](ParticleArrayType& _Array, const ParticleArrayType& _ArraySrc)
+        {
+            std::copy(_ArraySrc.begin() + _Particle.m_nBegin, _ArraySrc.begin() + nEnd,
+                      _Array.begin() + _Particle.m_nBegin);
+            std::copy(_ArraySrc.begin(), _ArraySrc.begin() + nWrap, _Array.begin());
+        };
+        copyLive(m_PosX, _Particle.m_PosX);
+        copyLive(m_PosY, _Particle.m_PosY);
+        copyLive(m_PosPrevX, _Particle.m_PosPrevX);
+        copyLive(m_PosPrevY, _Particle.m_PosPrevY);
+        copyLive(m_VelX, _Particle.m_VelX);
+        copyLive(m_VelY, _Particle.m_VelY);
+        copyLive(m_Ages, _Particle.m_Ages);
+    }
+    else
+    {
+        m_PosX = _Particle.m_PosX;
+        m_PosY = _Particle.m_PosY;
+        m_PosPrevX = _Particle.m_PosPrevX;
+        m_PosPrevY = _Particle.m_PosPrevY;
+        m_VelX = _Particle.m_VelX;
+        m_VelY = _Particle.m_VelY;
+        m_Ages = _Particle.m_Ages;
+    }
+    m_nCapacity = _Particle.m_nCapacity;
+    m_nBegin = _Particle.m_nBegin;
+    m_nSize = _Particle.m_nSize;
+    m_nGeneration = _Particle.m_nGeneration;
     m_BBox = _Particle.m_BBox;
     
     // m_Lifetime: New individual object
@@ -313,11 +679,16 @@ void CParticle::copy(const CParticle& _Particle)
 }
 
 SERIALIZE_IMPL(CParticle,
-    SERIALIZE("positions", &m_PosList);
-    SERIALIZE("positions_prev", &m_PosListPrev);
-    SERIALIZE("velocities", &m_VelList);
-    SERIALIZE("age", &m_AgeList);
-    SERIALIZE("state", &m_StateList);
+    SERIALIZE("capacity", m_nCapacity)
+    SERIALIZE("begin", m_nBegin)
+    SERIALIZE("size", m_nSize)
+    SERIALIZE_UNARY("positions_x", m_PosX)
+    SERIALIZE_UNARY("positions_y", m_PosY)
+    SERIALIZE_UNARY("positions_prev_x", m_PosPrevX)
+    SERIALIZE_UNARY("positions_prev_y", m_PosPrevY)
+    SERIALIZE_UNARY("velocities_x", m_VelX)
+    SERIALIZE_UNARY("velocities_y", m_VelY)
+    SERIALIZE_UNARY("age", m_Ages)
     SERIALIZE("bounding_box", &m_BBox)
     SERIALIZE("particle_type", s_ParticleTypeToStringMap.at(m_ParticleType))
     SERIALIZE("time_factor", m_fTimeFac)
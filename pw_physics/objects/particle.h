@@ -33,24 +33,37 @@
 
 //--- Program header ---------------------------------------------------------//
 #include "bounding_box.h"
-#include "circular_buffer.h"
 #include "graphics.h"
 #include "grid_user.h"
+#include "multi_buffer.h"
+#include "pool.h"
 #include "serializable.h"
 #include "uid_user.h"
 
 //--- Standard header --------------------------------------------------------//
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <vector>
 
 //--- Misc header ------------------------------------------------------------//
 #include <eigen3/Eigen/Core>
 
 const uint32_t PARTICLE_DEFAULT_NUMBER = 100;
-const uint8_t PARTICLE_STATE_ACTIVE = 0;
-const uint8_t PARTICLE_STATE_INACTIVE = 1;
 
 using namespace Eigen;
 
+/// Specifies contiguous storage of one particle attribute, aligned for SIMD access
+typedef std::vector<double, aligned_allocator<double>> ParticleArrayType;
+
+/// Specifies the kernel used for particle dynamics
+enum class ParticleKernelType
+{
+    SCALAR,
+    SSE2,
+    AVX2
+};
+
 /// Specifies the type of particle
 enum class ParticleTypeType
 {
@@ -67,9 +80,24 @@ enum class ParticleTypeType
 /// Particles have a very limited physical accuracy. They are mainly for visual
 /// purposes, do not have any real mass and thus, do not influence other objects.
 ///
-/// \Note The state is represented by a uint8_t, since bool specilisation for
-///       std::vector is a little restricted when accessing elements.
-/// 
+/// Particles are stored as structure of arrays, x and y components are kept in
+/// separate aligned arrays. The arrays are used as ring, live particles
+/// occupy a contiguous range of slots, beginning with the oldest particle.
+/// Remaining slots are free. New particles are appended to the range and
+/// overwrite the oldest one if the maximum number of particles is reached.
+///
+/// All particles age at the same rate, hence, expired particles always form
+/// the beginning of the range, which is advanced after each step. Dynamics,
+/// collisions and rendering only access live particles. Particles are
+/// indexed by their position within the range, thus, indices change when
+/// particles expire or new ones are generated.
+///
+/// Dynamics are calculated by SIMD kernels (AVX2 or SSE2, depending on the
+/// CPU), with a scalar fallback. Parts of the live range can be calculated
+/// independently, e.g. by multiple workers, each accumulating its own bounds.
+/// The step is finished afterwards by merging bounds and removing expired
+/// particles.
+///
 ////////////////////////////////////////////////////////////////////////////////
 class CParticle : public IGridUser,
                   public ISerializable,
@@ -77,6 +105,15 @@ class CParticle : public IGridUser,
 {
     
     public:
+        
+        /// Bounds of particles, accumulated by dynamics kernels
+        struct BoundsType
+        {
+            double fMinX;   ///< Minimum x
+            double fMinY;   ///< Minimum y
+            double fMaxX;   ///< Maximum x
+            double fMaxY;   ///< Maximum y
+        };
     
         //--- Constructor/Destructor -----------------------------------------//
         CParticle();
@@ -84,6 +121,9 @@ class CParticle : public IGridUser,
         CParticle& operator=(const CParticle&);
         CParticle* clone() const;
 
+        //--- Memory management ----------------------------------------------//
+        POOL_ALLOCATION(CParticle, BUFFER_QUADRUPLE)
+
         //--- Constant methods -----------------------------------------------//
         CBoundingBox&           getBoundingBox();
         const ParticleTypeType& getParticleType()  const;
@@ -95,28 +135,43 @@ class CParticle : public IGridUser,
         const double&           getSizeDeath() const {return m_fSizeDeath;}
         const double&           getMaxAge() const {return m_fMaxAge;}
 
-        //--- Methods --------------------------------------------------------//
-        CCircularBuffer<Vector2d>* getPositions();
-        CCircularBuffer<Vector2d>* getVelocities();
-        CCircularBuffer<Vector2d>* getPreviousPositions();
-        CCircularBuffer<double>*   getAge();
-        CCircularBuffer<std::uint8_t>*  getStates();
+        const double&               getAge(const int) const;
+        std::size_t                 getCapacity() const;
+        std::size_t                 getFirstSlot() const;
+        std::uint32_t               getGeneration() const;
+        std::size_t                 getNumberOfParticles() const;
+        Vector2d                    getPosition(const int) const;
+        const ParticleArrayType&    getPositionsX() const;
+        const ParticleArrayType&    getPositionsY() const;
+        Vector2d                    getPreviousPosition(const int) const;
+        Vector2d                    getVelocity(const int) const;
         
+        static ParticleKernelType   getKernel();
+
+        //--- Methods --------------------------------------------------------//
         void                setDamping(const double&);
         void                setParticleType(const ParticleTypeType&);
         void                setDepths(const int&);
         void                setForce(const Vector2d&);
         void                setNumber(const int&);
+        void                setPosition(const int, const Vector2d&);
         void                setTimeFac(const double&);
+        void                setVelocity(const int, const Vector2d&);
         
-        void                setColorBirth(const ColorTypeRGBA& _aColorBirth) {m_aColorBirth = _aColorBirth;}
-        void                setColorDeath(const ColorTypeRGBA& _aColorDeath) {m_aColorDeath = _aColorDeath;}
-        void                setSizeBirth(const double& _fSizeBirth) {m_fSizeBirth = _fSizeBirth;}
-        void                setSizeDeath(const double& _fSizeDeath) {m_fSizeDeath = _fSizeDeath;}
-        void                setMaxAge(const double& _fAge) {m_fMaxAge = _fAge;}
+        void                setColorBirth(const ColorTypeRGBA& _aColorBirth) {m_aColorBirth = _aColorBirth; ++m_nGeneration;}
+        void                setColorDeath(const ColorTypeRGBA& _aColorDeath) {m_aColorDeath = _aColorDeath; ++m_nGeneration;}
+        void                setSizeBirth(const double& _fSizeBirth) {m_fSizeBirth = _fSizeBirth; ++m_nGeneration;}
+        void                setSizeDeath(const double& _fSizeDeath) {m_fSizeDeath = _fSizeDeath; ++m_nGeneration;}
+        void                setMaxAge(const double& _fAge) {m_fMaxAge = _fAge; ++m_nGeneration;}
         
         void                dynamics(const double&);
+        void                dynamics(const double&, const int, const int, BoundsType&);
+        void                finishDynamics(const BoundsType&);
         void                generate(const Vector2d&, const Vector2d&);
+        
+        static BoundsType   getEmptyBounds();
+        static void         mergeBounds(BoundsType&, const BoundsType&);
+        static void         setKernel(const ParticleKernelType);
 
         //--- friends --------------------------------------------------------//
         friend std::istream&    operator>>(std::istream&, CParticle* const);
@@ -126,13 +181,28 @@ class CParticle : public IGridUser,
         
         //--- Methods [protected] --------------------------------------------//
         void                   copy(const CParticle&);
+        std::size_t            toSlot(const int) const;
+        void                   dynamicsAVX2(const double&, const Vector2d&, const int, const int, BoundsType&);
+        void                   dynamicsScalar(const double&, const Vector2d&, const int, const int, BoundsType&);
+        void                   dynamicsSSE2(const double&, const Vector2d&, const int, const int, BoundsType&);
+        
+        static ParticleKernelType detectKernel();
 
         //--- Variables [protected] ------------------------------------------//
-        CCircularBuffer<Vector2d> m_PosList;                 ///< Position of particle
-        CCircularBuffer<Vector2d> m_PosListPrev;             ///< Position of particle in previous time step
-        CCircularBuffer<Vector2d> m_VelList;                 ///< Velocity of derbis
-        CCircularBuffer<double>   m_AgeList;                 ///< Age of particles
-        CCircularBuffer<std::uint8_t>  m_StateList;          ///< Is the particle active or inactive
+        ParticleArrayType         m_PosX;                    ///< Position of particles, x
+        ParticleArrayType         m_PosY;                    ///< Position of particles, y
+        ParticleArrayType         m_PosPrevX;                ///< Position of particles in previous time step, x
+        ParticleArrayType         m_PosPrevY;                ///< Position of particles in previous time step, y
+        ParticleArrayType         m_VelX;                    ///< Velocity of particles, x
+        ParticleArrayType         m_VelY;                    ///< Velocity of particles, y
+        ParticleArrayType         m_Ages;                    ///< Age of particles
+        
+        std::size_t             m_nCapacity;                 ///< Maximum number of particles
+        std::size_t             m_nBegin;                    ///< Slot of oldest live particle
+        std::size_t             m_nSize;                     ///< Number of live particles
+        std::uint32_t           m_nGeneration;               ///< Incremented on each change, copies of same generation are equal
+        
+        static ParticleKernelType s_Kernel;                  ///< Kernel used for dynamics
         
         CBoundingBox            m_BBox;                      ///< Bounding box of all particle
         
@@ -215,70 +285,199 @@ inline const ParticleTypeType& CParticle::getParticleType() const
 
 ////////////////////////////////////////////////////////////////////////////////
 ///
-/// \brief Returns positions of the particle
+/// \brief Returns age of particle
 ///
-/// \return List of positions of particle
+/// \param _nI Index of live particle
+///
+/// \return Age of particle
 ///
 ////////////////////////////////////////////////////////////////////////////////
-inline CCircularBuffer<Vector2d>* CParticle::getPositions()
+inline const double& CParticle::getAge(const int _nI) const
 {
-    METHOD_ENTRY("CParticle::getPositions")
-    return &m_PosList;
+    METHOD_ENTRY("CParticle::getAge")
+    return m_Ages[this->toSlot(_nI)];
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ///
-/// \brief Returns velocities of the particle
+/// \brief Returns maximum number of particles
 ///
-/// \return List of velocities of particle
+/// \return Maximum number of particles
 ///
 ////////////////////////////////////////////////////////////////////////////////
-inline CCircularBuffer<Vector2d>* CParticle::getVelocities()
+inline std::size_t CParticle::getCapacity() const
 {
-    METHOD_ENTRY("CParticle::getVelocities")
-    return &m_VelList;
+    METHOD_ENTRY("CParticle::getCapacity")
+    return m_nCapacity;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ///
-/// \brief Returns positions of the particle from previous timestep
+/// \brief Returns slot of oldest live particle
 ///
-/// \return List of positions of particle from previous timestep
+/// \return Slot of oldest live particle
 ///
 ////////////////////////////////////////////////////////////////////////////////
-inline CCircularBuffer<Vector2d>* CParticle::getPreviousPositions()
+inline std::size_t CParticle::getFirstSlot() const
 {
-    METHOD_ENTRY("CParticle::getPreviousPositions")
-    return &m_PosListPrev;
+    METHOD_ENTRY("CParticle::getFirstSlot")
+    return m_nBegin;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ///
-/// \brief Returns age of the particles
+/// \brief Returns generation, i.e. number of changes
 ///
-/// \return List of age of the particles
+/// Copies of the same generation are equal, thus, buffers only need to be
+/// copied if generations differ.
+///
+/// \return Generation
 ///
 ////////////////////////////////////////////////////////////////////////////////
-inline CCircularBuffer<double>* CParticle::getAge()
+inline std::uint32_t CParticle::getGeneration() const
 {
-    METHOD_ENTRY("CParticle::getAge")
-    return &m_AgeList;
+    METHOD_ENTRY("CParticle::getGeneration")
+    return m_nGeneration;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of live particles
+///
+/// \return Number of live particles
+///
+////////////////////////////////////////////////////////////////////////////////
+inline std::size_t CParticle::getNumberOfParticles() const
+{
+    METHOD_ENTRY("CParticle::getNumberOfParticles")
+    return m_nSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns position of particle
+///
+/// \param _nI Index of live particle
+///
+/// \return Position of particle
+///
+////////////////////////////////////////////////////////////////////////////////
+inline Vector2d CParticle::getPosition(const int _nI) const
+{
+    METHOD_ENTRY("CParticle::getPosition")
+    const std::size_t nSlot = this->toSlot(_nI);
+    return Vector2d(m_PosX[nSlot], m_PosY[nSlot]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns x components of positions of all slots
+///
+/// Live particles occupy the slots beginning at \ref getFirstSlot, wrapping
+/// around at the capacity.
+///
+/// \return Positions, x
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const ParticleArrayType& CParticle::getPositionsX() const
+{
+    METHOD_ENTRY("CParticle::getPositionsX")
+    return m_PosX;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns y components of positions of all slots
+///
+/// Live particles occupy the slots beginning at \ref getFirstSlot, wrapping
+/// around at the capacity.
+///
+/// \return Positions, y
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const ParticleArrayType& CParticle::getPositionsY() const
+{
+    METHOD_ENTRY("CParticle::getPositionsY")
+    return m_PosY;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns position of particle from previous timestep
+///
+/// \param _nI Index of live particle
+///
+/// \return Position of particle from previous timestep
+///
+////////////////////////////////////////////////////////////////////////////////
+inline Vector2d CParticle::getPreviousPosition(const int _nI) const
+{
+    METHOD_ENTRY("CParticle::getPreviousPosition")
+    const std::size_t nSlot = this->toSlot(_nI);
+    return Vector2d(m_PosPrevX[nSlot], m_PosPrevY[nSlot]);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns velocity of particle
+///
+/// \param _nI Index of live particle
+///
+/// \return Velocity of particle
+///
+////////////////////////////////////////////////////////////////////////////////
+inline Vector2d CParticle::getVelocity(const int _nI) const
+{
+    METHOD_ENTRY("CParticle::getVelocity")
+    const std::size_t nSlot = this->toSlot(_nI);
+    return Vector2d(m_VelX[nSlot], m_VelY[nSlot]);
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 ///
-/// \brief Returns states of the particle, defining if a particle is active or not.
+/// \brief Returns kernel used for dynamics
 ///
-/// \return List of states of the particle
+/// \return Kernel
 ///
 ////////////////////////////////////////////////////////////////////////////////
-inline CCircularBuffer<std::uint8_t>* CParticle::getStates()
+inline ParticleKernelType CParticle::getKernel()
 {
-    METHOD_ENTRY("CParticle::getStates")
-    return &m_StateList;
+    METHOD_ENTRY("CParticle::getKernel")
+    return s_Kernel;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns empty bounds, to be extended by dynamics
+///
+/// \return Empty bounds
+///
+////////////////////////////////////////////////////////////////////////////////
+inline CParticle::BoundsType CParticle::getEmptyBounds()
+{
+    METHOD_ENTRY("CParticle::getEmptyBounds")
+    return {std::numeric_limits<double>::infinity(),
+            std::numeric_limits<double>::infinity(),
+            -std::numeric_limits<double>::infinity(),
+            -std::numeric_limits<double>::infinity()};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Extends bounds by given bounds
+///
+/// \param _Bounds Bounds to be extended
+/// \param _BoundsOther Bounds to be merged
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CParticle::mergeBounds(BoundsType& _Bounds, const BoundsType& _BoundsOther)
+{
+    METHOD_ENTRY("CParticle::mergeBounds")
+    _Bounds.fMinX = std::min(_Bounds.fMinX, _BoundsOther.fMinX);
+    _Bounds.fMinY = std::min(_Bounds.fMinY, _BoundsOther.fMinY);
+    _Bounds.fMaxX = std::max(_Bounds.fMaxX, _BoundsOther.fMaxX);
+    _Bounds.fMaxY = std::max(_Bounds.fMaxY, _BoundsOther.fMaxY);
+}
 
 ///////////////////////////////////////////////////////////////////////////////
 ///
@@ -306,6 +505,7 @@ inline void CParticle::setDamping(const double& _fD)
 {
     METHOD_ENTRY("CParticle::setDamping")
     m_fDamping = _fD;
+    ++m_nGeneration;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -319,6 +519,7 @@ inline void CParticle::setParticleType(const ParticleTypeType& _ParticleType)
 {
     METHOD_ENTRY("CParticle::setParticleTypeType")
     m_ParticleType = _ParticleType;
+    ++m_nGeneration;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -332,6 +533,7 @@ inline void CParticle::setDepths(const int& _nD)
 {
     METHOD_ENTRY("CParticle::setDepths")
     m_nDepthlayers |= _nD;
+    ++m_nGeneration;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -344,7 +546,28 @@ inline void CParticle::setDepths(const int& _nD)
 inline void CParticle::setForce(const Vector2d& _vecF)
 {
     METHOD_ENTRY("CParticle::setForce")
-    m_vecForce = _vecF;
+    if (m_vecForce != _vecF)
+    {
+        m_vecForce = _vecF;
+        ++m_nGeneration;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets position of particle
+///
+/// \param _nI Index of live particle
+/// \param _vecP Position
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CParticle::setPosition(const int _nI, const Vector2d& _vecP)
+{
+    METHOD_ENTRY("CParticle::setPosition")
+    const std::size_t nSlot = this->toSlot(_nI);
+    m_PosX[nSlot] = _vecP[0];
+    m_PosY[nSlot] = _vecP[1];
+    ++m_nGeneration;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -363,6 +586,42 @@ inline void CParticle::setTimeFac(const double& _fTF)
     METHOD_ENTRY("CParticle::setTimeFac")
 
     m_fTimeFac = _fTF;
+    ++m_nGeneration;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets velocity of particle
+///
+/// \param _nI Index of live particle
+/// \param _vecV Velocity
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CParticle::setVelocity(const int _nI, const Vector2d& _vecV)
+{
+    METHOD_ENTRY("CParticle::setVelocity")
+    const std::size_t nSlot = this->toSlot(_nI);
+    m_VelX[nSlot] = _vecV[0];
+    m_VelY[nSlot] = _vecV[1];
+    ++m_nGeneration;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns slot of live particle
+///
+/// \param _nI Index of live particle, starting with the oldest one
+///
+/// \return Slot of particle
+///
+////////////////////////////////////////////////////////////////////////////////
+inline std::size_t CParticle::toSlot(const int _nI) const
+{
+    METHOD_ENTRY("CParticle::toSlot")
+    
+    std::size_t nSlot = m_nBegin + _nI;
+    if (nSlot >= m_nCapacity) nSlot -= m_nCapacity;
+    return nSlot;
 }
 
 #endif
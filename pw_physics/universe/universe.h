@@ -36,7 +36,7 @@
 
 //--- Program header ---------------------------------------------------------//
 #include "conf_pw.h"
-#include "spinlock.h"
+#include "adaptive_lock.h"
 #include "star_system.h"
 
 //--- Misc header ------------------------------------------------------------//
@@ -74,7 +74,7 @@ class CUniverse
         const std::vector<CStarSystem*>* getStarSystems();
         
         //--- Variables ------------------------------------------------------//
-        CSpinlock Access;
+        CAdaptiveLock Access{"CUniverse::Access"};
             
     private:
         
@@ -0,0 +1,322 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017-2018 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       adaptive_lock.cpp
+/// \brief      Implementation of class "CAdaptiveLock"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "adaptive_lock.h"
+
+//--- Standard header --------------------------------------------------------//
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+//--- Misc header ------------------------------------------------------------//
+#if defined(_MSC_VER)
+    #include <immintrin.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Constructor, registering lock by name
+///
+/// Locks might be static, thus, no logging is done here.
+///
+/// \param _strName Name of lock
+///
+////////////////////////////////////////////////////////////////////////////////
+CAdaptiveLock::CAdaptiveLock(const std::string& _strName) : m_strName(_strName),
+                                                            #ifdef PW_MULTITHREADING
+                                                                m_bLocked(false),
+                                                                m_nWaiting(0),
+                                                            #endif
+                                                            m_nAcquisitions(0u),
+                                                            m_nAcquisitionsContended(0u),
+                                                            m_nWaitTotal(0u),
+                                                            m_nWaitMax(0u),
+                                                            m_nWaitsForRelease(0u),
+                                                            m_nWaitForReleaseTotal(0u)
+{
+    std::lock_guard<std::mutex> Lock(getLocksMutex());
+    getLocks().push_back(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Destructor, unregistering lock
+///
+////////////////////////////////////////////////////////////////////////////////
+CAdaptiveLock::~CAdaptiveLock()
+{
+    std::lock_guard<std::mutex> Lock(getLocksMutex());
+    getLocks().remove(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns statistics of lock
+///
+/// Counters are read individually while the lock might be in use, thus, they
+/// are not necessarily consistent with each other.
+///
+/// \return Statistics of lock
+///
+////////////////////////////////////////////////////////////////////////////////
+CAdaptiveLock::StatisticsType CAdaptiveLock::getStatistics() const
+{
+    METHOD_ENTRY("CAdaptiveLock::getStatistics")
+
+    StatisticsType Statistics;
+    Statistics.nAcquisitions = m_nAcquisitions.load(std::memory_order_relaxed);
+    Statistics.nAcquisitionsContended = m_nAcquisitionsContended.load(std::memory_order_relaxed);
+    Statistics.fWaitTotal = m_nWaitTotal.load(std::memory_order_relaxed) * 1.0e-9;
+    Statistics.fWaitMax = m_nWaitMax.load(std::memory_order_relaxed) * 1.0e-9;
+    Statistics.nWaitsForRelease = m_nWaitsForRelease.load(std::memory_order_relaxed);
+    Statistics.fWaitForReleaseTotal = m_nWaitForReleaseTotal.load(std::memory_order_relaxed) * 1.0e-9;
+    return Statistics;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Release lock
+///
+/// Waiting callers are only notified if there are any. Since the flag is
+/// cleared before the number of waiting callers is read, a caller going to
+/// wait either sees the cleared flag or is notified.
+///
+////////////////////////////////////////////////////////////////////////////////
+void CAdaptiveLock::releaseLock()
+{
+    METHOD_ENTRY("CAdaptiveLock::releaseLock")
+    #ifdef PW_MULTITHREADING
+        m_bLocked.store(false, std::memory_order_seq_cst);
+        if (m_nWaiting.load(std::memory_order_seq_cst) > 0)
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            m_Released.notify_one();
+        }
+    #endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Resets statistics of lock
+///
+////////////////////////////////////////////////////////////////////////////////
+void CAdaptiveLock::resetStatistics()
+{
+    METHOD_ENTRY("CAdaptiveLock::resetStatistics")
+    m_nAcquisitions = 0u;
+    m_nAcquisitionsContended = 0u;
+    m_nWaitTotal = 0u;
+    m_nWaitMax = 0u;
+    m_nWaitsForRelease = 0u;
+    m_nWaitForReleaseTotal = 0u;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Lock without waiting to acquire lock
+///
+////////////////////////////////////////////////////////////////////////////////
+void CAdaptiveLock::setLock()
+{
+    METHOD_ENTRY("CAdaptiveLock::setLock")
+    #ifdef PW_MULTITHREADING
+        m_bLocked.store(true, std::memory_order_seq_cst);
+        m_nAcquisitions.fetch_add(1u, std::memory_order_relaxed);
+    #endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Wait for lock to be released
+///
+/// The lock is taken only shortly to wait for release, hence, this isn't
+/// counted as acquisition. Waiting is accounted separately to not distort
+/// the wait statistics of acquisitions.
+///
+////////////////////////////////////////////////////////////////////////////////
+void CAdaptiveLock::waitForRelease()
+{
+    METHOD_ENTRY("CAdaptiveLock::waitForRelease")
+    #ifdef PW_MULTITHREADING
+        if (m_bLocked.exchange(true, std::memory_order_acquire))
+        {
+            m_nWaitForReleaseTotal.fetch_add(this->waitContended(), std::memory_order_relaxed);
+            m_nWaitsForRelease.fetch_add(1u, std::memory_order_relaxed);
+        }
+        this->releaseLock();
+    #endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns statistics of all locks as table
+///
+/// Locks are sorted by total time waited for acquisition, hence, the hottest
+/// lock is listed first.
+///
+/// \return Statistics of all locks, one line per lock
+///
+////////////////////////////////////////////////////////////////////////////////
+std::string CAdaptiveLock::getStatisticsAll()
+{
+    METHOD_ENTRY("CAdaptiveLock::getStatisticsAll")
+
+    std::vector<std::pair<std::string, StatisticsType>> Statistics;
+    {
+        std::lock_guard<std::mutex> Lock(getLocksMutex());
+        for (const auto pLock : getLocks())
+            Statistics.push_back({pLock->getName(), pLock->getStatistics()});
+    }
+    std::stable_sort(Statistics.begin(), Statistics.end(),
+                     [](const std::pair<std::string, StatisticsType>& _A,
+                        const std::pair<std::string, StatisticsType>& _B) -> bool
+                     {
+                         return _A.second.fWaitTotal > _B.second.fWaitTotal;
+                     });
+
+    std::ostringstream oss;
+    oss << std::left << std::setw(40) << "Lock" << std::right <<
+           std::setw(14) << "Acquisitions" <<
+           std::setw(14) << "Contended" <<
+           std::setw(16) << "Wait total/ms" <<
+           std::setw(14) << "Wait max/ms" <<
+           std::setw(14) << "Waits rel." <<
+           std::setw(16) << "Wait rel./ms" << std::endl;
+    for (const auto& Stat : Statistics)
+    {
+        oss << std::left << std::setw(40) << Stat.first << std::right <<
+               std::setw(14) << Stat.second.nAcquisitions <<
+               std::setw(14) << Stat.second.nAcquisitionsContended <<
+               std::setw(16) << Stat.second.fWaitTotal*1.0e3 <<
+               std::setw(14) << Stat.second.fWaitMax*1.0e3 <<
+               std::setw(14) << Stat.second.nWaitsForRelease <<
+               std::setw(16) << Stat.second.fWaitForReleaseTotal*1.0e3 << std::endl;
+    }
+    return oss.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Acquire lock held by another caller
+///
+/// The time waited is accounted to the statistics of acquisitions.
+///
+////////////////////////////////////////////////////////////////////////////////
+void CAdaptiveLock::acquireLockContended()
+{
+    METHOD_ENTRY("CAdaptiveLock::acquireLockContended")
+    #ifdef PW_MULTITHREADING
+        const std::uint64_t nWait = this->waitContended();
+        m_nAcquisitionsContended.fetch_add(1u, std::memory_order_relaxed);
+        m_nWaitTotal.fetch_add(nWait, std::memory_order_relaxed);
+        std::uint64_t nWaitMax = m_nWaitMax.load(std::memory_order_relaxed);
+        while (nWait > nWaitMax &&
+               !m_nWaitMax.compare_exchange_weak(nWaitMax, nWait, std::memory_order_relaxed)) {}
+    #endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Wait for release of lock held by another caller and take it
+///
+/// Spin with exponential backoff first, giving the processor some hint
+/// (pause) to optimise pipelining, hyper threading and bus frequency. If still
+/// blocked, wait for release on the condition variable.
+///
+/// \return Time waited, in nanoseconds
+///
+////////////////////////////////////////////////////////////////////////////////
+std::uint64_t CAdaptiveLock::waitContended()
+{
+    METHOD_ENTRY("CAdaptiveLock::waitContended")
+    #ifdef PW_MULTITHREADING
+        using namespace std::chrono;
+        const auto Start = steady_clock::now();
+
+        bool bAcquired = false;
+        for (auto i=0; i<ADAPTIVE_LOCK_BACKOFF_STEPS && !bAcquired; ++i)
+        {
+            for (auto j=0; j<(1 << i); ++j)
+            {
+                #if defined(_MSC_VER)
+                    _mm_pause();
+                #elif defined(__clang__) || defined(__GNUC__)
+                    asm("pause");
+                #endif
+            }
+            // Only read while held to keep cache line shared
+            bAcquired = !m_bLocked.load(std::memory_order_relaxed) &&
+                        !m_bLocked.exchange(true, std::memory_order_acquire);
+        }
+        if (!bAcquired)
+        {
+            std::unique_lock<std::mutex> Lock(m_Mutex);
+            m_nWaiting.fetch_add(1, std::memory_order_seq_cst);
+            m_Released.wait(Lock, [this]{return !m_bLocked.exchange(true, std::memory_order_seq_cst);});
+            m_nWaiting.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        return duration_cast<nanoseconds>(steady_clock::now() - Start).count();
+    #else
+        return 0u;
+    #endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns all registered locks
+///
+/// Constructed on first use, since locks might be static themselves.
+///
+/// \return Registered locks
+///
+////////////////////////////////////////////////////////////////////////////////
+std::list<CAdaptiveLock*>& CAdaptiveLock::getLocks()
+{
+    static std::list<CAdaptiveLock*> s_Locks;
+    return s_Locks;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns mutex guarding registered locks
+///
+/// Constructed on first use, since locks might be static themselves.
+///
+/// \return Mutex guarding registered locks
+///
+////////////////////////////////////////////////////////////////////////////////
+std::mutex& CAdaptiveLock::getLocksMutex()
+{
+    static std::mutex s_Mutex;
+    return s_Mutex;
+}
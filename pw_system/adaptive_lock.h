@@ -0,0 +1,163 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017-2018 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       adaptive_lock.h
+/// \brief      Prototype of class "CAdaptiveLock"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ADAPTIVE_LOCK_H
+#define ADAPTIVE_LOCK_H
+
+//--- Standard header --------------------------------------------------------//
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+
+//--- Program header ---------------------------------------------------------//
+#include "conf_pw.h"
+#include "log.h"
+
+//--- Constants --------------------------------------------------------------//
+constexpr int ADAPTIVE_LOCK_BACKOFF_STEPS = 10; ///< Number of spinning steps, pauses doubling each step
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Class representing a named, instrumented lock
+///
+/// The lock uses an atomic flag to signal access. If the lock is held, the
+/// caller spins with exponential backoff, i.e. the number of pause
+/// instructions between two attempts doubles each step. If the lock is still
+/// held, the caller waits on a condition variable until it is released.
+/// Releasing only involves the condition variable if there are waiting
+/// callers.
+///
+/// Like the flag, the lock might be released by another thread than the one
+/// setting it, which is used to block access while creating entities.
+///
+/// Each lock counts acquisitions, contended acquisitions and the time spent
+/// waiting. Callers only waiting for release without holding the lock are
+/// counted separately. All locks register by name, thus, statistics can be
+/// listed for all locks, e.g. to find out which one is hot.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CAdaptiveLock
+{
+
+    public:
+
+        /// Statistics of a lock
+        struct StatisticsType
+        {
+            std::uint64_t nAcquisitions;            ///< Number of acquisitions
+            std::uint64_t nAcquisitionsContended;   ///< Number of acquisitions that had to wait
+            double        fWaitTotal;               ///< Total time waited, in seconds
+            double        fWaitMax;                 ///< Maximum time waited, in seconds
+            std::uint64_t nWaitsForRelease;         ///< Number of waits for release that had to wait
+            double        fWaitForReleaseTotal;     ///< Total time waited for release, in seconds
+        };
+
+        //--- Constructor/Destructor------------------------------------------//
+        explicit CAdaptiveLock(const std::string&);
+        ~CAdaptiveLock();
+        CAdaptiveLock(const CAdaptiveLock&) = delete;
+        CAdaptiveLock& operator=(const CAdaptiveLock&) = delete;
+
+        //--- Constant methods -----------------------------------------------//
+        const std::string&  getName() const;
+        StatisticsType      getStatistics() const;
+
+        //--- Methods --------------------------------------------------------//
+        void acquireLock();
+        void releaseLock();
+        void resetStatistics();
+        void setLock();
+        void waitForRelease();
+
+        static std::string getStatisticsAll();
+
+    private:
+
+        //--- Methods [private] ----------------------------------------------//
+        void          acquireLockContended();
+        std::uint64_t waitContended();
+
+        static std::list<CAdaptiveLock*>&   getLocks();
+        static std::mutex&                  getLocksMutex();
+
+        //--- Variables [private] --------------------------------------------//
+        std::string                 m_strName;                  ///< Name of lock, e.g. for statistics
+
+        #ifdef PW_MULTITHREADING
+            std::atomic_bool            m_bLocked;              ///< Indicates access, important for multithreading
+            std::atomic_int             m_nWaiting;             ///< Number of callers waiting for release
+            std::mutex                  m_Mutex;                ///< Mutex guarding condition variable
+            std::condition_variable     m_Released;             ///< Signals release to waiting callers
+        #endif
+
+        std::atomic<std::uint64_t>  m_nAcquisitions;            ///< Number of acquisitions
+        std::atomic<std::uint64_t>  m_nAcquisitionsContended;   ///< Number of acquisitions that had to wait
+        std::atomic<std::uint64_t>  m_nWaitTotal;               ///< Total time waited, in nanoseconds
+        std::atomic<std::uint64_t>  m_nWaitMax;                 ///< Maximum time waited, in nanoseconds
+        std::atomic<std::uint64_t>  m_nWaitsForRelease;         ///< Number of waits for release that had to wait
+        std::atomic<std::uint64_t>  m_nWaitForReleaseTotal;     ///< Total time waited for release, in nanoseconds
+};
+
+//--- Implementation is done here for inline optimisation --------------------//
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns name of lock
+///
+/// \return Name of lock
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const std::string& CAdaptiveLock::getName() const
+{
+    METHOD_ENTRY("CAdaptiveLock::getName")
+    return m_strName;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Acquire lock
+///
+/// The uncontended case is a single atomic exchange.
+///
+////////////////////////////////////////////////////////////////////////////////
+inline void CAdaptiveLock::acquireLock()
+{
+    METHOD_ENTRY("CAdaptiveLock::acquireLock")
+    #ifdef PW_MULTITHREADING
+        if (m_bLocked.exchange(true, std::memory_order_acquire))
+            this->acquireLockContended();
+        m_nAcquisitions.fetch_add(1u, std::memory_order_relaxed);
+    #endif
+}
+
+#endif // ADAPTIVE_LOCK_H
@@ -122,14 +122,37 @@ CComInterface::~CComInterface()
         }
     }
     
-    for (auto pCallback : m_RegisteredCallbacks)
+    const CallbackTableType* const pTable = m_pCallbackTable.exchange(nullptr);
+    if (pTable != nullptr)
     {
-        if (pCallback.second != nullptr)
+        for (auto& Slot : *pTable)
         {
-            delete pCallback.second;
-            pCallback.second = nullptr;
-            MEM_FREED_QUIET("IBaseCommand")
+            const CallbackListType* pCallbacks = Slot.second->pCallbacks.exchange(nullptr);
+            if (pCallbacks != nullptr)
+            {
+                for (auto pCallback : *pCallbacks)
+                {
+                    delete pCallback;
+                    MEM_FREED_QUIET("IBaseCommand")
+                }
+                delete pCallbacks;
+                MEM_FREED_QUIET("CallbackListType")
+            }
+            delete Slot.second;
+            MEM_FREED_QUIET("CallbackSlotType")
         }
+        delete pTable;
+        MEM_FREED_QUIET("CallbackTableType")
+    }
+    for (auto pTableRetired : m_RetiredCallbackTables)
+    {
+        delete pTableRetired;
+        MEM_FREED_QUIET("CallbackTableType")
+    }
+    for (auto pCallbacks : m_RetiredCallbackLists)
+    {
+        delete pCallbacks;
+        MEM_FREED_QUIET("CallbackListType")
     }
 
     for (auto pFunction : m_RegisteredFunctions)
@@ -152,6 +175,9 @@ CComInterface::~CComInterface()
 /// external calls. Internally, direct call should be preferred to avoid
 /// the parsing.
 ///
+/// Dynamic arrays are read up to the end of the command. If a function takes
+/// two of them, the first one is preceded by its number of elements.
+///
 /// \param _strCommand Command that should be called
 /// \return Return value of function as string
 ///
@@ -166,34 +192,36 @@ const std::string CComInterface::call(const std::string& _strCommand)
     
     iss >> strName;
     
-    if (m_RegisteredFunctions.find(strName) != m_RegisteredFunctions.end())
+    const StringIDType nName = CStringTable::find(strName);
+    const auto ci = m_RegisteredFunctionsByID.find(nName);
+    if (ci != m_RegisteredFunctionsByID.end())
     {
-        switch (m_RegisteredFunctions[strName]->getSignature())
+        switch (ci->second->getSignature())
         {
             case SignatureType::BOOL_INT:
             {
                 int nParam(0);
                 iss >> nParam;
-                oss << this->call<bool,int>(strName, nParam);
+                oss << this->call<bool,int>(nName, nParam);
                 break;
             }
             case SignatureType::DOUBLE:
             {
-                oss << this->call<double>(strName);
+                oss << this->call<double>(nName);
                 break;
             }
             case SignatureType::DOUBLE_INT:
             {
                 int nParam(0);
                 iss >> nParam;
-                oss << this->call<double,int>(strName, nParam);
+                oss << this->call<double,int>(nName, nParam);
                 break;
             }
             case SignatureType::DOUBLE_STRING:
             {
                 std::string strParam = "";
                 iss >> strParam;
-                oss << this->call<double,std::string>(strName, strParam);
+                oss << this->call<double,std::string>(nName, strParam);
                 break;
             }
             case SignatureType::DOUBLE_STRING_DOUBLE:
@@ -201,45 +229,96 @@ const std::string CComInterface::call(const std::string& _strCommand)
                 std::string strParam = "";
                 double fParam = 0.0;
                 iss >> strParam >> fParam;
-                oss << this->call<double,std::string,double>(strName, strParam, fParam);
+                oss << this->call<double,std::string,double>(nName, strParam, fParam);
+                break;
+            }
+            case SignatureType::DYN_ARRAY_DYN_ARRAY:
+            {
+                double fParam(0);
+                std::vector<double> vecDynArray{};
+                while (iss >> fParam)
+                {
+                    vecDynArray.push_back(fParam);
+                }
+                for (const auto fRet : this->call<std::vector<double>,std::vector<double>>(nName, vecDynArray))
+                {
+                    oss << fRet << " ";
+                }
+                break;
+            }
+            case SignatureType::DYN_ARRAY_INT:
+            {
+                int nParam(0);
+                iss >> nParam;
+                for (const auto fRet : this->call<std::vector<double>,int>(nName, nParam))
+                {
+                    oss << fRet << " ";
+                }
+                break;
+            }
+            case SignatureType::DYN_ARRAY_INT_DYN_ARRAY:
+            {
+                int nParam(0);
+                iss >> nParam;
+                double fParam(0);
+                std::vector<double> vecDynArray{};
+                while (iss >> fParam)
+                {
+                    vecDynArray.push_back(fParam);
+                }
+                for (const auto fRet : this->call<std::vector<double>,int,std::vector<double>>(nName, nParam, vecDynArray))
+                {
+                    oss << fRet << " ";
+                }
+                break;
+            }
+            case SignatureType::DYN_ARRAY_STRING_INT:
+            {
+                std::string strParam("");
+                int nParam(0);
+                iss >> strParam >> nParam;
+                for (const auto fRet : this->call<std::vector<double>,std::string,int>(nName, strParam, nParam))
+                {
+                    oss << fRet << " ";
+                }
                 break;
             }
             case SignatureType::INT:
             {
-                oss << this->call<int>(strName);
+                oss << this->call<int>(nName);
                 break;
             }
             case SignatureType::INT_INT:
             {
                 int nParam = 0;
                 iss >> nParam;
-                oss << this->call<int,int>(strName, nParam);
+                oss << this->call<int,int>(nName, nParam);
                 break;
             }
             case SignatureType::INT_STRING:
             {
                 std::string strS("");
                 iss >> strS;
-                oss << this->call<int,std::string>(strName, strS);
+                oss << this->call<int,std::string>(nName, strS);
                 break;
             }
             case SignatureType::NONE:
             {
-                this->call<void>(strName);
+                this->call<void>(nName);
                 break;
             }
             case SignatureType::NONE_BOOL:
             {
                 bool bParam = 0;
                 iss >> bParam;
-                this->call<void,bool>(strName, bParam);
+                this->call<void,bool>(nName, bParam);
                 break;
             }
             case SignatureType::NONE_DOUBLE:
             {
                 double fParam = 0.0;
                 iss >> fParam;
-                this->call<void,double>(strName, fParam);
+                this->call<void,double>(nName, fParam);
                 break;
             }
             case SignatureType::NONE_2DOUBLE:
@@ -247,14 +326,32 @@ const std::string CComInterface::call(const std::string& _strCommand)
                 double fParam1 = 0.0;
                 double fParam2 = 0.0;
                 iss >> fParam1 >> fParam2;
-                this->call<void,double>(strName, fParam1, fParam2);
+                this->call<void,double>(nName, fParam1, fParam2);
+                break;
+            }
+            case SignatureType::NONE_2DYN_ARRAY:
+            {
+                int nSize(0);
+                iss >> nSize;
+                double fParam(0);
+                std::vector<double> vecDynArray1{};
+                std::vector<double> vecDynArray2{};
+                while (int(vecDynArray1.size()) < nSize && iss >> fParam)
+                {
+                    vecDynArray1.push_back(fParam);
+                }
+                while (iss >> fParam)
+                {
+                    vecDynArray2.push_back(fParam);
+                }
+                this->call<void, std::vector<double>, std::vector<double>>(nName, vecDynArray1, vecDynArray2);
                 break;
             }
             case SignatureType::NONE_INT:
             {
                 int nParam = 0;
                 iss >> nParam;
-                this->call<void,int>(strName, nParam);
+                this->call<void,int>(nName, nParam);
                 break;
             }
             case SignatureType::NONE_2INT:
@@ -262,7 +359,7 @@ const std::string CComInterface::call(const std::string& _strCommand)
                 int nParam1(0);
                 int nParam2(0);
                 iss >> nParam1 >> nParam2;
-                this->call<void,int,int>(strName, nParam1, nParam2);
+                this->call<void,int,int>(nName, nParam1, nParam2);
                 break;
             }
             case SignatureType::NONE_3INT:
@@ -271,7 +368,7 @@ const std::string CComInterface::call(const std::string& _strCommand)
                 int nParam2(0);
                 int nParam3(0);
                 iss >> nParam1 >> nParam2 >> nParam3;
-                this->call<void,int,int>(strName, nParam1, nParam2, nParam3);
+                this->call<void,int,int>(nName, nParam1, nParam2, nParam3);
                 break;
             }
             case SignatureType::NONE_INT_DOUBLE:
@@ -279,7 +376,7 @@ const std::string CComInterface::call(const std::string& _strCommand)
                 int    nParam = 0;
                 double fParam = 0.0;
                 iss >> nParam >> fParam;
-                this->call<void,int,double>(strName, nParam, fParam);
+                this->call<void,int,double>(nName, nParam, fParam);
                 break;
             }
             case SignatureType::NONE_INT_STRING:
@@ -287,14 +384,14 @@ const std::string CComInterface::call(const std::string& _strCommand)
                 int         nParam(0);
                 std::string strParam("");
                 iss >> nParam >> strParam;
-                this->call<void,int,std::string>(strName, nParam, strParam);
+                this->call<void,int,std::string>(nName, nParam, strParam);
                 break;
             }
             case SignatureType::NONE_STRING:
             {
                 std::string strS;
                 iss >> strS;
-                this->call<void,std::string>(strName, strS);
+                this->call<void,std::string>(nName, strS);
                 break;
             }
             case SignatureType::NONE_2STRING:
@@ -302,7 +399,7 @@ const std::string CComInterface::call(const std::string& _strCommand)
                 std::string str1{""};
                 std::string str2{""};
                 iss >> str1 >> str2;
-                this->call<void,std::string,std::string>(strName, str1, str2);
+                this->call<void,std::string,std::string>(nName, str1, str2);
                 break;
             }
             case SignatureType::NONE_4STRING:
@@ -312,7 +409,7 @@ const std::string CComInterface::call(const std::string& _strCommand)
                 std::string str3{""};
                 std::string str4{""};
                 iss >> str1 >> str2 >> str3 >> str4;
-                this->call<void,std::string,std::string,std::string,std::string>(strName, str1, str2, str3, str4);
+                this->call<void,std::string,std::string,std::string,std::string>(nName, str1, str2, str3, str4);
                 break;
             }
             case SignatureType::NONE_INT_2DOUBLE:
@@ -321,7 +418,7 @@ const std::string CComInterface::call(const std::string& _strCommand)
                 iss >> nParam;
                 double fParam[2] = {0.0, 0.0};
                 iss >> fParam[0] >> fParam[1];
-                this->call<void, int, double, double>(strName, nParam, fParam[0], fParam[1]);
+                this->call<void, int, double, double>(nName, nParam, fParam[0], fParam[1]);
                 break;
             }
             case SignatureType::NONE_INT_4DOUBLE:
@@ -330,7 +427,7 @@ const std::string CComInterface::call(const std::string& _strCommand)
                 iss >> nParam;
                 double fParam[4] = {0.0, 0.0, 0.0, 0.0};
                 iss >> fParam[0] >> fParam[1] >> fParam[2] >> fParam[3];
-                this->call<void, int, double, double, double, double>(strName, nParam, fParam[0], fParam[1], fParam[2], fParam[3]);
+                this->call<void, int, double, double, double, double>(nName, nParam, fParam[0], fParam[1], fParam[2], fParam[3]);
                 break;
             }
             case SignatureType::NONE_INT_DYN_ARRAY:
@@ -344,7 +441,7 @@ const std::string CComInterface::call(const std::string& _strCommand)
                     iss >> fParam;
                     vecDynArray.push_back(fParam);
                 }
-                this->call<void, int, std::vector<double>>(strName, nParam, vecDynArray);
+                this->call<void, int, std::vector<double>>(nName, nParam, vecDynArray);
                 break;
             }
             case SignatureType::NONE_STRING_DOUBLE:
@@ -353,7 +450,7 @@ const std::string CComInterface::call(const std::string& _strCommand)
                 iss >> strS;
                 double fParam = 0.0;
                 iss >> fParam;
-                this->call<void,std::string, double>(strName, strS, fParam);
+                this->call<void,std::string, double>(nName, strS, fParam);
                 break;
             }
             case SignatureType::NONE_STRING_INT:
@@ -362,7 +459,7 @@ const std::string CComInterface::call(const std::string& _strCommand)
                 iss >> strS;
                 int nParam = 0;
                 iss >> nParam;
-                this->call<void,std::string,int>(strName, strS, nParam);
+                this->call<void,std::string,int>(nName, strS, nParam);
                 break;
             }
             case SignatureType::NONE_STRING_2INT:
@@ -372,20 +469,20 @@ const std::string CComInterface::call(const std::string& _strCommand)
                 int nParam1 = 0;
                 int nParam2 = 0;
                 iss >> nParam1 >> nParam2;
-                this->call<void,std::string,int,int>(strName, strS, nParam1, nParam2);
+                this->call<void,std::string,int,int>(nName, strS, nParam1, nParam2);
                 break;
             }
             case SignatureType::STRING:
             {
                 std::string strRet("");
-                strRet = this->call<std::string>(strName);
+                strRet = this->call<std::string>(nName);
                 oss << strRet;
                 break;
             }
             case SignatureType::VEC2DDOUBLE:
             {
                 Vector2d vecRet; vecRet.setZero();
-                vecRet = this->call<Vector2d>(strName);
+                vecRet = this->call<Vector2d>(nName);
                 oss << vecRet[0] << " " << vecRet[1];
                 break;
             }
@@ -394,7 +491,7 @@ const std::string CComInterface::call(const std::string& _strCommand)
                 int nParam(0);
                 iss >> nParam;
                 Vector2d vecRet; vecRet.setZero();
-                vecRet = this->call<Vector2d,int>(strName, nParam);
+                vecRet = this->call<Vector2d,int>(nName, nParam);
                 oss << vecRet[0] << " " << vecRet[1];
                 break;
             }
@@ -404,7 +501,7 @@ const std::string CComInterface::call(const std::string& _strCommand)
                 int nParam2(0);
                 iss >> nParam1 >> nParam2;
                 Vector2d vecRet; vecRet.setZero();
-                vecRet = this->call<Vector2d,int,int>(strName, nParam1, nParam2);
+                vecRet = this->call<Vector2d,int,int>(nName, nParam1, nParam2);
                 oss << vecRet[0] << " " << vecRet[1];
                 break;
             }
@@ -413,7 +510,7 @@ const std::string CComInterface::call(const std::string& _strCommand)
                 std::string strParam = "";
                 iss >> strParam;
                 Vector2d vecRet; vecRet.setZero();
-                vecRet = this->call<Vector2d,std::string>(strName, strParam);
+                vecRet = this->call<Vector2d,std::string>(nName, strParam);
                 oss << vecRet[0] << " " << vecRet[1];
                 break;
             }
@@ -423,14 +520,14 @@ const std::string CComInterface::call(const std::string& _strCommand)
                 std::string strParam2 = "";
                 iss >> strParam1 >> strParam2;
                 Vector2d vecRet; vecRet.setZero();
-                vecRet = this->call<Vector2d,std::string,std::string>(strName, strParam1, strParam2);
+                vecRet = this->call<Vector2d,std::string,std::string>(nName, strParam1, strParam2);
                 oss << vecRet[0] << " " << vecRet[1];
                 break;
             }
             case SignatureType::VEC2DINT:
             {
                 Vector2i vecRet; vecRet.setZero();
-                vecRet = this->call<Vector2i>(strName);
+                vecRet = this->call<Vector2i>(nName);
                 oss << vecRet[0] << " " << vecRet[1];
                 break;
             }
@@ -439,7 +536,7 @@ const std::string CComInterface::call(const std::string& _strCommand)
                 int nParam(0);
                 iss >> nParam;
                 Vector2i vecRet; vecRet.setZero();
-                vecRet = this->call<Vector2i,int>(strName, nParam);
+                vecRet = this->call<Vector2i,int>(nName, nParam);
                 oss << vecRet[0] << " " << vecRet[1];
                 break;
             }
@@ -499,6 +596,13 @@ void CComInterface::callWriters(const std::string& _strQueue)
                                               std::get<1>(pQueuedFunctionConcrete->getParams()));
                 break;
             }
+            case SignatureType::NONE_2DYN_ARRAY:
+            {
+                auto pQueuedFunctionConcrete = static_cast<CCommandToQueueWrapper<void, std::vector<double>, std::vector<double>>*>(pQueuedFunction);
+                pQueuedFunctionConcrete->call(std::get<0>(pQueuedFunctionConcrete->getParams()),
+                                              std::get<1>(pQueuedFunctionConcrete->getParams()));
+                break;
+            }
             case SignatureType::NONE_INT:
             {
                 auto pQueuedFunctionConcrete = static_cast<CCommandToQueueWrapper<void, int>*>(pQueuedFunction);
@@ -607,6 +711,10 @@ void CComInterface::callWriters(const std::string& _strQueue)
             case SignatureType::DOUBLE_INT:
             case SignatureType::DOUBLE_STRING:
             case SignatureType::DOUBLE_STRING_DOUBLE:
+            case SignatureType::DYN_ARRAY_DYN_ARRAY:
+            case SignatureType::DYN_ARRAY_INT:
+            case SignatureType::DYN_ARRAY_INT_DYN_ARRAY:
+            case SignatureType::DYN_ARRAY_STRING_INT:
             case SignatureType::INT:
             case SignatureType::INT_INT:
             case SignatureType::INT_STRING:
@@ -682,3 +790,68 @@ void CComInterface::help()
     METHOD_ENTRY_QUIET("CComInterface::help")
     this->help(0);
 }
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adds the given callback to the callbacks of a function
+///
+/// A copy of the current list including the new callback is published, the
+/// replaced list is kept until destruction, since it might still be read by
+/// concurrent calls. Access has to be locked by the caller.
+///
+/// \param _nName Interned name of the function the callback listens to
+/// \param _pCallback Callback to be added
+///
+///////////////////////////////////////////////////////////////////////////////
+void CComInterface::addCallback(const StringIDType _nName, IBaseCommand* const _pCallback)
+{
+    METHOD_ENTRY_QUIET("CComInterface::addCallback")
+    
+    CallbackSlotType& Slot = *this->getCallbacks(_nName);
+    
+    const CallbackListType* const pCallbacksOld = Slot.pCallbacks.load(std::memory_order_relaxed);
+    CallbackListType* const pCallbacksNew = (pCallbacksOld == nullptr) ? new CallbackListType
+                                                                        : new CallbackListType(*pCallbacksOld);
+    MEM_ALLOC_QUIET("CallbackListType")
+    pCallbacksNew->push_back(_pCallback);
+    
+    Slot.pCallbacks.store(pCallbacksNew, std::memory_order_release);
+    if (pCallbacksOld != nullptr) m_RetiredCallbackLists.push_back(pCallbacksOld);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns the callbacks of a function, adding them if not existing
+///
+/// A new slot is added to a copy of the current table which is published
+/// afterwards (RCU). The replaced table is kept until destruction, since it
+/// might still be read by concurrent calls. Access has to be locked by the
+/// caller.
+///
+/// \param _nName Interned name of the function
+/// \return Callbacks of function
+///
+///////////////////////////////////////////////////////////////////////////////
+CallbackSlotType* CComInterface::getCallbacks(const StringIDType _nName)
+{
+    METHOD_ENTRY_QUIET("CComInterface::getCallbacks")
+    
+    const CallbackTableType* const pTableOld = m_pCallbackTable.load(std::memory_order_relaxed);
+    if (pTableOld != nullptr)
+    {
+        const auto ci = pTableOld->find(_nName);
+        if (ci != pTableOld->end()) return ci->second;
+    }
+    
+    CallbackTableType* const pTableNew = (pTableOld == nullptr) ? new CallbackTableType
+                                                                : new CallbackTableType(*pTableOld);
+    MEM_ALLOC_QUIET("CallbackTableType")
+    CallbackSlotType* const pSlot = new CallbackSlotType;
+    MEM_ALLOC_QUIET("CallbackSlotType")
+    pTableNew->emplace(_nName, pSlot);
+    
+    m_pCallbackTable.store(pTableNew, std::memory_order_release);
+    if (pTableOld != nullptr) m_RetiredCallbackTables.push_back(pTableOld);
+    
+    return pSlot;
+}
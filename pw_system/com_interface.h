@@ -32,17 +32,20 @@
 #define COM_INTERFACE_H
 
 //--- Standard header --------------------------------------------------------//
+#include <atomic>
 #include <functional>
 #include <map>
 #include <set>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 //--- Program header ---------------------------------------------------------//
 #include "conf_pw.h"
 #include "log.h"
 #include "log_listener.h"
-#include "spinlock.h"
+#include "adaptive_lock.h"
+#include "string_table.h"
 
 //--- Misc header ------------------------------------------------------------//
 #include "concurrentqueue.h"
@@ -72,12 +75,17 @@ enum class SignatureType
     DOUBLE_INT,
     DOUBLE_STRING,
     DOUBLE_STRING_DOUBLE,
+    DYN_ARRAY_DYN_ARRAY,
+    DYN_ARRAY_INT,
+    DYN_ARRAY_INT_DYN_ARRAY,
+    DYN_ARRAY_STRING_INT,
     INT,
     INT_INT,
     INT_STRING,
     NONE_BOOL,
     NONE_DOUBLE,
     NONE_2DOUBLE,
+    NONE_2DYN_ARRAY,
     NONE_INT,
     NONE_2INT,
     NONE_3INT,
@@ -201,7 +209,7 @@ class CCommandToQueueWrapper : public IBaseCommand
         CCommandToQueueWrapper(const std::function<TRet(TArgs...)>&, TArgs...);
         
         //--- Constant methods -----------------------------------------------//
-        const std::tuple<TArgs...> getParams() const {return m_Params;}
+        const std::tuple<TArgs...>& getParams() const {return m_Params;}
         
         //--- Methods --------------------------------------------------------//
         TRet call(TArgs...);
@@ -219,6 +227,8 @@ class CCommandToQueueWrapper : public IBaseCommand
 
 /// Map of all functions, accessed by name
 typedef std::map<std::string, IBaseCommand*> RegisteredFunctionsType;
+/// Map of all functions, accessed by interned name
+typedef std::unordered_map<StringIDType, IBaseCommand*> RegisteredFunctionsByIDType;
 /// Map of descriptions, accessed by name
 typedef std::unordered_map<std::string, std::string> RegisteredFunctionsDescriptionType;
 /// Parameter list for functions
@@ -231,14 +241,62 @@ typedef std::string DomainType;
 /// Map of domains, accessed by function name
 typedef std::unordered_map<std::string, DomainType> RegisteredDomainsType;
 
-/// Multimap of callback functions, accessed by name
-typedef std::unordered_multimap<std::string, IBaseCommand*> RegisteredCallbacksType;
+/// List of callback functions attached to one function, not changed once published
+typedef std::vector<IBaseCommand*> CallbackListType;
+
+/// Callbacks attached to one function. Registering a callback publishes a
+/// copy of the list (copy-on-write), hence, callers read without locking.
+struct CallbackSlotType
+{
+    std::atomic<const CallbackListType*> pCallbacks{nullptr}; ///< Currently published list of callbacks
+};
+
+/// Table of callback slots, accessed by interned name. A table is not changed
+/// once published, adding a slot publishes a copy (RCU). Slots are never removed.
+typedef std::unordered_map<StringIDType, CallbackSlotType*> CallbackTableType;
+/// Callback lists replaced by newer ones, kept until destruction for concurrent readers
+typedef std::vector<const CallbackListType*> RetiredCallbackListsType;
+/// Callback tables replaced by newer ones, kept until destruction for concurrent readers
+typedef std::vector<const CallbackTableType*> RetiredCallbackTablesType;
 
 /// List of writer domains
 typedef std::set<std::string> DomainsType;
 /// Map of queues with one queue for each writer domain
 typedef std::unordered_map<std::string, moodycamel::ConcurrentQueue<IBaseCommand*>> WriterQueuesType;
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Handle of a registered function, resolved once by name
+///
+/// Handles are provided by \ref CComInterface::resolve. The signature of the
+/// function is checked when resolving, hence, calls go straight to the
+/// function and its callbacks without looking up the name or locking.
+/// Callbacks that are registered after resolving are called as well.
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class TRet, class... TArgs>
+class CCommandHandle
+{
+    public:
+        
+        //--- Constructor/Destructor -----------------------------------------//
+        CCommandHandle() : m_pFunction(nullptr), m_pCallbacks(nullptr), m_nName(STRING_ID_INVALID) {}
+        CCommandHandle(CCommand<TRet, TArgs...>* const, const CallbackSlotType* const, const StringIDType);
+        
+        //--- Constant methods -----------------------------------------------//
+        StringIDType getName() const {return m_nName;}
+        bool         isValid() const {return m_pFunction != nullptr;}
+        
+        TRet call(TArgs...) const;
+        
+    private:
+        
+        /// --- Variables [private] ------------------------------------------//
+        CCommand<TRet, TArgs...>*   m_pFunction;    ///< Function, nullptr if unknown or of different signature
+        const CallbackSlotType*     m_pCallbacks;   ///< Callbacks attached to function
+        StringIDType                m_nName;        ///< Interned name of function
+};
+
 //--- Enum parser ------------------------------------------------------------//
 static std::map<ParameterType, std::string> mapParameterToString = {
     {ParameterType::UNDEFINED, "<undefined>"},
@@ -275,10 +333,14 @@ class CComInterface : public ILogListener
         //--- Methods --------------------------------------------------------//
         template<class TRet, class... Args>
         TRet                call(const std::string&, Args...);
+        template<class TRet, class... Args>
+        TRet                call(const StringIDType, Args...);
         const std::string   call(const std::string&);
         void                callWriters(const std::string&);
         void                help();
         void                help(int);
+        template<class TRet, class... Args>
+        CCommandHandle<TRet, Args...> resolve(const std::string&);
 
         template <class TRet, class... TArgs>
         bool registerCallback(const std::string&, const std::function<TRet(TArgs...)>&,
@@ -308,12 +370,20 @@ class CComInterface : public ILogListener
         
     private:
         
-        CSpinlock                           m_AccessData;                ///< Indicates access, important for multithreading
+        //--- Methods [private] ----------------------------------------------//
+        const CallbackSlotType* findCallbacks(const StringIDType) const;
+        CallbackSlotType*       getCallbacks(const StringIDType);
+        void                    addCallback(const StringIDType, IBaseCommand* const);
+        
+        CAdaptiveLock                       m_AccessData{"CComInterface::m_AccessData"};             ///< Serialises registration of callbacks, not taken by calls
         
         
-        RegisteredCallbacksType             m_RegisteredCallbacks;       ///< Callbacks attached to registered functions
+        std::atomic<const CallbackTableType*> m_pCallbackTable{nullptr}; ///< Currently published table of callbacks
+        RetiredCallbackTablesType           m_RetiredCallbackTables;     ///< Callback tables replaced by registration
+        RetiredCallbackListsType            m_RetiredCallbackLists;      ///< Callback lists replaced by registration
         
         RegisteredFunctionsType             m_RegisteredFunctions;       ///< All registered functions provided by modules
+        RegisteredFunctionsByIDType         m_RegisteredFunctionsByID;   ///< All registered functions, accessed by interned name
         RegisteredFunctionsDescriptionType  m_RegisteredFunctionsDescriptions; ///< Descriptions of registered functions
         RegisteredParameterListsType        m_RegisteredFunctionsParams; ///< Parameter lists of registered functions      
         RegisteredDomainsType               m_RegisteredFunctionsDomain; ///< Domain of registered functions
@@ -354,10 +424,33 @@ inline void CComInterface::logEntry(const std::string& _strSrc, const std::strin
 {
     METHOD_ENTRY_QUIET("CComInterface::logEntry")
     
-    this->call<void, std::string, std::string, std::string, std::string>("e_log_entry",
+    static const StringIDType s_nLogEntry = CStringTable::intern("e_log_entry");
+    this->call<void, std::string, std::string, std::string, std::string>(s_nLogEntry,
                 _strSrc, _strMessage, s_LogLevelTypeToStringMap[_Level], s_LogDomainTypeToStringMap[_Domain]);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Finds the callbacks of given function without locking
+///
+/// The published table is immutable, hence, it may be read while callbacks
+/// are registered concurrently.
+///
+/// \param _nName Interned name of the function
+/// \return Callbacks of function, nullptr if none were registered or resolved
+///
+////////////////////////////////////////////////////////////////////////////////
+inline const CallbackSlotType* CComInterface::findCallbacks(const StringIDType _nName) const
+{
+    METHOD_ENTRY_QUIET("CComInterface::findCallbacks")
+    
+    const CallbackTableType* const pTable = m_pCallbackTable.load(std::memory_order_acquire);
+    if (pTable == nullptr) return nullptr;
+    
+    const auto ci = pTable->find(_nName);
+    return (ci != pTable->end()) ? ci->second : nullptr;
+}
+
 #include "com_interface.tpp"
 
 #endif // COM_INTERFACE_H
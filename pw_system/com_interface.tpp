@@ -57,7 +57,7 @@ template <class TRet, class... TArgs>
 CCommandToQueueWrapper<TRet, TArgs...>::CCommandToQueueWrapper(const std::function<TRet(TArgs...)>& _Function,
                                                TArgs... _Args) : 
                                                m_Function(_Function),
-                                               m_Params(_Args...)
+                                               m_Params(std::move(_Args)...)
 {
     METHOD_ENTRY_QUIET("CCommandToQueueWrapper::CCommandToQueueWrapper")
     CTOR_CALL_QUIET("CCommandToQueueWrapper")
@@ -77,7 +77,7 @@ TRet CCommand<TRet, TArgs...>::call(TArgs... _Args)
 {
     METHOD_ENTRY_QUIET("CCommand::call")
     DEBUG_MSG_QUIET("Command", "Command called.")
-    return m_Function(_Args...);
+    return m_Function(std::move(_Args)...);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -94,7 +94,7 @@ TRet CCommandToQueueWrapper<TRet, TArgs...>::call(TArgs... _Args)
     try
     {
         DEBUG_MSG_QUIET("Queued Command", "Queued command called.")
-        m_Function(_Args...);
+        m_Function(std::move(_Args)...);
     }
     catch (const CComInterfaceException& ComIntEx)
     {
@@ -102,6 +102,77 @@ TRet CCommandToQueueWrapper<TRet, TArgs...>::call(TArgs... _Args)
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Constructor for a resolved function.
+///
+/// \param _pFunction Function, nullptr if unknown or of different signature
+/// \param _pCallbacks Callbacks attached to function
+/// \param _nName Interned name of function
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class TRet, class... TArgs>
+CCommandHandle<TRet, TArgs...>::CCommandHandle(CCommand<TRet, TArgs...>* const _pFunction,
+                                               const CallbackSlotType* const _pCallbacks,
+                                               const StringIDType _nName) :
+                                               m_pFunction(_pFunction),
+                                               m_pCallbacks(_pCallbacks),
+                                               m_nName(_nName)
+{
+    METHOD_ENTRY_QUIET("CCommandHandle::CCommandHandle")
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Calls the resolved function and its callbacks
+///
+/// \param _Args Arguments to call the function with
+/// \return Return value of function, default value if handle is not valid
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class TRet, class... TArgs>
+TRet CCommandHandle<TRet, TArgs...>::call(TArgs... _Args) const
+{
+    METHOD_ENTRY_QUIET("CCommandHandle::call")
+    
+    try
+    {
+        if (m_pCallbacks != nullptr)
+        {
+            const CallbackListType* const pCallbacks = m_pCallbacks->pCallbacks.load(std::memory_order_acquire);
+            if (pCallbacks != nullptr)
+            {
+                for (const auto pCom : *pCallbacks)
+                {
+                    #ifdef LOGLEVEL_DEBUG
+                        auto pCallback = dynamic_cast<CCommand<TRet, TArgs...>*>(pCom);
+                        if (pCallback != nullptr)
+                        {
+                            pCallback->call(_Args...);
+                        }
+                        else
+                        {
+                            WARNING_MSG_QUIET("Com Interface", "Known function with different signature <" << CStringTable::getString(m_nName) << ">. ")
+                        }
+                    #else
+                        static_cast<CCommand<TRet, TArgs...>*>(pCom)->call(_Args...);
+                    #endif
+                }
+            }
+        }
+        if (m_pFunction != nullptr)
+        {
+            return m_pFunction->call(std::move(_Args)...);
+        }
+        return TRet();
+    }
+    catch (const CComInterfaceException& ComIntEx)
+    {
+        WARNING_MSG("Com Interface", ComIntEx.getMessage())
+        throw; // To be caught bei com console
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Calls the given function if registered
@@ -113,6 +184,27 @@ TRet CCommandToQueueWrapper<TRet, TArgs...>::call(TArgs... _Args)
 ///////////////////////////////////////////////////////////////////////////////
 template<class TRet, class... Args>
 inline TRet CComInterface::call(const std::string& _strName, Args... _Args)
+{
+    METHOD_ENTRY_QUIET("CComInterface::call")
+    return this->call<TRet, Args...>(CStringTable::find(_strName), _Args...);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Calls the given function if registered
+///
+/// Functions and callbacks are accessed by interned name, hence, callers
+/// that intern the name once avoid hashing strings on each call.
+/// Callbacks are looked up in the published callback table without locking
+/// and are not called under any lock of the com interface.
+///
+/// \param _nName Interned name of the function that should be called
+/// \param _Args Arguments of the function to be called
+/// \return Return value of function
+///
+///////////////////////////////////////////////////////////////////////////////
+template<class TRet, class... Args>
+inline TRet CComInterface::call(const StringIDType _nName, Args... _Args)
 {
     METHOD_ENTRY_QUIET("CComInterface::call")
     
@@ -121,43 +213,43 @@ inline TRet CComInterface::call(const std::string& _strName, Args... _Args)
         #ifdef LOGLEVEL_DEBUG
             
             // Search for callbacks and execute if exist
-            m_AccessData.acquireLock();
-            const auto Range = m_RegisteredCallbacks.equal_range(_strName);
-            if (Range.first != m_RegisteredCallbacks.end())
+            const CallbackSlotType* const pSlot = this->findCallbacks(_nName);
+            if (pSlot != nullptr)
             {
-                for_each(Range.first, Range.second, 
-                    [&](RegisteredCallbacksType::value_type& _Com)
+                const CallbackListType* const pCallbacks = pSlot->pCallbacks.load(std::memory_order_acquire);
+                if (pCallbacks != nullptr)
+                {
+                    for (const auto pCom : *pCallbacks)
                     {
                         DEBUG_MSG_QUIET("Com Interface", "Callback called.")
                         
-                        auto pCallback = dynamic_cast<CCommand<TRet, Args...>*>(_Com.second);
+                        auto pCallback = dynamic_cast<CCommand<TRet, Args...>*>(pCom);
                         if (pCallback != nullptr)
                         {
                             pCallback->call(_Args...);
                         }
                         else
                         {
-                            WARNING_MSG_QUIET("Com Interface", "Known function with different signature <" << _strName << ">. ")
+                            WARNING_MSG_QUIET("Com Interface", "Known function with different signature <" << CStringTable::getString(_nName) << ">. ")
                         }
                     }
-                );
+                }
             }
-            m_AccessData.releaseLock();            
             
             // Execute function if existant
-            const auto ci = m_RegisteredFunctions.find(_strName);
-            if (ci != m_RegisteredFunctions.end())
+            const auto ci = m_RegisteredFunctionsByID.find(_nName);
+            if (ci != m_RegisteredFunctionsByID.end())
             {
-                DEBUG_MSG_QUIET("Com Interface", "Command called: <" << _strName << ">")
+                DEBUG_MSG_QUIET("Com Interface", "Command called: <" << CStringTable::getString(_nName) << ">")
                 
                 auto pFunction = dynamic_cast<CCommand<TRet, Args...>*>(ci->second);
                 if (pFunction != nullptr)
                 {
-                    return pFunction->call(_Args...);
+                    return pFunction->call(std::move(_Args)...);
                 }
                 else
                 {
-                    WARNING_MSG_QUIET("Com Interface", "Known function with different signature <" << _strName << ">. ")
+                    WARNING_MSG_QUIET("Com Interface", "Known function with different signature <" << CStringTable::getString(_nName) << ">. ")
                     return TRet();
                 }
             }
@@ -167,22 +259,24 @@ inline TRet CComInterface::call(const std::string& _strName, Args... _Args)
             }
         #else
             // Search for callbacks and execute if exist
-            m_AccessData.acquireLock();
-            const auto Range = m_RegisteredCallbacks.equal_range(_strName);
-            for_each(Range.first, Range.second, 
-                [&](RegisteredCallbacksType::value_type& _Com)
+            const CallbackSlotType* const pSlot = this->findCallbacks(_nName);
+            if (pSlot != nullptr)
+            {
+                const CallbackListType* const pCallbacks = pSlot->pCallbacks.load(std::memory_order_acquire);
+                if (pCallbacks != nullptr)
                 {
-                    auto pCallback = static_cast<CCommand<TRet, Args...>*>(_Com.second);
-                    pCallback->call(_Args...);
+                    for (const auto pCom : *pCallbacks)
+                    {
+                        static_cast<CCommand<TRet, Args...>*>(pCom)->call(_Args...);
+                    }
                 }
-            );
-            m_AccessData.releaseLock();
+            }
             // Execute function if existant
-            const auto ci = m_RegisteredFunctions.find(_strName);
-            if (ci != m_RegisteredFunctions.end())
+            const auto ci = m_RegisteredFunctionsByID.find(_nName);
+            if (ci != m_RegisteredFunctionsByID.end())
             {
                 auto pFunction = static_cast<CCommand<TRet, Args...>*>(ci->second);
-                return pFunction->call(_Args...);
+                return pFunction->call(std::move(_Args)...);
             }
             else
             {
@@ -197,11 +291,52 @@ inline TRet CComInterface::call(const std::string& _strName, Args... _Args)
     }
     catch (const std::out_of_range& oor)
     {
-        WARNING_MSG("Com Interface", "Unknown function <" << _strName << ">. " << oor.what())
+        WARNING_MSG("Com Interface", "Unknown function <" << CStringTable::getString(_nName) << ">. " << oor.what())
         return TRet();
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Resolves the given function once for repeated calls
+///
+/// The function has to be registered before resolving. Callbacks might be
+/// registered later on, they are called by the returned handle as well.
+///
+/// \param _strName Registered name of the function that should be resolved
+/// \return Handle of function, not valid if unknown or of different signature
+///
+///////////////////////////////////////////////////////////////////////////////
+template<class TRet, class... Args>
+CCommandHandle<TRet, Args...> CComInterface::resolve(const std::string& _strName)
+{
+    METHOD_ENTRY_QUIET("CComInterface::resolve")
+    
+    const StringIDType nName = CStringTable::intern(_strName);
+    
+    CCommand<TRet, Args...>* pFunction = nullptr;
+    const auto ci = m_RegisteredFunctionsByID.find(nName);
+    if (ci != m_RegisteredFunctionsByID.end())
+    {
+        pFunction = dynamic_cast<CCommand<TRet, Args...>*>(ci->second);
+        if (pFunction == nullptr)
+        {
+            WARNING_MSG_QUIET("Com Interface", "Known function with different signature <" << _strName << ">. ")
+        }
+    }
+    else
+    {
+        WARNING_MSG_QUIET("Com Interface", "Unknown function <" << _strName << ">. ")
+    }
+    
+    // Slots of callbacks are never removed or moved, thus, the handle may keep them
+    m_AccessData.acquireLock();
+    const CallbackSlotType* const pCallbacks = this->getCallbacks(nName);
+    m_AccessData.releaseLock();
+    
+    return CCommandHandle<TRet, Args...>(pFunction, pCallbacks, nName);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Register the given callback to existing function
@@ -236,20 +371,20 @@ bool CComInterface::registerCallback(const std::string& _strName, const std::fun
         ) // DOM_DEV
  
         m_AccessData.acquireLock();
-        m_RegisteredCallbacks.insert({{_strName,
-                                        new CCommand<TRet, TArgs...>([this, _strName, _Func, _strWriterDomain](TArgs... _Args) -> TRet
-                                        {
-                                            auto pCommand = new CCommandToQueueWrapper<TRet, TArgs...>(_Func, _Args...);
-                                            m_WriterQueues[_strWriterDomain].enqueue(pCommand);
-                                            MEM_ALLOC_QUIET("IBaseCommand")
-                                        })}});
+        this->addCallback(CStringTable::intern(_strName),
+                          new CCommand<TRet, TArgs...>([this, _strName, _Func, _strWriterDomain](TArgs... _Args) -> TRet
+                          {
+                              auto pCommand = new CCommandToQueueWrapper<TRet, TArgs...>(_Func, std::move(_Args)...);
+                              m_WriterQueues[_strWriterDomain].enqueue(pCommand);
+                              MEM_ALLOC_QUIET("IBaseCommand")
+                          }));
         m_AccessData.releaseLock();
         MEM_ALLOC_QUIET("IBaseCommand")
     }
     else
     {
         m_AccessData.acquireLock();
-        m_RegisteredCallbacks.insert({{_strName, new CCommand<TRet, TArgs...>(_Func)}});
+        this->addCallback(CStringTable::intern(_strName), new CCommand<TRet, TArgs...>(_Func));
         m_AccessData.releaseLock();
         MEM_ALLOC_QUIET("IBaseCommand")
     }    
@@ -283,6 +418,7 @@ bool CComInterface::registerEvent(const std::string& _strName,
     // might then be writers
 
     m_RegisteredFunctions[_strName] = new CCommand<void, TArgs...>([](const TArgs&...){});
+    m_RegisteredFunctionsByID[CStringTable::intern(_strName)] = m_RegisteredFunctions[_strName];
     MEM_ALLOC_QUIET("IBaseCommand")
     
     m_RegisteredFunctionsDescriptions[_strName] = _strDescription;
@@ -337,7 +473,7 @@ bool CComInterface::registerFunction(const std::string& _strName, const CCommand
         
         m_RegisteredFunctions[_strName] = new CCommand<TRet, TArgs...>([this,_strName,_Command, _strWriterDomain](TArgs... _Args) -> TRet
                                             {
-                                                auto pCommand = new CCommandToQueueWrapper<TRet, TArgs...>(_Command.getFunction(), _Args...);
+                                                auto pCommand = new CCommandToQueueWrapper<TRet, TArgs...>(_Command.getFunction(), std::move(_Args)...);
                                                 m_WriterQueues[_strWriterDomain].enqueue(pCommand);
                                                 MEM_ALLOC_QUIET("IBaseCommand")
                                                 return TRet();
@@ -349,6 +485,7 @@ bool CComInterface::registerFunction(const std::string& _strName, const CCommand
         m_RegisteredFunctions[_strName] = new CCommand<TRet, TArgs...>(_Command);
         MEM_ALLOC_QUIET("IBaseCommand")
     }
+    m_RegisteredFunctionsByID[CStringTable::intern(_strName)] = m_RegisteredFunctions[_strName];
     
     m_RegisteredFunctionsDescriptions[_strName] = _strDescription;
     m_RegisteredFunctionsParams[_strName] = _ParamList;
@@ -370,12 +507,17 @@ template<> inline void CCommand<double>::dispatchSignature() {m_Signature = Sign
 template<> inline void CCommand<double,int>::dispatchSignature() {m_Signature = SignatureType::DOUBLE_INT;}
 template<> inline void CCommand<double,std::string>::dispatchSignature() {m_Signature = SignatureType::DOUBLE_STRING;}
 template<> inline void CCommand<double,std::string,double>::dispatchSignature() {m_Signature = SignatureType::DOUBLE_STRING_DOUBLE;}
+template<> inline void CCommand<std::vector<double>, std::vector<double>>::dispatchSignature() {m_Signature = SignatureType::DYN_ARRAY_DYN_ARRAY;}
+template<> inline void CCommand<std::vector<double>, int>::dispatchSignature() {m_Signature = SignatureType::DYN_ARRAY_INT;}
+template<> inline void CCommand<std::vector<double>, int, std::vector<double>>::dispatchSignature() {m_Signature = SignatureType::DYN_ARRAY_INT_DYN_ARRAY;}
+template<> inline void CCommand<std::vector<double>, std::string, int>::dispatchSignature() {m_Signature = SignatureType::DYN_ARRAY_STRING_INT;}
 template<> inline void CCommand<int>::dispatchSignature() {m_Signature = SignatureType::INT;}
 template<> inline void CCommand<int,int>::dispatchSignature() {m_Signature = SignatureType::INT_INT;}
 template<> inline void CCommand<int,std::string>::dispatchSignature() {m_Signature = SignatureType::INT_STRING;}
 template<> inline void CCommand<void, bool>::dispatchSignature() {m_Signature = SignatureType::NONE_BOOL;}
 template<> inline void CCommand<void, double>::dispatchSignature() {m_Signature = SignatureType::NONE_DOUBLE;}
 template<> inline void CCommand<void, double, double>::dispatchSignature() {m_Signature = SignatureType::NONE_2DOUBLE;}
+template<> inline void CCommand<void, std::vector<double>, std::vector<double>>::dispatchSignature() {m_Signature = SignatureType::NONE_2DYN_ARRAY;}
 template<> inline void CCommand<void, int>::dispatchSignature() {m_Signature = SignatureType::NONE_INT;}
 template<> inline void CCommand<void, int, double>::dispatchSignature() {m_Signature = SignatureType::NONE_INT_DOUBLE;}
 template<> inline void CCommand<void, int, double, double>::dispatchSignature() {m_Signature = SignatureType::NONE_INT_2DOUBLE;}
@@ -406,12 +548,17 @@ template<> inline void CCommandToQueueWrapper<double>::dispatchSignature() {m_Si
 template<> inline void CCommandToQueueWrapper<double,int>::dispatchSignature() {m_Signature = SignatureType::DOUBLE_INT;}
 template<> inline void CCommandToQueueWrapper<double,std::string>::dispatchSignature() {m_Signature = SignatureType::DOUBLE_STRING;}
 template<> inline void CCommandToQueueWrapper<double,std::string,double>::dispatchSignature() {m_Signature = SignatureType::DOUBLE_STRING_DOUBLE;}
+template<> inline void CCommandToQueueWrapper<std::vector<double>, std::vector<double>>::dispatchSignature() {m_Signature = SignatureType::DYN_ARRAY_DYN_ARRAY;}
+template<> inline void CCommandToQueueWrapper<std::vector<double>, int>::dispatchSignature() {m_Signature = SignatureType::DYN_ARRAY_INT;}
+template<> inline void CCommandToQueueWrapper<std::vector<double>, int, std::vector<double>>::dispatchSignature() {m_Signature = SignatureType::DYN_ARRAY_INT_DYN_ARRAY;}
+template<> inline void CCommandToQueueWrapper<std::vector<double>, std::string, int>::dispatchSignature() {m_Signature = SignatureType::DYN_ARRAY_STRING_INT;}
 template<> inline void CCommandToQueueWrapper<int>::dispatchSignature() {m_Signature = SignatureType::INT;}
 template<> inline void CCommandToQueueWrapper<int,int>::dispatchSignature() {m_Signature = SignatureType::INT_INT;}
 template<> inline void CCommandToQueueWrapper<int,std::string>::dispatchSignature() {m_Signature = SignatureType::INT_STRING;}
 template<> inline void CCommandToQueueWrapper<void, bool>::dispatchSignature() {m_Signature = SignatureType::NONE_BOOL;}
 template<> inline void CCommandToQueueWrapper<void, double>::dispatchSignature() {m_Signature = SignatureType::NONE_DOUBLE;}
 template<> inline void CCommandToQueueWrapper<void, double, double>::dispatchSignature() {m_Signature = SignatureType::NONE_2DOUBLE;}
+template<> inline void CCommandToQueueWrapper<void, std::vector<double>, std::vector<double>>::dispatchSignature() {m_Signature = SignatureType::NONE_2DYN_ARRAY;}
 template<> inline void CCommandToQueueWrapper<void, int>::dispatchSignature() {m_Signature = SignatureType::NONE_INT;}
 template<> inline void CCommandToQueueWrapper<void, int, double>::dispatchSignature() {m_Signature = SignatureType::NONE_INT_DOUBLE;}
 template<> inline void CCommandToQueueWrapper<void, int, double, double>::dispatchSignature() {m_Signature = SignatureType::NONE_INT_2DOUBLE;}
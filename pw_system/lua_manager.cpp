@@ -75,6 +75,10 @@ bool CLuaManager::init()
     // apropriate casting. This would result in direct access without using
     // the com interface after registration. But it would also disable the
     // possibility to register callbacks, since the com interface is bypassed.
+    // Hence, functions are resolved once, and handles call the function and
+    // its callbacks without looking up the name on each call.
+    
+    m_hLuaUpdate = m_pComInterface->resolve<void>("e_lua_update");
     
     sol::table TablePW = m_LuaState.create_named_table(LUA_PACKAGE_PREFIX);
     for (const auto& Dom : *m_pComInterface->getDomains())
@@ -90,136 +94,254 @@ bool CLuaManager::init()
         {
             case SignatureType::BOOL_INT:
             {   
+                const auto hFunc = m_pComInterface->resolve<bool, int>(Function.first);
                 std::function<bool(int)> Func =
-                    [=](const int _nN) -> bool {return m_pComInterface->call<bool, int>(Function.first, _nN);};
+                    [=](const int _nN) -> bool {return hFunc.call(_nN);};
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
                 break;
             }   
             case SignatureType::INT:
             {   
+                const auto hFunc = m_pComInterface->resolve<int>(Function.first);
                 std::function<int()> Func =
-                    [=]() -> int {return m_pComInterface->call<int>(Function.first);};
+                    [=]() -> int {return hFunc.call();};
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
                 break;
             }   
             case SignatureType::INT_INT:
             {
+                const auto hFunc = m_pComInterface->resolve<int, int>(Function.first);
                 std::function<int(int)> Func =
-                    [=](const int _nN) -> int {return m_pComInterface->call<int, int>(Function.first, _nN);};
+                    [=](const int _nN) -> int {return hFunc.call(_nN);};
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
                 break;
             }   
             case SignatureType::INT_STRING:
             {  
+                const auto hFunc = m_pComInterface->resolve<int, std::string>(Function.first);
                 std::function<int(std::string)> Func =
-                    [=](const std::string& _strS) -> int {return m_pComInterface->call<int, std::string>(Function.first, _strS);};
+                    [=](const std::string& _strS) -> int {return hFunc.call(_strS);};
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
                     
                 break;
             }   
             case SignatureType::DOUBLE:
             {   
+                const auto hFunc = m_pComInterface->resolve<double>(Function.first);
                 std::function<double()> Func =
-                    [=]() -> double {return m_pComInterface->call<double>(Function.first);};
+                    [=]() -> double {return hFunc.call();};
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
                     
                 break;
             }   
             case SignatureType::DOUBLE_INT:
             {   
+                const auto hFunc = m_pComInterface->resolve<double, int>(Function.first);
                 std::function<double(int)> Func =
-                    [=](const int _nN) -> double {return m_pComInterface->call<double, int>(Function.first, _nN);};
+                    [=](const int _nN) -> double {return hFunc.call(_nN);};
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
                 break;
             }   
             case SignatureType::DOUBLE_STRING:
             {   
+                const auto hFunc = m_pComInterface->resolve<double, std::string>(Function.first);
                 std::function<double(std::string)> Func =
-                    [=](const std::string& _strS) -> double {return m_pComInterface->call<double, std::string>(Function.first, _strS);};
+                    [=](const std::string& _strS) -> double {return hFunc.call(_strS);};
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
                 break;
             }   
             case SignatureType::DOUBLE_STRING_DOUBLE:
             {   
+                const auto hFunc = m_pComInterface->resolve<double, std::string, double>(Function.first);
                 std::function<double(std::string, double)> Func = 
                     [=](const std::string& _strS, const double& _fD) -> double
-                    {return m_pComInterface->call<double, std::string, double>(Function.first, _strS, _fD);};
+                    {return hFunc.call(_strS, _fD);};
+                TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
+                break;
+            }   
+            case SignatureType::DYN_ARRAY_DYN_ARRAY:
+            {   
+                const auto hFunc = m_pComInterface->resolve<std::vector<double>, std::vector<double>>(Function.first);
+                std::function<sol::table(sol::table)> Func =
+                    [=](const sol::table& _T) -> sol::table
+                    {
+                        std::vector<double> vecTable(_T.size());
+                        for (auto i = 1u; i <= _T.size(); ++i)
+                        {
+                            vecTable[i-1] = _T[i];
+                        }
+                        const auto vecRet = hFunc.call(vecTable);
+                        sol::table TableRet = m_LuaState.create_table(static_cast<int>(vecRet.size()), 0);
+                        for (auto i = 0u; i < vecRet.size(); ++i)
+                        {
+                            TableRet[i+1] = vecRet[i];
+                        }
+                        return TableRet;
+                    };
+                TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
+                break;
+            }   
+            case SignatureType::DYN_ARRAY_INT:
+            {   
+                const auto hFunc = m_pComInterface->resolve<std::vector<double>, int>(Function.first);
+                std::function<sol::table(int)> Func =
+                    [=](const int _nN) -> sol::table
+                    {
+                        const auto vecRet = hFunc.call(_nN);
+                        sol::table TableRet = m_LuaState.create_table(static_cast<int>(vecRet.size()), 0);
+                        for (auto i = 0u; i < vecRet.size(); ++i)
+                        {
+                            TableRet[i+1] = vecRet[i];
+                        }
+                        return TableRet;
+                    };
+                TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
+                break;
+            }   
+            case SignatureType::DYN_ARRAY_INT_DYN_ARRAY:
+            {   
+                const auto hFunc = m_pComInterface->resolve<std::vector<double>, int, std::vector<double>>(Function.first);
+                std::function<sol::table(int, sol::table)> Func =
+                    [=](const int _n1, const sol::table& _T) -> sol::table
+                    {
+                        std::vector<double> vecTable(_T.size());
+                        for (auto i = 1u; i <= _T.size(); ++i)
+                        {
+                            vecTable[i-1] = _T[i];
+                        }
+                        const auto vecRet = hFunc.call(_n1, vecTable);
+                        sol::table TableRet = m_LuaState.create_table(static_cast<int>(vecRet.size()), 0);
+                        for (auto i = 0u; i < vecRet.size(); ++i)
+                        {
+                            TableRet[i+1] = vecRet[i];
+                        }
+                        return TableRet;
+                    };
+                TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
+                break;
+            }   
+            case SignatureType::DYN_ARRAY_STRING_INT:
+            {   
+                const auto hFunc = m_pComInterface->resolve<std::vector<double>, std::string, int>(Function.first);
+                std::function<sol::table(std::string, int)> Func =
+                    [=](const std::string& _strS, const int _nN) -> sol::table
+                    {
+                        const auto vecRet = hFunc.call(_strS, _nN);
+                        sol::table TableRet = m_LuaState.create_table(static_cast<int>(vecRet.size()), 0);
+                        for (auto i = 0u; i < vecRet.size(); ++i)
+                        {
+                            TableRet[i+1] = vecRet[i];
+                        }
+                        return TableRet;
+                    };
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
                 break;
             }   
             case SignatureType::NONE:
             {   
+                const auto hFunc = m_pComInterface->resolve<void>(Function.first);
                 std::function<void()> Func =
-                    [=]() {m_pComInterface->call<void>(Function.first);};
+                    [=]() {hFunc.call();};
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
                 break;
             }   
             case SignatureType::NONE_BOOL:
             {   
+                const auto hFunc = m_pComInterface->resolve<void, bool>(Function.first);
                 std::function<void(bool)> Func =
-                    [=](const bool _bB) {m_pComInterface->call<void, bool>(Function.first, _bB);};
+                    [=](const bool _bB) {hFunc.call(_bB);};
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
                 break;
             }   
             case SignatureType::NONE_DOUBLE:
             {   
+                const auto hFunc = m_pComInterface->resolve<void, double>(Function.first);
                 std::function<void(double)> Func =
-                    [=](const double& _fD) {m_pComInterface->call<void, double>(Function.first, _fD);};
+                    [=](const double& _fD) {hFunc.call(_fD);};
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
                 break;
             }   
             case SignatureType::NONE_2DOUBLE:
             {   
+                const auto hFunc = m_pComInterface->resolve<void, double, double>(Function.first);
                 std::function<void(double, double)> Func =
-                    [=](const double& _f1, const double& _f2) {m_pComInterface->call<void, double, double>(Function.first, _f1, _f2);};
+                    [=](const double& _f1, const double& _f2) {hFunc.call(_f1, _f2);};
+                TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
+                break;
+            }   
+            case SignatureType::NONE_2DYN_ARRAY:
+            {   
+                const auto hFunc = m_pComInterface->resolve<void, std::vector<double>, std::vector<double>>(Function.first);
+                std::function<void(sol::table, sol::table)> Func =
+                    [=](const sol::table& _T1, const sol::table& _T2)
+                    {
+                        std::vector<double> vecTable1(_T1.size());
+                        std::vector<double> vecTable2(_T2.size());
+                        for (auto i = 1u; i <= _T1.size(); ++i)
+                        {
+                            vecTable1[i-1] = _T1[i];
+                        }
+                        for (auto i = 1u; i <= _T2.size(); ++i)
+                        {
+                            vecTable2[i-1] = _T2[i];
+                        }
+                        hFunc.call(vecTable1, vecTable2);
+                    };
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
                 break;
             }   
             case SignatureType::NONE_INT:
             {   
+                const auto hFunc = m_pComInterface->resolve<void, int>(Function.first);
                 std::function<void(int)> Func =
-                    [=](const int _nN) {m_pComInterface->call<void, int>(Function.first, _nN);};
+                    [=](const int _nN) {hFunc.call(_nN);};
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
                 break;
             }   
             case SignatureType::NONE_2INT:
             {   
+                const auto hFunc = m_pComInterface->resolve<void, int, int>(Function.first);
                 std::function<void(int, int)> Func =
-                    [=](const int _n1, const int _n2) {m_pComInterface->call<void, int, int>(Function.first, _n1, _n2);};
+                    [=](const int _n1, const int _n2) {hFunc.call(_n1, _n2);};
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
                 break;
             }   
             case SignatureType::NONE_3INT:
             {   
+                const auto hFunc = m_pComInterface->resolve<void, int, int, int>(Function.first);
                 std::function<void(int, int, int)> Func =
-                    [=](const int _n1, const int _n2, const int _n3) {m_pComInterface->call<void, int, int>(Function.first, _n1, _n2, _n3);};
+                    [=](const int _n1, const int _n2, const int _n3) {hFunc.call(_n1, _n2, _n3);};
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
                 break;
             }   
             case SignatureType::NONE_INT_DOUBLE:
             {   
+                const auto hFunc = m_pComInterface->resolve<void, int, double>(Function.first);
                 std::function<void(int, double)> Func =
-                    [=](const int _n1, const double& _f1) {m_pComInterface->call<void, int, double>(Function.first, _n1, _f1);};
+                    [=](const int _n1, const double& _f1) {hFunc.call(_n1, _f1);};
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
                 break;
             }   
             case SignatureType::NONE_INT_2DOUBLE:
             {   
+                const auto hFunc = m_pComInterface->resolve<void, int, double, double>(Function.first);
                 std::function<void(int, double, double)> Func =
-                    [=](const int _n1, const double& _f1, const double& _f2) {m_pComInterface->call<void, int, double, double>(Function.first, _n1, _f1, _f2);};
+                    [=](const int _n1, const double& _f1, const double& _f2) {hFunc.call(_n1, _f1, _f2);};
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
                 break;
             }  
             case SignatureType::NONE_INT_4DOUBLE:
             {   
+                const auto hFunc = m_pComInterface->resolve<void, int, double, double, double, double>(Function.first);
                 std::function<void(int, double, double, double, double)> Func =
                     [=](const int _n1, const double& _f1, const double& _f2, const double& _f3, const double& _f4)
-                        {m_pComInterface->call<void, int, double, double, double, double>(Function.first, _n1, _f1, _f2, _f3, _f4);};
+                        {hFunc.call(_n1, _f1, _f2, _f3, _f4);};
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
                 break;
             }   
             case SignatureType::NONE_INT_DYN_ARRAY:
             {   
+                const auto hFunc = m_pComInterface->resolve<void, int, std::vector<double>>(Function.first);
                 std::function<void(int, sol::table)> Func =
                     [=](const int _n1, const sol::table& _T)
                     {
@@ -228,69 +350,77 @@ bool CLuaManager::init()
                         {
                             vecTable[i-1] = _T[i];
                         }
-                        m_pComInterface->call<void, int, std::vector<double>>(Function.first, _n1, vecTable);
+                        hFunc.call(_n1, vecTable);
                     };
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
                 break;
             }   
             case SignatureType::NONE_INT_STRING:
             {   
+                const auto hFunc = m_pComInterface->resolve<void, int, std::string>(Function.first);
                 std::function<void(int, std::string)> Func =
-                    [=](const int _n1, const std::string& _str1) {m_pComInterface->call<void, int, std::string>(Function.first, _n1, _str1);};
+                    [=](const int _n1, const std::string& _str1) {hFunc.call(_n1, _str1);};
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
                 break;
             }   
             case SignatureType::NONE_STRING:
             {   
+                const auto hFunc = m_pComInterface->resolve<void, std::string>(Function.first);
                 std::function<void(std::string)> Func =
-                    [=](const std::string& _str1) {m_pComInterface->call<void, std::string>(Function.first, _str1);};
+                    [=](const std::string& _str1) {hFunc.call(_str1);};
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
                 break;
             }   
             case SignatureType::NONE_2STRING:
             {   
+                const auto hFunc = m_pComInterface->resolve<void, std::string, std::string>(Function.first);
                 std::function<void(std::string, std::string)> Func =
                     [=](const std::string& _str1, const std::string& _str2)
-                        {m_pComInterface->call<void, std::string, std::string>(Function.first, _str1, _str2);};
+                        {hFunc.call(_str1, _str2);};
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
                 break;
             }
             case SignatureType::NONE_4STRING:
             {   
+                const auto hFunc = m_pComInterface->resolve<void, std::string, std::string, std::string, std::string>(Function.first);
                 std::function<void(std::string, std::string, std::string, std::string)> Func =
                     [=](const std::string& _str1, const std::string& _str2, const std::string& _str3, const std::string& _str4)
-                        {m_pComInterface->call<void, std::string, std::string, std::string, std::string>(Function.first, _str1, _str2, _str3, _str4);};
+                        {hFunc.call(_str1, _str2, _str3, _str4);};
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
                 break;
             }
             case SignatureType::NONE_STRING_INT:
             {   
+                const auto hFunc = m_pComInterface->resolve<void, std::string, int>(Function.first);
                 std::function<void(std::string, int)> Func =
-                    [=](const std::string& _str1, const int _n1) {m_pComInterface->call<void, std::string, int>(Function.first, _str1, _n1);};
+                    [=](const std::string& _str1, const int _n1) {hFunc.call(_str1, _n1);};
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
                 break;
             }   
             case SignatureType::NONE_STRING_2INT:
             {   
+                const auto hFunc = m_pComInterface->resolve<void, std::string, int, int>(Function.first);
                 std::function<void(std::string, int, int)> Func =
                     [=](const std::string& _str1, const int _n1, const int _n2)
-                        {m_pComInterface->call<void, std::string, int, int>(Function.first, _str1, _n1, _n2);};
+                        {hFunc.call(_str1, _n1, _n2);};
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
                 break;
             }   
             case SignatureType::NONE_STRING_DOUBLE:
             {   
+                const auto hFunc = m_pComInterface->resolve<void, std::string, double>(Function.first);
                 std::function<void(std::string, double)> Func =
-                    [=](const std::string& _str1, const double& _f1) {m_pComInterface->call<void, std::string, double>(Function.first, _str1, _f1);};
+                    [=](const std::string& _str1, const double& _f1) {hFunc.call(_str1, _f1);};
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
                 break;
             }   
             case SignatureType::VEC2DDOUBLE:
             {   
+                const auto hFunc = m_pComInterface->resolve<Vector2d>(Function.first);
                 std::function<std::tuple<double, double>()> Func =
                     [=]() -> std::tuple<double,double>
                     {
-                        Vector2d vecV = m_pComInterface->call<Vector2d>(Function.first);
+                        Vector2d vecV = hFunc.call();
                         return std::tie(vecV[0],vecV[1]);
                     };
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
@@ -298,10 +428,11 @@ bool CLuaManager::init()
             }   
             case SignatureType::VEC2DDOUBLE_INT:
             {   
+                const auto hFunc = m_pComInterface->resolve<Vector2d, int>(Function.first);
                 std::function<std::tuple<double, double>(int)> Func =
                     [=](const int _n1) -> std::tuple<double,double>
                     {
-                        Vector2d vecV = m_pComInterface->call<Vector2d, int>(Function.first, _n1);
+                        Vector2d vecV = hFunc.call(_n1);
                         return std::tie(vecV[0],vecV[1]);
                     };
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
@@ -309,10 +440,11 @@ bool CLuaManager::init()
             }   
             case SignatureType::VEC2DDOUBLE_2INT:
             {   
+                const auto hFunc = m_pComInterface->resolve<Vector2d, int, int>(Function.first);
                 std::function<std::tuple<double, double>(int, int)> Func =
                     [=](const int _n1, const int _n2) -> std::tuple<double,double>
                     {
-                        Vector2d vecV = m_pComInterface->call<Vector2d, int, int>(Function.first, _n1, _n2);
+                        Vector2d vecV = hFunc.call(_n1, _n2);
                         return std::tie(vecV[0],vecV[1]);
                     };
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
@@ -320,10 +452,11 @@ bool CLuaManager::init()
             }   
             case SignatureType::VEC2DDOUBLE_STRING:
             {   
+                const auto hFunc = m_pComInterface->resolve<Vector2d, std::string>(Function.first);
                 std::function<std::tuple<double, double>(std::string)> Func =
                     [=](const std::string& _str1) -> std::tuple<double,double>
                     {
-                        Vector2d vecV = m_pComInterface->call<Vector2d, std::string>(Function.first, _str1);
+                        Vector2d vecV = hFunc.call(_str1);
                         return std::tie(vecV[0],vecV[1]);
                     };
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
@@ -331,10 +464,11 @@ bool CLuaManager::init()
             }   
             case SignatureType::VEC2DDOUBLE_2STRING:
             {   
+                const auto hFunc = m_pComInterface->resolve<Vector2d, std::string, std::string>(Function.first);
                 std::function<std::tuple<double, double>(std::string, std::string)> Func =
                     [=](const std::string& _str1, const std::string& _str2) -> std::tuple<double,double>
                     {
-                        Vector2d vecV = m_pComInterface->call<Vector2d, std::string, std::string>(Function.first, _str1, _str2);
+                        Vector2d vecV = hFunc.call(_str1, _str2);
                         return std::tie(vecV[0],vecV[1]);
                     };
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
@@ -342,10 +476,11 @@ bool CLuaManager::init()
             }
             case SignatureType::VEC2DINT:
             {   
+                const auto hFunc = m_pComInterface->resolve<Vector2i>(Function.first);
                 std::function<std::tuple<int, int>()> Func =
                     [=]() -> std::tuple<int, int>
                     {
-                        Vector2i vecV = m_pComInterface->call<Vector2i>(Function.first);
+                        Vector2i vecV = hFunc.call();
                         return std::tie(vecV[0],vecV[1]);
                     };
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
@@ -353,10 +488,11 @@ bool CLuaManager::init()
             }
             case SignatureType::VEC2DINT_INT:
             {   
+                const auto hFunc = m_pComInterface->resolve<Vector2i, int>(Function.first);
                 std::function<std::tuple<int, int>(int)> Func =
                     [=](const int _n1) -> std::tuple<int, int>
                     {
-                        Vector2i vecV = m_pComInterface->call<Vector2i, int>(Function.first, _n1);
+                        Vector2i vecV = hFunc.call(_n1);
                         return std::tie(vecV[0],vecV[1]);
                     };
                 TablePW[strDomain.c_str()][Function.first.c_str()] = Func;
@@ -423,7 +559,7 @@ bool CLuaManager::processFrame()
         if (!m_bPaused)
         {
             m_TimeProcessed.start();
-            m_pComInterface->call<void>("e_lua_update");
+            m_hLuaUpdate.call();
             m_TimeProcessed.stop();
         }
         m_pComInterface->callWriters("lua");
@@ -575,6 +711,7 @@ bool CLuaManager::registerCallback(const std::string& _strFunc,
             }
             case SignatureType::BOOL_INT:
             case SignatureType::DOUBLE_INT:
+            case SignatureType::DYN_ARRAY_INT:
             case SignatureType::INT_INT:
             case SignatureType::NONE_INT:
             case SignatureType::VEC2DDOUBLE_INT:
@@ -618,6 +755,14 @@ bool CLuaManager::registerCallback(const std::string& _strFunc,
                 m_pComInterface->registerCallback<void, double, double>(_strFunc, Func, _strWriterDomain);
                 break;
             }
+            case SignatureType::NONE_2DYN_ARRAY:
+            {
+                std::function<void(std::vector<double>, std::vector<double>)> Func =
+                    [=](const std::vector<double>& _vec1, const std::vector<double>& _vec2)
+                        {m_LuaState[_strCallback](_vec1, _vec2);};
+                m_pComInterface->registerCallback<void, std::vector<double>, std::vector<double>>(_strFunc, Func, _strWriterDomain);
+                break;
+            }
             case SignatureType::NONE_2INT:
             case SignatureType::VEC2DDOUBLE_2INT:
             {
@@ -651,6 +796,14 @@ bool CLuaManager::registerCallback(const std::string& _strFunc,
                 m_pComInterface->registerCallback<void, int, double, double, double, double>(_strFunc, Func, _strWriterDomain);
                 break;
             }
+            case SignatureType::DYN_ARRAY_DYN_ARRAY:
+            {
+                std::function<void(std::vector<double>)> Func = [=](const std::vector<double>& _vecV)
+                {m_LuaState[_strCallback](_vecV);};
+                m_pComInterface->registerCallback<void, std::vector<double>>(_strFunc, Func, _strWriterDomain);
+                break;
+            }
+            case SignatureType::DYN_ARRAY_INT_DYN_ARRAY:
             case SignatureType::NONE_INT_DYN_ARRAY:
             {
                 std::function<void(int, std::vector<double>)> Func = [=](const int _nN, const std::vector<double>& _vecV)
@@ -680,6 +833,7 @@ bool CLuaManager::registerCallback(const std::string& _strFunc,
                 m_pComInterface->registerCallback<void, std::string>(_strFunc, Func, _strWriterDomain);
                 break;
             }
+            case SignatureType::DYN_ARRAY_STRING_INT:
             case SignatureType::NONE_STRING_INT:
             {
                 std::function<void(std::string, int)> Func = [=](const std::string& _strS, const int _nN)
@@ -89,6 +89,8 @@ class CLuaManager : public IComInterfaceProvider,
         bool            m_bPaused;              ///< Indicates if processing is paused, depends on physics
         
         CTimer          m_TimeProcessed;        ///< Counts processing time for one Lua frame
+        
+        CCommandHandle<void> m_hLuaUpdate;      ///< Event, called each Lua frame
 };
 
 //--- Implementation is done here for inline optimisation --------------------//
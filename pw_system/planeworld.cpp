@@ -262,6 +262,15 @@ int main(int argc, char *argv[])
                                     {{ParameterType::NONE, "No return value"}},
                                     "system", "main"
     );
+    ComInterface.registerFunction("get_lock_statistics",
+                                    CCommand<std::string>([&]() -> std::string
+                                    {
+                                        return CAdaptiveLock::getStatisticsAll();
+                                    }),
+                                    "Returns acquisitions, contended acquisitions and wait times of all locks, hottest first.",
+                                    {{ParameterType::STRING, "Table of lock statistics"}},
+                                    "system"
+    );
     ComInterface.registerFunction("init_physics",
                                     CCommand<void>([&]()
                                     {
@@ -315,6 +324,7 @@ int main(int argc, char *argv[])
     pPhysicsManager->initComInterface(&ComInterface, "physics");
     pVisualsManager->initComInterface(&ComInterface, "visuals");
     GameStateManager.initComInterface(&ComInterface, "gamestate");
+    pInputManager->init();
     
     //////////////////////////////////////////////////////////////////////////// 
     //
@@ -426,9 +436,8 @@ int main(int argc, char *argv[])
         pLuaThread->join();
         pPhysicsManager->terminate();
         pPhysicsThread->join();
-        DOM_STATS(DEBUG_MSG("main", "Spinlock waits: " << CSpinlock::getWaits()))
-        DOM_STATS(DEBUG_MSG("main", "Spinlock yields: " << CSpinlock::getYields()))
-        DOM_STATS(DEBUG_MSG("main", "Spinlock sleeps: " << CSpinlock::getSleeps()*0.5 << " ms"))
+        DOM_STATS(DEBUG_MSG("main", "Lock statistics:\n" << CAdaptiveLock::getStatisticsAll()))
+        DOM_STATS(DEBUG_MSG("main", "Pool occupancy:\n" << IPool::getStatisticsAll()))
     #endif
 
     CLEAN_UP;
@@ -0,0 +1,263 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       pw_eval_com_interface.cpp
+/// \brief      Evaluation of calls per second for the com interface
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+//--- Standard header --------------------------------------------------------//
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+//--- Program header ---------------------------------------------------------//
+#include "com_interface.h"
+
+//--- Misc-Header ------------------------------------------------------------//
+
+constexpr int EVAL_NR_OF_CALLS = 1000000; ///< Number of calls for each measurement
+
+thread_local long g_nCallbacksCalled = 0; ///< Callbacks called by this thread, avoiding shared counters
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Measures calls per second of given call
+///
+/// \param _Call Call to be measured, given the number of the call
+///
+/// \return Calls per second
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class TCall>
+double measureCallsPerSecond(TCall _Call)
+{
+    METHOD_ENTRY("measureCallsPerSecond")
+    
+    using namespace std::chrono;
+    
+    const auto Start = steady_clock::now();
+    for (auto i=0; i<EVAL_NR_OF_CALLS; ++i) _Call(i);
+    return EVAL_NR_OF_CALLS / duration_cast<duration<double>>(steady_clock::now() - Start).count();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Main function
+///
+/// This is the entrance point for program startup.
+///
+/// \return Exit code
+///
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    Log.setColourScheme(LOG_COLOUR_SCHEME_ONBLACK);
+
+    INFO_MSG("Evaluation", "Starting evaluation...")
+    
+    CComInterface ComInterface;
+    
+    long nSumFunction = 0;
+    long nSumCallback = 0;
+    ComInterface.registerFunction("eval_function",
+                                  CCommand<int, int>([&](const int _nN) -> int {nSumFunction += _nN; return _nN;}),
+                                  "Function to be evaluated.",
+                                  {{ParameterType::INT, "Given value"},
+                                   {ParameterType::INT, "Value"}},
+                                  "eval");
+    ComInterface.registerEvent<int>("e_eval_event",
+                                    "Event to be evaluated.",
+                                    {{ParameterType::NONE, "No return value"},
+                                     {ParameterType::INT, "Value"}},
+                                    "eval");
+    ComInterface.registerCallback("e_eval_event",
+                                  std::function<void(int)>([&](const int _nN) {nSumCallback += _nN;}));
+    
+    const auto hFunction = ComInterface.resolve<int, int>("eval_function");
+    const auto hEvent = ComInterface.resolve<void, int>("e_eval_event");
+    if (!hFunction.isValid() || !hEvent.isValid() || ComInterface.resolve<double>("eval_function").isValid())
+    {
+        ERROR_MSG("Evaluation", "Functions not resolved as expected.")
+        return EXIT_FAILURE;
+    }
+    
+    INFO_MSG("Evaluation", "Function without callbacks...")
+    const double fByName = measureCallsPerSecond([&](const int _nN){ComInterface.call<int, int>("eval_function", _nN);});
+    const double fByHandle = measureCallsPerSecond([&](const int _nN){hFunction.call(_nN);});
+    INFO_MSG("Evaluation", "Calls per second by name: " << fByName << ", by handle: " << fByHandle)
+    
+    INFO_MSG("Evaluation", "Event with one callback...")
+    const double fEventByName = measureCallsPerSecond([&](const int _nN){ComInterface.call<void, int>("e_eval_event", _nN);});
+    const double fEventByHandle = measureCallsPerSecond([&](const int _nN){hEvent.call(_nN);});
+    INFO_MSG("Evaluation", "Calls per second by name: " << fEventByName << ", by handle: " << fEventByHandle)
+    
+    if (nSumFunction != 2*long(EVAL_NR_OF_CALLS)*(EVAL_NR_OF_CALLS-1)/2 || nSumCallback != nSumFunction)
+    {
+        ERROR_MSG("Evaluation", "Calls by name and by handle differ.")
+        return EXIT_FAILURE;
+    }
+    
+    INFO_MSG("Evaluation", "Event called by several threads while registering callbacks...")
+    {
+        const auto nThreads = 4;
+        const auto nCallbacks = 10;
+        
+        ComInterface.registerEvent<>("e_eval_event_mt",
+                                     "Event to be evaluated by several threads.",
+                                     {{ParameterType::NONE, "No return value"}},
+                                     "eval");
+        
+        std::vector<double> CallsPerSecond(nThreads);
+        std::vector<std::thread> Threads;
+        for (auto t=0; t<nThreads; ++t)
+        {
+            Threads.emplace_back([&, t]()
+            {
+                CallsPerSecond[t] = measureCallsPerSecond([&](const int){ComInterface.call<void>("e_eval_event_mt");});
+            });
+        }
+        for (auto i=0; i<nCallbacks; ++i)
+        {
+            ComInterface.registerCallback("e_eval_event_mt",
+                                          std::function<void()>([](){++g_nCallbacksCalled;}));
+        }
+        for (auto& Thread : Threads) Thread.join();
+        
+        double fCallsPerSecond = 0.0;
+        for (const auto fCalls : CallsPerSecond) fCallsPerSecond += fCalls;
+        INFO_MSG("Evaluation", nThreads << " threads: " << fCallsPerSecond << " calls per second")
+        
+        ComInterface.call<void>("e_eval_event_mt");
+        if (g_nCallbacksCalled != nCallbacks)
+        {
+            ERROR_MSG("Evaluation", "Callbacks registered concurrently not called.")
+            return EXIT_FAILURE;
+        }
+    }
+    
+    INFO_MSG("Evaluation", "Queued writer per entity and in bulk...")
+    {
+        using namespace std::chrono;
+        
+        const auto nEntities = 100000u;
+        
+        std::vector<double> Values(2*nEntities, 0.0);
+        ComInterface.registerWriterDomain("eval");
+        ComInterface.registerFunction("eval_set",
+                                      CCommand<void, int, double, double>(
+                                      [&](const int _nUID, const double& _fX, const double& _fY)
+                                      {
+                                          Values[2*_nUID] = _fX;
+                                          Values[2*_nUID+1] = _fY;
+                                      }),
+                                      "Sets values of one entity.",
+                                      {{ParameterType::NONE, "No return value"},
+                                       {ParameterType::INT, "UID"},
+                                       {ParameterType::DOUBLE, "X"},
+                                       {ParameterType::DOUBLE, "Y"}},
+                                      "eval", "eval");
+        ComInterface.registerFunction("eval_set_bulk",
+                                      CCommand<void, std::vector<double>, std::vector<double>>(
+                                      [&](const std::vector<double>& _UIDs, const std::vector<double>& _Values)
+                                      {
+                                          for (auto i=0u; i<_UIDs.size(); ++i)
+                                          {
+                                              const auto nUID = static_cast<std::size_t>(_UIDs[i]);
+                                              Values[2*nUID] = _Values[2*i];
+                                              Values[2*nUID+1] = _Values[2*i+1];
+                                          }
+                                      }),
+                                      "Sets values of many entities at once.",
+                                      {{ParameterType::NONE, "No return value"},
+                                       {ParameterType::DYN_ARRAY, "UIDs"},
+                                       {ParameterType::DYN_ARRAY, "Values (x0, y0, ... xN, yN)"}},
+                                      "eval", "eval");
+        ComInterface.registerFunction("eval_get_bulk",
+                                      CCommand<std::vector<double>, std::vector<double>>(
+                                      [&](const std::vector<double>& _UIDs) -> std::vector<double>
+                                      {
+                                          std::vector<double> Ret(2*_UIDs.size());
+                                          for (auto i=0u; i<_UIDs.size(); ++i)
+                                          {
+                                              const auto nUID = static_cast<std::size_t>(_UIDs[i]);
+                                              Ret[2*i] = Values[2*nUID];
+                                              Ret[2*i+1] = Values[2*nUID+1];
+                                          }
+                                          return Ret;
+                                      }),
+                                      "Returns values of many entities at once.",
+                                      {{ParameterType::DYN_ARRAY, "Values (x0, y0, ... xN, yN)"},
+                                       {ParameterType::DYN_ARRAY, "UIDs"}},
+                                      "eval");
+        
+        std::vector<double> UIDs(nEntities);
+        std::vector<double> ValuesNew(2*nEntities);
+        for (auto i=0u; i<nEntities; ++i)
+        {
+            UIDs[i] = i;
+            ValuesNew[2*i] = i;
+            ValuesNew[2*i+1] = -1.0*i;
+        }
+        
+        const auto hSet = ComInterface.resolve<void, int, double, double>("eval_set");
+        auto Start = steady_clock::now();
+        for (auto i=0u; i<nEntities; ++i) hSet.call(i, ValuesNew[2*i], ValuesNew[2*i+1]);
+        ComInterface.callWriters("eval");
+        const double fTimePerEntity = duration_cast<duration<double>>(steady_clock::now() - Start).count();
+        if (Values != ValuesNew)
+        {
+            ERROR_MSG("Evaluation", "Values not set per entity.")
+            return EXIT_FAILURE;
+        }
+        
+        std::fill(Values.begin(), Values.end(), 0.0);
+        const auto hSetBulk = ComInterface.resolve<void, std::vector<double>, std::vector<double>>("eval_set_bulk");
+        Start = steady_clock::now();
+        hSetBulk.call(UIDs, ValuesNew);
+        ComInterface.callWriters("eval");
+        const double fTimeBulk = duration_cast<duration<double>>(steady_clock::now() - Start).count();
+        if (Values != ValuesNew ||
+            ComInterface.call<std::vector<double>, std::vector<double>>("eval_get_bulk", UIDs) != ValuesNew)
+        {
+            ERROR_MSG("Evaluation", "Values not set or returned in bulk.")
+            return EXIT_FAILURE;
+        }
+        INFO_MSG("Evaluation", nEntities << " entities per entity: " << fTimePerEntity*1.0e3 << "ms, in bulk: " <<
+                               fTimeBulk*1.0e3 << "ms")
+        
+        ComInterface.call("eval_set_bulk 2 3 4 1.5 2.5 3.5 4.5");
+        ComInterface.callWriters("eval");
+        if (ComInterface.call("eval_get_bulk 3 4") != "1.5 2.5 3.5 4.5 ")
+        {
+            ERROR_MSG("Evaluation", "Bulk commands not parsed as expected.")
+            return EXIT_FAILURE;
+        }
+    }
+    
+    INFO_MSG("Evaluation", "...done.")
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,193 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       pw_eval_gravity.cpp
+/// \brief      Evaluation of Barnes-Hut vs. pairwise gravitation
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-14
+///
+////////////////////////////////////////////////////////////////////////////////
+
+//--- Standard header --------------------------------------------------------//
+#include <random>
+#include <vector>
+
+//--- Program header ---------------------------------------------------------//
+#include "gravity_tree.h"
+#include "timer.h"
+
+//--- Misc-Header ------------------------------------------------------------//
+
+/// Bodies for evaluation, stored as in physics (local position and cell)
+struct Bodies
+{
+    std::vector<Vector2d> COMs;     ///< Center of mass, local to cell
+    std::vector<Vector2i> Cells;    ///< Grid cell
+    std::vector<double>   Masses;   ///< Mass
+};
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Creates randomly distributed bodies, spread over several grid cells
+///
+/// \param _nN Number of bodies
+///
+/// \return Bodies
+///
+///////////////////////////////////////////////////////////////////////////////
+Bodies createBodies(const int _nN)
+{
+    METHOD_ENTRY("createBodies")
+
+    std::mt19937 Generator(_nN);
+    std::normal_distribution<double> PosDist(0.0, 2.0*DEFAULT_CELL_SIZE);
+    std::uniform_real_distribution<double> MassDist(1.0e20, 1.0e24);
+
+    Bodies Result;
+    for (auto i=0; i<_nN; ++i)
+    {
+        Vector2d vecCOM;
+        Vector2i vecCell;
+        IGridUser::separateCenterCell(Vector2d(PosDist(Generator), PosDist(Generator)), vecCOM, vecCell);
+        Result.COMs.push_back(vecCOM);
+        Result.Cells.push_back(vecCell);
+        Result.Masses.push_back(MassDist(Generator));
+    }
+    return Result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Calculates field with the pairwise loop of physics manager
+///
+/// \param _B Bodies
+/// \param _Field Resulting gravitational field (acceleration / G)
+///
+///////////////////////////////////////////////////////////////////////////////
+void fieldPairwise(const Bodies& _B, std::vector<Vector2d>& _Field)
+{
+    METHOD_ENTRY("fieldPairwise")
+
+    _Field.assign(_B.Masses.size(), Vector2d(0.0, 0.0));
+    for (auto i=0u; i<_B.Masses.size(); ++i)
+    {
+        for (auto j=i+1; j<_B.Masses.size(); ++j)
+        {
+            Vector2d vecCC = _B.COMs[i] - _B.COMs[j] + IGridUser::cellToDouble(_B.Cells[i]-_B.Cells[j]);
+            double fCCSqr = vecCC.squaredNorm();
+            if (fCCSqr > GRAVITY_TREE_MIN_DISTANCE_SQR)
+            {
+                Vector2d vecG = vecCC.normalized() / fCCSqr;
+                _Field[i] -= vecG * _B.Masses[j];
+                _Field[j] += vecG * _B.Masses[i];
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Calculates field with the Barnes-Hut tree
+///
+/// \param _B Bodies
+/// \param _fTheta Opening angle
+/// \param _Field Resulting gravitational field (acceleration / G)
+///
+///////////////////////////////////////////////////////////////////////////////
+void fieldBarnesHut(const Bodies& _B, const double& _fTheta, std::vector<Vector2d>& _Field)
+{
+    METHOD_ENTRY("fieldBarnesHut")
+
+    CGravityTree Tree;
+    Tree.setOpeningAngle(_fTheta);
+    for (auto i=0u; i<_B.Masses.size(); ++i)
+        Tree.addBody(_B.COMs[i], _B.Cells[i], _B.Masses[i]);
+    Tree.build();
+
+    _Field.resize(_B.Masses.size());
+    for (auto i=0u; i<_B.Masses.size(); ++i)
+        _Field[i] = Tree.getField(_B.COMs[i], _B.Cells[i], i);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Main function
+///
+/// Compares accuracy and speed of Barnes-Hut and pairwise gravitation for
+/// 1k, 10k and 100k bodies.
+///
+/// \return Exit code
+///
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    Log.setColourScheme(LOG_COLOUR_SCHEME_ONBLACK);
+
+    const double fThetas[3] = {0.3, 0.5, 0.8};
+
+    for (auto nN : {1000, 10000, 100000})
+    {
+        Bodies B = createBodies(nN);
+        std::vector<Vector2d> FieldExact;
+        std::vector<Vector2d> FieldTree;
+        CTimer Timer;
+
+        Timer.start();
+        fieldPairwise(B, FieldExact);
+        Timer.stop();
+        INFO_MSG("Gravity Evaluation", "Bodies: " << nN << ", pairwise: " << Timer.getTime() << "s")
+
+        for (auto fTheta : fThetas)
+        {
+            Timer.start();
+            fieldBarnesHut(B, fTheta, FieldTree);
+            Timer.stop();
+
+            // Relative RMS error and maximum relative error
+            double fErrSqr = 0.0;
+            double fErrMax = 0.0;
+            for (auto i=0u; i<FieldExact.size(); ++i)
+            {
+                double fErr = (FieldTree[i]-FieldExact[i]).norm() / FieldExact[i].norm();
+                fErrSqr += fErr*fErr;
+                if (fErr > fErrMax) fErrMax = fErr;
+            }
+            INFO_MSG("Gravity Evaluation", "Bodies: " << nN << ", Barnes-Hut (theta = " << fTheta << "): " <<
+                     Timer.getTime() << "s, rel. error RMS: " << std::sqrt(fErrSqr/nN) <<
+                     ", max: " << fErrMax)
+        }
+
+        fieldBarnesHut(B, 0.0, FieldTree);
+        for (auto i=0u; i<FieldExact.size(); ++i)
+        {
+            if ((FieldTree[i]-FieldExact[i]).norm() > 1.0e-9 * FieldExact[i].norm())
+            {
+                ERROR_MSG("Gravity Evaluation", "Failed. Barnes-Hut with opening angle 0 differs from pairwise.")
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    INFO_MSG("Gravity Evaluation", "Passed.")
+    return EXIT_SUCCESS;
+}
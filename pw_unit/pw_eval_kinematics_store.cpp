@@ -0,0 +1,188 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       pw_eval_kinematics_store.cpp
+/// \brief      Evaluation of kinematics store vs. integration per object
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-16
+///
+////////////////////////////////////////////////////////////////////////////////
+
+//--- Standard header --------------------------------------------------------//
+#include <random>
+
+//--- Program header ---------------------------------------------------------//
+#include "circle.h"
+#include "object.h"
+#include "timer.h"
+
+//--- Misc-Header ------------------------------------------------------------//
+
+const int    NUMBER_OF_OBJECTS = 100000;    ///< Number of objects to integrate
+const int    NUMBER_OF_STEPS   = 100;       ///< Number of frames to integrate
+const double TIME_STEP         = 1.0/60.0;  ///< Time between two frames
+
+typedef CSlotMap<UIDType, CObject*> ObjectsType;
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Creates objects with random state and force
+///
+/// \param _Objects Objects to be created
+/// \param _IntType Integrator type of objects
+///
+///////////////////////////////////////////////////////////////////////////////
+void createObjects(ObjectsType& _Objects, const IntegratorType _IntType)
+{
+    METHOD_ENTRY("createObjects")
+
+    std::mt19937 Generator(42);
+    std::uniform_real_distribution<double> PosDist(-1.0e6, 1.0e6);
+    std::uniform_real_distribution<double> MassDist(1.0, 1.0e3);
+
+    for (auto i=0; i<NUMBER_OF_OBJECTS; ++i)
+    {
+        CCircle* pCircle = new CCircle;
+        pCircle->setRadius(1.0);
+        pCircle->setMass(MassDist(Generator));
+
+        CObject* pObj = new CObject;
+        pObj->setNewIntegrator(_IntType);
+        pObj->getGeometry()->addShape(pCircle);
+        pObj->setOrigin(Vector2d(PosDist(Generator), PosDist(Generator)));
+        pObj->setVelocity(Vector2d(PosDist(Generator), PosDist(Generator))*1.0e-3);
+        pObj->setAngle(PosDist(Generator));
+        pObj->init();
+        pObj->setForce(Vector2d(PosDist(Generator), PosDist(Generator)), PosDist(Generator));
+        _Objects[i] = pObj;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Compares integration of kinematics store and per object
+///
+/// Integrates the same objects by walking the hash map, every object using
+/// its own integrators, and by linear sweeps through the kinematics store.
+/// Resulting states have to be identical.
+///
+/// \param _IntType Integrator type of objects
+/// \param _strName Name of integrator type for output
+///
+/// \return Success?
+///
+///////////////////////////////////////////////////////////////////////////////
+bool evaluate(const IntegratorType _IntType, const std::string& _strName)
+{
+    METHOD_ENTRY("evaluate")
+
+    ObjectsType ObjectsMap;
+    ObjectsType ObjectsStore;
+    createObjects(ObjectsMap, _IntType);
+    createObjects(ObjectsStore, _IntType);
+
+    CKinematicsStore Store;
+    for (const auto& Obj : ObjectsStore) Store.add(Obj.second);
+
+    CTimer Timer;
+
+    Timer.start();
+    for (auto i=0; i<NUMBER_OF_STEPS; ++i)
+    {
+        for (const auto& Obj : ObjectsMap)
+            Obj.second->dynamics(TIME_STEP);
+    }
+    Timer.stop();
+    INFO_MSG("Kinematics Store Evaluation", _strName << ", objects: " << NUMBER_OF_OBJECTS << ", hash map, integrators per object: " <<
+             Timer.getTime()/NUMBER_OF_STEPS*1.0e3 << "ms per frame")
+
+    Timer.start();
+    for (auto i=0; i<NUMBER_OF_STEPS; ++i)
+    {
+        Store.integrate(TIME_STEP);
+        for (auto j=0; j<Store.size(); ++j)
+            Store.getObject(j)->dynamics(TIME_STEP);
+    }
+    Timer.stop();
+    INFO_MSG("Kinematics Store Evaluation", _strName << ", objects: " << NUMBER_OF_OBJECTS << ", kinematics store incl. kinematics state update: " <<
+             Timer.getTime()/NUMBER_OF_STEPS*1.0e3 << "ms per frame")
+
+    Timer.start();
+    for (auto i=0; i<NUMBER_OF_STEPS; ++i)
+    {
+        Store.integrate(TIME_STEP);
+    }
+    Timer.stop();
+    INFO_MSG("Kinematics Store Evaluation", _strName << ", objects: " << NUMBER_OF_OBJECTS << ", kinematics store, integration only: " <<
+             Timer.getTime()/NUMBER_OF_STEPS*1.0e3 << "ms per frame")
+
+    // Catch up with the map, store objects have been integrated twice as often
+    for (auto i=0; i<NUMBER_OF_STEPS; ++i)
+    {
+        for (const auto& Obj : ObjectsMap)
+            Obj.second->dynamics(TIME_STEP);
+    }
+    for (auto j=0; j<Store.size(); ++j)
+        Store.getObject(j)->dynamics(0.0);
+
+    for (const auto& Obj : ObjectsMap)
+    {
+        const CObject* pObjS = ObjectsStore[Obj.first];
+        if (Obj.second->getCOM() != pObjS->getCOM() ||
+            Obj.second->getVelocity() != pObjS->getVelocity() ||
+            Obj.second->getAngle() != pObjS->getAngle() ||
+            Obj.second->getAngleVelocity() != pObjS->getAngleVelocity())
+        {
+            ERROR_MSG("Kinematics Store Evaluation", "Failed. Kinematics store differs from integration per object (" <<
+                      _strName << ").")
+            return false;
+        }
+    }
+
+    for (const auto& Obj : ObjectsMap) delete Obj.second;
+    for (const auto& Obj : ObjectsStore) delete Obj.second;
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Main function
+///
+/// \return Exit code
+///
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    Log.setColourScheme(LOG_COLOUR_SCHEME_ONBLACK);
+
+    if (!evaluate(INTEGRATOR_EULER, "Euler") ||
+        !evaluate(INTEGRATOR_ADAMS_BASHFORTH, "Adams-Bashforth") ||
+        !evaluate(INTEGRATOR_ADAMS_MOULTON, "Adams-Moulton"))
+    {
+        return EXIT_FAILURE;
+    }
+
+    INFO_MSG("Kinematics Store Evaluation", "Passed.")
+    return EXIT_SUCCESS;
+}
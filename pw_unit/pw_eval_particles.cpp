@@ -0,0 +1,266 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       pw_eval_particles.cpp
+/// \brief      Evaluation of particle dynamics kernels
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+//--- Standard header --------------------------------------------------------//
+#include <random>
+
+//--- Program header ---------------------------------------------------------//
+#include "particle.h"
+#include "timer.h"
+
+//--- Misc-Header ------------------------------------------------------------//
+
+const int    NUMBER_OF_PARTICLES = 1000000;     ///< Number of particles
+const int    NUMBER_OF_STEPS     = 100;         ///< Number of frames to integrate
+const double TIME_STEP           = 1.0/60.0;    ///< Time between two frames
+const double MAXIMUM_AGE         = 2.0;         ///< Maximum age of particles
+const double MAXIMUM_AGE_SPARSE  = 0.1;         ///< Maximum age of particles, few live particles
+
+const std::uint8_t PARTICLE_STATE_ACTIVE   = 0; ///< Particle in circular buffers is active
+const std::uint8_t PARTICLE_STATE_INACTIVE = 1; ///< Particle in circular buffers is inactive
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Particles stored in circular buffers, one per attribute
+///
+/// This is the layout particles used before the structure of arrays was
+/// introduced, dynamics are calculated the way they were.
+///
+////////////////////////////////////////////////////////////////////////////////
+struct CircularBufferParticlesType
+{
+    CCircularBuffer<Vector2d>       PosList;        ///< Position of particles
+    CCircularBuffer<Vector2d>       PosListPrev;    ///< Position of particles in previous time step
+    CCircularBuffer<Vector2d>       VelList;        ///< Velocity of particles
+    CCircularBuffer<double>         AgeList;        ///< Age of particles
+    CCircularBuffer<std::uint8_t>   StateList;      ///< Is the particle active or inactive
+    CBoundingBox                    BBox;           ///< Bounding box of all particles
+    Vector2d                        vecForce;       ///< Force applied
+    double                          fMaxAge;        ///< Maximum age of particles
+};
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Calculates dynamics of particles stored in circular buffers
+///
+/// \param _Particles Particles
+/// \param _fStep Time step
+///
+///////////////////////////////////////////////////////////////////////////////
+void dynamics(CircularBufferParticlesType& _Particles, const double& _fStep)
+{
+    METHOD_ENTRY("dynamics")
+
+    _Particles.BBox.setLowerLeft(_Particles.PosList[0]);
+    _Particles.BBox.setUpperRight(_Particles.PosList[0]);
+
+    Vector2d vecStep = _Particles.vecForce * _fStep;
+    for (auto i=0u; i<_Particles.PosList.size(); ++i)
+    {
+        if (_Particles.StateList[i] == PARTICLE_STATE_ACTIVE)
+        {
+            _Particles.BBox.update(_Particles.PosList[i]);
+            _Particles.PosListPrev[i] = _Particles.PosList[i];
+            _Particles.VelList[i] += vecStep;
+            _Particles.PosList[i] += _Particles.VelList[i] * _fStep;
+            _Particles.BBox.update(_Particles.PosList[i]);
+            _Particles.AgeList[i] += _fStep;
+            if (_Particles.AgeList[i] >= _Particles.fMaxAge) _Particles.StateList[i] = PARTICLE_STATE_INACTIVE;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Generates the same particles for both layouts
+///
+/// Particles are generated over several frames, hence, they expire at
+/// different times during evaluation.
+///
+/// \param _CBParticles Particles stored in circular buffers
+/// \param _Particles Particles stored as structure of arrays
+/// \param _fMaxAge Maximum age of particles
+///
+///////////////////////////////////////////////////////////////////////////////
+void generate(CircularBufferParticlesType& _CBParticles, CParticle& _Particles, const double& _fMaxAge)
+{
+    METHOD_ENTRY("generate")
+
+    std::mt19937 Generator(42);
+    std::uniform_real_distribution<double> PosDist(-1.0e3, 1.0e3);
+    std::uniform_real_distribution<double> VelDist(-10.0, 10.0);
+
+    _CBParticles.PosList.reserve(NUMBER_OF_PARTICLES);
+    _CBParticles.PosListPrev.reserve(NUMBER_OF_PARTICLES);
+    _CBParticles.VelList.reserve(NUMBER_OF_PARTICLES);
+    _CBParticles.AgeList.reserve(NUMBER_OF_PARTICLES);
+    _CBParticles.StateList.reserve(NUMBER_OF_PARTICLES);
+    _CBParticles.vecForce = Vector2d(0.0, -9.81);
+    _CBParticles.fMaxAge = _fMaxAge;
+
+    _Particles.setNumber(NUMBER_OF_PARTICLES);
+    _Particles.setMaxAge(_fMaxAge);
+    _Particles.setForce(Vector2d(0.0, -9.81));
+
+    const int nFrames = 100;
+    for (auto i=0; i<nFrames; ++i)
+    {
+        for (auto j=0; j<NUMBER_OF_PARTICLES/nFrames; ++j)
+        {
+            const Vector2d vecP(PosDist(Generator), PosDist(Generator));
+            const Vector2d vecV(VelDist(Generator), VelDist(Generator));
+            _CBParticles.PosList.push_back(vecP);
+            _CBParticles.PosListPrev.push_back(vecP);
+            _CBParticles.VelList.push_back(vecV);
+            _CBParticles.AgeList.push_back(0.0);
+            _CBParticles.StateList.push_back(PARTICLE_STATE_ACTIVE);
+            _Particles.generate(vecP, vecV);
+        }
+        dynamics(_CBParticles, TIME_STEP);
+        _Particles.dynamics(TIME_STEP);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Compares particles of both layouts
+///
+/// The circular buffers are filled exactly once, thus, their indices equal
+/// the slots of the structure of arrays. Particles in front of the first live
+/// slot have to be expired. Without live particles, the bounding box isn't
+/// updated anymore.
+///
+/// \param _CBParticles Particles stored in circular buffers
+/// \param _Particles Particles stored as structure of arrays
+///
+/// \return Identical?
+///
+///////////////////////////////////////////////////////////////////////////////
+bool compare(CircularBufferParticlesType& _CBParticles, CParticle& _Particles)
+{
+    METHOD_ENTRY("compare")
+
+    if (_Particles.getNumberOfParticles() > 0 &&
+        (_CBParticles.BBox.getLowerLeft() != _Particles.getBoundingBox().getLowerLeft() ||
+         _CBParticles.BBox.getUpperRight() != _Particles.getBoundingBox().getUpperRight()))
+    {
+        return false;
+    }
+    const int nFirst = _Particles.getNumberOfParticles() > 0 ? _Particles.getFirstSlot() : NUMBER_OF_PARTICLES;
+    if (nFirst + _Particles.getNumberOfParticles() != NUMBER_OF_PARTICLES) return false;
+    for (auto i=0; i<NUMBER_OF_PARTICLES; ++i)
+    {
+        if (i < nFirst)
+        {
+            if (_CBParticles.StateList[i] == PARTICLE_STATE_ACTIVE) return false;
+        }
+        else if (_CBParticles.StateList[i] != PARTICLE_STATE_ACTIVE ||
+                 _CBParticles.PosList[i] != _Particles.getPosition(i-nFirst) ||
+                 _CBParticles.PosListPrev[i] != _Particles.getPreviousPosition(i-nFirst) ||
+                 _CBParticles.VelList[i] != _Particles.getVelocity(i-nFirst) ||
+                 _CBParticles.AgeList[i] != _Particles.getAge(i-nFirst))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Main function
+///
+/// \return Exit code
+///
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    Log.setColourScheme(LOG_COLOUR_SCHEME_ONBLACK);
+
+    const ParticleKernelType SupportedKernel = CParticle::getKernel();
+    const std::vector<std::pair<ParticleKernelType, std::string>> Kernels =
+    {
+        {ParticleKernelType::SCALAR, "scalar"},
+        {ParticleKernelType::SSE2, "SSE2"},
+        {ParticleKernelType::AVX2, "AVX2"}
+    };
+
+    // Particles live long enough for most of them to be active at the end,
+    // or expire soon, leaving few live particles in a large buffer
+    const std::vector<std::pair<double, std::string>> Scenarios =
+    {
+        {MAXIMUM_AGE, "long lived"},
+        {MAXIMUM_AGE_SPARSE, "short lived"}
+    };
+
+    CTimer Timer;
+    for (const auto& Scenario : Scenarios)
+    {
+        for (const auto& Kernel : Kernels)
+        {
+            if (static_cast<int>(Kernel.first) > static_cast<int>(SupportedKernel))
+            {
+                INFO_MSG("Particle Evaluation", "Kernel " << Kernel.second << " not supported by CPU, skipped.")
+                continue;
+            }
+            CParticle::setKernel(Kernel.first);
+
+            CircularBufferParticlesType CBParticles;
+            CParticle Particles;
+            generate(CBParticles, Particles, Scenario.first);
+
+            Timer.start();
+            for (auto i=0; i<NUMBER_OF_STEPS; ++i)
+                dynamics(CBParticles, TIME_STEP);
+            Timer.stop();
+            const double fTimeCB = Timer.getTime();
+
+            Timer.start();
+            for (auto i=0; i<NUMBER_OF_STEPS; ++i)
+                Particles.dynamics(TIME_STEP);
+            Timer.stop();
+            const double fTimeSoA = Timer.getTime();
+
+            INFO_MSG("Particle Evaluation", "Slots: " << NUMBER_OF_PARTICLES << ", " << Scenario.second <<
+                     ", live at end: " << Particles.getNumberOfParticles() << ", circular buffers: " <<
+                     NUMBER_OF_PARTICLES*NUMBER_OF_STEPS/fTimeCB*1.0e-6 << "M slots/s, structure of arrays (" <<
+                     Kernel.second << "): " << NUMBER_OF_PARTICLES*NUMBER_OF_STEPS/fTimeSoA*1.0e-6 << "M slots/s")
+
+            if (!compare(CBParticles, Particles))
+            {
+                ERROR_MSG("Particle Evaluation", "Failed. Kernel " << Kernel.second << " differs from circular buffers.")
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    INFO_MSG("Particle Evaluation", "Passed.")
+    return EXIT_SUCCESS;
+}
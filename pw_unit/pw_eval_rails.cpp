@@ -0,0 +1,243 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       pw_eval_rails.cpp
+/// \brief      Evaluation of conic propagation (rails) compared to integration
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+//--- Standard header --------------------------------------------------------//
+#include <cmath>
+#include <random>
+
+//--- Program header ---------------------------------------------------------//
+#include "circle.h"
+#include "kinematics_store.h"
+#include "object.h"
+#include "timer.h"
+
+//--- Misc-Header ------------------------------------------------------------//
+
+const double G                    = 6.67408e-11; ///< Gravitational constant
+const double PLANET_MASS          = 5.972e24;    ///< Mass of central body, earth
+const double PLANET_RADIUS        = 6.371e6;     ///< Radius of central body, earth
+const double PERIAPSIS_MIN        = 6.771e6;     ///< Minimum periapsis, low earth orbit
+const double PERIAPSIS_MAX        = 4.2164e7;    ///< Maximum periapsis, geostationary orbit
+const double ECCENTRICITY_MAX     = 0.7;         ///< Maximum eccentricity of orbits
+const double FRAME_FREQUENCY      = 200.0;       ///< Frequency of frames
+const int    NUMBER_OF_SATELLITES = 10000;       ///< Number of satellites
+const int    NUMBER_OF_FRAMES     = 200;         ///< Number of frames per measurement
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Creates satellites on random orbits, starting in periapsis
+///
+/// \param _Satellites Satellites to be created
+/// \param _Store Kinematics store satellites are added to
+/// \param _IntType Integrator type of satellites
+///
+///////////////////////////////////////////////////////////////////////////////
+void createSatellites(std::vector<CObject*>& _Satellites, CKinematicsStore& _Store, const IntegratorType _IntType)
+{
+    METHOD_ENTRY("createSatellites")
+
+    std::mt19937 Generator(42);
+    std::uniform_real_distribution<double> PeriapsisDist(PERIAPSIS_MIN, PERIAPSIS_MAX);
+    std::uniform_real_distribution<double> EccentricityDist(0.0, ECCENTRICITY_MAX);
+    std::uniform_real_distribution<double> AngleDist(0.0, 2.0*M_PI);
+
+    for (auto i=0; i<NUMBER_OF_SATELLITES; ++i)
+    {
+        const double fPeriapsis = PeriapsisDist(Generator);
+        const double fEccentricity = EccentricityDist(Generator);
+        const Rotation2Dd Rot(AngleDist(Generator));
+
+        CCircle* pCircle = new CCircle;
+        pCircle->setRadius(1.0);
+        pCircle->setMass(1000.0);
+
+        CObject* pObj = new CObject;
+        pObj->setNewIntegrator(_IntType);
+        pObj->getGeometry()->addShape(pCircle);
+        pObj->setOrigin(Rot * Vector2d(fPeriapsis, 0.0));
+        pObj->setVelocity(Rot * Vector2d(0.0, std::sqrt(G*PLANET_MASS*(1.0+fEccentricity)/fPeriapsis)));
+        pObj->init();
+
+        _Store.add(pObj);
+        _Satellites.push_back(pObj);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Simulates given number of frames as done by physics manager
+///
+/// Gravitation of the planet is calculated for all satellites in each frame,
+/// since rails rely on the perturbation measured from accumulated forces.
+///
+/// \param _Satellites Satellites
+/// \param _Store Kinematics store of satellites
+/// \param _pPlanet Planet
+/// \param _fStep Time step, including time scale
+/// \param _nFrames Number of frames
+///
+///////////////////////////////////////////////////////////////////////////////
+void simulate(const std::vector<CObject*>& _Satellites, CKinematicsStore& _Store,
+              CObject* const _pPlanet, const double& _fStep, const int _nFrames)
+{
+    METHOD_ENTRY("simulate")
+
+    for (auto i=0; i<_nFrames; ++i)
+    {
+        for (const auto pObj : _Satellites)
+        {
+            const Vector2d vecD = _pPlanet->getCOM() - pObj->getCOM();
+            pObj->setForce(vecD.normalized() * G*PLANET_MASS*pObj->getMass() / vecD.squaredNorm(), 0.0);
+        }
+        _Store.clearAttractors();
+        _Store.addAttractor(_pPlanet, G*PLANET_MASS);
+        _Store.updateRails();
+
+        _Store.integrate(_fStep);
+        for (const auto pObj : _Satellites)
+            pObj->dynamics(_fStep);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Main function
+///
+/// This is the entrance point for program startup.
+///
+/// \return Exit code
+///
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    Log.setColourScheme(LOG_COLOUR_SCHEME_ONBLACK);
+
+    INFO_MSG("Eval", "Starting evaluation...")
+
+    CCircle* pCircle = new CCircle;
+    pCircle->setRadius(PLANET_RADIUS);
+    pCircle->setMass(PLANET_MASS);
+
+    CObject* pPlanet = new CObject;
+    pPlanet->getGeometry()->addShape(pCircle);
+    pPlanet->disableDynamics();
+    pPlanet->init();
+
+    for (const double fTimeScale : {1.0, 1.0e3, 1.0e5})
+    {
+        const double fStep = fTimeScale / FRAME_FREQUENCY;
+        std::vector<std::vector<CObject*>> Satellites(3);
+        std::vector<std::vector<Vector2d>> Positions(3);
+        std::vector<double> Costs;
+
+        for (const IntegratorType IntType : {INTEGRATOR_ADAMS_BASHFORTH, INTEGRATOR_DORMAND_PRINCE})
+        {
+            CKinematicsStore Store;
+            std::vector<CObject*>& Objects = Satellites[Costs.size()];
+            createSatellites(Objects, Store, IntType);
+
+            CTimer Timer;
+            Timer.start();
+            simulate(Objects, Store, pPlanet, fStep, NUMBER_OF_FRAMES);
+            Timer.stop();
+            Costs.push_back(Timer.getTime()/NUMBER_OF_FRAMES);
+
+            for (const auto pObj : Objects) Positions[Costs.size()-1].push_back(pObj->getCOM());
+            while (Store.size() > 0) Store.remove(Store.size()-1);
+        }
+        {
+            CKinematicsStore Store;
+            Store.enableRails();
+            std::vector<CObject*>& Objects = Satellites[2];
+            createSatellites(Objects, Store, INTEGRATOR_DORMAND_PRINCE);
+
+            CTimer Timer;
+            Timer.start();
+            simulate(Objects, Store, pPlanet, fStep, NUMBER_OF_FRAMES);
+            Timer.stop();
+            Costs.push_back(Timer.getTime()/NUMBER_OF_FRAMES);
+
+            if (Store.getNumberOfRails() != NUMBER_OF_SATELLITES)
+            {
+                ERROR_MSG("Eval", "Only " << Store.getNumberOfRails() << " of " << NUMBER_OF_SATELLITES <<
+                                  " unperturbed satellites on rails.")
+                return EXIT_FAILURE;
+            }
+            for (const auto pObj : Objects) Positions[2].push_back(pObj->getCOM());
+
+            // Thrust lets satellites drop back to integration
+            Store.perturb(Objects[0]);
+            simulate(Objects, Store, pPlanet, fStep, 1);
+            if (Store.getNumberOfRails() != NUMBER_OF_SATELLITES-1 ||
+                Store.getNumberOfAdaptive() != 1)
+            {
+                ERROR_MSG("Eval", "Perturbed satellite didn't leave rails.")
+                return EXIT_FAILURE;
+            }
+
+            // Disabling rails lets all satellites drop back to integration
+            Store.disableRails();
+            simulate(Objects, Store, pPlanet, fStep, 1);
+            if (Store.getNumberOfRails() != 0 ||
+                Store.getNumberOfAdaptive() != NUMBER_OF_SATELLITES)
+            {
+                ERROR_MSG("Eval", Store.getNumberOfRails() << " satellites still on rails after disabling rails.")
+                return EXIT_FAILURE;
+            }
+            while (Store.size() > 0) Store.remove(Store.size()-1);
+        }
+
+        // Rails are exact, deviation is the error of adaptive integration
+        double fErrMax = 0.0;
+        for (auto i=0; i<NUMBER_OF_SATELLITES; ++i)
+        {
+            fErrMax = std::max(fErrMax, (Positions[2][i] - Positions[1][i]).norm() / Positions[1][i].norm());
+        }
+
+        INFO_MSG("Eval", "Time scale " << fTimeScale << ", " << NUMBER_OF_SATELLITES << " satellites, per frame: " <<
+                         Costs[0]*1.0e3 << "ms (Adams-Bashforth), " <<
+                         Costs[1]*1.0e3 << "ms (adaptive), " <<
+                         Costs[2]*1.0e3 << "ms (rails)")
+        INFO_MSG("Eval", "Maximum relative deviation of rails from adaptive integration: " << fErrMax)
+
+        if (fErrMax > 1.0e-5)
+        {
+            ERROR_MSG("Eval", "Rails deviate from adaptive integration at time scale " << fTimeScale << ".")
+            return EXIT_FAILURE;
+        }
+
+        for (const auto& Objects : Satellites)
+            for (const auto pObj : Objects) delete pObj;
+    }
+    delete pPlanet;
+
+    INFO_MSG("Eval", "...done.")
+    return EXIT_SUCCESS;
+}
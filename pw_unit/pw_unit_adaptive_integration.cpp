@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       pw_unit_adaptive_integration.cpp
+/// \brief      Unit test for adaptive integration of orbits at high time scale
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+//--- Standard header --------------------------------------------------------//
+#include <cmath>
+
+//--- Program header ---------------------------------------------------------//
+#include "circle.h"
+#include "kinematics_store.h"
+#include "object.h"
+#include "timer.h"
+
+//--- Misc-Header ------------------------------------------------------------//
+
+const double G               = 6.67408e-11; ///< Gravitational constant
+const double PLANET_MASS     = 5.972e24;    ///< Mass of central body, earth
+const double PLANET_RADIUS   = 6.371e6;     ///< Radius of central body, earth
+const double PERIAPSIS       = 6.771e6;     ///< Periapsis of all orbits, low earth orbit
+const double FRAME_FREQUENCY = 200.0;       ///< Frequency of frames
+const int    NUMBER_OF_ORBITS = 10;         ///< Number of orbits of circular orbit
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Creates an object starting in periapsis of an orbit
+///
+/// \param _IntType Integrator type of object
+/// \param _fEccentricity Eccentricity of orbit
+///
+/// \return Object
+///
+///////////////////////////////////////////////////////////////////////////////
+CObject* createSatellite(const IntegratorType _IntType, const double& _fEccentricity)
+{
+    METHOD_ENTRY("createSatellite")
+
+    CCircle* pCircle = new CCircle;
+    pCircle->setRadius(1.0);
+    pCircle->setMass(1000.0);
+
+    CObject* pObj = new CObject;
+    pObj->setNewIntegrator(_IntType);
+    pObj->getGeometry()->addShape(pCircle);
+    pObj->setOrigin(Vector2d(PERIAPSIS, 0.0));
+    pObj->setVelocity(Vector2d(0.0, std::sqrt(G*PLANET_MASS*(1.0+_fEccentricity)/PERIAPSIS)));
+    pObj->init();
+    return pObj;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns specific orbital energy of given object
+///
+/// \param _pObj Object
+///
+/// \return Specific orbital energy
+///
+///////////////////////////////////////////////////////////////////////////////
+double getEnergy(const CObject* const _pObj)
+{
+    METHOD_ENTRY("getEnergy")
+    return 0.5*_pObj->getVelocity().squaredNorm() - G*PLANET_MASS/_pObj->getCOM().norm();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Main function
+///
+/// This is the entrance point for program startup.
+///
+/// \return Exit code
+///
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    Log.setColourScheme(LOG_COLOUR_SCHEME_ONBLACK);
+
+    INFO_MSG("Unit test", "Starting unit test...")
+
+    CCircle* pCircle = new CCircle;
+    pCircle->setRadius(PLANET_RADIUS);
+    pCircle->setMass(PLANET_MASS);
+
+    CObject* pPlanet = new CObject;
+    pPlanet->getGeometry()->addShape(pCircle);
+    pPlanet->disableDynamics();
+    pPlanet->init();
+
+    const double fPeriod = 2.0*M_PI*std::sqrt(PERIAPSIS*PERIAPSIS*PERIAPSIS/(G*PLANET_MASS));
+
+    for (const double fTimeScale : {1.0e4, 1.0e5, 1.0e6})
+    {
+        CKinematicsStore Store;
+        std::vector<CObject*> Satellites = {createSatellite(INTEGRATOR_DORMAND_PRINCE, 0.0),
+                                            createSatellite(INTEGRATOR_DORMAND_PRINCE, 0.7),
+                                            createSatellite(INTEGRATOR_ADAMS_BASHFORTH, 0.0)};
+        std::vector<double> Energies;
+        for (const auto pObj : Satellites)
+        {
+            Store.add(pObj);
+            Energies.push_back(getEnergy(pObj));
+        }
+        if (Store.getNumberOfAdaptive() != 2)
+        {
+            ERROR_MSG("Unit test", "Wrong number of adaptively integrated objects.")
+            return EXIT_FAILURE;
+        }
+
+        const double fStep = fTimeScale / FRAME_FREQUENCY;
+        const int nFrames = int(std::ceil(NUMBER_OF_ORBITS*fPeriod/fStep));
+        int nSubStepsMax = 0;
+        double fSubSteps = 0.0;
+
+        CTimer Timer;
+        Timer.start();
+        for (auto i=0; i<nFrames; ++i)
+        {
+            // Gravitation as added by physics manager
+            for (const auto pObj : Satellites)
+            {
+                const Vector2d vecD = pPlanet->getCOM() - pObj->getCOM();
+                pObj->setForce(vecD.normalized() * G*PLANET_MASS*pObj->getMass() / vecD.squaredNorm(), 0.0);
+            }
+            Store.clearAttractors();
+            Store.addAttractor(pPlanet, G*PLANET_MASS);
+
+            Store.integrate(fStep);
+            for (auto j=0; j<Store.size(); ++j)
+                Store.getObject(j)->dynamics(fStep);
+
+            fSubSteps += Store.getNumberOfSubSteps();
+            nSubStepsMax = std::max(nSubStepsMax, Store.getNumberOfSubStepsMax());
+        }
+        Timer.stop();
+
+        const double fErrRadius = std::abs(Satellites[0]->getCOM().norm() - PERIAPSIS) / PERIAPSIS;
+        const double fErrEnergyCircular = std::abs((getEnergy(Satellites[0]) - Energies[0]) / Energies[0]);
+        const double fErrEnergyElliptic = std::abs((getEnergy(Satellites[1]) - Energies[1]) / Energies[1]);
+        const double fErrEnergyFixed = std::abs((getEnergy(Satellites[2]) - Energies[2]) / Energies[2]);
+
+        INFO_MSG("Unit test", "Time scale " << fTimeScale << ", " << nFrames << " frames: " <<
+                              fSubSteps/nFrames << " sub-steps per frame (max. " << nSubStepsMax << " per object), " <<
+                              Timer.getTime()/nFrames*1.0e6 << "us per frame")
+        INFO_MSG("Unit test", "Relative energy error, adaptive: " << fErrEnergyCircular << " (circular), " <<
+                              fErrEnergyElliptic << " (elliptic), Adams-Bashforth: " << fErrEnergyFixed << " (circular)")
+
+        if (fErrRadius > 1.0e-6 || fErrEnergyCircular > 1.0e-6 || fErrEnergyElliptic > 1.0e-6)
+        {
+            ERROR_MSG("Unit test", "Adaptive integration exceeds error bounds at time scale " << fTimeScale << ".")
+            return EXIT_FAILURE;
+        }
+        if (fTimeScale >= 1.0e5 && nSubStepsMax < 2)
+        {
+            ERROR_MSG("Unit test", "Adaptive integration doesn't sub-step at time scale " << fTimeScale << ".")
+            return EXIT_FAILURE;
+        }
+
+        for (const auto pObj : Satellites) delete pObj;
+    }
+    delete pPlanet;
+
+    INFO_MSG("Unit test", "...done. Test successful.")
+    return EXIT_SUCCESS;
+}
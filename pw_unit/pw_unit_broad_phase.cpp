@@ -0,0 +1,243 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       pw_unit_broad_phase.cpp
+/// \brief      Unit test for sweep and prune collision broad phase
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+//--- Standard header --------------------------------------------------------//
+#include <cmath>
+#include <random>
+#include <set>
+
+//--- Program header ---------------------------------------------------------//
+#include "broad_phase.h"
+#include "circle.h"
+#include "timer.h"
+
+//--- Misc-Header ------------------------------------------------------------//
+
+const int    NUMBER_OF_OBJECTS = 400;  ///< Number of objects
+const int    NUMBER_OF_STEPS   = 50;   ///< Number of frames
+const int    COMPARE_EVERY     = 7;    ///< Frames between all pairs tests
+const double FRAME_STEP        = 0.1;  ///< Timestep of frames, small to keep frames coherent
+
+typedef CSlotMap<UIDType, CObject*> ObjectsType;
+typedef std::set<std::pair<UIDType, UIDType>> PairsType;
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns pair of UIDs, smaller UID first
+///
+/// \param _pObjA Object A
+/// \param _pObjB Object B
+///
+/// \return Ordered pair of UIDs
+///
+///////////////////////////////////////////////////////////////////////////////
+std::pair<UIDType, UIDType> makePair(CObject* const _pObjA, CObject* const _pObjB)
+{
+    METHOD_ENTRY("makePair")
+    if (_pObjA->getUID() < _pObjB->getUID())
+        return {_pObjA->getUID(), _pObjB->getUID()};
+    else
+        return {_pObjB->getUID(), _pObjA->getUID()};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Finds overlapping pairs by testing all pairs
+///
+/// \param _Objects Objects
+///
+/// \return Overlapping pairs
+///
+///////////////////////////////////////////////////////////////////////////////
+PairsType pairsAll(const ObjectsType& _Objects)
+{
+    METHOD_ENTRY("pairsAll")
+
+    PairsType Pairs;
+    for (auto ci = _Objects.cbegin(); ci != _Objects.cend(); ++ci)
+    {
+        auto cj = ci;
+        ++cj;
+        while (cj != _Objects.cend())
+        {
+            if ((ci->second->getDepths() & cj->second->getDepths()) > 0 &&
+                ci->second->getGeometry()->getBoundingBox().overlaps(
+                cj->second->getGeometry()->getBoundingBox(), BROAD_PHASE_CELL_LIMIT))
+            {
+                Pairs.insert(makePair(ci->second, cj->second));
+            }
+            ++cj;
+        }
+    }
+    return Pairs;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Compares candidate pairs of broad phase with all pairs test
+///
+/// The broad phase is expected to be updated for the current frame already.
+///
+/// \param _BroadPhase Broad phase
+/// \param _Objects Objects
+///
+/// \return Identical?
+///
+///////////////////////////////////////////////////////////////////////////////
+bool compare(const CBroadPhase& _BroadPhase, const ObjectsType& _Objects)
+{
+    METHOD_ENTRY("compare")
+
+    PairsType PairsBroadPhase;
+    for (const auto& Pair : _BroadPhase.getPairs())
+    {
+        if (!PairsBroadPhase.insert(makePair(Pair.first, Pair.second)).second)
+        {
+            ERROR_MSG("Unit test", "Pair reported twice by broad phase.")
+            return false;
+        }
+    }
+    return (PairsBroadPhase == pairsAll(_Objects));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Main function
+///
+/// This is the entrance point for program startup.
+///
+/// \return Exit code
+///
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    Log.setColourScheme(LOG_COLOUR_SCHEME_ONBLACK);
+
+    INFO_MSG("Unit test", "Starting unit test...")
+
+    std::mt19937 Generator(42);
+    std::uniform_real_distribution<double> PosDist(-4.0e3, 4.0e3);
+    std::uniform_real_distribution<double> VelDist(-50.0, 50.0);
+    std::uniform_real_distribution<double> RadiusDist(10.0, 200.0);
+
+    // Place objects around cell boundaries to test for pairs across cells
+    ObjectsType Objects;
+    for (auto i=0; i<NUMBER_OF_OBJECTS; ++i)
+    {
+        CCircle* pCircle = new CCircle;
+        pCircle->setRadius(RadiusDist(Generator));
+
+        CObject* pObj = new CObject;
+        pObj->getGeometry()->addShape(pCircle);
+        pObj->setOrigin(Vector2d(PosDist(Generator) + (i % 2 ? DEFAULT_CELL_SIZE : -DEFAULT_CELL_SIZE),
+                                 PosDist(Generator)));
+        pObj->setVelocity(Vector2d(VelDist(Generator), VelDist(Generator)));
+        pObj->setCell(-(i % 2), 0);
+        pObj->setDepths(i % 5 == 0 ? 2 : 1);
+        pObj->init();
+        Objects[pObj->getUID()] = pObj;
+    }
+
+    CBroadPhase BroadPhase;
+    CTimer Timer;
+    double fTimeBroadPhase = 0.0;
+    double fTimeAll = 0.0;
+    double fSwapsFullSort = 0.0;
+    long   nSwaps = 0;
+    int    nCompared = 0;
+
+    INFO_MSG("Unit test", "Comparing broad phase with test of all pairs every " << COMPARE_EVERY <<
+                          " of " << NUMBER_OF_STEPS << " frames...")
+    for (auto i=0; i<NUMBER_OF_STEPS; ++i)
+    {
+        for (const auto& Obj : Objects)
+        {
+            Obj.second->dynamics(FRAME_STEP);
+            Obj.second->transform();
+        }
+
+        // Remove some objects to test removal of proxies
+        if (i % 10 == 5)
+        {
+            auto it = Objects.begin();
+            delete it->second;
+            Objects.erase(it);
+        }
+
+        Timer.start();
+        BroadPhase.update(&Objects);
+        Timer.stop();
+        fTimeBroadPhase += Timer.getTime();
+
+        // First frame sorts from scratch, count swaps of moving frames only
+        if (i > 0)
+        {
+            const double fNumberOfEndpoints = 2.0 * Objects.size();
+            nSwaps += BroadPhase.getNumberOfSwaps();
+            fSwapsFullSort += fNumberOfEndpoints * std::log2(fNumberOfEndpoints);
+        }
+
+        // Testing all pairs is slow in debug builds, only compare some frames
+        if (i % COMPARE_EVERY == 0)
+        {
+            Timer.start();
+            pairsAll(Objects);
+            Timer.stop();
+            fTimeAll += Timer.getTime();
+            ++nCompared;
+
+            if (!compare(BroadPhase, Objects))
+            {
+                ERROR_MSG("Unit test", "Broad phase differs from test of all pairs in frame " << i << ".")
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    INFO_MSG("Unit test", "Pairs: " << BroadPhase.getNumberOfPairs() << ", swaps: " <<
+                          double(nSwaps)/(NUMBER_OF_STEPS-1) << " per frame, full sort: " <<
+                          fSwapsFullSort/(NUMBER_OF_STEPS-1) << " per frame")
+    if (nSwaps == 0)
+    {
+        ERROR_MSG("Unit test", "No endpoints swapped although objects are moving.")
+        return EXIT_FAILURE;
+    }
+    if (nSwaps > 0.1 * fSwapsFullSort)
+    {
+        ERROR_MSG("Unit test", "Incremental sort of endpoints not well below full sort.")
+        return EXIT_FAILURE;
+    }
+    INFO_MSG("Unit test", "Broad phase: " << fTimeBroadPhase/NUMBER_OF_STEPS*1.0e3 << "ms, all pairs: " <<
+                          fTimeAll/nCompared*1.0e3 << "ms per frame")
+
+    for (const auto& Obj : Objects) delete Obj.second;
+
+    INFO_MSG("Unit test", "...done. Test successful.")
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,205 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       pw_unit_force_accumulator.cpp
+/// \brief      Unit test for multithreaded force accumulation
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-15
+///
+////////////////////////////////////////////////////////////////////////////////
+
+//--- Standard header --------------------------------------------------------//
+#include <array>
+#include <omp.h>
+#include <random>
+
+//--- Program header ---------------------------------------------------------//
+#include "circle.h"
+#include "force_accumulator.h"
+
+//--- Misc-Header ------------------------------------------------------------//
+
+const double G = 6.67408e-11;               ///< Gravitational constant
+const Vector2d GRAVITY_CONST(0.0, -9.81);   ///< Constant gravity
+
+typedef CSlotMap<UIDType, CObject*> ObjectsType;
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Calculates forces serially, directly applying them to objects
+///
+/// \param _Objects Objects
+///
+///////////////////////////////////////////////////////////////////////////////
+void forcesSerial(const ObjectsType& _Objects)
+{
+    METHOD_ENTRY("forcesSerial")
+
+    for (auto ci = _Objects.cbegin(); ci != _Objects.cend(); ++ci)
+    {
+        auto cj = ci;
+        ++cj;
+        while (cj != _Objects.cend())
+        {
+            Vector2d vecCC = ci->second->getCOM() - cj->second->getCOM() +
+                             IGridUser::cellToDouble(ci->second->getCell()-cj->second->getCell());
+            double fCCSqr = vecCC.squaredNorm();
+            if (fCCSqr > 400.0)
+            {
+                Vector2d vecG = vecCC.normalized() * (ci->second->getMass() * cj->second->getMass()) / fCCSqr * G;
+                ci->second->addForce(-vecG, ci->second->getCOM());
+                cj->second->addForce(vecG, cj->second->getCOM());
+            }
+            ++cj;
+        }
+        ci->second->addAcceleration(GRAVITY_CONST);
+    }
+    for (const auto& Obj : _Objects)
+        Obj.second->addForceLC(Vector2d(1.0e3, 0.0), Vector2d(1.0, 2.0));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Calculates forces using force accumulator
+///
+/// \param _Objects Objects
+/// \param _nWorkers Number of workers
+///
+///////////////////////////////////////////////////////////////////////////////
+void forcesAccumulated(const ObjectsType& _Objects, const int _nWorkers)
+{
+    METHOD_ENTRY("forcesAccumulated")
+
+    CForceAccumulator Forces;
+    Forces.setNumberOfWorkers(_nWorkers);
+    Forces.init(&_Objects);
+
+    const int nSize = Forces.size();
+
+    #pragma omp parallel for schedule(static, 1) num_threads(_nWorkers) if(_nWorkers > 1)
+    for (auto i=0; i<nSize; ++i)
+    {
+        const int nWorker = omp_get_thread_num();
+        CObject* pObjI = Forces.getObject(i);
+        for (auto j=i+1; j<nSize; ++j)
+        {
+            CObject* pObjJ = Forces.getObject(j);
+            Vector2d vecCC = pObjI->getCOM() - pObjJ->getCOM() +
+                             IGridUser::cellToDouble(pObjI->getCell()-pObjJ->getCell());
+            double fCCSqr = vecCC.squaredNorm();
+            if (fCCSqr > 400.0)
+            {
+                Vector2d vecG = vecCC.normalized() * (pObjI->getMass() * pObjJ->getMass()) / fCCSqr * G;
+                Forces.addForce(i, -vecG, pObjI->getCOM(), nWorker);
+                Forces.addForce(j,  vecG, pObjJ->getCOM(), nWorker);
+            }
+        }
+        Forces.addAcceleration(i, GRAVITY_CONST, nWorker);
+    }
+    for (const auto& Obj : _Objects)
+        Forces.addForceLC(Obj.second, Vector2d(1.0e3, 0.0), Vector2d(1.0, 2.0));
+
+    Forces.reduce();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Main function
+///
+/// This is the entrance point for program startup.
+///
+/// \return Exit code
+///
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    Log.setColourScheme(LOG_COLOUR_SCHEME_ONBLACK);
+
+    INFO_MSG("Unit test", "Starting unit test...")
+
+    std::mt19937 Generator(42);
+    std::uniform_real_distribution<double> PosDist(-1.0e6, 1.0e6);
+    std::uniform_real_distribution<double> MassDist(1.0e8, 1.0e12);
+
+    ObjectsType ObjectsSerial;
+    ObjectsType ObjectsParallel;
+    for (auto i=0; i<500; ++i)
+    {
+        const double fMass = MassDist(Generator);
+        const Vector2d vecOrigin(PosDist(Generator), PosDist(Generator));
+        const double fAngle = PosDist(Generator);
+
+        // Objects are created twice instead of cloned, since cloning doesn't
+        // copy the state of integrators
+        std::array<CObject*, 2> Objects;
+        for (auto& pObj : Objects)
+        {
+            CCircle* pCircle = new CCircle;
+            pCircle->setRadius(10.0);
+            pCircle->setMass(fMass);
+
+            pObj = new CObject;
+            pObj->getGeometry()->addShape(pCircle);
+            pObj->setOrigin(vecOrigin);
+            pObj->setCell(i % 3 - 1, i % 2);
+            pObj->setAngle(fAngle);
+            pObj->init();
+            pObj->clearForces();
+        }
+        ObjectsSerial[i] = Objects[0];
+        ObjectsParallel[i] = Objects[1];
+    }
+
+    INFO_MSG("Unit test", "Comparing serial force calculation with one worker...")
+    forcesSerial(ObjectsSerial);
+    forcesAccumulated(ObjectsParallel, 1);
+    for (const auto& Obj : ObjectsSerial)
+    {
+        const CObject* pObjP = ObjectsParallel[Obj.first];
+        if (Obj.second->getForce() != pObjP->getForce() ||
+            Obj.second->getTorque() != pObjP->getTorque())
+        {
+            ERROR_MSG("Unit test", "Force of single worker differs from serial calculation.")
+            return EXIT_FAILURE;
+        }
+    }
+
+    INFO_MSG("Unit test", "Comparing serial force calculation with four workers...")
+    for (const auto& Obj : ObjectsSerial) Obj.second->clearForces();
+    for (const auto& Obj : ObjectsParallel) Obj.second->clearForces();
+    forcesSerial(ObjectsSerial);
+    forcesAccumulated(ObjectsParallel, 4);
+    for (const auto& Obj : ObjectsSerial)
+    {
+        const CObject* pObjP = ObjectsParallel[Obj.first];
+        if ((Obj.second->getForce() - pObjP->getForce()).norm() > 1.0e-9 * Obj.second->getForce().norm() ||
+            std::abs(Obj.second->getTorque() - pObjP->getTorque()) > 1.0e-9 * std::abs(Obj.second->getTorque()) + 1.0e-9)
+        {
+            ERROR_MSG("Unit test", "Force of four workers differs from serial calculation.")
+            return EXIT_FAILURE;
+        }
+    }
+
+    INFO_MSG("Unit test", "...done. Test successful.")
+    return EXIT_SUCCESS;
+}
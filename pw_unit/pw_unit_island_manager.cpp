@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       pw_unit_island_manager.cpp
+/// \brief      Unit test for sleeping objects and islands
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+//--- Standard header --------------------------------------------------------//
+#include <list>
+
+//--- Program header ---------------------------------------------------------//
+#include "circle.h"
+#include "island_manager.h"
+#include "kinematics_store.h"
+#include "spring.h"
+
+//--- Misc-Header ------------------------------------------------------------//
+
+const double FRAME_STEP = 1.0/200.0;   ///< Time step of frames
+
+typedef CSlotMap<UIDType, CObject*> ObjectsType;
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Simulates given number of frames as done by physics manager
+///
+/// \param _Objects Objects
+/// \param _Joints Joints
+/// \param _Store Kinematics store of objects
+/// \param _Islands Island manager
+/// \param _vecForce External force
+/// \param _nFrames Number of frames
+/// \param _nObj Object the external force acts on
+///
+///////////////////////////////////////////////////////////////////////////////
+void simulate(const ObjectsType& _Objects, const std::list<IJoint*>& _Joints,
+              CKinematicsStore& _Store, CIslandManager& _Islands,
+              const Vector2d& _vecForce, const int _nFrames, const UIDType _nObj = 1u)
+{
+    METHOD_ENTRY("simulate")
+
+    for (auto i=0; i<_nFrames; ++i)
+    {
+        CForceAccumulator Forces;
+        Forces.init(&_Objects);
+        for (const auto pJoint : _Joints) pJoint->react(&Forces);
+        Forces.addForce(_Objects.at(_nObj), _vecForce, _Objects.at(_nObj)->getCOM());
+        Forces.reduce();
+
+        _Islands.update(Forces, _Joints);
+
+        _Store.integrate(FRAME_STEP);
+        for (auto j=0; j<_Store.size(); ++j)
+        {
+            CObject* const pObj = _Store.getObject(j);
+            if (pObj->isSleeping()) continue;
+            pObj->dynamics(FRAME_STEP);
+            pObj->transform();
+        }
+        for (const auto& Obj : _Objects) Obj.second->clearForces();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Main function
+///
+/// This is the entrance point for program startup.
+///
+/// \return Exit code
+///
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    Log.setColourScheme(LOG_COLOUR_SCHEME_ONBLACK);
+
+    INFO_MSG("Unit test", "Starting unit test...")
+
+    // Objects 0 and 1 are connected by a relaxed spring, object 2 is alone
+    ObjectsType Objects;
+    CKinematicsStore Store;
+    for (auto i=0; i<3; ++i)
+    {
+        CCircle* pCircle = new CCircle;
+        pCircle->setRadius(1.0);
+        pCircle->setMass(10.0);
+
+        CObject* pObj = new CObject;
+        pObj->setNewIntegrator(INTEGRATOR_ADAMS_BASHFORTH);
+        pObj->getGeometry()->addShape(pCircle);
+        pObj->setOrigin(Vector2d(10.0*i, 0.0));
+        pObj->init();
+        pObj->clearForces();
+        Store.add(pObj);
+        Objects[i] = pObj;
+    }
+    CSpring* pSpring = new CSpring;
+    pSpring->attachObjectA(Objects[0], Objects[0]->addAnchor(Vector2d::Zero()));
+    pSpring->attachObjectB(Objects[1], Objects[1]->addAnchor(Vector2d::Zero()));
+    pSpring->setC(100.0);
+    pSpring->setLength(10.0);
+    std::list<IJoint*> Joints = {pSpring};
+
+    CIslandManager Islands;
+    const int nFrames = Islands.getFrames();
+
+    INFO_MSG("Unit test", "Objects at rest fall asleep...")
+    simulate(Objects, Joints, Store, Islands, Vector2d::Zero(), nFrames-1);
+    if (Islands.getNumberOfSleeping() != 0)
+    {
+        ERROR_MSG("Unit test", "Objects fell asleep too early.")
+        return EXIT_FAILURE;
+    }
+    simulate(Objects, Joints, Store, Islands, Vector2d::Zero(), 2);
+    if (Islands.getNumberOfSleeping() != 3 || Islands.getNumberOfIslands() != 2)
+    {
+        ERROR_MSG("Unit test", "Expected 3 sleeping objects in 2 islands, got " <<
+                  Islands.getNumberOfSleeping() << " in " << Islands.getNumberOfIslands() << ".")
+        return EXIT_FAILURE;
+    }
+
+    INFO_MSG("Unit test", "Setting velocity wakes object, not islands of others...")
+    Objects[2]->setVelocity(Vector2d(1.0, 0.0));
+    simulate(Objects, Joints, Store, Islands, Vector2d::Zero(), 1);
+    if (Objects[2]->isSleeping() || !Objects[0]->isSleeping() || !Objects[1]->isSleeping() ||
+        Objects[2]->getOrigin()[0] <= 20.0)
+    {
+        ERROR_MSG("Unit test", "Only the moved object should be awake.")
+        return EXIT_FAILURE;
+    }
+
+    INFO_MSG("Unit test", "Changing forces wakes whole island...")
+    const Vector2d vecPos0 = Objects[0]->getCOM();
+    simulate(Objects, Joints, Store, Islands, Vector2d(10.0, 0.0), 1);
+    if (Objects[0]->isSleeping() || Objects[1]->isSleeping())
+    {
+        ERROR_MSG("Unit test", "Island should be woken by force on one of its objects.")
+        return EXIT_FAILURE;
+    }
+    simulate(Objects, Joints, Store, Islands, Vector2d(10.0, 0.0), 100);
+    if (Objects[0]->getCOM() == vecPos0)
+    {
+        ERROR_MSG("Unit test", "Woken object should be pulled by spring.")
+        return EXIT_FAILURE;
+    }
+
+    INFO_MSG("Unit test", "Disabling sleep wakes all objects...")
+    Islands.disable();
+    simulate(Objects, Joints, Store, Islands, Vector2d::Zero(), 1);
+    for (const auto& Obj : Objects)
+    {
+        if (Obj.second->isSleeping())
+        {
+            ERROR_MSG("Unit test", "Object still sleeping after disabling.")
+            return EXIT_FAILURE;
+        }
+    }
+
+    INFO_MSG("Unit test", "Weak constant acceleration prevents sleep...")
+    Islands.enable();
+    Objects[2]->setVelocity(Vector2d::Zero());
+    simulate(Objects, Joints, Store, Islands, Vector2d(0.2, 0.0), 2*nFrames, 2u);
+    if (Objects[2]->isSleeping() || Objects[2]->getRestFrames() != 0)
+    {
+        ERROR_MSG("Unit test", "Object fell asleep although accelerated.")
+        return EXIT_FAILURE;
+    }
+
+    while (Store.size() > 0) Store.remove(Store.size()-1);
+    for (const auto& Obj : Objects) delete Obj.second;
+    delete pSpring;
+
+    INFO_MSG("Unit test", "...done.")
+    return EXIT_SUCCESS;
+}
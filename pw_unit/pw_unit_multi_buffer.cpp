@@ -37,24 +37,108 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 //--- Standard header --------------------------------------------------------//
+#include <atomic>
 #include <cstdint>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
 //--- Program header ---------------------------------------------------------//
+#include "atomic_triple_buffer.h"
 #include "conf_pw.h"
 #include "multi_buffer.h"
+#include "timer.h"
 
 //--- Misc-Header ------------------------------------------------------------//
 
+const int    CONTENTION_FRAMES = 200000;  ///< Number of frames published by producer
+const int    CONTENTION_SIZE   = 256;     ///< Number of elements of each frame
+
 /// Data for unit tests
-class CObject
+class CObject : public ISerializable
 {
     public: 
         std::string strName = "";
         std::uint32_t nVal = 0;
+        
+        SERIALIZE_DECL
 };
 
+SERIALIZE_IMPL(CObject,
+    SERIALIZE("name", strName)
+    SERIALIZE("value", nVal)
+)
+
+/// Frame for contention test, all elements carry the frame number
+typedef std::vector<int> FrameType;
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Hands frames over from producer to consumer thread
+///
+/// Both threads run at full speed without ever blocking. The consumer checks
+/// that frames are complete, i.e. not torn by the producer, and that frame
+/// numbers are increasing.
+///
+/// \return Test successful?
+///
+///////////////////////////////////////////////////////////////////////////////
+bool testContention()
+{
+    METHOD_ENTRY("testContention")
+    
+    CAtomicTripleBuffer<FrameType> TripleBuffer;
+    for (auto i=0u; i<TripleBuffer.getBufferSize(); ++i)
+        TripleBuffer.getBufferByIndex(i)->assign(CONTENTION_SIZE, -1);
+    
+    std::atomic_bool bDone(false);
+    std::atomic_bool bValid(true);
+    int nFramesReceived = 0;
+    int nFramesFetched = 0;
+    
+    CTimer Timer;
+    Timer.start();
+    
+    std::thread Consumer([&]()
+    {
+        int nLast = -1;
+        while (true)
+        {
+            // Read flag before fetching, thus, the last frame is never missed
+            const bool bProducerDone = bDone.load();
+            if (TripleBuffer.swapFront())
+            {
+                const FrameType& Frame = *TripleBuffer.getBuffer<BUFFER_TRIPLE_FRONT>();
+                for (const auto nVal : Frame)
+                {
+                    if (nVal != Frame.front()) bValid = false;
+                }
+                if (Frame.front() <= nLast) bValid = false;
+                nLast = Frame.front();
+                ++nFramesReceived;
+            }
+            ++nFramesFetched;
+            if (bProducerDone) break;
+        }
+        if (nLast != CONTENTION_FRAMES-1) bValid = false;
+    });
+    
+    for (auto i=0; i<CONTENTION_FRAMES; ++i)
+    {
+        FrameType& Frame = *TripleBuffer.getBuffer<BUFFER_TRIPLE_BACK>();
+        for (auto& nVal : Frame) nVal = i;
+        TripleBuffer.swapBack();
+    }
+    bDone = true;
+    Consumer.join();
+    
+    Timer.stop();
+    
+    INFO_MSG("Unit test", "Published " << CONTENTION_FRAMES << " frames in " << Timer.getTime()*1.0e3 <<
+                          "ms, consumer received " << nFramesReceived << " in " << nFramesFetched << " attempts")
+    return bValid;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Main function
@@ -73,9 +157,9 @@ int main()
     INFO_MSG("Unit test", "Starting unit test...")
     INDENT()
     
-    CMultiBuffer<BUFFER_DOUBLE, CObject> DoubleBufferSingle;
-    CMultiBuffer<BUFFER_DOUBLE, std::vector<CObject>, CObject> DoubleBufferUnary;
-    CMultiBuffer<BUFFER_DOUBLE, std::unordered_map<std::string, CObject>, std::string, CObject> DoubleBufferBinary;
+    CMultiBuffer<BUFFER_DOUBLE, CObject*> DoubleBufferSingle;
+    CMultiBuffer<BUFFER_DOUBLE, std::vector<CObject*>, CObject*> DoubleBufferUnary;
+    CMultiBuffer<BUFFER_DOUBLE, std::unordered_map<std::string, CObject*>, std::string, CObject*> DoubleBufferBinary;
     
    
     CObject Obj0; Obj0.nVal=0; Obj0.strName="Obj0";
@@ -88,17 +172,17 @@ int main()
     INDENT()
     INFO_MSG("Unit test", "Insertion")
     
-    DoubleBufferSingle.add(Obj0);
+    DoubleBufferSingle.add(&Obj0);
     
-    DoubleBufferUnary.add(Obj0);
-    DoubleBufferUnary.add(Obj1);
-    DoubleBufferUnary.add(Obj2);
-    DoubleBufferUnary.add(Obj3);
+    DoubleBufferUnary.add(&Obj0);
+    DoubleBufferUnary.add(&Obj1);
+    DoubleBufferUnary.add(&Obj2);
+    DoubleBufferUnary.add(&Obj3);
     
-    DoubleBufferBinary.add(Obj0.strName, Obj0);
-    DoubleBufferBinary.add(Obj1.strName, Obj1);
-    DoubleBufferBinary.add(Obj2.strName, Obj2);
-    DoubleBufferBinary.add(Obj3.strName, Obj3);
+    DoubleBufferBinary.add(Obj0.strName, &Obj0);
+    DoubleBufferBinary.add(Obj1.strName, &Obj1);
+    DoubleBufferBinary.add(Obj2.strName, &Obj2);
+    DoubleBufferBinary.add(Obj3.strName, &Obj3);
     
     if (DoubleBufferSingle.getBufferSize() != 2u)
     {
@@ -134,35 +218,43 @@ int main()
     
     
     INFO_MSG("Unit test", "Swapping")
-    DoubleBufferSingle.swap(BUFFER_DOUBLE_BACK, BUFFER_DOUBLE_FRONT);
-    DoubleBufferUnary.swap(BUFFER_DOUBLE_BACK, BUFFER_DOUBLE_FRONT);
-    DoubleBufferBinary.swap(BUFFER_DOUBLE_BACK, BUFFER_DOUBLE_FRONT);
+    DoubleBufferSingle.swap<BUFFER_DOUBLE_BACK, BUFFER_DOUBLE_FRONT>();
+    DoubleBufferUnary.swap<BUFFER_DOUBLE_BACK, BUFFER_DOUBLE_FRONT>();
+    DoubleBufferBinary.swap<BUFFER_DOUBLE_BACK, BUFFER_DOUBLE_FRONT>();
     
 
-    if ((DoubleBufferSingle.getBuffer(BUFFER_DOUBLE_FRONT)->nVal != 0u) ||
-        (DoubleBufferSingle.getBuffer(BUFFER_DOUBLE_FRONT)->strName != "Obj0"))
+    if (((*DoubleBufferSingle.getBuffer<BUFFER_DOUBLE_FRONT>())->nVal != 0u) ||
+        ((*DoubleBufferSingle.getBuffer<BUFFER_DOUBLE_FRONT>())->strName != "Obj0"))
     {
         ERROR_MSG("Unit test", "DoubleBufferBinary has wrong entry.")
         return EXIT_FAILURE;
     }
-    if ((DoubleBufferUnary.getBuffer(BUFFER_DOUBLE_FRONT)->at(0).nVal != 0u) ||
-        (DoubleBufferUnary.getBuffer(BUFFER_DOUBLE_FRONT)->at(1).nVal != 1u) ||
-        (DoubleBufferUnary.getBuffer(BUFFER_DOUBLE_FRONT)->at(2).nVal != 2u) ||
-        (DoubleBufferUnary.getBuffer(BUFFER_DOUBLE_FRONT)->at(3).nVal != 3u))
+    if ((DoubleBufferUnary.getBuffer<BUFFER_DOUBLE_FRONT>()->at(0)->nVal != 0u) ||
+        (DoubleBufferUnary.getBuffer<BUFFER_DOUBLE_FRONT>()->at(1)->nVal != 1u) ||
+        (DoubleBufferUnary.getBuffer<BUFFER_DOUBLE_FRONT>()->at(2)->nVal != 2u) ||
+        (DoubleBufferUnary.getBuffer<BUFFER_DOUBLE_FRONT>()->at(3)->nVal != 3u))
     {
         ERROR_MSG("Unit test", "DoubleBufferBinary has wrong entry.")
         return EXIT_FAILURE;
     }
-    if ((DoubleBufferBinary.getBuffer(BUFFER_DOUBLE_FRONT)->at("Obj0").nVal != 0u) ||
-        (DoubleBufferBinary.getBuffer(BUFFER_DOUBLE_FRONT)->at("Obj1").nVal != 1u) ||
-        (DoubleBufferBinary.getBuffer(BUFFER_DOUBLE_FRONT)->at("Obj2").nVal != 2u) ||
-        (DoubleBufferBinary.getBuffer(BUFFER_DOUBLE_FRONT)->at("Obj3").nVal != 3u))
+    if ((DoubleBufferBinary.getBuffer<BUFFER_DOUBLE_FRONT>()->at("Obj0")->nVal != 0u) ||
+        (DoubleBufferBinary.getBuffer<BUFFER_DOUBLE_FRONT>()->at("Obj1")->nVal != 1u) ||
+        (DoubleBufferBinary.getBuffer<BUFFER_DOUBLE_FRONT>()->at("Obj2")->nVal != 2u) ||
+        (DoubleBufferBinary.getBuffer<BUFFER_DOUBLE_FRONT>()->at("Obj3")->nVal != 3u))
     {
         ERROR_MSG("Unit test", "DoubleBufferBinary has wrong entry.")
         return EXIT_FAILURE;
     }
     
     UNINDENT()
+    
+    INFO_MSG("Unit test", "Testing lock-free triple buffer under contention")
+    if (!testContention())
+    {
+        ERROR_MSG("Unit test", "Consumer received torn or outdated frames.")
+        return EXIT_FAILURE;
+    }
+    
     UNINDENT()
     INFO_MSG("Unit test", "...done. Test successful.")
     return EXIT_SUCCESS;
@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       pw_unit_multi_rate_scheduler.cpp
+/// \brief      Unit test for multi rate scheduling of physics classes
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+//--- Standard header --------------------------------------------------------//
+#include <cmath>
+
+//--- Program header ---------------------------------------------------------//
+#include "multi_rate_scheduler.h"
+
+//--- Misc-Header ------------------------------------------------------------//
+
+const double FRAME_FREQUENCY  = 200.0;  ///< Frequency of frames
+const int    NUMBER_OF_FRAMES = 2000;   ///< Number of frames, 10 seconds
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Main function
+///
+/// This is the entrance point for program startup.
+///
+/// \return Exit code
+///
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    Log.setColourScheme(LOG_COLOUR_SCHEME_ONBLACK);
+
+    INFO_MSG("Unit test", "Starting unit test...")
+
+    // Rates are integer divisors, non-integer ratios and faster than frames
+    const std::array<double, RATE_CLASS_NUMBER> Frequencies = {{200.0, 30.0, 60.0, 7.0, 1000.0}};
+
+    CMultiRateScheduler Scheduler;
+    for (auto i=0; i<RATE_CLASS_NUMBER; ++i)
+        Scheduler.setFrequency(static_cast<RateClassType>(i), Frequencies[i]);
+
+    std::array<double, RATE_CLASS_NUMBER> TimeStepped = {{0.0, 0.0, 0.0, 0.0, 0.0}};
+    std::array<int, RATE_CLASS_NUMBER> FramesSinceStep = {{0, 0, 0, 0, 0}};
+
+    // Forces accumulated every frame are averaged over the frames of a step,
+    // the resulting impulse has to match the one of stepping every frame
+    std::array<double, RATE_CLASS_NUMBER> ForceAccumulated = {{0.0, 0.0, 0.0, 0.0, 0.0}};
+    std::array<double, RATE_CLASS_NUMBER> ImpulsePending = {{0.0, 0.0, 0.0, 0.0, 0.0}};
+    std::array<double, RATE_CLASS_NUMBER> ImpulseExpected = {{0.0, 0.0, 0.0, 0.0, 0.0}};
+    std::array<double, RATE_CLASS_NUMBER> ImpulseStepped = {{0.0, 0.0, 0.0, 0.0, 0.0}};
+    double fTime = 0.0;
+
+    for (auto i=0; i<NUMBER_OF_FRAMES; ++i)
+    {
+        // Time scale changes in between, all classes have to follow
+        const double fTimeScale = (i < NUMBER_OF_FRAMES/2) ? 1.0 : 4.0;
+        Scheduler.advance(FRAME_FREQUENCY, fTimeScale);
+        fTime += 1.0/FRAME_FREQUENCY*fTimeScale;
+
+        // Forces are applied irregularly, e.g. by queued commands
+        const double fForce = (i % 3 == 0) ? 3.0 : 0.0;
+
+        for (auto j=0; j<RATE_CLASS_NUMBER; ++j)
+        {
+            const RateClassType Class = static_cast<RateClassType>(j);
+            ++FramesSinceStep[j];
+            ForceAccumulated[j] += fForce;
+            ImpulsePending[j] += fForce/FRAME_FREQUENCY*fTimeScale;
+            if (i == 0 && !Scheduler.isDue(Class))
+            {
+                ERROR_MSG("Unit test", "Class " << mapRateClassToString.at(Class) << " not due in first frame.")
+                return EXIT_FAILURE;
+            }
+            if (Scheduler.isDue(Class))
+            {
+                // Gaps between steps differ by one frame at most
+                const double fFrames = FRAME_FREQUENCY / std::min(Frequencies[j], FRAME_FREQUENCY);
+                if (i > 0 && (FramesSinceStep[j] < std::floor(fFrames) || FramesSinceStep[j] > std::ceil(fFrames)))
+                {
+                    ERROR_MSG("Unit test", "Class " << mapRateClassToString.at(Class) << " stepped after " <<
+                                           FramesSinceStep[j] << " frames.")
+                    return EXIT_FAILURE;
+                }
+                if (Scheduler.getNumberOfFramesStep(Class) != FramesSinceStep[j])
+                {
+                    ERROR_MSG("Unit test", "Class " << mapRateClassToString.at(Class) << " covers " <<
+                                           Scheduler.getNumberOfFramesStep(Class) << " instead of " <<
+                                           FramesSinceStep[j] << " frames.")
+                    return EXIT_FAILURE;
+                }
+                TimeStepped[j] += Scheduler.getStep(Class);
+                ImpulseStepped[j] += ForceAccumulated[j] / Scheduler.getNumberOfFramesStep(Class) *
+                                     Scheduler.getStep(Class);
+                ImpulseExpected[j] += ImpulsePending[j];
+                ForceAccumulated[j] = 0.0;
+                ImpulsePending[j] = 0.0;
+                FramesSinceStep[j] = 0;
+            }
+        }
+    }
+
+    for (auto j=0; j<RATE_CLASS_NUMBER; ++j)
+    {
+        const RateClassType Class = static_cast<RateClassType>(j);
+        const double fSteps = std::min(Frequencies[j], FRAME_FREQUENCY) * NUMBER_OF_FRAMES / FRAME_FREQUENCY;
+
+        INFO_MSG("Unit test", mapRateClassToString.at(Class) << ": " << Scheduler.getNumberOfSteps(Class) <<
+                              " steps, " << TimeStepped[j] << "s of " << fTime << "s stepped, impulse " <<
+                              ImpulseStepped[j] << " of " << ImpulseExpected[j])
+
+        if (std::abs(double(Scheduler.getNumberOfSteps(Class)) - fSteps) > 1.0)
+        {
+            ERROR_MSG("Unit test", "Class " << mapRateClassToString.at(Class) << " has wrong number of steps.")
+            return EXIT_FAILURE;
+        }
+        // Simulation time not yet stepped is less than one step at highest time scale
+        const double fPending = fTime - TimeStepped[j];
+        if (fPending < -1.0e-9 || fPending > 4.0 / std::min(Frequencies[j], FRAME_FREQUENCY) + 1.0e-9)
+        {
+            ERROR_MSG("Unit test", "Class " << mapRateClassToString.at(Class) << " lost simulation time.")
+            return EXIT_FAILURE;
+        }
+        // Only the step across the change of time scale deviates slightly
+        if (std::abs(ImpulseStepped[j] - ImpulseExpected[j]) > 1.0e-3 * ImpulseExpected[j])
+        {
+            ERROR_MSG("Unit test", "Class " << mapRateClassToString.at(Class) << " has wrong impulse.")
+            return EXIT_FAILURE;
+        }
+    }
+
+    INFO_MSG("Unit test", "...done. Test successful.")
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,202 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       pw_unit_particle_dynamics.cpp
+/// \brief      Unit test for parallel dynamics of particle chunks
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+//--- Standard header --------------------------------------------------------//
+#include <random>
+#include <thread>
+
+//--- Program header ---------------------------------------------------------//
+#include "particle_dynamics.h"
+#include "timer.h"
+
+//--- Misc-Header ------------------------------------------------------------//
+
+const int    NUMBER_OF_SYSTEMS = 20;        ///< Number of particle systems
+const int    NUMBER_OF_STEPS   = 200;       ///< Number of frames
+const int    CHUNK_SIZE        = 1000;      ///< Particles per chunk, small to get many chunks
+const double TIME_STEP         = 1.0/30.0;  ///< Time between two frames
+
+typedef CSlotMap<UIDType, CParticle*> ParticlesType;
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Compares two particle systems
+///
+/// \param _pA Particle system A
+/// \param _pB Particle system B
+///
+/// \return Identical?
+///
+///////////////////////////////////////////////////////////////////////////////
+bool compare(CParticle* const _pA, CParticle* const _pB)
+{
+    METHOD_ENTRY("compare")
+
+    if (_pA->getNumberOfParticles() != _pB->getNumberOfParticles() ||
+        _pA->getFirstSlot() != _pB->getFirstSlot())
+    {
+        return false;
+    }
+    if (_pA->getNumberOfParticles() > 0 &&
+        (_pA->getBoundingBox().getLowerLeft() != _pB->getBoundingBox().getLowerLeft() ||
+         _pA->getBoundingBox().getUpperRight() != _pB->getBoundingBox().getUpperRight()))
+    {
+        return false;
+    }
+    for (auto i=0; i<int(_pA->getNumberOfParticles()); ++i)
+    {
+        if (_pA->getPosition(i) != _pB->getPosition(i) ||
+            _pA->getPreviousPosition(i) != _pB->getPreviousPosition(i) ||
+            _pA->getVelocity(i) != _pB->getVelocity(i) ||
+            _pA->getAge(i) != _pB->getAge(i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Main function
+///
+/// This is the entrance point for program startup.
+///
+/// \return Exit code
+///
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    Log.setColourScheme(LOG_COLOUR_SCHEME_ONBLACK);
+
+    INFO_MSG("Unit test", "Starting unit test...")
+
+    std::mt19937 Generator(42);
+    std::uniform_real_distribution<double> PosDist(-1.0e3, 1.0e3);
+    std::uniform_real_distribution<double> VelDist(-10.0, 10.0);
+    std::uniform_int_distribution<int> NumberDist(10, 50000);
+
+    // Systems of different sizes and maximum ages, particles are generated
+    // every frame, thus live ranges wrap around and systems overflow
+    ParticlesType ParticlesSerial;
+    ParticlesType ParticlesParallel;
+    std::vector<std::pair<CParticle*, CParticle*>> Pairs;
+    std::vector<CParticle*> Copies;
+    for (auto i=0; i<NUMBER_OF_SYSTEMS; ++i)
+    {
+        CParticle* pParticle = new CParticle;
+        pParticle->setNumber(NumberDist(Generator));
+        pParticle->setMaxAge(0.5 + 0.25 * (i % 8));
+        pParticle->setForce(Vector2d(0.0, -9.81));
+
+        CParticle* pCopy = new CParticle(*pParticle);
+        ParticlesSerial[pParticle->getUID()] = pParticle;
+        ParticlesParallel[pCopy->getUID()] = pCopy;
+        Pairs.push_back({pParticle, pCopy});
+        Copies.push_back(new CParticle(*pParticle));
+    }
+
+    const int nWorkers = std::max(2u, std::thread::hardware_concurrency());
+    CParticleDynamics ParticleDynamics;
+    ParticleDynamics.setChunkSize(CHUNK_SIZE);
+    ParticleDynamics.setNumberOfWorkers(nWorkers);
+
+    CTimer Timer;
+    double fTimeSerial = 0.0;
+    double fTimeParallel = 0.0;
+    std::uniform_int_distribution<int> EmitDist(0, 2000);
+
+    INFO_MSG("Unit test", "Comparing " << nWorkers << " workers with serial dynamics over " << NUMBER_OF_STEPS << " frames...")
+    for (auto i=0; i<NUMBER_OF_STEPS; ++i)
+    {
+        for (const auto& Pair : Pairs)
+        {
+            const int nEmit = EmitDist(Generator);
+            for (auto j=0; j<nEmit; ++j)
+            {
+                const Vector2d vecP(PosDist(Generator), PosDist(Generator));
+                const Vector2d vecV(VelDist(Generator), VelDist(Generator));
+                Pair.first->generate(vecP, vecV);
+                Pair.second->generate(vecP, vecV);
+            }
+        }
+
+        Timer.start();
+        for (const auto& Particle : ParticlesSerial)
+            Particle.second->dynamics(TIME_STEP);
+        Timer.stop();
+        fTimeSerial += Timer.getTime();
+
+        Timer.start();
+        ParticleDynamics.dynamics(&ParticlesParallel, TIME_STEP);
+        Timer.stop();
+        fTimeParallel += Timer.getTime();
+
+        for (const auto& Pair : Pairs)
+        {
+            if (!compare(Pair.first, Pair.second))
+            {
+                ERROR_MSG("Unit test", "Parallel dynamics differ from serial dynamics in frame " << i << ".")
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    INFO_MSG("Unit test", "Chunks: " << ParticleDynamics.getNumberOfChunks())
+    INFO_MSG("Unit test", "Serial: " << fTimeSerial/NUMBER_OF_STEPS*1.0e3 << "ms, parallel: " <<
+                          fTimeParallel/NUMBER_OF_STEPS*1.0e3 << "ms per frame")
+
+    INFO_MSG("Unit test", "Copying changed systems like buffers...")
+    for (auto i=0u; i<Pairs.size(); ++i)
+    {
+        // Copies are outdated, wrapped live ranges are copied only
+        if (Copies[i]->getGeneration() == Pairs[i].first->getGeneration())
+        {
+            ERROR_MSG("Unit test", "Generation of changed system not increased.")
+            return EXIT_FAILURE;
+        }
+        *Copies[i] = *Pairs[i].first;
+        if (!compare(Copies[i], Pairs[i].first) ||
+            Copies[i]->getGeneration() != Pairs[i].first->getGeneration())
+        {
+            ERROR_MSG("Unit test", "Copy of live range differs from system.")
+            return EXIT_FAILURE;
+        }
+    }
+
+    for (const auto& Pair : Pairs)
+    {
+        delete Pair.first;
+        delete Pair.second;
+    }
+    for (const auto pCopy : Copies) delete pCopy;
+
+    INFO_MSG("Unit test", "...done. Test successful.")
+    return EXIT_SUCCESS;
+}
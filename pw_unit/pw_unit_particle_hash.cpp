@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       pw_unit_particle_hash.cpp
+/// \brief      Unit test for spatial hash of particles
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+//--- Standard header --------------------------------------------------------//
+#include <algorithm>
+#include <random>
+
+//--- Program header ---------------------------------------------------------//
+#include "particle_hash.h"
+#include "timer.h"
+
+//--- Misc-Header ------------------------------------------------------------//
+
+const int NUMBER_OF_SYSTEMS   = 10;     ///< Number of particle systems
+const int NUMBER_OF_PARTICLES = 20000;  ///< Number of particles per system
+const int NUMBER_OF_QUERIES   = 1000;   ///< Number of bounding boxes to query
+
+typedef CSlotMap<UIDType, CParticle*> ParticlesType;
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Finds active particles within bounding box by testing all particles
+///
+/// \param _Hash Hash, providing indices of particle systems
+/// \param _BBox Bounding box
+/// \param _Candidates Resulting particles, one index list per system
+///
+///////////////////////////////////////////////////////////////////////////////
+void queryAll(const CParticleHash& _Hash, const CBoundingBox& _BBox,
+              ParticleCandidatesType& _Candidates)
+{
+    METHOD_ENTRY("queryAll")
+
+    _Candidates.assign(_Hash.getNumberOfParticleSystems(), std::vector<int>());
+    for (auto i=0; i<_Hash.getNumberOfParticleSystems(); ++i)
+    {
+        CParticle* pParticle = _Hash.getParticleSystem(i);
+        for (auto j=0; j<int(pParticle->getNumberOfParticles()); ++j)
+        {
+            CBoundingBox BBox;
+            BBox.setCell(pParticle->getCell());
+            BBox.setLowerLeft(pParticle->getPosition(j));
+            BBox.setUpperRight(pParticle->getPosition(j));
+            if (_BBox.overlaps(BBox))
+                _Candidates[i].push_back(j);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Main function
+///
+/// This is the entrance point for program startup.
+///
+/// \return Exit code
+///
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    Log.setColourScheme(LOG_COLOUR_SCHEME_ONBLACK);
+
+    INFO_MSG("Unit test", "Starting unit test...")
+
+    std::mt19937 Generator(42);
+    std::uniform_real_distribution<double> PosDist(-2.0e3, 2.0e3);
+    std::uniform_real_distribution<double> VelDist(-5.0, 5.0);
+    std::uniform_real_distribution<double> SizeDist(1.0, 200.0);
+
+    // Half of the particle systems are located in the neighbouring cell, close
+    // to the cell border
+    ParticlesType Particles;
+    for (auto i=0; i<NUMBER_OF_SYSTEMS; ++i)
+    {
+        CParticle* pParticle = new CParticle;
+        pParticle->setNumber(NUMBER_OF_PARTICLES);
+        pParticle->setCell(i % 2, 0);
+        const double fOffset = (i % 2) ? -DEFAULT_CELL_SIZE : DEFAULT_CELL_SIZE;
+        for (auto j=0; j<NUMBER_OF_PARTICLES; ++j)
+        {
+            pParticle->generate(Vector2d(PosDist(Generator) + fOffset, PosDist(Generator)),
+                                Vector2d(VelDist(Generator), VelDist(Generator)));
+        }
+        pParticle->dynamics(1.0);
+        Particles[pParticle->getUID()] = pParticle;
+    }
+
+    CParticleHash Hash;
+    CTimer Timer;
+    Timer.start();
+    Hash.build(&Particles);
+    Timer.stop();
+    INFO_MSG("Unit test", "Hashed " << Hash.getNumberOfEntries() << " particles in " << Timer.getTime()*1.0e3 << "ms")
+
+    double fTimeHash = 0.0;
+    double fTimeAll = 0.0;
+    ParticleCandidatesType CandidatesHash;
+    ParticleCandidatesType CandidatesAll;
+    for (auto i=0; i<NUMBER_OF_QUERIES; ++i)
+    {
+        CBoundingBox BBox;
+        const Vector2d vecLL(PosDist(Generator) + DEFAULT_CELL_SIZE, PosDist(Generator));
+        BBox.setLowerLeft(vecLL);
+        BBox.setUpperRight(vecLL + Vector2d(SizeDist(Generator), SizeDist(Generator)));
+
+        Timer.start();
+        Hash.query(BBox, CandidatesHash);
+        Timer.stop();
+        fTimeHash += Timer.getTime();
+
+        Timer.start();
+        queryAll(Hash, BBox, CandidatesAll);
+        Timer.stop();
+        fTimeAll += Timer.getTime();
+
+        // Hash is conservative, all particles within the box must be found
+        for (auto j=0u; j<CandidatesAll.size(); ++j)
+        {
+            std::sort(CandidatesHash[j].begin(), CandidatesHash[j].end());
+            if (!std::includes(CandidatesHash[j].begin(), CandidatesHash[j].end(),
+                               CandidatesAll[j].begin(), CandidatesAll[j].end()))
+            {
+                ERROR_MSG("Unit test", "Particle within bounding box not found by spatial hash.")
+                return EXIT_FAILURE;
+            }
+            if (std::adjacent_find(CandidatesHash[j].begin(), CandidatesHash[j].end()) != CandidatesHash[j].end())
+            {
+                ERROR_MSG("Unit test", "Particle reported twice by spatial hash.")
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    INFO_MSG("Unit test", "Spatial hash: " << fTimeHash/NUMBER_OF_QUERIES*1.0e6 << "us, all particles: " <<
+                          fTimeAll/NUMBER_OF_QUERIES*1.0e6 << "us per query")
+
+    for (const auto& Particle : Particles) delete Particle.second;
+
+    INFO_MSG("Unit test", "...done. Test successful.")
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       pw_unit_pool.cpp
+/// \brief      Unit test for pooled allocation of buffered entities
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+//--- Standard header --------------------------------------------------------//
+#include <algorithm>
+#include <array>
+#include <set>
+#include <thread>
+#include <vector>
+
+//--- Program header ---------------------------------------------------------//
+#include "circle.h"
+#include "object.h"
+
+//--- Misc-Header ------------------------------------------------------------//
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Tests if given entities are placed in adjacent slots
+///
+/// \param _Entities Entities to be tested
+/// \param _nSlotSize Size of slots
+///
+/// \return Adjacent?
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class T>
+bool isAdjacent(const std::array<T*, BUFFER_QUADRUPLE>& _Entities, const std::size_t _nSlotSize)
+{
+    METHOD_ENTRY("isAdjacent")
+
+    const auto MinMax = std::minmax_element(_Entities.begin(), _Entities.end(),
+                                            [](const T* const _pA, const T* const _pB)
+                                            {return reinterpret_cast<std::uintptr_t>(_pA) <
+                                                    reinterpret_cast<std::uintptr_t>(_pB);});
+    return reinterpret_cast<std::uintptr_t>(*MinMax.second) -
+           reinterpret_cast<std::uintptr_t>(*MinMax.first) == (BUFFER_QUADRUPLE-1) * _nSlotSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Main function
+///
+/// This is the entrance point for program startup.
+///
+/// \return Exit code
+///
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    Log.setColourScheme(LOG_COLOUR_SCHEME_ONBLACK);
+
+    INFO_MSG("Unit test", "Starting unit test...")
+
+    INFO_MSG("Unit test", "Buffer copies are placed next to each other...")
+    std::vector<std::array<CObject*, BUFFER_QUADRUPLE>> Entities;
+    for (auto i=0; i<100; ++i)
+    {
+        CCircle* pCircle = new CCircle;
+        pCircle->setRadius(1.0);
+
+        CObject* pObj = new CObject;
+        pObj->getGeometry()->addShape(pCircle);
+        pObj->init();
+
+        Entities.push_back({{pObj->clone(), pObj->clone(), pObj->clone(), pObj}});
+    }
+    const std::size_t nSlotSizeObject = CObject::getPool().getStatistics().nSlotSize;
+    const std::size_t nSlotSizeCircle = CCircle::getPool().getStatistics().nSlotSize;
+    for (const auto& Copies : Entities)
+    {
+        std::array<CCircle*, BUFFER_QUADRUPLE> Circles;
+        for (auto i=0u; i<BUFFER_QUADRUPLE; ++i)
+            Circles[i] = static_cast<CCircle*>(Copies[i]->getGeometry()->getShapes().front().ptr());
+
+        if (!isAdjacent(Copies, nSlotSizeObject) || !isAdjacent(Circles, nSlotSizeCircle))
+        {
+            ERROR_MSG("Unit test", "Buffer copies are not adjacent.")
+            return EXIT_FAILURE;
+        }
+    }
+    if (CObject::getPool().getStatistics().nSlotsUsed != 400u ||
+        CCircle::getPool().getStatistics().nSlotsUsed != 400u)
+    {
+        ERROR_MSG("Unit test", "Expected 400 objects and shapes in use.")
+        return EXIT_FAILURE;
+    }
+
+    INFO_MSG("Unit test", "Copying buffers keeps shapes in place...")
+    for (const auto& Copies : Entities)
+    {
+        const IShape* const pShape = Copies[0]->getGeometry()->getShapes().front().ptr();
+        *Copies[0] = *Copies[3];
+        if (Copies[0]->getGeometry()->getShapes().front().ptr() != pShape)
+        {
+            ERROR_MSG("Unit test", "Shape of copy moved to another slot.")
+            return EXIT_FAILURE;
+        }
+    }
+    if (CCircle::getPool().getStatistics().nSlotsUsed != 400u)
+    {
+        ERROR_MSG("Unit test", "Expected 400 shapes in use after copying.")
+        return EXIT_FAILURE;
+    }
+
+    INFO_MSG("Unit test", "Objects not allocated by pool are cloned...")
+    {
+        CObject Obj;
+        CObject* pClone = Obj.clone();
+        delete pClone;
+    }
+
+    INFO_MSG("Unit test", "Freed overflow groups are not taken by neighbours...")
+    {
+        // Fill the group of an object and let one more copy overflow
+        CObject* pObj = new CObject;
+        std::vector<CObject*> Copies{pObj};
+        for (auto i=1u; i<BUFFER_QUADRUPLE; ++i) Copies.push_back(pObj->clone());
+        CObject* pOverflow = pObj->clone();
+        delete pOverflow;
+
+        // Overflow group is free now, neighbours filling it and regular
+        // allocations must not share it
+        for (auto i=0u; i<BUFFER_QUADRUPLE; ++i) Copies.push_back(pObj->clone());
+        for (auto i=0; i<2*BUFFER_QUADRUPLE; ++i) Copies.push_back(new CObject);
+
+        std::set<CObject*> Unique(Copies.begin(), Copies.end());
+        if (Unique.size() != Copies.size() ||
+            CObject::getPool().getStatistics().nSlotsUsed != Copies.size() + 400u)
+        {
+            ERROR_MSG("Unit test", "Slot of overflow group allocated twice.")
+            return EXIT_FAILURE;
+        }
+        for (auto pCopy : Copies) delete pCopy;
+    }
+
+    INFO_MSG("Unit test", "Freed groups are recycled...")
+    const std::size_t nSlots = CObject::getPool().getStatistics().nSlots;
+    for (auto& Copies : Entities)
+    {
+        for (auto pObj : Copies) delete pObj;
+    }
+    Entities.clear();
+    if (CObject::getPool().getStatistics().nSlotsUsed != 0u ||
+        CCircle::getPool().getStatistics().nSlotsUsed != 0u)
+    {
+        ERROR_MSG("Unit test", "Expected all slots to be freed.")
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::thread> Threads;
+    for (auto t=0; t<4; ++t)
+    {
+        Threads.emplace_back([]()
+        {
+            for (auto i=0; i<1000; ++i)
+            {
+                CObject* pObj = new CObject;
+                CObject* pClone = pObj->clone();
+                delete pObj;
+                delete pClone;
+            }
+        });
+    }
+    for (auto& Thread : Threads) Thread.join();
+    if (CObject::getPool().getStatistics().nSlots != nSlots ||
+        CObject::getPool().getStatistics().nSlotsUsed != 0u)
+    {
+        ERROR_MSG("Unit test", "Pool grew although groups were free.")
+        return EXIT_FAILURE;
+    }
+
+    DOM_STATS(DEBUG_MSG("Unit test", "Pool statistics:\n" << IPool::getStatisticsAll()))
+
+    INFO_MSG("Unit test", "...done.")
+    return EXIT_SUCCESS;
+}
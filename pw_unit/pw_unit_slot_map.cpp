@@ -0,0 +1,206 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       pw_unit_slot_map.cpp
+/// \brief      Unit test for generational slot map
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+//--- Standard header --------------------------------------------------------//
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+//--- Program header ---------------------------------------------------------//
+#include "slot_map.h"
+
+//--- Misc-Header ------------------------------------------------------------//
+
+typedef CSlotMap<std::uint32_t, double*> SlotMapType; ///< Slot map as used for entities
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Tests if all elements are found by key and handle
+///
+/// \param _SlotMap Slot map to be tested
+///
+/// \return Consistent?
+///
+////////////////////////////////////////////////////////////////////////////////
+bool isConsistent(const SlotMapType& _SlotMap)
+{
+    METHOD_ENTRY("isConsistent")
+
+    for (const auto& Elem : _SlotMap)
+    {
+        const auto ci = _SlotMap.find(Elem.first);
+        if (ci == _SlotMap.end() || ci->second != Elem.second) return false;
+
+        const auto ppVal = _SlotMap.get(_SlotMap.getHandle(Elem.first));
+        if (ppVal == nullptr || *ppVal != Elem.second) return false;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Main function
+///
+/// This is the entrance point for program startup.
+///
+/// \return Exit code
+///
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    Log.setColourScheme(LOG_COLOUR_SCHEME_ONBLACK);
+
+    INFO_MSG("Unit test", "Starting unit test...")
+
+    std::vector<double> Values(1000, 0.0);
+
+    INFO_MSG("Unit test", "Elements are inserted once and found...")
+    SlotMapType SlotMap;
+    for (auto i=0u; i<Values.size(); ++i)
+    {
+        if (!SlotMap.insert({i+1u, &Values[i]}).second)
+        {
+            ERROR_MSG("Unit test", "Element not inserted.")
+            return EXIT_FAILURE;
+        }
+    }
+    if (SlotMap.insert({1u, nullptr}).second || SlotMap.at(1u) != &Values[0] ||
+        SlotMap.size() != Values.size() || !isConsistent(SlotMap))
+    {
+        ERROR_MSG("Unit test", "Elements not stored as expected.")
+        return EXIT_FAILURE;
+    }
+
+    INFO_MSG("Unit test", "Handles of removed elements are outdated...")
+    std::vector<SlotMapHandleType> Handles;
+    for (auto i=1u; i<=Values.size(); i+=2u)
+    {
+        Handles.push_back(SlotMap.getHandle(i));
+        SlotMap.erase(i);
+    }
+    for (const auto nHandle : Handles)
+    {
+        if (SlotMap.isValid(nHandle) || SlotMap.get(nHandle) != nullptr)
+        {
+            ERROR_MSG("Unit test", "Handle of removed element still valid.")
+            return EXIT_FAILURE;
+        }
+    }
+    if (SlotMap.size() != Values.size()/2 || SlotMap.count(1u) != 0u || !isConsistent(SlotMap) ||
+        SlotMap.isValid(SLOT_MAP_HANDLE_INVALID))
+    {
+        ERROR_MSG("Unit test", "Elements not removed as expected.")
+        return EXIT_FAILURE;
+    }
+
+    INFO_MSG("Unit test", "Reused slots do not revive outdated handles...")
+    for (auto i=1u; i<=Values.size(); i+=2u)
+    {
+        SlotMap[i+Values.size()] = &Values[i-1];
+    }
+    for (const auto nHandle : Handles)
+    {
+        if (SlotMap.isValid(nHandle))
+        {
+            ERROR_MSG("Unit test", "Handle of removed element valid after reusing slot.")
+            return EXIT_FAILURE;
+        }
+    }
+    if (SlotMap.size() != Values.size() || !isConsistent(SlotMap))
+    {
+        ERROR_MSG("Unit test", "Elements not stored as expected after reusing slots.")
+        return EXIT_FAILURE;
+    }
+
+    INFO_MSG("Unit test", "Equal operations result in equal order and handles...")
+    SlotMapType SlotMapCopy;
+    for (auto i=0u; i<Values.size(); ++i) SlotMapCopy.insert({i+1u, &Values[i]});
+    for (auto i=1u; i<=Values.size(); i+=2u) SlotMapCopy.erase(i);
+    for (auto i=1u; i<=Values.size(); i+=2u) SlotMapCopy[i+Values.size()] = &Values[i-1];
+    auto itCopy = SlotMapCopy.begin();
+    for (const auto& Elem : SlotMap)
+    {
+        if (itCopy->first != Elem.first || SlotMapCopy.getHandle(itCopy->first) != SlotMap.getHandle(Elem.first))
+        {
+            ERROR_MSG("Unit test", "Order or handles differ.")
+            return EXIT_FAILURE;
+        }
+        ++itCopy;
+    }
+
+    INFO_MSG("Unit test", "Removing while iterating visits all elements...")
+    auto nVisited = 0u;
+    for (auto it = SlotMap.begin(); it != SlotMap.end();)
+    {
+        ++nVisited;
+        it = SlotMap.erase(it);
+    }
+    if (nVisited != Values.size() || !SlotMap.empty())
+    {
+        ERROR_MSG("Unit test", "Not all elements removed.")
+        return EXIT_FAILURE;
+    }
+
+    INFO_MSG("Unit test", "Comparing iteration with hash map...")
+    {
+        using namespace std::chrono;
+
+        std::vector<double> ValuesLarge(100000, 1.0);
+        std::unordered_map<std::uint32_t, double*> HashMap;
+        SlotMapType SlotMapLarge;
+        for (auto i=0u; i<ValuesLarge.size(); ++i)
+        {
+            HashMap.insert({i+1u, &ValuesLarge[i]});
+            SlotMapLarge.insert({i+1u, &ValuesLarge[i]});
+        }
+
+        double fSumHashMap = 0.0;
+        double fSumSlotMap = 0.0;
+        auto Start = steady_clock::now();
+        for (auto i=0; i<100; ++i)
+            for (const auto& Elem : HashMap) fSumHashMap += *Elem.second;
+        const double fTimeHashMap = duration_cast<duration<double>>(steady_clock::now() - Start).count();
+        Start = steady_clock::now();
+        for (auto i=0; i<100; ++i)
+            for (const auto& Elem : SlotMapLarge) fSumSlotMap += *Elem.second;
+        const double fTimeSlotMap = duration_cast<duration<double>>(steady_clock::now() - Start).count();
+
+        if (fSumHashMap != fSumSlotMap)
+        {
+            ERROR_MSG("Unit test", "Iterations differ.")
+            return EXIT_FAILURE;
+        }
+        INFO_MSG("Unit test", "Iteration hash map: " << fTimeHashMap*1.0e3 << "ms, slot map: " <<
+                              fTimeSlotMap*1.0e3 << "ms")
+    }
+
+    INFO_MSG("Unit test", "...done.")
+    return EXIT_SUCCESS;
+}
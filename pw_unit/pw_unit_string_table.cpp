@@ -0,0 +1,147 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       pw_unit_string_table.cpp
+/// \brief      Unit test for interned strings
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+//--- Standard header --------------------------------------------------------//
+#include <chrono>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+//--- Program header ---------------------------------------------------------//
+#include "string_table.h"
+
+//--- Misc-Header ------------------------------------------------------------//
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Main function
+///
+/// This is the entrance point for program startup.
+///
+/// \return Exit code
+///
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    Log.setColourScheme(LOG_COLOUR_SCHEME_ONBLACK);
+
+    INFO_MSG("Unit test", "Starting unit test...")
+
+    INFO_MSG("Unit test", "Equal strings are interned once...")
+    const StringIDType nWorld = CStringTable::intern("world");
+    const StringIDType nFont = CStringTable::intern("font");
+    if (nWorld == STRING_ID_INVALID || nWorld == nFont ||
+        CStringTable::intern(std::string("wor")+"ld") != nWorld ||
+        CStringTable::getString(nWorld) != "world" || CStringTable::getNumberOfStrings() != 2u)
+    {
+        ERROR_MSG("Unit test", "Strings not interned as expected.")
+        return EXIT_FAILURE;
+    }
+
+    INFO_MSG("Unit test", "Unknown strings are not found...")
+    if (CStringTable::find("lights") != STRING_ID_INVALID || CStringTable::find("font") != nFont ||
+        CStringTable::intern("") != STRING_ID_INVALID || CStringTable::getString(STRING_ID_INVALID) != "" ||
+        CStringTable::getNumberOfStrings() != 2u)
+    {
+        ERROR_MSG("Unit test", "Lookup without interning failed.")
+        return EXIT_FAILURE;
+    }
+
+    INFO_MSG("Unit test", "Concurrent interning results in unique IDs...")
+    std::vector<std::vector<StringIDType>> IDs(4);
+    std::vector<std::thread> Threads;
+    for (auto t=0u; t<IDs.size(); ++t)
+    {
+        Threads.emplace_back([t, &IDs]()
+        {
+            for (auto i=0; i<1000; ++i)
+                IDs[t].push_back(CStringTable::intern("Obj_" + std::to_string(i)));
+        });
+    }
+    for (auto& Thread : Threads) Thread.join();
+    for (auto t=1u; t<IDs.size(); ++t)
+    {
+        if (IDs[t] != IDs[0])
+        {
+            ERROR_MSG("Unit test", "Threads interned equal strings with different IDs.")
+            return EXIT_FAILURE;
+        }
+    }
+    for (auto i=0u; i<IDs[0].size(); ++i)
+    {
+        if (CStringTable::getString(IDs[0][i]) != "Obj_" + std::to_string(i))
+        {
+            ERROR_MSG("Unit test", "Interned string does not match its ID.")
+            return EXIT_FAILURE;
+        }
+    }
+    if (CStringTable::getNumberOfStrings() != 1002u)
+    {
+        ERROR_MSG("Unit test", "Expected 1002 interned strings.")
+        return EXIT_FAILURE;
+    }
+
+    INFO_MSG("Unit test", "Comparing lookup by name and by ID...")
+    {
+        using namespace std::chrono;
+
+        std::unordered_map<std::string, int> ByName;
+        std::unordered_map<StringIDType, int> ByID;
+        for (auto i=0u; i<IDs[0].size(); ++i)
+        {
+            ByName["Obj_" + std::to_string(i)] = i;
+            ByID[IDs[0][i]] = i;
+        }
+        std::vector<std::string> Names;
+        for (const auto nID : IDs[0]) Names.push_back(CStringTable::getString(nID));
+
+        long nSumByName = 0;
+        long nSumByID = 0;
+        auto Start = steady_clock::now();
+        for (auto i=0; i<100; ++i)
+            for (const auto& strName : Names) nSumByName += ByName.find(strName)->second;
+        const double fTimeByName = duration_cast<duration<double>>(steady_clock::now() - Start).count();
+        Start = steady_clock::now();
+        for (auto i=0; i<100; ++i)
+            for (const auto nID : IDs[0]) nSumByID += ByID.find(nID)->second;
+        const double fTimeByID = duration_cast<duration<double>>(steady_clock::now() - Start).count();
+
+        if (nSumByName != nSumByID)
+        {
+            ERROR_MSG("Unit test", "Lookups differ.")
+            return EXIT_FAILURE;
+        }
+        INFO_MSG("Unit test", "Lookup by name: " << fTimeByName*1.0e3 << "ms, by ID: " <<
+                              fTimeByID*1.0e3 << "ms")
+    }
+
+    INFO_MSG("Unit test", "...done.")
+    return EXIT_SUCCESS;
+}
@@ -37,6 +37,10 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 //--- Standard header --------------------------------------------------------//
+#include <chrono>
+#include <set>
+#include <thread>
+#include <vector>
 
 //--- Program header ---------------------------------------------------------//
 #include "conf_pw.h"
@@ -313,8 +317,82 @@ int main()
         ERROR_MSG("Unit test", "Incorrect default string (uid12=" << UID12.getName() << ")")
         return EXIT_FAILURE;
     }
-    
- 
+    // Test reservation of IDs, reserved IDs are referenced right away
+    {
+        CUID::reserve(10u);
+        outputInternalUIDData("10x Reserved");
+        const auto nReferenced = CUID::getReferencedUIDs().size();
+        if (CUID::getNumberOfReserved() != 10u)
+        {
+            ERROR_MSG("Unit test", "Incorrect number of reserved uids (" << CUID::getNumberOfReserved() << ")")
+            return EXIT_FAILURE;
+        }
+        CUID UID14;
+        CUID UID15;
+        outputInternalUIDData("2x Constructor");
+        if (CUID::getNumberOfReserved() != 8u || CUID::getReferencedUIDs().size() != nReferenced)
+        {
+            ERROR_MSG("Unit test", "Reserved uids not used (reserved=" << CUID::getNumberOfReserved() << ")")
+            return EXIT_FAILURE;
+        }
+        CUID::unreserve();
+        outputInternalUIDData("8x Unreserved");
+        if (CUID::getNumberOfReserved() != 0u || CUID::getReferencedUIDs().size() != nReferenced-8u)
+        {
+            ERROR_MSG("Unit test", "Reserved uids not released (reserved=" << CUID::getNumberOfReserved() << ")")
+            return EXIT_FAILURE;
+        }
+    }
+    // Benchmark allocation by multiple threads, IDs still have to be unique
+    {
+        const auto nReferenced = CUID::getReferencedUIDs().size();
+        const auto nThreads = 4u;
+        const auto nUIDs = 1000u;
+        const auto nRounds = 100u;
+        
+        // UIDs are kept alive after threads finished to check uniqueness
+        {
+            std::vector<std::vector<CUID>> UIDsByThread(nThreads);
+            std::vector<std::thread> Threads;
+            const auto Start = std::chrono::steady_clock::now();
+            for (auto t=0u; t<nThreads; ++t)
+            {
+                Threads.emplace_back([&UIDsByThread, t]()
+                {
+                    std::vector<CUID>& UIDs = UIDsByThread[t];
+                    UIDs.resize(nUIDs);
+                    for (auto i=0u; i<nRounds; ++i)
+                    {
+                        for (auto& UID : UIDs)
+                        {
+                            CUID UIDCopy(UID);
+                            UID.setNewID();
+                        }
+                    }
+                });
+            }
+            for (auto& Thread : Threads) Thread.join();
+            const double fTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+            INFO_MSG("Unit test", nThreads << " threads: " << nThreads*nUIDs*nRounds/fTime << " allocations/s")
+            
+            std::set<UIDType> UIDsAll;
+            for (const auto& UIDs : UIDsByThread)
+                for (const auto& UID : UIDs)
+                    UIDsAll.insert(UID.getValue());
+            if (UIDsAll.size() != nThreads*nUIDs)
+            {
+                ERROR_MSG("Unit test", "Uids allocated by different threads not unique (" << UIDsAll.size() << ")")
+                return EXIT_FAILURE;
+            }
+        }
+        if (CUID::getReferencedUIDs().size() != nReferenced)
+        {
+            ERROR_MSG("Unit test", "Uids of threads not released (" << CUID::getReferencedUIDs().size() << ")")
+            return EXIT_FAILURE;
+        }
+    }
+
+
     INFO_MSG("Unit test", "...done. Test successful.")
     return EXIT_SUCCESS;
 }
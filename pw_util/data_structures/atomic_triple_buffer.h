@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       atomic_triple_buffer.h
+/// \brief      Prototype of class "CAtomicTripleBuffer"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ATOMIC_TRIPLE_BUFFER_H
+#define ATOMIC_TRIPLE_BUFFER_H
+
+//--- Standard header --------------------------------------------------------//
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+//--- Program header ---------------------------------------------------------//
+#include "log.h"
+#include "multi_buffer.h"
+
+//--- Constants --------------------------------------------------------------//
+constexpr std::uint8_t ATOMIC_TRIPLE_BUFFER_INDEX_MASK = 0x03u; ///< Bits of state storing index of middle buffer
+constexpr std::uint8_t ATOMIC_TRIPLE_BUFFER_NEW_BIT    = 0x04u; ///< Bit of state indicating new data in middle buffer
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Lock-free triple buffer for one producer and one consumer
+///
+/// Unlike \ref CMultiBuffer, buffers are not swapped by the caller under a
+/// lock. The producer owns the back buffer, the consumer owns the front
+/// buffer, and the middle buffer is handed over by atomically exchanging its
+/// index. The index of the middle buffer and a bit indicating new data are
+/// packed into the same atomic word, thus, neither side ever blocks or
+/// waits for the other.
+///
+/// The producer fills its back buffer and publishes it by \ref swapBack. The
+/// consumer fetches the latest published buffer by \ref swapFront, frames
+/// published in between are dropped.
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class T>
+class CAtomicTripleBuffer
+{
+
+    public:
+
+        //--- Constructor/Destructor -----------------------------------------//
+        CAtomicTripleBuffer();
+
+        //--- Constant methods -----------------------------------------------//
+        std::uint8_t    getBufferSize() const {return BUFFER_TRIPLE;}
+        bool            isNew() const;
+
+        //--- Methods --------------------------------------------------------//
+        template<std::uint8_t I>
+        T*              getBuffer();
+        T*              getBufferByIndex(const std::uint8_t);
+
+        void            swapBack();
+        bool            swapFront();
+
+    private:
+
+        //--- Variables [private] --------------------------------------------//
+        std::array<T, BUFFER_TRIPLE>    m_Buffer;       ///< Buffers
+        std::atomic<std::uint8_t>       m_nState;       ///< Index of middle buffer and new data bit
+        std::uint8_t                    m_nBack;        ///< Index of back buffer, owned by producer
+        std::uint8_t                    m_nFront;       ///< Index of front buffer, owned by consumer
+};
+
+//--- Implementation is done here for inline optimisation --------------------//
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Constructor, initialising indices
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class T>
+CAtomicTripleBuffer<T>::CAtomicTripleBuffer() : m_nState(BUFFER_TRIPLE_MIDDLE),
+                                                 m_nBack(BUFFER_TRIPLE_BACK),
+                                                 m_nFront(BUFFER_TRIPLE_FRONT)
+{
+    METHOD_ENTRY("CAtomicTripleBuffer::CAtomicTripleBuffer")
+    CTOR_CALL("CAtomicTripleBuffer::CAtomicTripleBuffer")
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns if the middle buffer holds data not fetched by the consumer
+///
+/// \return New data available?
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class T>
+inline bool CAtomicTripleBuffer<T>::isNew() const
+{
+    METHOD_ENTRY("CAtomicTripleBuffer::isNew")
+    return (m_nState.load(std::memory_order_relaxed) & ATOMIC_TRIPLE_BUFFER_NEW_BIT) != 0u;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns buffer
+///
+/// Only front and back buffer are accessible, the middle buffer is owned by
+/// neither side. The back buffer may only be accessed by the producer, the
+/// front buffer only by the consumer.
+///
+/// \return Buffer
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class T>
+template<std::uint8_t I>
+inline T* CAtomicTripleBuffer<T>::getBuffer()
+{
+    METHOD_ENTRY("CAtomicTripleBuffer::getBuffer")
+    static_assert(I == BUFFER_TRIPLE_FRONT || I == BUFFER_TRIPLE_BACK,
+                  "Only front and back buffer are accessible.");
+    return &m_Buffer[I == BUFFER_TRIPLE_BACK ? m_nBack : m_nFront];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns buffer by its fixed index, regardless of its current role
+///
+/// This is meant for initialisation and cleanup while neither producer nor
+/// consumer are running.
+///
+/// \param _nIndex Fixed index of buffer
+///
+/// \return Buffer
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class T>
+inline T* CAtomicTripleBuffer<T>::getBufferByIndex(const std::uint8_t _nIndex)
+{
+    METHOD_ENTRY("CAtomicTripleBuffer::getBufferByIndex")
+    return &m_Buffer[_nIndex];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Publishes back buffer, producer continues with former middle buffer
+///
+/// Release semantics make all writes to the back buffer visible to the
+/// consumer fetching it.
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class T>
+inline void CAtomicTripleBuffer<T>::swapBack()
+{
+    METHOD_ENTRY("CAtomicTripleBuffer::swapBack")
+    const std::uint8_t nState = m_nState.exchange(m_nBack | ATOMIC_TRIPLE_BUFFER_NEW_BIT,
+                                                  std::memory_order_acq_rel);
+    m_nBack = nState & ATOMIC_TRIPLE_BUFFER_INDEX_MASK;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Fetches latest published buffer as front buffer, if any
+///
+/// \return New front buffer?
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class T>
+inline bool CAtomicTripleBuffer<T>::swapFront()
+{
+    METHOD_ENTRY("CAtomicTripleBuffer::swapFront")
+    if (!this->isNew()) return false;
+
+    const std::uint8_t nState = m_nState.exchange(m_nFront, std::memory_order_acq_rel);
+    m_nFront = nState & ATOMIC_TRIPLE_BUFFER_INDEX_MASK;
+    return true;
+}
+
+#endif // ATOMIC_TRIPLE_BUFFER_H
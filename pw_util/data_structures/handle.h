@@ -32,8 +32,10 @@
 #define HANDLE_H
 
 //--- Standard header --------------------------------------------------------//
+#include <string>
 
 //--- Program header ---------------------------------------------------------//
+#include "slot_map.h"
 #include "uid.h"
 
 //--- Misc header ------------------------------------------------------------//
@@ -42,6 +44,11 @@
 ///
 /// \brief Interface for classes that refer to an unique id.
 ///
+/// Besides the pointer and UID of the referred entity, the handle might
+/// store the handle of the entity within the \ref CSlotMap it is stored in.
+/// Resolving the handle by the slot map returns nullptr once the entity was
+/// removed, while the plain pointer would dangle.
+///
 ////////////////////////////////////////////////////////////////////////////////
 template <class T>
 class CHandle
@@ -50,29 +57,32 @@ class CHandle
     public:
         
         //--- Constructor/Destructor -----------------------------------------//
-        CHandle() : m_strName("UID_0"), m_UID(0u), m_pRef(nullptr){}
+        CHandle() : m_nHandle(SLOT_MAP_HANDLE_INVALID), m_UID(0u), m_pRef(nullptr){}
         CHandle(T* _pT) {this->set(_pT);}
+        CHandle(T* _pT, const SlotMapHandleType _nHandle) {this->set(_pT, _nHandle);}
    
         //--- Operators ------------------------------------------------------//
         T* operator->() const {return this->ptr();}
         T& operator*() {return *m_pRef;}
    
         //--- Constant Methods -----------------------------------------------//
-        const std::string&  getName() const;
+        SlotMapHandleType   getHandle() const;
+        std::string         getName() const;
         UIDType             getUID() const;
         bool                isValid() const;
         T*                  ptr() const;
+        T*                  resolve(const CSlotMap<UIDType, T*>&) const;
         
         //--- Methods --------------------------------------------------------//
-        void set(T* const);
+        void set(T* const, const SlotMapHandleType = SLOT_MAP_HANDLE_INVALID);
         void setPtr(T* const _pPtr) {m_pRef = _pPtr;}
         
     private:
         
         //--- Variables [protected] ------------------------------------------//
-        std::string     m_strName;    ///< Reference to named uid
-        UIDType         m_UID;        ///< Reference to unique identifier 
-        T*              m_pRef;       ///< Pointer reference to UID user
+        SlotMapHandleType   m_nHandle;  ///< Handle of UID user in slot map, if stored in one
+        UIDType             m_UID;      ///< Reference to unique identifier 
+        T*                  m_pRef;     ///< Pointer reference to UID user
 };
 
 //--- Implementation is done here for inline optimisation --------------------//
@@ -82,29 +92,46 @@ class CHandle
 /// \brief Sets handle
 ///
 /// \param _pRef Reference of this handle
+/// \param _nHandle Handle of reference in slot map, if stored in one
 ///
 ////////////////////////////////////////////////////////////////////////////////
 template <class T>
-inline void CHandle<T>::set(T* const _pRef)
+inline void CHandle<T>::set(T* const _pRef, const SlotMapHandleType _nHandle)
 {
     METHOD_ENTRY("CHandle::set")
     m_pRef   = _pRef;
-    m_strName = _pRef->getName();
+    m_nHandle = _nHandle;
     m_UID = _pRef->getUID();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns handle of reference in slot map
+///
+/// \return Handle in slot map, SLOT_MAP_HANDLE_INVALID if not stored in one
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline SlotMapHandleType CHandle<T>::getHandle() const
+{
+    METHOD_ENTRY("CHandle::getHandle")
+    return m_nHandle;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Returns name
 ///
+/// The name isn't stored in the handle but looked up when needed.
+///
 /// \return Name
 ///
 ////////////////////////////////////////////////////////////////////////////////
 template <class T>
-inline const std::string& CHandle<T>::getName() const
+inline std::string CHandle<T>::getName() const
 {
     METHOD_ENTRY("CHandle::getName")
-    return m_strName;
+    return (m_pRef != nullptr) ? m_pRef->getName() : "UID_0";
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -149,4 +176,21 @@ inline T* CHandle<T>::ptr() const
     return m_pRef;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns the reference to UID user, validated by slot map
+///
+/// \param _SlotMap Slot map the UID user is stored in
+///
+/// \return Reference to UID user, nullptr if removed from slot map
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline T* CHandle<T>::resolve(const CSlotMap<UIDType, T*>& _SlotMap) const
+{
+    METHOD_ENTRY("CHandle::resolve")
+    T* const* const ppRef = _SlotMap.get(m_nHandle);
+    return (ppRef != nullptr) ? *ppRef : nullptr;
+}
+
 #endif // HANDLE_H
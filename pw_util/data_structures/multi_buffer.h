@@ -183,6 +183,10 @@ class CMultiBuffer<N, TContainer, TKey, TVal> : public ISerializable
         void add(const TKey&, const std::array<TVal, N>&);
         template<std::uint8_t I, std::uint8_t J>
         void copyDeep();
+        template<std::uint8_t I, std::uint8_t J, class TSkip>
+        std::size_t copyDeep(TSkip);
+        template<std::uint8_t I, class TSkip>
+        std::size_t copyDeep(TContainer* const, TSkip);
         
         void fillBuffer(const TVal&);
         void resizeBuffer(const std::size_t _nSize);
@@ -260,13 +260,65 @@ void CMultiBuffer<N, TContainer, TKey, TVal>::copyDeep()
 {
     METHOD_ENTRY("CMultiBuffer::copyDeep")
     auto it = m_BufferRef[J]->begin();
-    for (auto ci  = m_BufferRef[I]->cbegin(); ci != m_BufferRef[J]->cend(); ++ci)
+    for (auto ci  = m_BufferRef[I]->cbegin(); ci != m_BufferRef[I]->cend(); ++ci)
     {
         *(it->second) = *(ci->second);
         ++it;
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Deep copy of buffer content, skipping unchanged elements
+///
+/// \param _Skip Predicate, called with source and destination value, returns
+///              true if destination doesn't need to be copied
+///
+/// \return Number of copied elements
+///
+////////////////////////////////////////////////////////////////////////////////
+template<std::uint8_t N, class TContainer, class TKey, class TVal>
+template<std::uint8_t I, std::uint8_t J, class TSkip>
+std::size_t CMultiBuffer<N, TContainer, TKey, TVal>::copyDeep(TSkip _Skip)
+{
+    METHOD_ENTRY("CMultiBuffer::copyDeep")
+    return this->template copyDeep<I>(m_BufferRef[J], _Skip);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Deep copy of buffer content to given buffer, skipping unchanged
+///        elements
+///
+/// The destination is one of the own buffers, handed over by other means
+/// than swapping, e.g. by a lock-free triple buffer.
+///
+/// \param _pDst Destination buffer
+/// \param _Skip Predicate, called with source and destination value, returns
+///              true if destination doesn't need to be copied
+///
+/// \return Number of copied elements
+///
+////////////////////////////////////////////////////////////////////////////////
+template<std::uint8_t N, class TContainer, class TKey, class TVal>
+template<std::uint8_t I, class TSkip>
+std::size_t CMultiBuffer<N, TContainer, TKey, TVal>::copyDeep(TContainer* const _pDst, TSkip _Skip)
+{
+    METHOD_ENTRY("CMultiBuffer::copyDeep")
+    std::size_t nCopied = 0u;
+    auto it = _pDst->begin();
+    for (auto ci  = m_BufferRef[I]->cbegin(); ci != m_BufferRef[I]->cend(); ++ci)
+    {
+        if (!_Skip(ci->second, it->second))
+        {
+            *(it->second) = *(ci->second);
+            ++nCopied;
+        }
+        ++it;
+    }
+    return nCopied;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Fill the buffer with given value
@@ -0,0 +1,509 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       pool.h
+/// \brief      Prototype of classes "IPool" and "CPool"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef POOL_H
+#define POOL_H
+
+//--- Standard header --------------------------------------------------------//
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+//--- Program header ---------------------------------------------------------//
+#include "adaptive_lock.h"
+#include "log.h"
+
+//--- Constants --------------------------------------------------------------//
+constexpr std::uint32_t POOL_SLOTS_PER_BLOCK = 256u; ///< Number of slots allocated at once when pool grows
+
+/// Hint to place an allocation next to a pooled entity, e.g. its buffer copies
+struct PoolNeighbourType
+{
+    const void* pNeighbour; ///< Entity to allocate next to
+};
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Interface of pools, registering them for statistics
+///
+////////////////////////////////////////////////////////////////////////////////
+class IPool
+{
+
+    public:
+
+        /// Statistics of a pool
+        struct StatisticsType
+        {
+            std::size_t nSlotSize;  ///< Size of one slot in bytes
+            std::size_t nSlots;     ///< Number of slots allocated
+            std::size_t nSlotsUsed; ///< Number of slots in use
+        };
+
+        //--- Constructor/Destructor -----------------------------------------//
+        explicit IPool(const std::string&);
+        virtual ~IPool();
+        IPool(const IPool&) = delete;
+        IPool& operator=(const IPool&) = delete;
+
+        //--- Constant methods -----------------------------------------------//
+        const std::string& getName() const {return m_strName;}
+
+        virtual StatisticsType getStatistics() const = 0;
+
+        //--- Static methods -------------------------------------------------//
+        static std::string getStatisticsAll();
+
+    protected:
+
+        //--- Variables [protected] ------------------------------------------//
+        std::string m_strName; ///< Name of pool, e.g. for statistics
+
+    private:
+
+        //--- Static methods [private] ---------------------------------------//
+        static std::list<IPool*>&   getPools();
+        static std::mutex&          getPoolsMutex();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Typed pool allocator
+///
+/// Memory is allocated in blocks of slots, each slot holding one entity of
+/// type T. Slots are organised in groups of N. A regular allocation takes a
+/// completely free group. An allocation next to a given neighbour takes a
+/// free slot of the neighbour's group, if any, or of the group its overflow
+/// went to. Hence, the buffer copies of an entity, which are cloned from it,
+/// are placed next to each other. This also holds if one copy is deleted and
+/// cloned again, since its slot is taken again. A group is free for regular
+/// allocations again when all of its slots are freed.
+///
+/// Allocations of a different size, i.e. of derived classes without their
+/// own pool, are forwarded to the global allocator.
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class T, std::uint8_t N>
+class CPool : public IPool
+{
+
+    public:
+
+        //--- Constructor/Destructor -----------------------------------------//
+        explicit CPool(const std::string&);
+        ~CPool() override;
+
+        //--- Constant methods -----------------------------------------------//
+        StatisticsType getStatistics() const override;
+
+        //--- Methods --------------------------------------------------------//
+        void* allocate(const std::size_t, const void* const _pNeighbour = nullptr);
+        void  free(void* const, const std::size_t);
+
+    private:
+
+        static_assert(N > 0u && N <= 8u, "Group size must be between 1 and 8.");
+
+        struct GroupType;
+
+        /// Slot holding one entity
+        struct SlotType
+        {
+            GroupType* pGroup;                                                  ///< Group of this slot
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type Data;    ///< Memory of entity
+        };
+
+        /// Group of adjacent slots
+        struct GroupType
+        {
+            std::array<SlotType, N> Slots;  ///< Slots of this group
+            GroupType*   pNextFree;         ///< Next free group
+            GroupType*   pOverflow;         ///< Group taking further neighbours if this one is full
+            std::uint8_t nUsed;             ///< Bit mask of used slots
+            bool         bFree;             ///< Indicates if group is in list of free groups
+        };
+
+        //--- Methods [private] ----------------------------------------------//
+        GroupType*  findGroup(const void* const) const;
+        void        grow();
+
+        //--- Variables [private] --------------------------------------------//
+        mutable CAdaptiveLock                               m_Access;       ///< Guards groups
+        std::map<const GroupType*, std::unique_ptr<GroupType[]>> m_Blocks;  ///< Blocks of groups by address
+        GroupType*                                          m_pFreeGroups;  ///< List of free groups
+        std::size_t                                         m_nSlotsUsed;   ///< Number of slots in use
+};
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Declares class specific allocation from a pool
+///
+/// The pool is constructed on first use. Allocation next to a neighbour is
+/// done by new (PoolNeighbourType{pNeighbour}) T(...).
+///
+/// \param T Class to be allocated from pool
+/// \param N Number of adjacent slots per group
+///
+////////////////////////////////////////////////////////////////////////////////
+#define POOL_ALLOCATION(T, N) \
+    static CPool<T, N>& getPool() {static CPool<T, N> s_Pool(#T); return s_Pool;} \
+    static void* operator new(std::size_t _nSize) {return getPool().allocate(_nSize);} \
+    static void* operator new(std::size_t _nSize, const PoolNeighbourType& _Neighbour) \
+        {return getPool().allocate(_nSize, _Neighbour.pNeighbour);} \
+    static void  operator delete(void* _p, std::size_t _nSize) {getPool().free(_p, _nSize);} \
+    static void  operator delete(void* _p, const PoolNeighbourType&) {getPool().free(_p, sizeof(T));}
+
+//--- Implementation is done here for inline optimisation --------------------//
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Constructor, registering pool by name
+///
+/// \param _strName Name of pool
+///
+////////////////////////////////////////////////////////////////////////////////
+inline IPool::IPool(const std::string& _strName) : m_strName(_strName)
+{
+    METHOD_ENTRY("IPool::IPool")
+    CTOR_CALL("IPool::IPool")
+
+    std::lock_guard<std::mutex> Lock(getPoolsMutex());
+    getPools().push_back(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Destructor, unregistering pool
+///
+////////////////////////////////////////////////////////////////////////////////
+inline IPool::~IPool()
+{
+    std::lock_guard<std::mutex> Lock(getPoolsMutex());
+    getPools().remove(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns occupancy of all pools as table
+///
+/// \return Statistics of all pools, one line per pool
+///
+////////////////////////////////////////////////////////////////////////////////
+inline std::string IPool::getStatisticsAll()
+{
+    METHOD_ENTRY("IPool::getStatisticsAll")
+
+    std::vector<std::pair<std::string, StatisticsType>> Statistics;
+    {
+        std::lock_guard<std::mutex> Lock(getPoolsMutex());
+        for (const auto pPool : getPools())
+            Statistics.push_back({pPool->getName(), pPool->getStatistics()});
+    }
+    std::sort(Statistics.begin(), Statistics.end(),
+              [](const std::pair<std::string, StatisticsType>& _A,
+                 const std::pair<std::string, StatisticsType>& _B) -> bool
+              {
+                  return _A.first < _B.first;
+              });
+
+    std::ostringstream oss;
+    oss << std::left << std::setw(40) << "Pool" << std::right <<
+           std::setw(10) << "Slot/B" <<
+           std::setw(12) << "Slots" <<
+           std::setw(12) << "Used" <<
+           std::setw(12) << "Memory/kB" <<
+           std::setw(12) << "Occupancy" << std::endl;
+    for (const auto& Stat : Statistics)
+    {
+        oss << std::left << std::setw(40) << Stat.first << std::right <<
+               std::setw(10) << Stat.second.nSlotSize <<
+               std::setw(12) << Stat.second.nSlots <<
+               std::setw(12) << Stat.second.nSlotsUsed <<
+               std::setw(12) << Stat.second.nSlots * Stat.second.nSlotSize / 1024 <<
+               std::setw(11) << (Stat.second.nSlots == 0 ? 0.0 :
+                                 100.0 * Stat.second.nSlotsUsed / Stat.second.nSlots) << "%" << std::endl;
+    }
+    return oss.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns all registered pools
+///
+/// Constructed on first use, since pools are static themselves.
+///
+/// \return Registered pools
+///
+////////////////////////////////////////////////////////////////////////////////
+inline std::list<IPool*>& IPool::getPools()
+{
+    static std::list<IPool*> s_Pools;
+    return s_Pools;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns mutex guarding registered pools
+///
+/// \return Mutex guarding registered pools
+///
+////////////////////////////////////////////////////////////////////////////////
+inline std::mutex& IPool::getPoolsMutex()
+{
+    static std::mutex s_Mutex;
+    return s_Mutex;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Constructor
+///
+/// \param _strName Name of pool, usually the pooled type
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class T, std::uint8_t N>
+CPool<T, N>::CPool(const std::string& _strName) : IPool(_strName),
+                                                  m_Access("CPool<" + _strName + ">"),
+                                                  m_pFreeGroups(nullptr),
+                                                  m_nSlotsUsed(0u)
+{
+    METHOD_ENTRY("CPool::CPool")
+    CTOR_CALL("CPool::CPool")
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Destructor
+///
+/// Blocks are freed with the pool, entities still in use are not destroyed.
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class T, std::uint8_t N>
+CPool<T, N>::~CPool()
+{
+    METHOD_ENTRY("CPool::~CPool")
+    DTOR_CALL("CPool::~CPool")
+
+    if (m_nSlotsUsed != 0u)
+    {
+        DOM_MEMF(DEBUG_MSG("Pool", m_strName << ": " << m_nSlotsUsed << " slots still in use."))
+    }
+    for (auto i=0u; i<m_Blocks.size(); ++i)
+    {
+        MEM_FREED("CPool::GroupType")
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns occupancy of pool
+///
+/// \return Statistics of pool
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class T, std::uint8_t N>
+IPool::StatisticsType CPool<T, N>::getStatistics() const
+{
+    METHOD_ENTRY("CPool::getStatistics")
+
+    m_Access.acquireLock();
+    StatisticsType Statistics;
+    Statistics.nSlotSize  = sizeof(SlotType);
+    Statistics.nSlots     = m_Blocks.size() * (POOL_SLOTS_PER_BLOCK / N) * N;
+    Statistics.nSlotsUsed = m_nSlotsUsed;
+    m_Access.releaseLock();
+
+    return Statistics;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Allocates memory for one entity
+///
+/// \param _nSize Size of entity, memory of any other size than T is
+///               allocated globally
+/// \param _pNeighbour Entity to allocate next to, if possible
+///
+/// \return Memory for entity
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class T, std::uint8_t N>
+void* CPool<T, N>::allocate(const std::size_t _nSize, const void* const _pNeighbour)
+{
+    METHOD_ENTRY("CPool::allocate")
+
+    if (_nSize != sizeof(T)) return ::operator new(_nSize);
+
+    m_Access.acquireLock();
+
+    constexpr std::uint8_t nFull = (1u << N) - 1u;
+
+    GroupType* pGroup = this->findGroup(_pNeighbour);
+    if (pGroup != nullptr && pGroup->nUsed == nFull &&
+        pGroup->pOverflow != nullptr && !pGroup->pOverflow->bFree &&
+        pGroup->pOverflow->nUsed != nFull)
+    {
+        // The overflow group might have been recycled by another entity
+        // meanwhile, which only affects locality. Free groups are not taken,
+        // since they are still listed for regular allocations.
+        pGroup = pGroup->pOverflow;
+    }
+    if (pGroup == nullptr || pGroup->nUsed == nFull)
+    {
+        if (m_pFreeGroups == nullptr) this->grow();
+        GroupType* const pFree = m_pFreeGroups;
+        m_pFreeGroups = pFree->pNextFree;
+        pFree->pNextFree = nullptr;
+        pFree->pOverflow = nullptr;
+        pFree->bFree = false;
+        if (pGroup != nullptr) pGroup->pOverflow = pFree;
+        pGroup = pFree;
+    }
+
+    std::uint8_t nSlot = 0u;
+    while (pGroup->nUsed & (1u << nSlot)) ++nSlot;
+    PW_ASSERT(nSlot < N);
+    pGroup->nUsed |= (1u << nSlot);
+    ++m_nSlotsUsed;
+
+    m_Access.releaseLock();
+
+    return &pGroup->Slots[nSlot].Data;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Frees memory of one entity
+///
+/// \param _p Memory of entity
+/// \param _nSize Size of entity
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class T, std::uint8_t N>
+void CPool<T, N>::free(void* const _p, const std::size_t _nSize)
+{
+    METHOD_ENTRY("CPool::free")
+
+    if (_p == nullptr) return;
+    if (_nSize != sizeof(T))
+    {
+        ::operator delete(_p);
+        return;
+    }
+
+    SlotType* const pSlot = reinterpret_cast<SlotType*>(static_cast<char*>(_p) - offsetof(SlotType, Data));
+    GroupType* const pGroup = pSlot->pGroup;
+
+    m_Access.acquireLock();
+    pGroup->nUsed &= ~(1u << (pSlot - pGroup->Slots.data()));
+    --m_nSlotsUsed;
+    if (pGroup->nUsed == 0u)
+    {
+        pGroup->pNextFree = m_pFreeGroups;
+        pGroup->bFree = true;
+        m_pFreeGroups = pGroup;
+    }
+    m_Access.releaseLock();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Finds the group of given entity
+///
+/// Only entities of this pool are found, e.g. not those on the stack.
+///
+/// \param _p Entity to find group of
+///
+/// \return Group of entity, nullptr if not allocated by this pool
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class T, std::uint8_t N>
+typename CPool<T, N>::GroupType* CPool<T, N>::findGroup(const void* const _p) const
+{
+    METHOD_ENTRY("CPool::findGroup")
+
+    if (_p == nullptr || m_Blocks.empty()) return nullptr;
+
+    const char* const p = static_cast<const char*>(_p);
+    auto it = m_Blocks.upper_bound(reinterpret_cast<const GroupType*>(p));
+    if (it == m_Blocks.begin()) return nullptr;
+    --it;
+
+    const GroupType* const pBlock = it->first;
+    if (p >= reinterpret_cast<const char*>(pBlock + POOL_SLOTS_PER_BLOCK / N)) return nullptr;
+
+    const SlotType* const pSlot = reinterpret_cast<const SlotType*>(p - offsetof(SlotType, Data));
+    return pSlot->pGroup;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Allocates another block of free groups
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class T, std::uint8_t N>
+void CPool<T, N>::grow()
+{
+    METHOD_ENTRY("CPool::grow")
+
+    constexpr std::uint32_t nGroups = POOL_SLOTS_PER_BLOCK / N;
+
+    std::unique_ptr<GroupType[]> pBlock(new GroupType[nGroups]);
+    MEM_ALLOC("CPool::GroupType")
+
+    for (auto i=nGroups; i>0u; --i)
+    {
+        GroupType* const pGroup = &pBlock[i-1];
+        for (auto& Slot : pGroup->Slots) Slot.pGroup = pGroup;
+        pGroup->nUsed = 0u;
+        pGroup->bFree = true;
+        pGroup->pOverflow = nullptr;
+        pGroup->pNextFree = m_pFreeGroups;
+        m_pFreeGroups = pGroup;
+    }
+    m_Blocks.emplace(pBlock.get(), std::move(pBlock));
+
+    DOM_MEMA(DEBUG_MSG("Pool", m_strName << ": grown to " <<
+                       m_Blocks.size() * nGroups * N << " slots, " <<
+                       m_nSlotsUsed << " in use"))
+}
+
+#endif // POOL_H
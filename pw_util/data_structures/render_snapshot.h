@@ -0,0 +1,70 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       render_snapshot.h
+/// \brief      Definition of render state published by physics each frame
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef RENDER_SNAPSHOT_H
+#define RENDER_SNAPSHOT_H
+
+//--- Standard header --------------------------------------------------------//
+#include <vector>
+
+//--- Program header ---------------------------------------------------------//
+#include "uid.h"
+
+//--- Misc header ------------------------------------------------------------//
+#include <eigen3/Eigen/Core>
+
+using namespace Eigen;
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief State of an object that changes each frame, as needed for rendering
+///
+/// Shapes of an object are transformed rigidly, thus, origin and angle are
+/// the transformation of all of its shapes.
+///
+////////////////////////////////////////////////////////////////////////////////
+struct RenderObjectType
+{
+    UIDType     nUID;                   ///< UID of object
+    Vector2i    vecCell;                ///< Grid cell
+    Vector2d    vecOrigin;              ///< Origin of local coordinates, translation of shapes
+    Vector2d    vecVelocity;            ///< Velocity
+    double      fAngle;                 ///< Angle, rotation of shapes
+    double      fAngleVelocity;         ///< Angle velocity
+    Vector2d    vecAABBLowerLeft;       ///< Lower left corner of multi frame bounding box
+    Vector2d    vecAABBUpperRight;      ///< Upper right corner of multi frame bounding box
+    Vector2d    vecAABBSLowerLeft;      ///< Lower left corner of single frame bounding box
+    Vector2d    vecAABBSUpperRight;     ///< Upper right corner of single frame bounding box
+};
+
+/// Specifies the render state of all objects, ordered like buffered objects
+typedef std::vector<RenderObjectType> RenderSnapshotType;
+
+#endif // RENDER_SNAPSHOT_H
@@ -0,0 +1,456 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       slot_map.h
+/// \brief      Prototype of class "CSlotMap"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SLOT_MAP_H
+#define SLOT_MAP_H
+
+//--- Standard header --------------------------------------------------------//
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+//--- Program header ---------------------------------------------------------//
+#include "log.h"
+
+//--- Constants --------------------------------------------------------------//
+typedef std::uint64_t SlotMapHandleType; ///< Handle of a slot map element, generation and index of slot
+
+constexpr SlotMapHandleType SLOT_MAP_HANDLE_INVALID = 0u; ///< Handle never referring to an element
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Associative container storing its elements densely
+///
+/// Elements are stored as key-value pairs in one contiguous array, thus,
+/// iterating is a linear walk without chasing nodes of a hash map. Removing
+/// an element moves the last element into its place, hence, the order of
+/// elements is the order of insertion until the first removal. Since every
+/// buffer of a \ref CMultiBuffer sees the same insertions and removals, the
+/// order is the same for all buffers, which is relied on when copying them.
+///
+/// Besides lookup by key, every element is referred to by a 64 bit handle,
+/// consisting of the index of its slot and the slot's generation. A slot
+/// points to the element in the dense array and its generation is
+/// incremented when the element is removed. Therefore, resolving a handle
+/// is two indexed reads, and a handle of a removed element never resolves
+/// to another element, even if its slot is reused. Handles are stable while
+/// elements move in the dense array and, like the order, equal for all
+/// buffers of a \ref CMultiBuffer.
+///
+/// The interface follows std::unordered_map as far as used, so the
+/// container might be used in its place. Iterators and references are
+/// invalidated by insertion and removal, keys must not be altered through
+/// iterators.
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class TKey, class TVal>
+class CSlotMap
+{
+
+    public:
+
+        typedef TKey                                            key_type;
+        typedef TVal                                            mapped_type;
+        typedef std::pair<TKey, TVal>                           value_type;
+        typedef std::size_t                                     size_type;
+        typedef typename std::vector<value_type>::iterator       iterator;
+        typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+        //--- Constant methods -----------------------------------------------//
+        const_iterator      begin() const {return m_Elements.cbegin();}
+        const_iterator      cbegin() const {return m_Elements.cbegin();}
+        const_iterator      end() const {return m_Elements.cend();}
+        const_iterator      cend() const {return m_Elements.cend();}
+
+        const TVal&         at(const TKey&) const;
+        std::size_t         count(const TKey&) const;
+        bool                empty() const {return m_Elements.empty();}
+        const_iterator      find(const TKey&) const;
+        const TVal*         get(const SlotMapHandleType) const;
+        SlotMapHandleType   getHandle(const TKey&) const;
+        bool                isValid(const SlotMapHandleType) const;
+        std::size_t         size() const {return m_Elements.size();}
+
+        //--- Operators ------------------------------------------------------//
+        TVal&               operator[](const TKey&);
+
+        //--- Methods --------------------------------------------------------//
+        iterator            begin() {return m_Elements.begin();}
+        iterator            end() {return m_Elements.end();}
+
+        TVal&               at(const TKey&);
+        void                clear();
+        iterator            erase(const_iterator);
+        std::size_t         erase(const TKey&);
+        iterator            find(const TKey&);
+        TVal*               get(const SlotMapHandleType);
+        std::pair<iterator, bool> insert(const value_type&);
+        void                reserve(const std::size_t);
+
+    private:
+
+        /// Slot referring to an element in the dense array
+        struct SlotType
+        {
+            std::uint32_t nIndex;       ///< Index of element in dense array, if slot is in use
+            std::uint32_t nGeneration;  ///< Generation, incremented on removal of element
+        };
+
+        //--- Constant methods [private] -------------------------------------//
+        std::uint32_t       getIndex(const SlotMapHandleType) const;
+
+        //--- Variables [private] --------------------------------------------//
+        std::vector<value_type>                 m_Elements;     ///< Dense array of elements
+        std::vector<std::uint32_t>              m_ElementSlots; ///< Slot of each element in dense array
+        std::vector<SlotType>                   m_Slots;        ///< Slots, referring to elements
+        std::vector<std::uint32_t>              m_SlotsFree;    ///< Slots not referring to an element
+        std::unordered_map<TKey, std::uint32_t> m_SlotsByKey;   ///< Slots, accessed by key
+};
+
+//--- Implementation is done here for inline optimisation --------------------//
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns value of given key, throwing if key is not contained
+///
+/// \param _Key Key of element
+///
+/// \return Value of element
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class TKey, class TVal>
+inline const TVal& CSlotMap<TKey, TVal>::at(const TKey& _Key) const
+{
+    METHOD_ENTRY("CSlotMap::at")
+    return m_Elements[m_Slots[m_SlotsByKey.at(_Key)].nIndex].second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of elements with given key, i.e. 0 or 1
+///
+/// \param _Key Key of element
+///
+/// \return Number of elements with given key
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class TKey, class TVal>
+inline std::size_t CSlotMap<TKey, TVal>::count(const TKey& _Key) const
+{
+    METHOD_ENTRY("CSlotMap::count")
+    return m_SlotsByKey.count(_Key);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Finds element by key
+///
+/// \param _Key Key of element
+///
+/// \return Iterator to element, end if key is not contained
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class TKey, class TVal>
+inline typename CSlotMap<TKey, TVal>::const_iterator CSlotMap<TKey, TVal>::find(const TKey& _Key) const
+{
+    METHOD_ENTRY("CSlotMap::find")
+    const auto ci = m_SlotsByKey.find(_Key);
+    if (ci == m_SlotsByKey.end()) return m_Elements.cend();
+    return m_Elements.cbegin() + m_Slots[ci->second].nIndex;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns value referred to by handle
+///
+/// \param _nHandle Handle of element
+///
+/// \return Value of element, nullptr if handle is invalid or outdated
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class TKey, class TVal>
+inline const TVal* CSlotMap<TKey, TVal>::get(const SlotMapHandleType _nHandle) const
+{
+    METHOD_ENTRY("CSlotMap::get")
+    const std::uint32_t nIndex = this->getIndex(_nHandle);
+    return (nIndex < m_Elements.size()) ? &m_Elements[nIndex].second : nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns handle of element with given key
+///
+/// \param _Key Key of element
+///
+/// \return Handle of element, SLOT_MAP_HANDLE_INVALID if key is not contained
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class TKey, class TVal>
+inline SlotMapHandleType CSlotMap<TKey, TVal>::getHandle(const TKey& _Key) const
+{
+    METHOD_ENTRY("CSlotMap::getHandle")
+    const auto ci = m_SlotsByKey.find(_Key);
+    if (ci == m_SlotsByKey.end()) return SLOT_MAP_HANDLE_INVALID;
+    return (SlotMapHandleType(m_Slots[ci->second].nGeneration) << 32) | ci->second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Indicates if handle refers to an element
+///
+/// \param _nHandle Handle of element
+///
+/// \return Handle refers to element?
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class TKey, class TVal>
+inline bool CSlotMap<TKey, TVal>::isValid(const SlotMapHandleType _nHandle) const
+{
+    METHOD_ENTRY("CSlotMap::isValid")
+    return this->getIndex(_nHandle) < m_Elements.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns value of given key, inserting a default value if not
+///        contained
+///
+/// \param _Key Key of element
+///
+/// \return Value of element
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class TKey, class TVal>
+inline TVal& CSlotMap<TKey, TVal>::operator[](const TKey& _Key)
+{
+    METHOD_ENTRY("CSlotMap::operator[]")
+    return this->insert(value_type(_Key, TVal())).first->second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns value of given key, throwing if key is not contained
+///
+/// \param _Key Key of element
+///
+/// \return Value of element
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class TKey, class TVal>
+inline TVal& CSlotMap<TKey, TVal>::at(const TKey& _Key)
+{
+    METHOD_ENTRY("CSlotMap::at")
+    return m_Elements[m_Slots[m_SlotsByKey.at(_Key)].nIndex].second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Removes all elements
+///
+/// Generations of all slots are incremented, thus, handles handed out
+/// before stay invalid.
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class TKey, class TVal>
+inline void CSlotMap<TKey, TVal>::clear()
+{
+    METHOD_ENTRY("CSlotMap::clear")
+    while (!m_Elements.empty()) this->erase(m_Elements.cend()-1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Removes element, moving the last element into its place
+///
+/// \param _ci Iterator to element
+///
+/// \return Iterator to element that took the place of the removed one
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class TKey, class TVal>
+inline typename CSlotMap<TKey, TVal>::iterator CSlotMap<TKey, TVal>::erase(const_iterator _ci)
+{
+    METHOD_ENTRY("CSlotMap::erase")
+
+    const std::uint32_t nIndex = _ci - m_Elements.cbegin();
+    const std::uint32_t nSlot = m_ElementSlots[nIndex];
+
+    m_SlotsByKey.erase(_ci->first);
+
+    // Outdate handles, generation 0 is never used to keep handle 0 invalid
+    if (++m_Slots[nSlot].nGeneration == 0u) m_Slots[nSlot].nGeneration = 1u;
+    m_Slots[nSlot].nIndex = std::uint32_t(-1);
+    m_SlotsFree.push_back(nSlot);
+
+    if (nIndex != m_Elements.size()-1)
+    {
+        m_Elements[nIndex] = std::move(m_Elements.back());
+        m_ElementSlots[nIndex] = m_ElementSlots.back();
+        m_Slots[m_ElementSlots[nIndex]].nIndex = nIndex;
+    }
+    m_Elements.pop_back();
+    m_ElementSlots.pop_back();
+
+    return m_Elements.begin() + nIndex;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Removes element with given key
+///
+/// \param _Key Key of element
+///
+/// \return Number of removed elements, i.e. 0 or 1
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class TKey, class TVal>
+inline std::size_t CSlotMap<TKey, TVal>::erase(const TKey& _Key)
+{
+    METHOD_ENTRY("CSlotMap::erase")
+    const auto ci = this->find(_Key);
+    if (ci == m_Elements.end()) return 0u;
+    this->erase(ci);
+    return 1u;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Finds element by key
+///
+/// \param _Key Key of element
+///
+/// \return Iterator to element, end if key is not contained
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class TKey, class TVal>
+inline typename CSlotMap<TKey, TVal>::iterator CSlotMap<TKey, TVal>::find(const TKey& _Key)
+{
+    METHOD_ENTRY("CSlotMap::find")
+    const auto ci = m_SlotsByKey.find(_Key);
+    if (ci == m_SlotsByKey.end()) return m_Elements.end();
+    return m_Elements.begin() + m_Slots[ci->second].nIndex;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns value referred to by handle
+///
+/// \param _nHandle Handle of element
+///
+/// \return Value of element, nullptr if handle is invalid or outdated
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class TKey, class TVal>
+inline TVal* CSlotMap<TKey, TVal>::get(const SlotMapHandleType _nHandle)
+{
+    METHOD_ENTRY("CSlotMap::get")
+    const std::uint32_t nIndex = this->getIndex(_nHandle);
+    return (nIndex < m_Elements.size()) ? &m_Elements[nIndex].second : nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Inserts element if key is not contained, yet
+///
+/// Free slots are reused, otherwise, a new slot is appended.
+///
+/// \param _Elem Key-value pair to be inserted
+///
+/// \return Iterator to element with key, and if it was inserted
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class TKey, class TVal>
+inline std::pair<typename CSlotMap<TKey, TVal>::iterator, bool>
+CSlotMap<TKey, TVal>::insert(const value_type& _Elem)
+{
+    METHOD_ENTRY("CSlotMap::insert")
+
+    const auto ci = m_SlotsByKey.find(_Elem.first);
+    if (ci != m_SlotsByKey.end())
+        return {m_Elements.begin() + m_Slots[ci->second].nIndex, false};
+
+    std::uint32_t nSlot;
+    if (m_SlotsFree.empty())
+    {
+        nSlot = m_Slots.size();
+        m_Slots.push_back({0u, 1u});
+    }
+    else
+    {
+        nSlot = m_SlotsFree.back();
+        m_SlotsFree.pop_back();
+    }
+    m_Slots[nSlot].nIndex = m_Elements.size();
+    m_SlotsByKey.insert({_Elem.first, nSlot});
+    m_ElementSlots.push_back(nSlot);
+    m_Elements.push_back(_Elem);
+
+    return {m_Elements.end()-1, true};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Reserves memory for given number of elements
+///
+/// \param _nSize Number of elements
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class TKey, class TVal>
+inline void CSlotMap<TKey, TVal>::reserve(const std::size_t _nSize)
+{
+    METHOD_ENTRY("CSlotMap::reserve")
+    m_Elements.reserve(_nSize);
+    m_ElementSlots.reserve(_nSize);
+    m_Slots.reserve(_nSize);
+    m_SlotsByKey.reserve(_nSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns index of element in dense array referred to by handle
+///
+/// \param _nHandle Handle of element
+///
+/// \return Index of element, exceeding number of elements if handle is
+///         invalid or outdated
+///
+////////////////////////////////////////////////////////////////////////////////
+template<class TKey, class TVal>
+inline std::uint32_t CSlotMap<TKey, TVal>::getIndex(const SlotMapHandleType _nHandle) const
+{
+    METHOD_ENTRY("CSlotMap::getIndex")
+    const std::uint32_t nSlot = std::uint32_t(_nHandle);
+    if (nSlot >= m_Slots.size() || m_Slots[nSlot].nGeneration != std::uint32_t(_nHandle >> 32))
+        return std::uint32_t(-1);
+    return m_Slots[nSlot].nIndex;
+}
+
+#endif // SLOT_MAP_H
@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       string_table.cpp
+/// \brief      Implementation of class "CStringTable"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "string_table.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns ID of given string without interning it
+///
+/// \param _strString String to look up
+///
+/// \return ID of string, STRING_ID_INVALID if not interned
+///
+///////////////////////////////////////////////////////////////////////////////
+StringIDType CStringTable::find(const std::string& _strString)
+{
+    METHOD_ENTRY("CStringTable::find")
+
+    TableType& Table = getTable();
+    StringIDType nID = STRING_ID_INVALID;
+
+    Table.Access.acquireLock();
+    const auto ci = Table.IDsByString.find(_strString);
+    if (ci != Table.IDsByString.end()) nID = ci->second;
+    Table.Access.releaseLock();
+
+    return nID;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns string of given ID
+///
+/// \param _nID ID of string
+///
+/// \return Interned string, empty if ID is unknown
+///
+///////////////////////////////////////////////////////////////////////////////
+const std::string& CStringTable::getString(const StringIDType _nID)
+{
+    METHOD_ENTRY("CStringTable::getString")
+
+    TableType& Table = getTable();
+
+    Table.Access.acquireLock();
+    const std::string& strString = (_nID < Table.Strings.size()) ? Table.Strings[_nID] : Table.Strings[0];
+    Table.Access.releaseLock();
+
+    return strString;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of interned strings
+///
+/// \return Number of interned strings
+///
+///////////////////////////////////////////////////////////////////////////////
+std::size_t CStringTable::getNumberOfStrings()
+{
+    METHOD_ENTRY("CStringTable::getNumberOfStrings")
+
+    TableType& Table = getTable();
+
+    Table.Access.acquireLock();
+    const std::size_t nNumber = Table.IDsByString.size();
+    Table.Access.releaseLock();
+
+    return nNumber;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Interns given string
+///
+/// \param _strString String to intern
+///
+/// \return ID of string, the same for all calls with equal strings
+///
+///////////////////////////////////////////////////////////////////////////////
+StringIDType CStringTable::intern(const std::string& _strString)
+{
+    METHOD_ENTRY("CStringTable::intern")
+
+    if (_strString.empty()) return STRING_ID_INVALID;
+
+    TableType& Table = getTable();
+
+    Table.Access.acquireLock();
+    const auto Result = Table.IDsByString.insert({_strString, StringIDType(Table.Strings.size())});
+    if (Result.second) Table.Strings.push_back(_strString);
+    const StringIDType nID = Result.first->second;
+    Table.Access.releaseLock();
+
+    return nID;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns table of interned strings
+///
+/// Constructed on first use and kept until program exit, since strings might
+/// be interned by static initialisation and used by static destruction.
+///
+/// \return Table of interned strings
+///
+///////////////////////////////////////////////////////////////////////////////
+CStringTable::TableType& CStringTable::getTable()
+{
+    static TableType* const s_pTable = new TableType;
+    return *s_pTable;
+}
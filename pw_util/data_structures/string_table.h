@@ -0,0 +1,89 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       string_table.h
+/// \brief      Prototype of class "CStringTable"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef STRING_TABLE_H
+#define STRING_TABLE_H
+
+//--- Standard header --------------------------------------------------------//
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+
+//--- Program header ---------------------------------------------------------//
+#include "adaptive_lock.h"
+#include "log.h"
+
+//--- Constants --------------------------------------------------------------//
+using StringIDType = std::uint32_t; ///< ID of an interned string
+
+constexpr StringIDType STRING_ID_INVALID = 0u; ///< ID of the empty string, never interned otherwise
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Global table of interned strings
+///
+/// Each string is interned once and mapped to a compact integer ID, which is
+/// valid until program exit. Names of entities, commands, render modes and
+/// fonts are resolved to IDs when they are set or registered, thus, lookups
+/// on hot paths compare and hash integers instead of strings.
+///
+/// IDs are counted from 1, the empty string has ID 0. Strings are stored in a
+/// deque, hence, references returned by \ref getString stay valid while more
+/// strings are interned. The table is guarded by a lock, since it is only
+/// accessed when resolving a string, not when using an ID.
+///
+////////////////////////////////////////////////////////////////////////////////
+class CStringTable
+{
+
+    public:
+
+        //--- Static methods -------------------------------------------------//
+        static StringIDType         find(const std::string&);
+        static const std::string&   getString(const StringIDType);
+        static std::size_t          getNumberOfStrings();
+        static StringIDType         intern(const std::string&);
+
+    private:
+
+        /// Strings and their IDs, guarded by a lock
+        struct TableType
+        {
+            CAdaptiveLock                                   Access{"CStringTable::Access"}; ///< Guards table
+            std::unordered_map<std::string, StringIDType>   IDsByString;    ///< IDs, accessed by string
+            std::deque<std::string>                         Strings{""};    ///< Strings, accessed by ID
+        };
+
+        //--- Static methods [private] ---------------------------------------//
+        static TableType& getTable();
+};
+
+#endif // STRING_TABLE_H
@@ -30,76 +30,73 @@
 
 #include "uid.h"
 
+//--- Standard header --------------------------------------------------------//
+#include <algorithm>
+#include <functional>
+#include <thread>
+
 /// Global counter for unique IDs. Reserve 0 for no reference
-UIDType CUID::s_nUID = 1;
+std::atomic<UIDType> CUID::s_nUID{1u};
+
+/// Global number of unused unique IDs in shards
+std::atomic<std::size_t> CUID::s_nUnusedShared{0u};
 
-/// Global list for unused unique IDs
-std::deque<UIDType> CUID::s_UnusedUIDs;
+/// Global chunks of reference counters, allocated on demand
+std::array<std::atomic<std::atomic<std::uint32_t>*>, UID_REFS_CHUNKS> CUID::s_RefChunks;
 
-/// Global list for reference counting of uids
-std::unordered_map<UIDType, std::uint32_t> CUID::s_ReferencedUIDs;
+/// Thread local cache of unique IDs
+thread_local CUID::CacheType CUID::s_Cache;
 
-/// Global lock
-CSpinlock CUID::s_Access;
+/// Thread local state of cache
+thread_local CUID::CacheStateType CUID::s_CacheState = CUID::CacheStateType::NONE;
 
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Constructor
 ///
-/// When the constructor is called, the specific ID is assigned. If there are
-/// any unused IDs, these will be used first.
+/// When the constructor is called, the specific ID is assigned. IDs reserved
+/// by the calling thread are used first, then unused IDs.
 ///
 ///////////////////////////////////////////////////////////////////////////////
-CUID::CUID()
+CUID::CUID() : m_pPrefix("")
 {
     METHOD_ENTRY("CUID::CUID")
-    DTOR_CALL("CUID::CUID")
-    
-    s_Access.acquireLock();
+    CTOR_CALL("CUID::CUID")
     
-    if (s_UnusedUIDs.empty())
+    if (s_CacheState != CacheStateType::DESTROYED && !s_Cache.ReservedUIDs.empty())
     {
-        m_nUID = s_nUID++;
+        m_nUID = s_Cache.ReservedUIDs.front();
+        s_Cache.ReservedUIDs.pop_front();
     }
     else
     {
-        m_nUID = s_UnusedUIDs.front();
-        s_UnusedUIDs.pop_front();
+        m_nUID = acquireID();
     }
-    s_ReferencedUIDs[m_nUID] = 1u;
-    m_strName = "UID_"+std::to_string(m_nUID);
-    
-    s_Access.releaseLock();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Copy Constructor
 ///
-/// Copy constructor will exactly do the same as standard constructor, since
-/// id has to be unique and thus, may not be copied 1:1.
+/// The ID is shared by the copy, which is reference counted.
 ///
-/// \param _UID UID (won't be copied to ensure unique ids)
+/// \param _UID UID to be copied
 ///
 ///////////////////////////////////////////////////////////////////////////////
 CUID::CUID(const CUID& _UID)
 {
     METHOD_ENTRY("CUID::CUID")
-    DTOR_CALL("CUID::CUID")
-    
-    s_Access.acquireLock();
+    CTOR_CALL("CUID::CUID")
     
     this->copy(_UID);
-    
-    s_Access.releaseLock();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Destructor
 ///
-/// When the destructor is called, the specific ID is released and thus added
-/// to the list of unused IDs. These can be used by the next unique ID that is
+/// When the destructor is called, the specific ID is released if it isn't
+/// referenced anymore. It can be used by the next unique ID that is
 /// constructed.
 ///
 ///////////////////////////////////////////////////////////////////////////////
@@ -108,16 +105,8 @@ CUID::~CUID()
     METHOD_ENTRY("CUID::~CUID")
     DTOR_CALL("CUID::~CUID")
     
-    s_Access.acquireLock();
-    
-    s_ReferencedUIDs[m_nUID] -= 1u;
-    if (s_ReferencedUIDs[m_nUID] == 0u)
-    {
-        s_UnusedUIDs.push_back(m_nUID);
-        s_ReferencedUIDs.erase(m_nUID);
-    }
-    
-    s_Access.releaseLock();
+    if (getRefs(m_nUID).fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+        releaseID(m_nUID);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -133,18 +122,10 @@ CUID& CUID::operator=(const CUID& _UID)
     
     if (this != &_UID)
     {
-        s_Access.acquireLock();
-        
-        s_ReferencedUIDs[m_nUID] -= 1u;
-        if (s_ReferencedUIDs[m_nUID] == 0u)
-        {
-            s_UnusedUIDs.push_back(m_nUID);
-            s_ReferencedUIDs.erase(m_nUID);
-        }
-            
+        const UIDType nUIDOld = m_nUID;
         this->copy(_UID);
-        
-        s_Access.releaseLock();
+        if (getRefs(nUIDOld).fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+            releaseID(nUIDOld);
     }
     return *this;
 }
@@ -153,34 +134,307 @@ CUID& CUID::operator=(const CUID& _UID)
 ///
 /// \brief Sets a new value for this ID
 ///
+/// A name set explicitly is reset, the prefix of the name is kept.
+///
 ////////////////////////////////////////////////////////////////////////////////
 void CUID::setNewID()
 {
     METHOD_ENTRY("CUID::setNewID")
     
-    s_Access.acquireLock();
+    const UIDType nUIDOld = m_nUID;
+    m_nUID = acquireID();
+    m_strName.clear();
+    if (getRefs(nUIDOld).fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+        releaseID(nUIDOld);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns all unused IDs
+///
+/// IDs cached by the calling thread come first, followed by those in shards.
+/// Blocks of fresh IDs aren't included. This is meant for debugging, hence,
+/// a copy is returned.
+///
+/// \return Unused IDs
+///
+///////////////////////////////////////////////////////////////////////////////
+std::deque<UIDType> CUID::getUnusedUIDs()
+{
+    METHOD_ENTRY("CUID::getUnusedUIDs")
+    
+    std::deque<UIDType> UnusedUIDs;
+    if (s_CacheState != CacheStateType::DESTROYED)
+        UnusedUIDs = s_Cache.UnusedUIDs;
+    for (auto& Shard : getShards())
+    {
+        Shard.Access.acquireLock();
+        UnusedUIDs.insert(UnusedUIDs.end(), Shard.UnusedUIDs.begin(), Shard.UnusedUIDs.end());
+        Shard.Access.releaseLock();
+    }
+    return UnusedUIDs;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns all referenced IDs and their number of references
+///
+/// This is meant for debugging, hence, reference counters are scanned and
+/// a copy is returned.
+///
+/// \return Referenced IDs
+///
+///////////////////////////////////////////////////////////////////////////////
+std::unordered_map<UIDType, std::uint32_t> CUID::getReferencedUIDs()
+{
+    METHOD_ENTRY("CUID::getReferencedUIDs")
+    
+    std::unordered_map<UIDType, std::uint32_t> ReferencedUIDs;
+    const UIDType nUIDMax = s_nUID.load(std::memory_order_relaxed);
+    for (UIDType nUID = 1u; nUID < nUIDMax; ++nUID)
+    {
+        const std::uint32_t nRefs = getRefs(nUID).load(std::memory_order_relaxed);
+        if (nRefs != 0u)
+            ReferencedUIDs[nUID] = nRefs;
+    }
+    return ReferencedUIDs;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of IDs reserved by calling thread
+///
+/// \return Number of reserved IDs
+///
+///////////////////////////////////////////////////////////////////////////////
+std::size_t CUID::getNumberOfReserved()
+{
+    METHOD_ENTRY("CUID::getNumberOfReserved")
+    if (s_CacheState == CacheStateType::DESTROYED) return 0u;
+    return s_Cache.ReservedUIDs.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Reserves IDs for the calling thread
+///
+/// IDs are referenced right away. UIDs constructed afterwards by the calling
+/// thread use them, hence, IDs of entities created in a batch are close to
+/// each other. IDs that are not used should be returned by \ref unreserve.
+///
+/// \param _nNumber Number of IDs to be reserved in total
+///
+///////////////////////////////////////////////////////////////////////////////
+void CUID::reserve(const std::size_t _nNumber)
+{
+    METHOD_ENTRY("CUID::reserve")
+    
+    if (s_CacheState == CacheStateType::DESTROYED) return;
+    
+    while (s_Cache.ReservedUIDs.size() < _nNumber)
+    {
+        s_Cache.ReservedUIDs.push_back(acquireID());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns IDs reserved but not used by the calling thread
+///
+///////////////////////////////////////////////////////////////////////////////
+void CUID::unreserve()
+{
+    METHOD_ENTRY("CUID::unreserve")
+    
+    if (s_CacheState == CacheStateType::DESTROYED) return;
+    
+    while (!s_Cache.ReservedUIDs.empty())
+    {
+        const UIDType nUID = s_Cache.ReservedUIDs.front();
+        s_Cache.ReservedUIDs.pop_front();
+        getRefs(nUID).store(0u, std::memory_order_relaxed);
+        releaseID(nUID);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Constructor of thread local cache
+///
+/// Threads prefer different shards to spread contention.
+///
+///////////////////////////////////////////////////////////////////////////////
+CUID::CacheType::CacheType() : nNext(0u),
+                               nEnd(0u),
+                               nShard(std::hash<std::thread::id>()(std::this_thread::get_id()) % UID_SHARDS)
+{
+    s_CacheState = CacheStateType::VALID;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Destructor of thread local cache, handing all cached IDs to shards
+///
+/// UIDs destroyed later by the exiting thread bypass the cache.
+///
+///////////////////////////////////////////////////////////////////////////////
+CUID::CacheType::~CacheType()
+{
+    s_CacheState = CacheStateType::DESTROYED;
+    
+    for (const auto nUID : ReservedUIDs)
+        getRefs(nUID).store(0u, std::memory_order_relaxed);
+    for (; nNext != nEnd; ++nNext)
+        UnusedUIDs.push_back(nNext);
+    
+    const std::vector<UIDType> UIDs(UnusedUIDs.begin(), UnusedUIDs.end());
+    const std::vector<UIDType> UIDsReserved(ReservedUIDs.begin(), ReservedUIDs.end());
+    addUnused(UIDs.data(), UIDs.size(), nShard);
+    addUnused(UIDsReserved.data(), UIDsReserved.size(), nShard);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Acquires an unused ID and references it
+///
+/// Released IDs are used first, preferably those cached by the calling thread.
+/// Fresh IDs are taken from the current block, a new block is taken from the
+/// global counter if exhausted.
+///
+/// \return Acquired ID
+///
+///////////////////////////////////////////////////////////////////////////////
+UIDType CUID::acquireID()
+{
+    METHOD_ENTRY("CUID::acquireID")
     
-    UIDType nTmp;
-    if (s_UnusedUIDs.empty())
+    UIDType nUID;
+    if (s_CacheState == CacheStateType::DESTROYED)
     {
-        nTmp = s_nUID++;
+        nUID = s_nUID.fetch_add(1u, std::memory_order_relaxed);
     }
     else
     {
-        nTmp = s_UnusedUIDs.front();
-        s_UnusedUIDs.pop_front();
+        CacheType& Cache = s_Cache;
+        if (Cache.UnusedUIDs.empty())
+            refillCache(Cache);
+        
+        if (!Cache.UnusedUIDs.empty())
+        {
+            nUID = Cache.UnusedUIDs.front();
+            Cache.UnusedUIDs.pop_front();
+        }
+        else
+        {
+            if (Cache.nNext == Cache.nEnd)
+            {
+                Cache.nNext = s_nUID.fetch_add(UID_BLOCK_SIZE, std::memory_order_relaxed);
+                Cache.nEnd = Cache.nNext + UID_BLOCK_SIZE;
+            }
+            nUID = Cache.nNext++;
+        }
     }
-    s_ReferencedUIDs[m_nUID] -= 1u;
-    if (s_ReferencedUIDs[m_nUID] == 0u)
+    getRefs(nUID).store(1u, std::memory_order_relaxed);
+    return nUID;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adds unused IDs to shards
+///
+/// \param _pUIDs Unused IDs
+/// \param _nNumber Number of unused IDs
+/// \param _nShard Shard to add IDs to
+///
+///////////////////////////////////////////////////////////////////////////////
+void CUID::addUnused(const UIDType* const _pUIDs, const std::size_t _nNumber, const std::size_t _nShard)
+{
+    METHOD_ENTRY("CUID::addUnused")
+    
+    if (_nNumber == 0u) return;
+    
+    ShardType& Shard = getShards()[_nShard];
+    Shard.Access.acquireLock();
+    Shard.UnusedUIDs.insert(Shard.UnusedUIDs.end(), _pUIDs, _pUIDs+_nNumber);
+    Shard.Access.releaseLock();
+    s_nUnusedShared.fetch_add(_nNumber, std::memory_order_relaxed);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns shards of unused IDs
+///
+/// Constructed on first use and kept until program exit, since UIDs might be
+/// static themselves.
+///
+/// \return Shards of unused IDs
+///
+///////////////////////////////////////////////////////////////////////////////
+std::array<CUID::ShardType, UID_SHARDS>& CUID::getShards()
+{
+    static std::array<ShardType, UID_SHARDS>* const s_pShards = new std::array<ShardType, UID_SHARDS>;
+    return *s_pShards;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Refills thread local cache with a batch of unused IDs from shards
+///
+/// Shards are only visited if there are any unused IDs in them, starting with
+/// the shard preferred by the calling thread.
+///
+/// \param _Cache Cache of calling thread
+///
+///////////////////////////////////////////////////////////////////////////////
+void CUID::refillCache(CacheType& _Cache)
+{
+    METHOD_ENTRY("CUID::refillCache")
+    
+    for (auto i=0u; i<UID_SHARDS && s_nUnusedShared.load(std::memory_order_relaxed) > 0u; ++i)
     {
-        s_UnusedUIDs.push_back(m_nUID);
-        s_ReferencedUIDs.erase(m_nUID);
+        ShardType& Shard = getShards()[(_Cache.nShard+i) % UID_SHARDS];
+        Shard.Access.acquireLock();
+        const std::size_t nNumber = std::min<std::size_t>(Shard.UnusedUIDs.size(), UID_BLOCK_SIZE);
+        _Cache.UnusedUIDs.insert(_Cache.UnusedUIDs.end(), Shard.UnusedUIDs.end()-nNumber, Shard.UnusedUIDs.end());
+        Shard.UnusedUIDs.resize(Shard.UnusedUIDs.size()-nNumber);
+        Shard.Access.releaseLock();
+        
+        if (nNumber > 0u)
+        {
+            s_nUnusedShared.fetch_sub(nNumber, std::memory_order_relaxed);
+            return;
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Releases ID not referenced anymore
+///
+/// The ID is cached by the calling thread. If too many IDs are cached, the
+/// oldest are handed to the shard preferred by the calling thread.
+///
+/// \param _nUID ID to be released
+///
+///////////////////////////////////////////////////////////////////////////////
+void CUID::releaseID(const UIDType _nUID)
+{
+    METHOD_ENTRY("CUID::releaseID")
+    
+    if (s_CacheState == CacheStateType::DESTROYED)
+    {
+        addUnused(&_nUID, 1u, 0u);
+        return;
     }
-    s_ReferencedUIDs[nTmp] = 1u;
-    m_nUID = nTmp;
-    m_strName = "UID_"+std::to_string(m_nUID);
     
-    s_Access.releaseLock();
+    CacheType& Cache = s_Cache;
+    Cache.UnusedUIDs.push_back(_nUID);
+    if (Cache.UnusedUIDs.size() > UID_CACHE_SIZE_MAX)
+    {
+        const std::vector<UIDType> UIDs(Cache.UnusedUIDs.begin(), Cache.UnusedUIDs.begin()+UID_BLOCK_SIZE);
+        Cache.UnusedUIDs.erase(Cache.UnusedUIDs.begin(), Cache.UnusedUIDs.begin()+UID_BLOCK_SIZE);
+        addUnused(UIDs.data(), UIDs.size(), Cache.nShard);
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -196,12 +450,12 @@ void CUID::copy(const CUID& _UID)
     
     m_nUID = _UID.m_nUID;
     m_strName = _UID.m_strName;
-    s_ReferencedUIDs[_UID.m_nUID] += 1u;
+    m_pPrefix = _UID.m_pPrefix;
+    getRefs(m_nUID).fetch_add(1u, std::memory_order_relaxed);
 }
 
 SERIALIZE_IMPL(CUID,
     SERIALIZE("uid_value", m_nUID)
-    SERIALIZE("uid_value_max", s_nUID)
-    SERIALIZE("uid_name", m_strName)
+    SERIALIZE("uid_value_max", s_nUID.load())
+    SERIALIZE("uid_name", this->getName())
 )
-
@@ -32,21 +32,47 @@
 #define UID_H
 
 //--- Standard header --------------------------------------------------------//
+#include <array>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <deque>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 //--- Program header ---------------------------------------------------------//
 #include "log.h"
-#include "spinlock.h"
+#include "adaptive_lock.h"
 #include "serializable.h"
 
 using UIDType = std::uint32_t;
 
+//--- Constants --------------------------------------------------------------//
+constexpr UIDType     UID_BLOCK_SIZE = 64u;             ///< Number of fresh IDs a thread takes from the global counter at once
+constexpr std::size_t UID_CACHE_SIZE_MAX = 256u;        ///< Number of unused IDs a thread keeps before handing them to shards
+constexpr std::size_t UID_SHARDS = 16u;                 ///< Number of shards for unused IDs shared between threads
+constexpr int         UID_REFS_CHUNK_BITS = 16;         ///< Bits of ID addressing a reference counter within a chunk
+constexpr std::size_t UID_REFS_CHUNK_SIZE = std::size_t(1) << UID_REFS_CHUNK_BITS;  ///< Reference counters per chunk
+constexpr std::size_t UID_REFS_CHUNKS = std::size_t(1) << (32 - UID_REFS_CHUNK_BITS); ///< Chunks covering all IDs
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Class that manages a unique ID to identify objects etc.
 ///
+/// Each thread takes blocks of fresh IDs from a global atomic counter and
+/// caches released IDs, thus, most IDs are allocated and released without
+/// any lock. If a thread caches too many released IDs, a batch of them is
+/// handed to one of some shards where other threads can pick them up. Only
+/// shards are locked, once per batch.
+///
+/// IDs are reference counted due to copy constructor and copy assignment
+/// operator duplication of UIDs. Since IDs are dense, reference counters are
+/// stored in an array, allocated in chunks on demand and indexed by ID.
+///
+/// Names are formatted lazily from an optional prefix and the ID value,
+/// unless a name is set explicitly.
+///
 ////////////////////////////////////////////////////////////////////////////////
 class CUID : public ISerializable
 {
@@ -61,31 +87,74 @@ class CUID : public ISerializable
         CUID& operator=(const CUID&);
         
         //--- Constant Methods -----------------------------------------------//
-        const std::string&  getName() const;
+        std::string         getName() const;
         const UIDType&      getValue() const;
         
         //--- Methods --------------------------------------------------------//
         void setName(const std::string&);
+        void setNamePrefix(const char* const);
         void setNewID();
         
         //--- Static methods -------------------------------------------------//
-        static const std::deque<UIDType>& getUnusedUIDs();
-        static const std::unordered_map<UIDType, std::uint32_t>& getReferencedUIDs();
+        static std::deque<UIDType> getUnusedUIDs();
+        static std::unordered_map<UIDType, std::uint32_t> getReferencedUIDs();
+        static std::size_t getNumberOfReserved();
+        static void reserve(const std::size_t);
+        static void unreserve();
         
     private:
         
+        /// IDs cached by a thread
+        struct CacheType
+        {
+            CacheType();
+            ~CacheType();
+            
+            std::deque<UIDType> UnusedUIDs;     ///< Released IDs, used first
+            std::deque<UIDType> ReservedUIDs;   ///< Reserved IDs, already referenced
+            UIDType             nNext;          ///< Next fresh ID of current block
+            UIDType             nEnd;           ///< End of current block
+            std::size_t         nShard;         ///< Shard preferred by thread
+        };
+        
+        /// Unused IDs shared between threads
+        struct ShardType
+        {
+            ShardType() : Access("CUID::ShardType::Access") {}
+            
+            CAdaptiveLock        Access;        ///< Lock guarding unused IDs
+            std::vector<UIDType> UnusedUIDs;    ///< Unused IDs
+        };
+        
+        /// State of cache of calling thread
+        enum class CacheStateType : std::uint8_t
+        {
+            NONE,
+            VALID,
+            DESTROYED
+        };
+        
         //--- Methods [private] ----------------------------------------------//
         void copy(const CUID&);
         
+        static UIDType acquireID();
+        static void    addUnused(const UIDType* const, const std::size_t, const std::size_t);
+        static std::atomic<std::uint32_t>& getRefs(const UIDType);
+        static std::array<ShardType, UID_SHARDS>& getShards();
+        static void    refillCache(CacheType&);
+        static void    releaseID(const UIDType);
+        
         //--- Variables [private] --------------------------------------------//
                UIDType             m_nUID;              ///< Unique ID for this instance
-               std::string         m_strName;           ///< Name for this instance
+               std::string         m_strName;           ///< Name for this instance, if set explicitly
+               const char*         m_pPrefix;           ///< Prefix of name, must be a static string
                
-        static UIDType             s_nUID;              ///< Unique ID counter
-        static std::deque<UIDType> s_UnusedUIDs;        ///< Storage for unused / released IDs
-        static std::unordered_map<UIDType, std::uint32_t> s_ReferencedUIDs; ///< Storage for reference counting of uids
+        static std::atomic<UIDType>     s_nUID;         ///< Unique ID counter
+        static std::atomic<std::size_t> s_nUnusedShared;///< Number of unused IDs in shards
+        static std::array<std::atomic<std::atomic<std::uint32_t>*>, UID_REFS_CHUNKS> s_RefChunks; ///< Chunks of reference counters
         
-        static CSpinlock           s_Access;            ///< Global lock
+        static thread_local CacheType       s_Cache;        ///< IDs cached by calling thread
+        static thread_local CacheStateType  s_CacheState;   ///< State of cache, it might be gone on thread exit
         
         SERIALIZE_DECL
 };
@@ -96,13 +165,16 @@ class CUID : public ISerializable
 ///
 /// \brief Returns the name as identifier
 ///
+/// If no name was set explicitly, it is formatted from prefix and ID value.
+///
 /// \return Name as identifier
 ///
 ////////////////////////////////////////////////////////////////////////////////
-inline const std::string& CUID::getName() const
+inline std::string CUID::getName() const
 {
     METHOD_ENTRY("CUID::getName")
-    return m_strName;
+    if (!m_strName.empty()) return m_strName;
+    return m_pPrefix + ("UID_" + std::to_string(m_nUID));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -133,31 +205,47 @@ inline void CUID::setName(const std::string& _strName)
 
 ////////////////////////////////////////////////////////////////////////////////
 ///
-/// \brief Returns all unused UIDs
+/// \brief Sets a prefix for the default name
 ///
-/// \return Unused UIDs
+/// The prefix isn't copied, hence, it has to be a static string.
+///
+/// \param _pPrefix Prefix of default name
 ///
 ////////////////////////////////////////////////////////////////////////////////
-inline const std::deque<UIDType>& CUID::getUnusedUIDs()
+inline void CUID::setNamePrefix(const char* const _pPrefix)
 {
-    METHOD_ENTRY("CUID::getUnusedUIDs")
-    return s_UnusedUIDs;
+    METHOD_ENTRY("CUID::setNamePrefix")
+    m_pPrefix = _pPrefix;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ///
-/// \brief Returns all referenced UIDs
+/// \brief Returns reference counter of given ID
+///
+/// Chunks of counters are allocated on first use. If two threads allocate the
+/// same chunk, the loser frees its chunk. Chunks are kept until program exit,
+/// since static UIDs might be destroyed late.
 ///
-/// UIDs are reference counted due to copy constructor and copy assignment
-/// operator duplication of UIDs.
+/// \param _nUID ID to return reference counter for
 ///
-/// \return Referenced UIDs
+/// \return Reference counter
 ///
 ////////////////////////////////////////////////////////////////////////////////
-inline const std::unordered_map<UIDType, std::uint32_t>& CUID::getReferencedUIDs()
+inline std::atomic<std::uint32_t>& CUID::getRefs(const UIDType _nUID)
 {
-    METHOD_ENTRY("CUID::getReferencedUIDs")
-    return s_ReferencedUIDs;
+    METHOD_ENTRY("CUID::getRefs")
+    
+    auto& Chunk = s_RefChunks[_nUID >> UID_REFS_CHUNK_BITS];
+    std::atomic<std::uint32_t>* pChunk = Chunk.load(std::memory_order_acquire);
+    if (pChunk == nullptr)
+    {
+        std::atomic<std::uint32_t>* pChunkNew = new std::atomic<std::uint32_t>[UID_REFS_CHUNK_SIZE]();
+        if (Chunk.compare_exchange_strong(pChunk, pChunkNew, std::memory_order_acq_rel))
+            pChunk = pChunkNew;
+        else
+            delete[] pChunkNew;
+    }
+    return pChunk[_nUID & (UID_REFS_CHUNK_SIZE-1u)];
 }
 
 #endif // CUID
@@ -50,7 +50,7 @@ class IUIDUser
     public:
    
         //--- Constant Methods -----------------------------------------------//
-        const std::string&  getName() const;
+        std::string         getName() const;
               UIDType       getUID() const;
         
         //--- Methods --------------------------------------------------------//
@@ -72,7 +72,7 @@ class IUIDUser
 /// \return Name of entity
 ///
 ////////////////////////////////////////////////////////////////////////////////
-inline const std::string& IUIDUser::getName() const
+inline std::string IUIDUser::getName() const
 {
     METHOD_ENTRY("IUIDUser::getName")
     return m_UID.getName();
@@ -42,7 +42,8 @@
 ///
 ///////////////////////////////////////////////////////////////////////////////
 CWorldDataStorage::CWorldDataStorage() : m_pUniverse(nullptr),
-                                         m_bFrontNew(false),
+                                         m_nNumberOfCopied(0),
+                                         m_nNumberOfSkipped(0),
                                          m_fTimeScale(1.0)                                 
 {
     METHOD_ENTRY("CWorldDataStorage::CWorldDataStorage")
@@ -51,6 +52,12 @@ CWorldDataStorage::CWorldDataStorage() : m_pUniverse(nullptr),
     // Setup a clean environment
     m_UIDUsersByValue.resizeBuffer(WDS_DEFAULT_UID_BUFFER_SIZE);
     m_UIDUsersByValue.fillBuffer(nullptr);
+    
+    // Front and middle buffers are handed over in frames, the back buffer
+    // is owned by physics
+    this->initFrame<BUFFER_QUADRUPLE_FRONT>();
+    this->initFrame<BUFFER_QUADRUPLE_MIDDLE_FRONT>();
+    this->initFrame<BUFFER_QUADRUPLE_MIDDLE_BACK>();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -197,7 +204,7 @@ bool CWorldDataStorage::addParticle(CParticle* _pParticle)
     std::array<IUIDUser*, BUFFER_QUADRUPLE> aUIDUsers =
     {{aParticle[0],aParticle[1],aParticle[2],aParticle[3]}};
     
-    m_ParticlesByName.add(_pParticle->getName(), aParticle);
+    m_ParticlesByName.add(CStringTable::intern(_pParticle->getName()), aParticle);
     m_ParticlesByValue.add(_pParticle->getUID(), aParticle);
     
     if (!this->addUIDUser(aUIDUsers)) return false;
@@ -243,6 +250,10 @@ bool CWorldDataStorage::addObject(CObject* _pObject)
     {{&aObjects[0]->getKinematicsState(), &aObjects[1]->getKinematicsState(),
       &aObjects[2]->getKinematicsState(), &aObjects[3]->getKinematicsState()}};
     
+    // Only the back buffer object, used by physics, is bound to the
+    // kinematics store
+    m_KinematicsStore.add(_pObject);
+    
     // Initialise new objects
     for (const auto& pObj : aObjects) pObj->init();
     
@@ -454,8 +465,9 @@ CObject* CWorldDataStorage::getObjectByValueFront(const UIDType _nUID)
     METHOD_ENTRY("CWorldDataStorage::getObjectByValueFront")
 
     AccessObjects.waitForRelease();
-    const auto ci = m_ObjectsByValue.getBuffer<BUFFER_QUADRUPLE_FRONT>()->find(_nUID);
-    if (ci != m_ObjectsByValue.getBuffer<BUFFER_QUADRUPLE_FRONT>()->end())
+    const ObjectsByValueType* const pObjects = this->getObjectsByValueFront();
+    const auto ci = pObjects->find(_nUID);
+    if (ci != pObjects->end())
     {
         return ci->second;
     }
@@ -506,8 +518,9 @@ CObjectPlanet* CWorldDataStorage::getObjectPlanetByValueFront(const UIDType _nUI
     METHOD_ENTRY("CWorldDataStorage::getObjectPlanetByValueFront")
 
     AccessObjectsPlanets.waitForRelease();
-    const auto ci = m_ObjectsPlanetsByValue.getBuffer<BUFFER_QUADRUPLE_FRONT>()->find(_nUID);
-    if (ci != m_ObjectsPlanetsByValue.getBuffer<BUFFER_QUADRUPLE_FRONT>()->end())
+    const ObjectsPlanetsByValueType* const pObjects = this->getObjectsPlanetsByValueFront();
+    const auto ci = pObjects->find(_nUID);
+    if (ci != pObjects->end())
     {
         return ci->second;
     }
@@ -619,59 +632,129 @@ bool CWorldDataStorage::addUIDUser(IUIDUser* _pUIDUser)
     else
     {
         m_UIDUsersByValue.setAt(_pUIDUser->getUID(), _pUIDUser);
-        m_UIDsByName.insert(std::pair<std::string,UIDType>(_pUIDUser->getName(), _pUIDUser->getUID()));
+        m_UIDsByName.insert({CStringTable::intern(_pUIDUser->getName()), _pUIDUser->getUID()});
         return true;
     }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ///
-/// \brief Swaps back buffer for all internal buffers
+/// \brief Applies front render snapshot to objects of front buffer
+///
+/// Snapshot and buffers are ordered alike. If objects were added in between,
+/// objects are looked up by UID until both are in line again.
 ///
 ////////////////////////////////////////////////////////////////////////////////
-void CWorldDataStorage::swapBack()
+void CWorldDataStorage::applyRenderSnapshot()
 {
-    METHOD_ENTRY("CWorldDataStorage::swapBack")
+    METHOD_ENTRY("CWorldDataStorage::applyRenderSnapshot")
+
+    const WorldDataFrameType* const pFrame = m_Frames.getBuffer<BUFFER_TRIPLE_FRONT>();
+    ObjectsByValueType* const pObjects = pFrame->pObjectsByValue;
+    auto it = pObjects->begin();
+    for (const auto& State : pFrame->RenderSnapshot)
+    {
+        if (it == pObjects->end() || it->first != State.nUID)
+        {
+            it = pObjects->find(State.nUID);
+            if (it == pObjects->end()) continue;
+        }
+        it->second->setRenderState(State);
+        ++it;
+    }
+}
 
-    m_AccessFront.acquireLock();
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Captures render state of all objects of back buffer into back frame
+///
+////////////////////////////////////////////////////////////////////////////////
+void CWorldDataStorage::captureRenderSnapshot()
+{
+    METHOD_ENTRY("CWorldDataStorage::captureRenderSnapshot")
+
+    const ObjectsByValueType* const pObjects = m_ObjectsByValue.getBuffer<BUFFER_QUADRUPLE_BACK>();
+    RenderSnapshotType& Snapshot = m_Frames.getBuffer<BUFFER_TRIPLE_BACK>()->RenderSnapshot;
+    Snapshot.resize(pObjects->size());
     
-    m_ParticlesByName.swap<BUFFER_QUADRUPLE_MIDDLE_BACK, BUFFER_QUADRUPLE_MIDDLE_FRONT>();
-    m_ParticlesByValue.swap<BUFFER_QUADRUPLE_MIDDLE_BACK, BUFFER_QUADRUPLE_MIDDLE_FRONT>();
-    m_ParticlesByValue.copyDeep<BUFFER_QUADRUPLE_BACK, BUFFER_QUADRUPLE_MIDDLE_BACK>();
+    auto it = Snapshot.begin();
+    for (const auto& Obj : *pObjects)
+    {
+        Obj.second->getRenderState(*it);
+        ++it;
+    }
+}
 
-    m_ObjectsByValue.swap<BUFFER_QUADRUPLE_MIDDLE_BACK, BUFFER_QUADRUPLE_MIDDLE_FRONT>();
-    m_ObjectsPlanetsByValue.swap<BUFFER_QUADRUPLE_MIDDLE_BACK, BUFFER_QUADRUPLE_MIDDLE_FRONT>();
-    m_UIDUsersByValue.swap<BUFFER_QUADRUPLE_MIDDLE_BACK, BUFFER_QUADRUPLE_MIDDLE_FRONT>();
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets frame of triple buffer to given buffer of multi buffers
+///
+/// Frame and buffer share the index, i.e. front, middle and back of the
+/// triple buffer initially refer to front, first and second middle buffer.
+///
+////////////////////////////////////////////////////////////////////////////////
+template<std::uint8_t I>
+void CWorldDataStorage::initFrame()
+{
+    METHOD_ENTRY("CWorldDataStorage::initFrame")
+    
+    WorldDataFrameType* const pFrame = m_Frames.getBufferByIndex(I);
+    pFrame->pParticlesByName = m_ParticlesByName.getBuffer<I>();
+    pFrame->pParticlesByValue = m_ParticlesByValue.getBuffer<I>();
+    pFrame->pObjectsByValue = m_ObjectsByValue.getBuffer<I>();
+    pFrame->pObjectsPlanetsByValue = m_ObjectsPlanetsByValue.getBuffer<I>();
+    pFrame->pUIDUsersByValue = m_UIDUsersByValue.getBuffer<I>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Publishes back buffer of physics to graphical clients
+///
+/// Changed entities are copied to the back frame of the triple buffer, which
+/// is then handed over without locking.
+///
+////////////////////////////////////////////////////////////////////////////////
+void CWorldDataStorage::swapBack()
+{
+    METHOD_ENTRY("CWorldDataStorage::swapBack")
+
+    WorldDataFrameType* const pFrame = m_Frames.getBuffer<BUFFER_TRIPLE_BACK>();
     
-    m_ObjectsByValue.copyDeep<BUFFER_QUADRUPLE_BACK, BUFFER_QUADRUPLE_MIDDLE_BACK>();
+    this->captureRenderSnapshot();
     
-    m_bFrontNew = true;
+    // Only changed entities are copied, unchanged copies of the same
+    // generation are up to date. State changing each frame is published by
+    // the render snapshot, objects are only copied if anything else changed.
+    m_nNumberOfCopied = m_ParticlesByValue.copyDeep<BUFFER_QUADRUPLE_BACK>(pFrame->pParticlesByValue,
+        [](const CParticle* const _pSrc, const CParticle* const _pDst) -> bool
+        {
+            return _pSrc->getGeneration() == _pDst->getGeneration();
+        });
+    m_nNumberOfCopied += m_ObjectsByValue.copyDeep<BUFFER_QUADRUPLE_BACK>(pFrame->pObjectsByValue,
+        [](const CObject* const _pSrc, const CObject* const _pDst) -> bool
+        {
+            return _pSrc->getGeneration() == _pDst->getGeneration();
+        });
+    m_nNumberOfSkipped = m_ParticlesByValue.getBuffer<BUFFER_QUADRUPLE_BACK>()->size() +
+                         m_ObjectsByValue.getBuffer<BUFFER_QUADRUPLE_BACK>()->size() -
+                         m_nNumberOfCopied;
     
-    m_AccessFront.releaseLock();
+    m_Frames.swapBack();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ///
-/// \brief Swaps front buffer for all internal buffers
+/// \brief Fetches latest frame published by physics, if any
+///
+/// Never blocks, the front buffer stays unchanged if there is no new frame.
 ///
 ////////////////////////////////////////////////////////////////////////////////
 void CWorldDataStorage::swapFront()
 {
     METHOD_ENTRY("CWorldDataStorage::swapFront")
-   
-    m_AccessFront.acquireLock();
-    
-    if (m_bFrontNew)
-    {
-        m_ParticlesByName.swap<BUFFER_QUADRUPLE_MIDDLE_FRONT, BUFFER_QUADRUPLE_FRONT>();
-        m_ParticlesByValue.swap<BUFFER_QUADRUPLE_MIDDLE_FRONT, BUFFER_QUADRUPLE_FRONT>();
-        m_ObjectsByValue.swap<BUFFER_QUADRUPLE_MIDDLE_FRONT, BUFFER_QUADRUPLE_FRONT>();
-        m_ObjectsPlanetsByValue.swap<BUFFER_QUADRUPLE_MIDDLE_FRONT, BUFFER_QUADRUPLE_FRONT>();
-        m_UIDUsersByValue.swap<BUFFER_QUADRUPLE_MIDDLE_FRONT, BUFFER_QUADRUPLE_FRONT>();
-        m_bFrontNew = false;
-    }
     
-    m_AccessFront.releaseLock();
+    // Front buffer is owned by caller, no need to lock while applying
+    if (m_Frames.swapFront()) this->applyRenderSnapshot();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -908,7 +991,7 @@ bool CWorldDataStorage::addUIDUser(const std::array<IUIDUser*, BUFFER_QUADRUPLE>
     else
     {
         m_UIDUsersByValue.setAt(_aUIDUser[0]->getUID(), _aUIDUser);
-        m_UIDsByName.insert(std::pair<std::string,UIDType>(_aUIDUser[0]->getName(), _aUIDUser[0]->getUID()));
+        m_UIDsByName.insert({CStringTable::intern(_aUIDUser[0]->getName()), _aUIDUser[0]->getUID()});
         return true;
     }
 }
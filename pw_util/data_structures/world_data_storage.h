@@ -32,16 +32,21 @@
 #define WORLD_DATA_STORAGE_H
 
 //--- Standard header --------------------------------------------------------//
+#include <array>
 #include <list>
 #include <map>
 #include <unordered_map>
 #include <vector>
 
 //--- Program header ---------------------------------------------------------//
+#include "atomic_triple_buffer.h"
 #include "joint.h"
 #include "multi_buffer.h"
-#include "spinlock.h"
+#include "render_snapshot.h"
+#include "adaptive_lock.h"
 #include "serializable.h"
+#include "slot_map.h"
+#include "string_table.h"
 #include "uid_user.h"
 #include "universe.h"
 
@@ -54,31 +59,31 @@ class CThruster;
 
 typedef std::list<IJoint*>                      JointsType;                 ///< Specifies a list of joints
 
-/// Map of particles, accessed by name
-typedef std::unordered_map<std::string, CParticle*> ParticlesByNameType;
-/// Buffered particles, accessed by name
-typedef CMultiBuffer<BUFFER_QUADRUPLE, ParticlesByNameType, std::string, CParticle*> BufferedParticlesByNameType;
+/// Map of particles, accessed by interned name
+typedef std::unordered_map<StringIDType, CParticle*> ParticlesByNameType;
+/// Buffered particles, accessed by interned name
+typedef CMultiBuffer<BUFFER_QUADRUPLE, ParticlesByNameType, StringIDType, CParticle*> BufferedParticlesByNameType;
 /// Map of particles, accessed by UID value
-typedef std::unordered_map<UIDType, CParticle*> ParticlesByValueType;
+typedef CSlotMap<UIDType, CParticle*> ParticlesByValueType;
 /// Map of buffered particles, accessed by UID value
 typedef CMultiBuffer<BUFFER_QUADRUPLE, ParticlesByValueType, UIDType, CParticle*> BufferedParticlesByValueType;
 
 /// Map of emitters, accessed by UID value
-typedef std::unordered_map<UIDType, IEmitter*> EmittersByValueType;
+typedef CSlotMap<UIDType, IEmitter*> EmittersByValueType;
 /// Map of emitters, accessed by UID value
-typedef std::unordered_map<UIDType, CThruster*> ThrustersByValueType;
+typedef CSlotMap<UIDType, CThruster*> ThrustersByValueType;
 // /// Map of buffered emitters, accessed by UID value
 // typedef CMultiBuffer<BUFFER_TRIPLE, EmittersByValueType, UIDType, IEmitter*> BufferedEmittersByValueType;
 
 /// Map of objects, accessed by UID value
-typedef std::unordered_map<UIDType, CObject*> ObjectsByValueType;
+typedef CSlotMap<UIDType, CObject*> ObjectsByValueType;
 /// Map of buffered objects, accessed by UID value
 typedef CMultiBuffer<BUFFER_QUADRUPLE, ObjectsByValueType, UIDType, CObject*> BufferedObjectsByValueType;
 /// Map of shapes, accessed by UID value
-typedef std::unordered_map<UIDType, IShape*> ShapesByValueType;
+typedef CSlotMap<UIDType, IShape*> ShapesByValueType;
 
 /// Map of objects, accessed by UID value
-typedef std::unordered_map<UIDType, CObjectPlanet*> ObjectsPlanetsByValueType;
+typedef CSlotMap<UIDType, CObjectPlanet*> ObjectsPlanetsByValueType;
 /// Map of buffered planetary objects, accessed by UID value
 typedef CMultiBuffer<BUFFER_QUADRUPLE, ObjectsPlanetsByValueType, UIDType, CObjectPlanet*> BufferedObjectsPlanetsByValueType;
 
@@ -86,8 +91,19 @@ typedef CMultiBuffer<BUFFER_QUADRUPLE, ObjectsPlanetsByValueType, UIDType, CObje
 typedef std::vector<IUIDUser*> UIDUsersByValueType;
 /// Vector of buffered UID users, accessed by UID value
 typedef CMultiBuffer<BUFFER_QUADRUPLE, UIDUsersByValueType, IUIDUser*> BufferedUIDUsersByValueType;
-/// Map of UIDs, accessed by name
-typedef std::unordered_map<std::string, UIDType> UIDsByNameType;
+/// Map of UIDs, accessed by interned name
+typedef std::unordered_map<StringIDType, UIDType> UIDsByNameType;
+
+/// Buffers of one frame, handed over from physics to graphical clients
+struct WorldDataFrameType
+{
+    ParticlesByNameType*        pParticlesByName;           ///< Particles, accessed by name
+    ParticlesByValueType*       pParticlesByValue;          ///< Particles, accessed by value
+    ObjectsByValueType*         pObjectsByValue;            ///< Objects, accessed by UID value
+    ObjectsPlanetsByValueType*  pObjectsPlanetsByValue;     ///< Planetary objects, accessed by UID value
+    UIDUsersByValueType*        pUIDUsersByValue;           ///< UID users, accessed by value
+    RenderSnapshotType          RenderSnapshot;             ///< Render state of objects
+};
 
 const std::uint16_t WDS_DEFAULT_UID_BUFFER_SIZE = 32768; ///< Default size of value buffer
 
@@ -107,6 +123,8 @@ class CWorldDataStorage : public ISerializable
         
         //--- Constant Methods -----------------------------------------------//
         const JointsType&           getJoints() const;
+        int                         getNumberOfCopied() const;
+        int                         getNumberOfSkipped() const;
         const double&               getTimeScale() const;
         
         //--- Methods --------------------------------------------------------//
@@ -126,6 +144,7 @@ class CWorldDataStorage : public ISerializable
         CUniverse*                  getUniverse();
         
         IEmitter*                   getEmitterByValue(const UIDType);
+        CKinematicsStore*           getKinematicsStore();
         CObject*                    getObjectByValueBack(const UIDType);
         CObject*                    getObjectByValueFront(const UIDType);
         CObjectPlanet*              getObjectPlanetByValueBack(const UIDType);
@@ -162,18 +181,22 @@ class CWorldDataStorage : public ISerializable
         friend std::ostream& operator<<(std::ostream&, CWorldDataStorage&);
         
         //--- Variables ------------------------------------------------------//
-        CSpinlock AccessEmitters;
-        CSpinlock AccessNames;
-        CSpinlock AccessObjects;
-        CSpinlock AccessObjectsPlanets;
-        CSpinlock AccessParticles;
-        CSpinlock AccessShapes;
-        CSpinlock AccessThrusters;
+        CAdaptiveLock AccessEmitters{"CWorldDataStorage::AccessEmitters"};
+        CAdaptiveLock AccessNames{"CWorldDataStorage::AccessNames"};
+        CAdaptiveLock AccessObjects{"CWorldDataStorage::AccessObjects"};
+        CAdaptiveLock AccessObjectsPlanets{"CWorldDataStorage::AccessObjectsPlanets"};
+        CAdaptiveLock AccessParticles{"CWorldDataStorage::AccessParticles"};
+        CAdaptiveLock AccessShapes{"CWorldDataStorage::AccessShapes"};
+        CAdaptiveLock AccessThrusters{"CWorldDataStorage::AccessThrusters"};
         
     private:
         
         //--- Methods [private] ----------------------------------------------//
         bool addUIDUser(const std::array<IUIDUser*,BUFFER_QUADRUPLE>&);
+        void applyRenderSnapshot();
+        void captureRenderSnapshot();
+        template<std::uint8_t I>
+        void initFrame();
       
         CUniverse*                      m_pUniverse;            ///< The procedurally generated universe
         
@@ -183,17 +206,19 @@ class CWorldDataStorage : public ISerializable
         BufferedObjectsByValueType          m_ObjectsByValue;           ///< Buffered objects, accessed by UID value+
         BufferedObjectsPlanetsByValueType   m_ObjectsPlanetsByValue;    ///< Buffered planetary objects, accessed by UID value+
         BufferedUIDUsersByValueType         m_UIDUsersByValue;          ///< Buffered UID users, accessed by value
+        CAtomicTripleBuffer<WorldDataFrameType> m_Frames;           ///< Frames handed over to graphical clients, lock-free
 
         // Entities of physics engine
         EmittersByValueType         m_EmittersByValue;          ///< Emitters, accessed by value
+        CKinematicsStore            m_KinematicsStore;          ///< Kinematics of objects in back buffer
         ShapesByValueType           m_ShapesByValue;            ///< Shapes, accessed by UID value
         ThrustersByValueType        m_ThrustersByValue;         ///< Thrusters, accessed by UID value
         UIDsByNameType              m_UIDsByName;               ///< UIDs of entities, accessed by name
         
         JointsType                  m_Joints;                   ///< List of joints
         
-        CSpinlock                   m_AccessFront;              ///< Spinlock for thread safety when swapping
-        bool                        m_bFrontNew;                ///< Indicates new information for front buffer
+        int                         m_nNumberOfCopied;          ///< Number of objects and particles copied by last swap
+        int                         m_nNumberOfSkipped;         ///< Number of unchanged objects and particles skipped by last swap
         double                      m_fTimeScale;               ///< Factor for global acceleration of time
         
         SERIALIZE_DECL
@@ -214,6 +239,32 @@ inline const JointsType& CWorldDataStorage::getJoints() const
     return m_Joints;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of objects and particles copied by last swap
+///
+/// \return Number of copied entities
+///
+////////////////////////////////////////////////////////////////////////////////
+inline int CWorldDataStorage::getNumberOfCopied() const
+{
+    METHOD_ENTRY("CWorldDataStorage::getNumberOfCopied")
+    return m_nNumberOfCopied;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns number of unchanged objects and particles skipped by last swap
+///
+/// \return Number of skipped entities
+///
+////////////////////////////////////////////////////////////////////////////////
+inline int CWorldDataStorage::getNumberOfSkipped() const
+{
+    METHOD_ENTRY("CWorldDataStorage::getNumberOfSkipped")
+    return m_nNumberOfSkipped;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Returns the global time scale of the simulation
@@ -263,7 +314,7 @@ inline EmittersByValueType* CWorldDataStorage::getEmittersByValue()
 inline ParticlesByNameType* CWorldDataStorage::getParticlesByNameFront()
 {
     METHOD_ENTRY("CWorldDataStorage::getParticlesByNameFront")
-    return m_ParticlesByName.getBuffer<BUFFER_QUADRUPLE_FRONT>();
+    return m_Frames.getBuffer<BUFFER_TRIPLE_FRONT>()->pParticlesByName;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -302,7 +353,20 @@ inline ParticlesByValueType* CWorldDataStorage::getParticlesByValueBack()
 inline ParticlesByValueType* CWorldDataStorage::getParticlesByValueFront()
 {
     METHOD_ENTRY("CWorldDataStorage::getParticlesByValueFront")
-    return m_ParticlesByValue.getBuffer<BUFFER_QUADRUPLE_FRONT>();
+    return m_Frames.getBuffer<BUFFER_TRIPLE_FRONT>()->pParticlesByValue;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns kinematics store of objects in back buffer
+///
+/// \return Kinematics store
+///
+////////////////////////////////////////////////////////////////////////////////
+inline CKinematicsStore* CWorldDataStorage::getKinematicsStore()
+{
+    METHOD_ENTRY("CWorldDataStorage::getKinematicsStore")
+    return &m_KinematicsStore;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -328,7 +392,7 @@ inline ObjectsByValueType* CWorldDataStorage::getObjectsByValueBack()
 inline ObjectsByValueType* CWorldDataStorage::getObjectsByValueFront()
 {
     METHOD_ENTRY("CWorldDataStorage::getObjectsByValueFront")
-    return m_ObjectsByValue.getBuffer<BUFFER_QUADRUPLE_FRONT>();
+    return m_Frames.getBuffer<BUFFER_TRIPLE_FRONT>()->pObjectsByValue;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -354,7 +418,7 @@ inline ObjectsPlanetsByValueType* CWorldDataStorage::getObjectsPlanetsByValueBac
 inline ObjectsPlanetsByValueType* CWorldDataStorage::getObjectsPlanetsByValueFront()
 {
     METHOD_ENTRY("CWorldDataStorage::getObjectsPlanetsByValueFront")
-    return m_ObjectsPlanetsByValue.getBuffer<BUFFER_QUADRUPLE_FRONT>();
+    return m_Frames.getBuffer<BUFFER_TRIPLE_FRONT>()->pObjectsPlanetsByValue;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -419,7 +483,7 @@ inline ShapesByValueType* CWorldDataStorage::getShapesByValue()
 inline UIDUsersByValueType* CWorldDataStorage::getUIDUsersByValueFront()
 {
     METHOD_ENTRY("CWorldDataStorage::getUIDUsersByValueFront")
-    return m_UIDUsersByValue.getBuffer<BUFFER_QUADRUPLE_FRONT>();
+    return m_Frames.getBuffer<BUFFER_TRIPLE_FRONT>()->pUIDUsersByValue;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
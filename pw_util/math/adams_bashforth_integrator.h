@@ -52,6 +52,9 @@ class CAdamsBashforthIntegrator : public IIntegrator<T>
         CAdamsBashforthIntegrator();
         ~CAdamsBashforthIntegrator();
 
+        //--- Memory management ----------------------------------------------//
+        POOL_ALLOCATION(CAdamsBashforthIntegrator<T>, 1)
+
         //--- Constant Methods -----------------------------------------------//
         IIntegrator<T>* clone() const;
         const T         getPrevValue() const;
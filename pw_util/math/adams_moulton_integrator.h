@@ -52,6 +52,9 @@ class CAdamsMoultonIntegrator : public IIntegrator<T>
         CAdamsMoultonIntegrator();
         ~CAdamsMoultonIntegrator();
 
+        //--- Memory management ----------------------------------------------//
+        POOL_ALLOCATION(CAdamsMoultonIntegrator<T>, 1)
+
         //--- Constant Methods -----------------------------------------------//
         IIntegrator<T>* clone() const;
         const T         getPrevValue() const;
@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       batch_integrator.h
+/// \brief      Prototype of template class "CBatchIntegrator"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-16
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef BATCH_INTEGRATOR_H
+#define BATCH_INTEGRATOR_H
+
+//--- Standard header --------------------------------------------------------//
+#include <array>
+#include <vector>
+
+//--- Program header ---------------------------------------------------------//
+#include "integrator.h"
+
+//--- Constants --------------------------------------------------------------//
+const int BATCH_INTEGRATOR_HISTORY_DEPTH = 5; ///< Depth of derivative history, Adams-Moulton needs the most
+
+/// Derivative history of a batch, one array per past step, newest first
+template <class T>
+using BatchHistoryType = std::array<std::vector<T>, BATCH_INTEGRATOR_HISTORY_DEPTH>;
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Kernels integrating whole arrays of values at once
+///
+/// This is the batched counterpart of \ref CEulerIntegrator,
+/// \ref CAdamsBashforthIntegrator and \ref CAdamsMoultonIntegrator. Values,
+/// derivatives and the derivative history are given as separate arrays
+/// (structure of arrays), a range of them is integrated in one loop without
+/// any virtual calls. The integration scheme is a template parameter, thus
+/// the loop body is fixed at compile time. Floating point operations are the
+/// same as those of the single value integrators.
+///
+////////////////////////////////////////////////////////////////////////////////
+template <IntegratorType TIntegrator, class T>
+class CBatchIntegrator
+{
+
+    public:
+
+        //--- Static Methods -------------------------------------------------//
+        static void integrate(std::vector<T>&, BatchHistoryType<T>&,
+                              const std::vector<T>&, const std::vector<double>&,
+                              const double&, const int, const int);
+        static void integrateClip(std::vector<T>&, BatchHistoryType<T>&,
+                                  const std::vector<T>&, const std::vector<double>&,
+                                  const double&, const int, const int, const T&);
+
+    private:
+
+        //--- Static Methods [private] ---------------------------------------//
+        static T derive(BatchHistoryType<T>&, const T&, const int);
+};
+
+//--- Implementation of template members -------------------------------------//
+#include "batch_integrator.tpp"
+
+#endif // BATCH_INTEGRATOR_H
@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       batch_integrator.tpp
+/// \brief      Implementation of template class "CBatchIntegrator"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-16
+///
+////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Integrates a range of values
+///
+/// \param _Values Values to integrate
+/// \param _History Derivative history of values
+/// \param _Derivs Current derivatives of values
+/// \param _TimeFacs Time factors, multiplied with time step
+/// \param _fTimeStep Time step
+/// \param _nFirst First index of range
+/// \param _nLast Index behind last index of range
+///
+///////////////////////////////////////////////////////////////////////////////
+template <IntegratorType TIntegrator, class T>
+void CBatchIntegrator<TIntegrator, T>::integrate(std::vector<T>& _Values,
+                                                 BatchHistoryType<T>& _History,
+                                                 const std::vector<T>& _Derivs,
+                                                 const std::vector<double>& _TimeFacs,
+                                                 const double& _fTimeStep,
+                                                 const int _nFirst,
+                                                 const int _nLast)
+{
+    METHOD_ENTRY("CBatchIntegrator::integrate")
+
+    for (auto i=_nFirst; i<_nLast; ++i)
+    {
+        _Values[i] += derive(_History, _Derivs[i], i) * (_fTimeStep*_TimeFacs[i]);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Integrates a range of values, clipping them to a given interval
+///
+/// Clipping is done as in single value integrators, e.g. for angles.
+///
+/// \param _Values Values to integrate
+/// \param _History Derivative history of values
+/// \param _Derivs Current derivatives of values
+/// \param _TimeFacs Time factors, multiplied with time step
+/// \param _fTimeStep Time step
+/// \param _nFirst First index of range
+/// \param _nLast Index behind last index of range
+/// \param _Clip Clipping value
+///
+///////////////////////////////////////////////////////////////////////////////
+template <IntegratorType TIntegrator, class T>
+void CBatchIntegrator<TIntegrator, T>::integrateClip(std::vector<T>& _Values,
+                                                     BatchHistoryType<T>& _History,
+                                                     const std::vector<T>& _Derivs,
+                                                     const std::vector<double>& _TimeFacs,
+                                                     const double& _fTimeStep,
+                                                     const int _nFirst,
+                                                     const int _nLast,
+                                                     const T& _Clip)
+{
+    METHOD_ENTRY("CBatchIntegrator::integrateClip")
+
+    // Separate loops, the first one being free of branches
+    CBatchIntegrator<TIntegrator, T>::integrate(_Values, _History, _Derivs, _TimeFacs,
+                                                _fTimeStep, _nFirst, _nLast);
+
+    for (auto i=_nFirst; i<_nLast; ++i)
+    {
+        int nF = floor(_Values[i] / _Clip);
+        if (nF >= 1)
+            _Values[i] -= nF*_Clip;
+        else if (nF <= -2)
+            _Values[i] -= (nF+1)*_Clip;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Shifts history of given index and returns derivative to integrate
+///
+/// The branches depend on template parameters only and are resolved at
+/// compile time.
+///
+/// \param _History Derivative history of values
+/// \param _Deriv Current derivative
+/// \param _nI Index
+///
+/// \return Derivative, weighted by integration scheme
+///
+///////////////////////////////////////////////////////////////////////////////
+template <IntegratorType TIntegrator, class T>
+inline T CBatchIntegrator<TIntegrator, T>::derive(BatchHistoryType<T>& _History,
+                                                  const T& _Deriv,
+                                                  const int _nI)
+{
+    METHOD_ENTRY("CBatchIntegrator::derive")
+
+    if (TIntegrator == INTEGRATOR_ADAMS_BASHFORTH)
+    {
+        _History[3][_nI] = _History[2][_nI];
+        _History[2][_nI] = _History[1][_nI];
+        _History[1][_nI] = _History[0][_nI];
+        _History[0][_nI] = _Deriv;
+
+        return (_History[0][_nI] * 55.0/24.0 -
+                _History[1][_nI] * 59.0/24.0 +
+                _History[2][_nI] * 37.0/24.0 -
+                _History[3][_nI] *  3.0/ 8.0);
+    }
+    else if (TIntegrator == INTEGRATOR_ADAMS_MOULTON)
+    {
+        _History[4][_nI] = _History[3][_nI];
+        _History[3][_nI] = _History[2][_nI];
+        _History[2][_nI] = _History[1][_nI];
+        _History[1][_nI] = _History[0][_nI];
+        _History[0][_nI] = _Deriv;
+
+        return (_History[0][_nI] * 251.0/720.0 +
+                _History[1][_nI] * 646.0/720.0 -
+                _History[2][_nI] * 264.0/720.0 +
+                _History[3][_nI] * 106.0/720.0 -
+                _History[4][_nI] * 19.0 /720.0);
+    }
+    // Euler doesn't need any history
+    return _Deriv;
+}
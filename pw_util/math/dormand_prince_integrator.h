@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       dormand_prince_integrator.h
+/// \brief      Prototype of template class "CDormandPrinceIntegrator"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DORMAND_PRINCE_INTEGRATOR_H
+#define DORMAND_PRINCE_INTEGRATOR_H
+
+//--- Program header ---------------------------------------------------------//
+#include "integrator.h"
+
+//--- Constants --------------------------------------------------------------//
+const double DORMAND_PRINCE_DEFAULT_TOLERANCE_ABS = 1.0e-3;  ///< Default absolute tolerance of local error
+const double DORMAND_PRINCE_DEFAULT_TOLERANCE_REL = 1.0e-10; ///< Default relative tolerance of local error
+const int    DORMAND_PRINCE_DEFAULT_MAX_SUBSTEPS  = 10000;   ///< Default maximum number of sub-steps per time step
+const double DORMAND_PRINCE_SAFETY                = 0.9;     ///< Safety factor of step size control
+const double DORMAND_PRINCE_FACTOR_MIN            = 0.2;     ///< Minimum factor of step size change
+const double DORMAND_PRINCE_FACTOR_MAX            = 5.0;     ///< Maximum factor of step size change
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Adaptive Runge-Kutta integrator of second order motion
+///
+/// Position and velocity are integrated as one coupled system, the
+/// acceleration being a function of position. The embedded fifth and fourth
+/// order solutions of Dormand and Prince estimate the local error of each
+/// sub-step. Sub-steps exceeding the tolerance are rejected, the size of
+/// the next sub-step is adapted to the estimated error. Thus, a time step
+/// is divided into as many sub-steps as needed, few on smooth parts of an
+/// orbit and many close to the periapsis.
+///
+/// The last stage of an accepted sub-step equals the first stage of the next
+/// one, hence, six evaluations of acceleration are needed per sub-step. The
+/// size of the last sub-step is returned to be used as initial guess for the
+/// next time step.
+///
+/// If the maximum number of sub-steps is reached, remaining sub-steps are
+/// accepted without error control to limit the processing time per step.
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+class CDormandPrinceIntegrator
+{
+
+    public:
+
+        //--- Constructor/Destructor -----------------------------------------//
+        CDormandPrinceIntegrator();
+
+        //--- Constant Methods -----------------------------------------------//
+        const int&      getMaxSubSteps() const;
+        const double&   getToleranceAbs() const;
+        const double&   getToleranceRel() const;
+
+        template <class TAccel>
+        int integrate(T&, T&, double&, const double&, const TAccel&, int&) const;
+
+        //--- Methods --------------------------------------------------------//
+        void setMaxSubSteps(const int);
+        void setTolerance(const double&, const double&);
+
+    private:
+
+        //--- Constant Methods [private] -------------------------------------//
+        double error(const T&, const T&, const T&, const T&, const T&, const T&) const;
+
+        //--- Variables [private] --------------------------------------------//
+        double  m_fToleranceAbs;    ///< Absolute tolerance of local error
+        double  m_fToleranceRel;    ///< Relative tolerance of local error
+        int     m_nMaxSubSteps;     ///< Maximum number of sub-steps per time step
+};
+
+//--- Implementation is done here for inline optimisation --------------------//
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns maximum number of sub-steps per time step
+///
+/// \return Maximum number of sub-steps
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline const int& CDormandPrinceIntegrator<T>::getMaxSubSteps() const
+{
+    METHOD_ENTRY("CDormandPrinceIntegrator::getMaxSubSteps")
+    return m_nMaxSubSteps;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns absolute tolerance of local error
+///
+/// \return Absolute tolerance
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline const double& CDormandPrinceIntegrator<T>::getToleranceAbs() const
+{
+    METHOD_ENTRY("CDormandPrinceIntegrator::getToleranceAbs")
+    return m_fToleranceAbs;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns relative tolerance of local error
+///
+/// \return Relative tolerance
+///
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline const double& CDormandPrinceIntegrator<T>::getToleranceRel() const
+{
+    METHOD_ENTRY("CDormandPrinceIntegrator::getToleranceRel")
+    return m_fToleranceRel;
+}
+
+//--- Implementation of template members -------------------------------------//
+#include "dormand_prince_integrator.tpp"
+
+#endif // DORMAND_PRINCE_INTEGRATOR_H
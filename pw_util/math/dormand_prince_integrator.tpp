@@ -0,0 +1,222 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of planeworld, a 2D simulation of physics and much more.
+// Copyright (C) 2017 Torsten Büschenfeld
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file       dormand_prince_integrator.tpp
+/// \brief      Implementation of template class "CDormandPrinceIntegrator"
+///
+/// \author     Torsten Büschenfeld (planeworld@bfeld.eu)
+/// \date       2017-10-17
+///
+////////////////////////////////////////////////////////////////////////////////
+
+//--- Standard header --------------------------------------------------------//
+#include <algorithm>
+#include <cmath>
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Constructor
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T>
+CDormandPrinceIntegrator<T>::CDormandPrinceIntegrator() :
+                                m_fToleranceAbs(DORMAND_PRINCE_DEFAULT_TOLERANCE_ABS),
+                                m_fToleranceRel(DORMAND_PRINCE_DEFAULT_TOLERANCE_REL),
+                                m_nMaxSubSteps(DORMAND_PRINCE_DEFAULT_MAX_SUBSTEPS)
+{
+    METHOD_ENTRY("CDormandPrinceIntegrator::CDormandPrinceIntegrator")
+    CTOR_CALL("CDormandPrinceIntegrator::CDormandPrinceIntegrator")
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Integrates position and velocity over given time
+///
+/// \param _Pos Position, integrated in place
+/// \param _Vel Velocity, integrated in place
+/// \param _fStepSize Initial guess of sub-step size, returns size proposed
+///                   for the next time step
+/// \param _fTime Time to integrate
+/// \param _Accel Acceleration as function of position
+/// \param _nRejected Returns number of rejected sub-steps
+///
+/// \return Number of accepted sub-steps
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T>
+template <class TAccel>
+int CDormandPrinceIntegrator<T>::integrate(T& _Pos, T& _Vel, double& _fStepSize,
+                                           const double& _fTime, const TAccel& _Accel,
+                                           int& _nRejected) const
+{
+    METHOD_ENTRY("CDormandPrinceIntegrator::integrate")
+
+    _nRejected = 0;
+    if (_fTime <= 0.0) return 0;
+
+    double fH = (_fStepSize > 0.0) ? std::min(_fStepSize, _fTime) : _fTime;
+    double fT = 0.0;
+    int nSteps = 0;
+
+    // Stages of position (velocities) and velocity (accelerations)
+    T KP1 = _Vel;
+    T KV1 = _Accel(_Pos);
+    T KP2, KP3, KP4, KP5, KP6, KP7;
+    T KV2, KV3, KV4, KV5, KV6, KV7;
+
+    while (fT < _fTime)
+    {
+        // Last sub-step ends exactly at given time
+        const double fRemaining = _fTime - fT;
+        const bool   bClamped = (fH >= fRemaining);
+        const double fStep = bClamped ? fRemaining : fH;
+
+        KP2 = _Vel + fStep*(KV1*(1.0/5.0));
+        KV2 = _Accel(_Pos + fStep*(KP1*(1.0/5.0)));
+        KP3 = _Vel + fStep*(KV1*(3.0/40.0) + KV2*(9.0/40.0));
+        KV3 = _Accel(_Pos + fStep*(KP1*(3.0/40.0) + KP2*(9.0/40.0)));
+        KP4 = _Vel + fStep*(KV1*(44.0/45.0) - KV2*(56.0/15.0) + KV3*(32.0/9.0));
+        KV4 = _Accel(_Pos + fStep*(KP1*(44.0/45.0) - KP2*(56.0/15.0) + KP3*(32.0/9.0)));
+        KP5 = _Vel + fStep*(KV1*(19372.0/6561.0) - KV2*(25360.0/2187.0) +
+                            KV3*(64448.0/6561.0) - KV4*(212.0/729.0));
+        KV5 = _Accel(_Pos + fStep*(KP1*(19372.0/6561.0) - KP2*(25360.0/2187.0) +
+                                   KP3*(64448.0/6561.0) - KP4*(212.0/729.0)));
+        KP6 = _Vel + fStep*(KV1*(9017.0/3168.0) - KV2*(355.0/33.0) + KV3*(46732.0/5247.0) +
+                            KV4*(49.0/176.0) - KV5*(5103.0/18656.0));
+        KV6 = _Accel(_Pos + fStep*(KP1*(9017.0/3168.0) - KP2*(355.0/33.0) + KP3*(46732.0/5247.0) +
+                                   KP4*(49.0/176.0) - KP5*(5103.0/18656.0)));
+
+        // Fifth order solution
+        const T PosNew = _Pos + fStep*(KP1*(35.0/384.0) + KP3*(500.0/1113.0) + KP4*(125.0/192.0) -
+                                       KP5*(2187.0/6784.0) + KP6*(11.0/84.0));
+        const T VelNew = _Vel + fStep*(KV1*(35.0/384.0) + KV3*(500.0/1113.0) + KV4*(125.0/192.0) -
+                                       KV5*(2187.0/6784.0) + KV6*(11.0/84.0));
+        KP7 = VelNew;
+        KV7 = _Accel(PosNew);
+
+        // Difference to embedded fourth order solution
+        const T ErrPos = fStep*(KP1*(71.0/57600.0) - KP3*(71.0/16695.0) + KP4*(71.0/1920.0) -
+                                KP5*(17253.0/339200.0) + KP6*(22.0/525.0) - KP7*(1.0/40.0));
+        const T ErrVel = fStep*(KV1*(71.0/57600.0) - KV3*(71.0/16695.0) + KV4*(71.0/1920.0) -
+                                KV5*(17253.0/339200.0) + KV6*(22.0/525.0) - KV7*(1.0/40.0));
+        const double fErr = this->error(_Pos, _Vel, PosNew, VelNew, ErrPos, ErrVel);
+
+        double fFactor = DORMAND_PRINCE_FACTOR_MAX;
+        if (fErr > 0.0)
+            fFactor = std::min(DORMAND_PRINCE_FACTOR_MAX,
+                      std::max(DORMAND_PRINCE_FACTOR_MIN, DORMAND_PRINCE_SAFETY*std::pow(fErr, -0.2)));
+
+        if (fErr <= 1.0 || nSteps + _nRejected >= m_nMaxSubSteps)
+        {
+            fT = bClamped ? _fTime : fT + fStep;
+            _Pos = PosNew;
+            _Vel = VelNew;
+            KP1 = KP7;
+            KV1 = KV7;
+            ++nSteps;
+
+            // A clamped sub-step doesn't tell much about the size of the next one
+            fH = bClamped ? std::max(fH, fStep*fFactor) : fStep*fFactor;
+        }
+        else
+        {
+            ++_nRejected;
+            fH = fStep*std::min(fFactor, 1.0);
+        }
+    }
+    _fStepSize = fH;
+    return nSteps;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets maximum number of sub-steps per time step
+///
+/// \param _nMaxSubSteps Maximum number of sub-steps
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T>
+void CDormandPrinceIntegrator<T>::setMaxSubSteps(const int _nMaxSubSteps)
+{
+    METHOD_ENTRY("CDormandPrinceIntegrator::setMaxSubSteps")
+
+    if (_nMaxSubSteps < 1)
+    {
+        WARNING_MSG("Dormand-Prince Integrator", "Maximum number of sub-steps must be at least 1.")
+        return;
+    }
+    m_nMaxSubSteps = _nMaxSubSteps;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Sets tolerances of local error
+///
+/// \param _fToleranceRel Relative tolerance
+/// \param _fToleranceAbs Absolute tolerance
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T>
+void CDormandPrinceIntegrator<T>::setTolerance(const double& _fToleranceRel, const double& _fToleranceAbs)
+{
+    METHOD_ENTRY("CDormandPrinceIntegrator::setTolerance")
+
+    if (_fToleranceRel < 0.0 || _fToleranceAbs < 0.0 || _fToleranceRel + _fToleranceAbs <= 0.0)
+    {
+        WARNING_MSG("Dormand-Prince Integrator", "Tolerances must not be negative, one of them must be positive.")
+        return;
+    }
+    m_fToleranceRel = _fToleranceRel;
+    m_fToleranceAbs = _fToleranceAbs;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Returns local error, scaled by tolerances
+///
+/// Errors of position and velocity are scaled separately and combined as
+/// root mean square. Values less or equal to 1 are within tolerance.
+///
+/// \param _Pos Position before sub-step
+/// \param _Vel Velocity before sub-step
+/// \param _PosNew Position after sub-step
+/// \param _VelNew Velocity after sub-step
+/// \param _ErrPos Estimated error of position
+/// \param _ErrVel Estimated error of velocity
+///
+/// \return Scaled error
+///
+///////////////////////////////////////////////////////////////////////////////
+template <class T>
+inline double CDormandPrinceIntegrator<T>::error(const T& _Pos, const T& _Vel,
+                                                 const T& _PosNew, const T& _VelNew,
+                                                 const T& _ErrPos, const T& _ErrVel) const
+{
+    METHOD_ENTRY("CDormandPrinceIntegrator::error")
+
+    const double fScalePos = m_fToleranceAbs + m_fToleranceRel * std::max(_Pos.norm(), _PosNew.norm());
+    const double fScaleVel = m_fToleranceAbs + m_fToleranceRel * std::max(_Vel.norm(), _VelNew.norm());
+    const double fErrPos = _ErrPos.norm() / fScalePos;
+    const double fErrVel = _ErrVel.norm() / fScaleVel;
+
+    return std::sqrt(0.5 * (fErrPos*fErrPos + fErrVel*fErrVel));
+}
@@ -49,6 +49,9 @@ class CEulerIntegrator : public IIntegrator<T>
         CEulerIntegrator();
         ~CEulerIntegrator();
 
+        //--- Memory management ----------------------------------------------//
+        POOL_ALLOCATION(CEulerIntegrator<T>, 1)
+
         //--- Constant Methods -----------------------------------------------//
         IIntegrator<T>* clone() const;
         const T         getPrevValue() const;
@@ -31,8 +31,13 @@
 #ifndef INTEGRATOR_H
 #define INTEGRATOR_H
 
+//--- Standard header --------------------------------------------------------//
+#include <map>
+#include <string>
+
 //--- Program header ---------------------------------------------------------//
 #include "log.h"
+#include "pool.h"
 #include <eigen3/Eigen/Core>
 
 using namespace Eigen;
@@ -42,9 +47,44 @@ typedef enum
 {
     INTEGRATOR_EULER,
     INTEGRATOR_ADAMS_BASHFORTH,
-    INTEGRATOR_ADAMS_MOULTON
+    INTEGRATOR_ADAMS_MOULTON,
+    INTEGRATOR_DORMAND_PRINCE,
+    INTEGRATOR_NONE
 } IntegratorType;
 
+//--- Enum parser ------------------------------------------------------------//
+const std::map<IntegratorType, std::string> mapIntegratorToString = {
+    {INTEGRATOR_EULER, "euler"},
+    {INTEGRATOR_ADAMS_BASHFORTH, "adams_bashforth"},
+    {INTEGRATOR_ADAMS_MOULTON, "adams_moulton"},
+    {INTEGRATOR_DORMAND_PRINCE, "dormand_prince"}
+}; ///< Map from IntegratorType to string
+
+const std::map<std::string, IntegratorType> STRING_TO_INTEGRATOR_TYPE_MAP = {
+    {"euler", INTEGRATOR_EULER},
+    {"adams_bashforth", INTEGRATOR_ADAMS_BASHFORTH},
+    {"adams_moulton", INTEGRATOR_ADAMS_MOULTON},
+    {"dormand_prince", INTEGRATOR_DORMAND_PRINCE}
+}; ///< Map from string to IntegratorType
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Maps given string to integrator type
+///
+/// \return Integrator type
+///
+////////////////////////////////////////////////////////////////////////////////
+static IntegratorType mapStringToIntegratorType(const std::string& _strS)
+{
+    METHOD_ENTRY("mapStringToIntegratorType")
+
+    const auto ci = STRING_TO_INTEGRATOR_TYPE_MAP.find(_strS);
+    if (ci != STRING_TO_INTEGRATOR_TYPE_MAP.end())
+        return ci->second;
+    else
+        return INTEGRATOR_NONE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// \brief Abstract class representing an integrator